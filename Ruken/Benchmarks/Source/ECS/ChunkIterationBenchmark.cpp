@@ -0,0 +1,201 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include "Harness.hpp"
+
+#include "ECS/Component.hpp"
+#include "ECS/EntityAdmin.hpp"
+#include "ECS/ComponentItem.hpp"
+#include "ECS/ComponentSystem.hpp"
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_entities         = 1000000u;
+    constexpr RkSize g_frames           = 10u;
+    constexpr RkSize g_samples          = 5u;
+    constexpr RkSize g_large_chunk_size = 512u * 1024u;
+
+    enum class EComponent
+    {
+        Position,
+        Velocity,
+        Life
+    };
+
+    struct PositionComponentItem : ComponentItem<RkFloat, RkFloat, RkFloat> { using ComponentItem::ComponentItem; };
+    struct VelocityComponentItem : ComponentItem<RkFloat, RkFloat, RkFloat> { using ComponentItem::ComponentItem; };
+    struct LifeComponentItem     : ComponentItem<RkInt32>                    { using ComponentItem::ComponentItem; };
+
+    RUKEN_DEFINE_COMPONENT(EComponent, Position);
+    RUKEN_DEFINE_COMPONENT(EComponent, Velocity);
+    RUKEN_DEFINE_COMPONENT(EComponent, Life);
+
+    /**
+     * \brief Streams 2 of the 3 fields of the positions and of the velocities, leaving the others in the chunks
+     */
+    class MoveSystem final : public ComponentSystem<PositionComponent, VelocityComponent const>
+    {
+        public:
+
+            std::atomic<RkSize> processed {0u};
+
+            RkVoid OnUpdate(Range& in_range) noexcept override
+            {
+                processed.fetch_add(in_range.Size(), std::memory_order_relaxed);
+
+                RkFloat*       position_x = in_range.Get<PositionComponent>().GetStorage<0>();
+                RkFloat*       position_y = in_range.Get<PositionComponent>().GetStorage<1>();
+                RkFloat const* velocity_x = in_range.Get<VelocityComponent>().GetStorage<0>();
+                RkFloat const* velocity_y = in_range.Get<VelocityComponent>().GetStorage<1>();
+
+                for (RkSize index = in_range.Begin(); index < in_range.End(); ++index)
+                {
+                    position_x[index] += velocity_x[index];
+                    position_y[index] += velocity_y[index];
+                }
+            }
+    };
+
+    /**
+     * \brief Runs the same loop as MoveSystem over plain arrays, as a reference
+     */
+    struct ReferenceStorage
+    {
+        std::vector<RkFloat> position_x;
+        std::vector<RkFloat> position_y;
+        std::vector<RkFloat> velocity_x;
+        std::vector<RkFloat> velocity_y;
+
+        explicit ReferenceStorage(RkSize const in_size) noexcept:
+            position_x(in_size, 0.0f),
+            position_y(in_size, 0.0f),
+            velocity_x(in_size, 1.0f),
+            velocity_y(in_size, 1.0f)
+        {}
+
+        RkVoid Update() noexcept
+        {
+            for (RkSize index = 0u; index < position_x.size(); ++index)
+            {
+                position_x[index] += velocity_x[index];
+                position_y[index] += velocity_y[index];
+            }
+        }
+    };
+
+    /**
+     * \brief Returns the fastest frame time of a few samples
+     * \param in_update Function running a frame
+     * \return Milliseconds per frame
+     */
+    template <typename TUpdate>
+    RkDouble MeasureFrames(TUpdate&& in_update) noexcept
+    {
+        RkDouble best = std::numeric_limits<RkDouble>::max();
+
+        for (RkSize sample = 0u; sample < g_samples; ++sample)
+        {
+            auto const start = std::chrono::steady_clock::now();
+
+            for (RkSize frame = 0u; frame < g_frames; ++frame)
+                in_update();
+
+            best = std::min(best, SecondsSince(start) * 1e3 / g_frames);
+        }
+
+        return best;
+    }
+
+    /**
+     * \brief Measures MoveSystem over the entities of an admin using the given chunk size
+     * \param in_scheduler Scheduler updating the systems
+     * \param in_chunk_size Chunk size of the entity admin
+     * \param out_processed Number of entities processed by the system over every frame
+     * \return Milliseconds per frame
+     */
+    RkDouble MeasureSystem(Scheduler& in_scheduler, RkSize const in_chunk_size, RkSize& out_processed) noexcept
+    {
+        EntityAdmin admin(in_scheduler, in_chunk_size);
+
+        auto const initialize = [](auto& in_range) {
+            std::fill(in_range.template Get<VelocityComponent>().template GetStorage<0>() + in_range.Begin(), in_range.template Get<VelocityComponent>().template GetStorage<0>() + in_range.End(), 1.0f);
+            std::fill(in_range.template Get<VelocityComponent>().template GetStorage<1>() + in_range.Begin(), in_range.template Get<VelocityComponent>().template GetStorage<1>() + in_range.End(), 1.0f);
+        };
+
+        // Two archetypes, the second one storing an additional component which isn't accessed by the system
+        admin.CreateEntities<PositionComponent, VelocityComponent>               (g_entities,      initialize);
+        admin.CreateEntities<PositionComponent, VelocityComponent, LifeComponent>(g_entities / 2u, initialize);
+
+        MoveSystem& system = admin.CreateSystem<MoveSystem>();
+
+        RkDouble const time = MeasureFrames([&admin] { admin.UpdateSystems(); });
+
+        out_processed = system.processed.load();
+
+        return time;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(ECSChunkIteration)
+{
+    // A single worker, the system and the reference loop are then compared on the same core
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), ESchedulerMode::WorkStealing);
+
+    // The default chunks, then the bigger chunks an admin streaming a few huge archetypes would use
+    RkSize         default_processed = 0u;
+    RkSize         large_processed   = 0u;
+    RkDouble const default_time      = MeasureSystem(*scheduler, RUKEN_ECS_CHUNK_SIZE, default_processed);
+    RkDouble const large_time        = MeasureSystem(*scheduler, g_large_chunk_size,   large_processed);
+
+    ReferenceStorage reference(g_entities + g_entities / 2u);
+
+    RkDouble const reference_time = MeasureFrames([&reference] { reference.Update(); });
+
+    std::cout << "    " << g_entities + g_entities / 2u << " entities | plain arrays " << reference_time << " ms/frame"
+              << " | " << RUKEN_ECS_CHUNK_SIZE / 1024u << "KB chunks " << default_time << " ms/frame (ratio " << default_time / reference_time << ")"
+              << " | " << g_large_chunk_size   / 1024u << "KB chunks " << large_time   << " ms/frame (ratio " << large_time   / reference_time << ")" << std::endl;
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    RUKEN_BENCHMARK_CHECK(default_processed == (g_entities + g_entities / 2u) * g_samples * g_frames);
+    RUKEN_BENCHMARK_CHECK(large_processed   == (g_entities + g_entities / 2u) * g_samples * g_frames);
+    RUKEN_BENCHMARK_CHECK(reference.position_x.back() == static_cast<RkFloat>(g_samples * g_frames));
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "Harness.hpp"
+
+#include "ECS/Component.hpp"
+#include "ECS/EntityAdmin.hpp"
+#include "ECS/ComponentItem.hpp"
+#include "ECS/SparseComponent.hpp"
+#include "ECS/ComponentSystem.hpp"
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_frames = 20u;
+
+    enum class EComponent
+    {
+        Position,
+        Health,
+        Order
+    };
+
+    struct PositionComponentItem : ComponentItem<RkFloat, RkFloat, RkFloat> { using ComponentItem::ComponentItem; };
+    struct HealthComponentItem   : ComponentItem<RkInt32>                    { using ComponentItem::ComponentItem; };
+    struct OrderComponentItem    : ComponentItem<RkUint32, RkFloat>          { using ComponentItem::ComponentItem; };
+
+    RUKEN_DEFINE_COMPONENT       (EComponent, Position);
+    RUKEN_DEFINE_SPARSE_COMPONENT(EComponent, Health);
+    RUKEN_DEFINE_COMPONENT       (EComponent, Order);
+
+    /**
+     * \brief Counts the entities owning a position, and the sum of their health if they own a health too
+     */
+    template <typename... TComponents>
+    class CountSystem final : public ComponentSystem<PositionComponent const, TComponents const...>
+    {
+        public:
+
+            std::atomic<RkSize>  entities {0u};
+            std::atomic<RkInt32> health   {0};
+
+            RkVoid OnUpdate(typename ComponentSystem<PositionComponent const, TComponents const...>::Range& in_range) noexcept override
+            {
+                entities.fetch_add(in_range.Size());
+
+                if constexpr (sizeof...(TComponents) > 0u)
+                {
+                    for (RkSize index = in_range.Begin(); index < in_range.End(); ++index)
+                        health.fetch_add(in_range.template Get<HealthComponent>().template Get<0>(index));
+                }
+            }
+    };
+
+    /**
+     * \brief Waits a bit on every range, suspending its job when running on a worker,
+     *        then records the creation of an entity holding the index of the system and the first position of the range
+     */
+    template <RkUint32 TSystem>
+    class SuspendingSystem final : public ComponentSystem<PositionComponent const>
+    {
+        public:
+
+            RkVoid OnUpdate(Range& in_range) noexcept override
+            {
+                // The worker picks up the chunks of the other systems in the meantime
+                if (Scheduler* scheduler = Scheduler::GetCurrentScheduler())
+                {
+                    auto const deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+
+                    scheduler->WaitUntil([deadline] { return std::chrono::steady_clock::now() >= deadline; });
+                }
+
+                EntityCommandBuffer& commands = GetCommandBuffer();
+                EntityID const       entity   = commands.CreateEntity();
+
+                commands.AddComponent<OrderComponent>(entity, OrderComponentItem(TSystem, in_range.Get<PositionComponent>().GetStorage<0>()[in_range.Begin()]));
+            }
+    };
+
+    /**
+     * \brief Only used to find the entities created by the suspending systems
+     */
+    class OrderSystem final : public ComponentSystem<OrderComponent const>
+    {
+        public:
+
+            RkVoid OnUpdate(Range&) noexcept override
+            {}
+    };
+}
+
+RUKEN_BENCHMARK_CASE(ECSDeferredSparseCreation)
+{
+    // Entities created by a command buffer with a sparse component must end up like the ones created right away:
+    // stored into the archetype of their other components, and into the sparse set of the sparse component
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), ESchedulerMode::WorkStealing);
+
+    {
+        EntityAdmin admin(*scheduler);
+
+        admin.CreateEntity<PositionComponent, HealthComponent>();
+
+        EntityCommandBuffer& command_buffer = admin.GetCommandBuffer();
+
+        // Default initialized, then with a value copied into the sparse set at playback
+        command_buffer.CreateEntity<PositionComponent, HealthComponent>();
+
+        EntityID const placeholder = command_buffer.CreateEntity<HealthComponent, PositionComponent>();
+
+        command_buffer.RemoveComponent<HealthComponent>(placeholder);
+        command_buffer.AddComponent<HealthComponent>(placeholder, HealthComponentItem(41));
+
+        admin.PlaybackCommands();
+
+        RUKEN_BENCHMARK_CHECK(admin.EntitiesCount() == 3u);
+
+        auto& all_entities    = admin.CreateSystem<CountSystem<>>();
+        auto& sparse_entities = admin.CreateSystem<CountSystem<HealthComponent>>();
+
+        admin.UpdateSystems();
+
+        RUKEN_BENCHMARK_CHECK(all_entities   .entities.load() == 3u);
+        RUKEN_BENCHMARK_CHECK(sparse_entities.entities.load() == 3u);
+        RUKEN_BENCHMARK_CHECK(sparse_entities.health  .load() == 41);
+    }
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    return true;
+}
+RUKEN_BENCHMARK_CASE(ECSSuspendedCommandOrder)
+{
+    // Commands are played back by system, then by chunk, even if the jobs recording them got suspended
+    // while their worker processed the chunks of other systems
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(3u), ESchedulerMode::WorkStealing);
+
+    {
+        EntityAdmin admin(*scheduler);
+
+        RkFloat next = 0.0f;
+
+        admin.CreateEntities<PositionComponent>(200000u, [&next] (auto& in_range) {
+            for (RkSize index = in_range.Begin(); index < in_range.End(); ++index, next += 1.0f)
+                in_range.template Get<PositionComponent>().template GetStorage<0>()[index] = next;
+        });
+
+        admin.CreateSystem<SuspendingSystem<0u>>();
+        admin.CreateSystem<SuspendingSystem<1u>>();
+        admin.CreateSystem<SuspendingSystem<2u>>();
+
+        OrderSystem const& order_system = admin.CreateSystem<OrderSystem>();
+
+        RkSize                misplaced = 0u;
+        RkSize                recorded  = 0u;
+        std::vector<EntityID> created;
+
+        for (RkSize frame = 0u; frame < g_frames; ++frame)
+        {
+            admin.UpdateSystems();
+
+            // Entities are stored in playback order, each system after the previous one and their chunks in order
+            std::pair<RkUint32, RkFloat> previous {0u, -1.0f};
+
+            for (Archetype const* archetype : order_system.GetQuery().GetArchetypes())
+            {
+                for (RkSize chunk = 0u; chunk < archetype->GetChunksCount(); ++chunk)
+                {
+                    OrderComponent const component = archetype->GetComponent<OrderComponent>(chunk);
+
+                    for (RkSize row = 0u; row < archetype->GetChunk(chunk).count; ++row)
+                    {
+                        std::pair<RkUint32, RkFloat> const order {component.GetStorage<0>()[row], component.GetStorage<1>()[row]};
+
+                        if (!(previous < order))
+                            ++misplaced;
+
+                        previous = order;
+
+                        created.push_back(archetype->GetEntities(chunk)[row]);
+                    }
+                }
+            }
+
+            recorded += created.size();
+
+            for (EntityID const& entity : created)
+                admin.DestroyEntity(entity);
+
+            created.clear();
+        }
+
+        RUKEN_BENCHMARK_CHECK(recorded > 0u);
+        RUKEN_BENCHMARK_CHECK(misplaced == 0u);
+    }
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    return true;
+}
@@ -0,0 +1,243 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Harness.hpp"
+
+#include "ECS/Component.hpp"
+#include "ECS/EntityAdmin.hpp"
+#include "ECS/ComponentItem.hpp"
+#include "ECS/WorldSnapshot.hpp"
+#include "ECS/SparseComponent.hpp"
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkChar const* g_path     = "ECSSnapshotValidation.snapshot";
+    constexpr RkSize        g_entities = 64u;
+
+    enum class EComponent
+    {
+        Position,
+        Health
+    };
+
+    struct PositionComponentItem : ComponentItem<RkFloat, RkFloat, RkFloat> { using ComponentItem::ComponentItem; };
+    struct HealthComponentItem   : ComponentItem<RkInt32>                    { using ComponentItem::ComponentItem; };
+
+    RUKEN_DEFINE_COMPONENT       (EComponent, Position);
+    RUKEN_DEFINE_SPARSE_COMPONENT(EComponent, Health);
+
+    /**
+     * \brief Snapshot loaded into memory, aligned on 8 bytes like a mapped file
+     */
+    struct Snapshot
+    {
+        std::vector<RkUint64> storage;
+        RkSize                size;
+
+        [[nodiscard]]
+        RkUint8* GetData() noexcept
+        {
+            return reinterpret_cast<RkUint8*>(storage.data());
+        }
+
+        [[nodiscard]]
+        WorldSnapshot::Header& GetHeader() noexcept
+        {
+            return *reinterpret_cast<WorldSnapshot::Header*>(storage.data());
+        }
+
+        /**
+         * \brief Returns the generations of the entity table, skipping the component descriptors
+         * \return First generation
+         */
+        [[nodiscard]]
+        RkUint32* GetGenerations() noexcept
+        {
+            RkSize offset = sizeof(WorldSnapshot::Header);
+
+            for (RkSize component = 0u; component < GetHeader().components_count; ++component)
+            {
+                WorldSnapshot::ComponentHeader const* header = reinterpret_cast<WorldSnapshot::ComponentHeader const*>(GetData() + offset);
+                WorldSnapshot::FieldHeader     const* fields = reinterpret_cast<WorldSnapshot::FieldHeader     const*>(header + 1);
+
+                offset += sizeof(WorldSnapshot::ComponentHeader) + header->fields_count * sizeof(WorldSnapshot::FieldHeader);
+
+                for (RkSize field = 0u; field < header->fields_count; ++field)
+                    offset += fields[field].size;
+
+                offset = (offset + WorldSnapshot::section_alignment - 1u) & ~(WorldSnapshot::section_alignment - 1u);
+            }
+
+            return reinterpret_cast<RkUint32*>(GetData() + offset);
+        }
+
+        /**
+         * \brief Replaces every occurrence of an entity ID stored after the entity table, in the archetypes and the sparse sets
+         * \param in_entity Replaced ID
+         * \param in_replacement New ID
+         * \return Number of replaced IDs
+         */
+        RkSize ReplaceEntity(EntityID const in_entity, EntityID const in_replacement) noexcept
+        {
+            RkUint8* const generations_end = reinterpret_cast<RkUint8*>(GetGenerations() + GetHeader().slots_count);
+            RkSize         replaced        = 0u;
+
+            for (RkSize offset = 0u; offset + sizeof(EntityID) <= size; offset += sizeof(EntityID))
+            {
+                if (GetData() + offset < generations_end || std::memcmp(GetData() + offset, &in_entity, sizeof(EntityID)) != 0)
+                    continue;
+
+                std::memcpy(GetData() + offset, &in_replacement, sizeof(EntityID));
+
+                ++replaced;
+            }
+
+            return replaced;
+        }
+    };
+
+    /**
+     * \brief Reads a snapshot file
+     * \param in_path Path of the file
+     * \return Snapshot, empty if the file couldn't be read
+     */
+    Snapshot ReadSnapshot(RkChar const* in_path) noexcept
+    {
+        std::ifstream file(in_path, std::ios::binary | std::ios::ate);
+        Snapshot      snapshot {{}, 0u};
+
+        if (!file)
+            return snapshot;
+
+        snapshot.size = static_cast<RkSize>(file.tellg());
+        snapshot.storage.resize((snapshot.size + sizeof(RkUint64) - 1u) / sizeof(RkUint64));
+
+        file.seekg(0);
+        file.read(reinterpret_cast<RkChar*>(snapshot.storage.data()), static_cast<std::streamsize>(snapshot.size));
+
+        return snapshot;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(ECSSnapshotValidation)
+{
+    // Corrupted snapshots must be rejected before anything gets loaded, leaving the entity admin empty
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), ESchedulerMode::WorkStealing);
+
+    {
+        EntityID recycled_entity;
+        EntityID destroyed_entity;
+
+        {
+            EntityAdmin admin(*scheduler);
+
+            EntityRange const entities = admin.CreateEntities<PositionComponent>(g_entities);
+
+            // A recycled slot of generation 2 owning a sparse component, and a free slot
+            admin.DestroyEntity(entities[3u]);
+
+            recycled_entity  = admin.CreateEntity<PositionComponent, HealthComponent>();
+            destroyed_entity = entities[5u];
+
+            admin.DestroyEntity(destroyed_entity);
+
+            RUKEN_BENCHMARK_CHECK(recycled_entity.GetIndex() == 3u && recycled_entity.GetGeneration() == 2u);
+            RUKEN_BENCHMARK_CHECK(admin.Save(g_path));
+        }
+
+        Snapshot const snapshot = ReadSnapshot(g_path);
+
+        std::remove(g_path);
+
+        RUKEN_BENCHMARK_CHECK(snapshot.size > sizeof(WorldSnapshot::Header));
+
+        EntityAdmin admin(*scheduler);
+
+        // Truncated snapshots
+        Snapshot truncated          = snapshot;
+        RkBool   truncated_rejected = true;
+
+        for (RkSize size = 0u; size < snapshot.size; size += 4u)
+            truncated_rejected = truncated_rejected && !admin.Load(truncated.GetData(), size);
+
+        RUKEN_BENCHMARK_CHECK(truncated_rejected);
+
+        // Counts which don't fit in the snapshot, they must be rejected before anything is allocated from them
+        Snapshot archetypes_count  = snapshot;
+        Snapshot sparse_sets_count = snapshot;
+        Snapshot header_only       = {{}, sizeof(WorldSnapshot::Header)};
+
+        archetypes_count .GetHeader().archetypes_count  = 0xFFFFFFFFu;
+        sparse_sets_count.GetHeader().sparse_sets_count = 0xFFFFFFFFu;
+
+        header_only.storage.resize(sizeof(WorldSnapshot::Header) / sizeof(RkUint64));
+        header_only.GetHeader() = WorldSnapshot::Header {WorldSnapshot::magic, WorldSnapshot::version, RUKEN_ECS_COLUMN_ALIGNMENT, 0u, 0xFFFFFFFFu, 0u, 0u, 0u, 0u};
+
+        RUKEN_BENCHMARK_CHECK(!admin.Load(archetypes_count .GetData(), archetypes_count .size));
+        RUKEN_BENCHMARK_CHECK(!admin.Load(sparse_sets_count.GetData(), sparse_sets_count.size));
+        RUKEN_BENCHMARK_CHECK(!admin.Load(header_only      .GetData(), header_only      .size));
+
+        // Generation 0, the one of default constructed IDs, for a free slot and for an entity along with its IDs
+        Snapshot free_slot    = snapshot;
+        Snapshot alive_entity = snapshot;
+
+        free_slot.GetGenerations()[destroyed_entity.GetIndex()] = 0u;
+
+        alive_entity.GetGenerations()[recycled_entity.GetIndex()] = 0u;
+
+        // Once in its archetype, once in the sparse set
+        RUKEN_BENCHMARK_CHECK(alive_entity.ReplaceEntity(recycled_entity, EntityID::Create(recycled_entity.GetIndex(), 0u)) == 2u);
+
+        RUKEN_BENCHMARK_CHECK(!admin.Load(free_slot   .GetData(), free_slot   .size));
+        RUKEN_BENCHMARK_CHECK(!admin.Load(alive_entity.GetData(), alive_entity.size));
+
+        RUKEN_BENCHMARK_CHECK(admin.EntitiesCount() == 0u);
+
+        // The untouched snapshot still loads
+        Snapshot valid = snapshot;
+
+        RUKEN_BENCHMARK_CHECK(admin.Load(valid.GetData(), valid.size));
+        RUKEN_BENCHMARK_CHECK(admin.EntitiesCount() == g_entities - 1u);
+        RUKEN_BENCHMARK_CHECK(admin.IsAlive(recycled_entity) && !admin.IsAlive(destroyed_entity));
+    }
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    return true;
+}
\ No newline at end of file
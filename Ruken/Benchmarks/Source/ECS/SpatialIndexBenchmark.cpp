@@ -0,0 +1,242 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "Harness.hpp"
+
+#include "ECS/Component.hpp"
+#include "ECS/EntityAdmin.hpp"
+#include "ECS/ComponentItem.hpp"
+#include "ECS/ComponentSystem.hpp"
+#include "ECS/SpatialIndexSystem.hpp"
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize   g_entities       = 1000000u;
+    constexpr RkSize   g_queries        = 10000u;
+    constexpr RkSize   g_frames         = 10u;
+    constexpr RkSize   g_churn          = 1000u;
+    constexpr RkSize   g_moving_ratio   = 8u;
+    constexpr RkUint16 g_workers        = 3u;
+    constexpr RkFloat  g_world_size     = 500.0f;
+    constexpr RkFloat  g_cell_size      = 10.0f;
+
+    enum class EComponent
+    {
+        Position,
+        Moving
+    };
+
+    struct PositionComponentItem : ComponentItem<Vector3f> { using ComponentItem::ComponentItem; };
+    struct MovingComponentItem   : ComponentItem<RkUint8>  { using ComponentItem::ComponentItem; };
+
+    RUKEN_DEFINE_COMPONENT(EComponent, Position);
+    RUKEN_DEFINE_COMPONENT(EComponent, Moving);
+
+    using IndexSystem = SpatialIndexSystem<PositionComponent>;
+
+    /**
+     * \brief Moves the entities flagged as moving by a small pseudo random step, every frame
+     */
+    class MoveSystem final : public ComponentSystem<PositionComponent, MovingComponent const>
+    {
+        public:
+
+            RkUint32 frame {0u};
+
+            RkVoid OnUpdate(Range& in_range) noexcept override
+            {
+                Vector3f* positions = in_range.Get<PositionComponent>().GetStorage<0>();
+
+                for (RkSize index = in_range.Begin(); index < in_range.End(); ++index)
+                {
+                    RkUint32 const hash = static_cast<RkUint32>(index * 2654435761u) ^ (frame * 40503u);
+
+                    for (RkSize axis = 0u; axis < 3u; ++axis)
+                        positions[index].data[axis] += static_cast<RkFloat>((hash >> (axis * 8u)) & 255u) / 255.0f - 0.5f;
+                }
+            }
+    };
+
+    /**
+     * \brief Rebuilds a spatial index from scratch out of every chunk of the archetypes matching the index system
+     * \param in_scheduler Scheduler used to process the chunks in parallel
+     * \param in_system Index system, only used for its matching archetypes
+     * \param inout_index Rebuilt index
+     */
+    RkVoid RebuildIndex(Scheduler& in_scheduler, IndexSystem const& in_system, SpatialIndex& inout_index) noexcept
+    {
+        std::vector<std::pair<Archetype const*, RkSize>> chunks;
+        std::vector<RkSize>                              offsets(1u, 0u);
+
+        for (Archetype const* archetype : in_system.GetQuery().GetArchetypes())
+        {
+            for (RkSize chunk = 0u; chunk < archetype->GetChunksCount(); ++chunk)
+            {
+                chunks .emplace_back(archetype, chunk);
+                offsets.push_back   (offsets.back() + archetype->GetChunk(chunk).count);
+            }
+        }
+
+        inout_index.Clear      ();
+        inout_index.BeginUpdate(chunks.size(), offsets.back());
+
+        in_scheduler.ParallelFor(0u, chunks.size(), 1u, [&chunks, &offsets, &inout_index] (RkSize const in_begin, RkSize const in_end) {
+            for (RkSize index = in_begin; index < in_end; ++index)
+            {
+                auto const [archetype, chunk] = chunks[index];
+
+                PositionComponent const component = archetype->GetComponent<PositionComponent>(chunk);
+
+                inout_index.UpdateBatch(index, offsets[index], archetype->GetEntities(chunk), component.GetStorage<0>(), archetype->GetChunk(chunk).count);
+            }
+        });
+
+        inout_index.EndUpdate(in_scheduler);
+    }
+}
+
+RUKEN_BENCHMARK_CASE(ECSSpatialIndexUpdate)
+{
+    // Every frame, 1 entity out of 8 moves, then a few entities are destroyed, lose their position or get created.
+    // The index system only updates the changed chunks and removes the entities which left its archetypes, the other index is rebuilt from scratch.
+    // Both indices then answer the same radius queries
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(g_workers, ESchedulerMode::WorkStealing);
+
+    {
+        EntityAdmin admin(*scheduler);
+
+        std::mt19937                          random(42u);
+        std::uniform_real_distribution<RkFloat> coordinate(0.0f, g_world_size);
+
+        auto const initialize = [&random, &coordinate] (auto& in_range) {
+            Vector3f* positions = in_range.template Get<PositionComponent>().template GetStorage<0>();
+
+            for (RkSize index = in_range.Begin(); index < in_range.End(); ++index)
+                positions[index] = Vector3f {{coordinate(random), coordinate(random), coordinate(random)}};
+        };
+
+        EntityRange const moving_entities = admin.CreateEntities<PositionComponent, MovingComponent>(g_entities / g_moving_ratio,             initialize);
+        EntityRange const static_entities = admin.CreateEntities<PositionComponent>                 (g_entities - g_entities / g_moving_ratio, initialize);
+
+        MoveSystem&  move_system  = admin.CreateSystem<MoveSystem> ();
+        IndexSystem& index_system = admin.CreateSystem<IndexSystem>(g_cell_size);
+        SpatialIndex rebuilt_index(g_cell_size);
+
+        std::vector<EntityID> alive_entities;
+
+        for (RkSize index = 0u; index < static_entities.Size(); ++index)
+            alive_entities.push_back(static_entities[index]);
+
+        std::vector<SpatialIndex::Sphere> queries(g_queries);
+        SpatialIndex::QueryResults        incremental_results;
+        SpatialIndex::QueryResults        rebuilt_results;
+
+        // First frame, indexing every entity
+        admin.UpdateSystems();
+
+        RkDouble update_seconds  = 0.0;
+        RkDouble rebuild_seconds = 0.0;
+        RkDouble query_seconds   = 0.0;
+        RkBool   same_results    = true;
+
+        for (RkSize frame = 0u; frame < g_frames; ++frame)
+        {
+            // Churn of the static entities: some are destroyed, some lose their position, new ones are created
+            for (RkSize index = 0u; index < g_churn; ++index)
+            {
+                RkSize const victim = random() % alive_entities.size();
+
+                if (index % 5u == 0u)
+                    admin.RemoveComponent<PositionComponent>(alive_entities[victim]);
+                else
+                    admin.DestroyEntity(alive_entities[victim]);
+
+                alive_entities[victim] = alive_entities.back();
+                alive_entities.pop_back();
+            }
+
+            EntityRange const created_entities = admin.CreateEntities<PositionComponent>(g_churn, initialize);
+
+            for (RkSize index = 0u; index < created_entities.Size(); ++index)
+                alive_entities.push_back(created_entities[index]);
+
+            // Moving entities and updating the index incrementally, then rebuilding the other index from the same chunks
+            move_system.frame = static_cast<RkUint32>(frame);
+
+            auto start = std::chrono::steady_clock::now();
+
+            admin.UpdateSystems();
+
+            update_seconds += SecondsSince(start);
+
+            start = std::chrono::steady_clock::now();
+
+            RebuildIndex(*scheduler, index_system, rebuilt_index);
+
+            rebuild_seconds += SecondsSince(start);
+
+            for (SpatialIndex::Sphere& query : queries)
+                query = SpatialIndex::Sphere {Vector3f {{coordinate(random), coordinate(random), coordinate(random)}}, g_cell_size};
+
+            start = std::chrono::steady_clock::now();
+
+            index_system.GetIndex().QueryRadius(*scheduler, queries.data(), queries.size(), incremental_results);
+
+            query_seconds += SecondsSince(start);
+
+            rebuilt_index.QueryRadius(*scheduler, queries.data(), queries.size(), rebuilt_results);
+
+            same_results = same_results && incremental_results.offsets == rebuilt_results.offsets && index_system.GetIndex().GetSize() == rebuilt_index.GetSize();
+        }
+
+        // Only the static entities are destroyed or lose their position, the tracked ones are all still indexed
+        RkSize const expected_size = moving_entities.Size() + alive_entities.size();
+
+        std::cout << "    " << expected_size << " entities, " << g_entities / g_moving_ratio << " moving, " << g_churn << " destroyed or removed and created per frame"
+                  << " | incremental update (move + index) " << update_seconds  * 1e3 / g_frames << " ms/frame"
+                  << " | rebuild " << rebuild_seconds * 1e3 / g_frames << " ms/frame"
+                  << " | " << g_queries << " radius queries " << query_seconds * 1e3 / g_frames << " ms/frame" << std::endl;
+
+        RUKEN_BENCHMARK_CHECK(same_results);
+        RUKEN_BENCHMARK_CHECK(index_system.GetIndex().GetSize() == expected_size);
+    }
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+
+#include "Harness.hpp"
+
+#include "ECS/Component.hpp"
+#include "ECS/EntityAdmin.hpp"
+#include "ECS/ComponentItem.hpp"
+#include "ECS/ComponentSystem.hpp"
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_entities = 1000000u;
+
+    enum class EComponent
+    {
+        Position,
+        Velocity,
+        Life
+    };
+
+    struct PositionComponentItem : ComponentItem<RkFloat, RkFloat, RkFloat> { using ComponentItem::ComponentItem; };
+    struct LifeComponentItem     : ComponentItem<RkInt32>                    { using ComponentItem::ComponentItem; };
+
+    // Non zero default values, the bulk creation has to copy them instead of zeroing the columns
+    struct VelocityComponentItem : ComponentItem<RkDouble, RkInt16>
+    {
+        VelocityComponentItem() noexcept:
+            ComponentItem(4.5, static_cast<RkInt16>(7))
+        {}
+
+        using ComponentItem::ComponentItem;
+    };
+
+    RUKEN_DEFINE_COMPONENT(EComponent, Position);
+    RUKEN_DEFINE_COMPONENT(EComponent, Velocity);
+    RUKEN_DEFINE_COMPONENT(EComponent, Life);
+
+    /**
+     * \brief Counts the entities whose components don't hold the expected values,
+     *        the velocities must be default initialized and the life must match the first position field
+     */
+    class CheckSystem final : public ComponentSystem<PositionComponent const, VelocityComponent const, LifeComponent const>
+    {
+        public:
+
+            std::atomic<RkSize> checked {0u};
+            std::atomic<RkSize> invalid {0u};
+
+            RkVoid OnUpdate(Range& in_range) noexcept override
+            {
+                RkFloat  const* position_x = in_range.Get<PositionComponent>().GetStorage<0>();
+                RkDouble const* velocity_x = in_range.Get<VelocityComponent>().GetStorage<0>();
+                RkInt16  const* velocity_y = in_range.Get<VelocityComponent>().GetStorage<1>();
+                RkInt32  const* life       = in_range.Get<LifeComponent>    ().GetStorage<0>();
+
+                RkSize errors = 0u;
+
+                for (RkSize index = in_range.Begin(); index < in_range.End(); ++index)
+                {
+                    if (velocity_x[index] != 4.5 || velocity_y[index] != 7 || life[index] != static_cast<RkInt32>(position_x[index]))
+                        ++errors;
+                }
+
+                checked.fetch_add(in_range.Size(), std::memory_order_relaxed);
+                invalid.fetch_add(errors,          std::memory_order_relaxed);
+            }
+    };
+
+    /**
+     * \brief Prints the spawn rate of a creation method
+     * \param in_name Name of the method
+     * \param in_seconds Time taken to create g_entities entities
+     */
+    RkVoid PrintSpawnRate(RkChar const* in_name, RkDouble const in_seconds) noexcept
+    {
+        std::cout << "    " << in_name << " | " << in_seconds * 1e3 << " ms | " << in_seconds * 1e9 / g_entities << " ns/entity | "
+                  << g_entities / in_seconds / 1e6 << " M entities/s" << std::endl;
+    }
+
+    /**
+     * \brief Checks that a range of new entities is contiguous and alive
+     * \param in_admin Entity admin owning the entities
+     * \param in_entities Range of new entities
+     * \return True if the range is valid
+     */
+    RkBool CheckRange(EntityAdmin const& in_admin, EntityRange const& in_entities) noexcept
+    {
+        if (in_entities.Size() != g_entities || in_entities[g_entities - 1u].GetIndex() - in_entities[0u].GetIndex() != g_entities - 1u)
+            return false;
+
+        for (RkSize index = 0u; index < in_entities.Size(); ++index)
+        {
+            if (!in_admin.IsAlive(in_entities[index]))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(ECSSpawnRate)
+{
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), ESchedulerMode::WorkStealing);
+
+    // Every admin creates a first entity, so that the archetype and its first chunk exist before the measurement
+    {
+        EntityAdmin admin(*scheduler);
+
+        admin.CreateEntity<PositionComponent, VelocityComponent, LifeComponent>();
+
+        auto const start = std::chrono::steady_clock::now();
+
+        for (RkSize index = 0u; index < g_entities; ++index)
+            admin.CreateEntity<PositionComponent, VelocityComponent, LifeComponent>();
+
+        PrintSpawnRate("one by one           ", SecondsSince(start));
+
+        RUKEN_BENCHMARK_CHECK(admin.EntitiesCount() == g_entities + 1u);
+    }
+
+    {
+        EntityAdmin admin(*scheduler);
+
+        admin.CreateEntity<PositionComponent, VelocityComponent, LifeComponent>();
+
+        auto const start = std::chrono::steady_clock::now();
+
+        EntityRange const entities = admin.CreateEntities<PositionComponent, VelocityComponent, LifeComponent>(g_entities);
+
+        PrintSpawnRate("bulk                 ", SecondsSince(start));
+
+        // Default values everywhere: the life matches the zeroed position
+        CheckSystem& system = admin.CreateSystem<CheckSystem>();
+
+        admin.UpdateSystems();
+
+        RUKEN_BENCHMARK_CHECK(CheckRange(admin, entities));
+        RUKEN_BENCHMARK_CHECK(system.checked.load() == g_entities + 1u);
+        RUKEN_BENCHMARK_CHECK(system.invalid.load() == 0u);
+    }
+
+    {
+        EntityAdmin admin(*scheduler);
+
+        admin.CreateEntity<PositionComponent, VelocityComponent, LifeComponent>();
+
+        RkSize next = 0u;
+
+        auto const start = std::chrono::steady_clock::now();
+
+        EntityRange const entities = admin.CreateEntities<PositionComponent, VelocityComponent, LifeComponent>(g_entities, [&next](auto& in_range) {
+            RkFloat* position_x = in_range.template Get<PositionComponent>().template GetStorage<0>();
+            RkInt32* life       = in_range.template Get<LifeComponent>    ().template GetStorage<0>();
+
+            for (RkSize index = in_range.Begin(); index < in_range.End(); ++index, ++next)
+            {
+                position_x[index] = static_cast<RkFloat>(next);
+                life      [index] = static_cast<RkInt32>(next);
+            }
+        });
+
+        PrintSpawnRate("bulk with initializer", SecondsSince(start));
+
+        CheckSystem& system = admin.CreateSystem<CheckSystem>();
+
+        admin.UpdateSystems();
+
+        // The initializer is called in creation order
+        RUKEN_BENCHMARK_CHECK(next == g_entities);
+        RUKEN_BENCHMARK_CHECK(CheckRange(admin, entities));
+        RUKEN_BENCHMARK_CHECK(system.checked.load() == g_entities + 1u);
+        RUKEN_BENCHMARK_CHECK(system.invalid.load() == 0u);
+
+        // Bulk creations still return contiguous IDs once destroyed entities left holes in the entity table
+        for (RkSize index = 0u; index < g_entities; index += 3u)
+            admin.DestroyEntity(entities[index]);
+
+        EntityRange const more_entities = admin.CreateEntities<PositionComponent, VelocityComponent, LifeComponent>(1000u);
+
+        RUKEN_BENCHMARK_CHECK(more_entities.Size() == 1000u && more_entities[999u].GetIndex() - more_entities[0u].GetIndex() == 999u);
+        RUKEN_BENCHMARK_CHECK(admin.IsAlive(more_entities[0u]) && admin.IsAlive(more_entities[999u]));
+        RUKEN_BENCHMARK_CHECK(admin.EntitiesCount() == 1u + g_entities - (g_entities + 2u) / 3u + 1000u);
+    }
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <new>
+#include <ctime>
+#include <atomic>
+#include <cstdlib>
+
+#include "Harness.hpp"
+
+#include "Build/OperatingSystem.hpp"
+
+#if defined(RUKEN_OS_WINDOWS)
+    #include "Utility/WindowsOS.hpp"
+#endif
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    std::atomic<RkUint64> g_allocations {0u};
+}
+
+// Counting every allocation of the executable, the array versions forward to these ones
+RkVoid* operator new(std::size_t const in_size, std::nothrow_t const&) noexcept
+{
+    g_allocations.fetch_add(1u, std::memory_order_relaxed);
+
+    return std::malloc(in_size ? in_size : 1u);
+}
+
+RkVoid* operator new(std::size_t const in_size)
+{
+    if (RkVoid* memory = operator new(in_size, std::nothrow))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+RkVoid operator delete(RkVoid* in_memory) noexcept
+{
+    std::free(in_memory);
+}
+
+RkVoid operator delete(RkVoid* in_memory, std::size_t) noexcept
+{
+    std::free(in_memory);
+}
+
+RkUint64 RUKEN_NAMESPACE::AllocationsCount() noexcept
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+RkBool BenchmarkRegistry::Register(RkChar const* in_name, RkBool (*in_function)()) noexcept
+{
+    GetCases().push_back({in_name, in_function});
+
+    return true;
+}
+
+std::vector<BenchmarkCase>& BenchmarkRegistry::GetCases() noexcept
+{
+    static std::vector<BenchmarkCase> cases;
+
+    return cases;
+}
+
+RkVoid BenchmarkRegistry::ReportFailure(RkChar const* in_condition, RkChar const* in_file, RkUint32 const in_line) noexcept
+{
+    std::cout << "    Check failed: " << in_condition << " (" << in_file << ":" << in_line << ")" << std::endl;
+}
+
+RkDouble RUKEN_NAMESPACE::ProcessCpuSeconds() noexcept
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+
+    if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+        return 0.0;
+
+    // File times are expressed in 100 nanoseconds intervals
+    RkUint64 const kernel = (static_cast<RkUint64>(kernel_time.dwHighDateTime) << 32u) | kernel_time.dwLowDateTime;
+    RkUint64 const user   = (static_cast<RkUint64>(user_time  .dwHighDateTime) << 32u) | user_time  .dwLowDateTime;
+
+    return static_cast<RkDouble>(kernel + user) * 1e-7;
+
+    #else
+
+    // std::clock measures the processor time of the whole process everywhere but on Windows
+    return static_cast<RkDouble>(std::clock()) / CLOCKS_PER_SEC;
+
+    #endif
+}
\ No newline at end of file
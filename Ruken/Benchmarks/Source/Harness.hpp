@@ -0,0 +1,123 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief A benchmark, or a stress test, of the benchmarks executable.
+ *        Cases print their measurements on the standard output and return false if one of their checks failed
+ */
+struct BenchmarkCase
+{
+    RkChar const* name;
+    RkBool      (*function)();
+};
+
+/**
+ * \brief Gathers the benchmark cases of every translation unit of the benchmarks executable, see RUKEN_BENCHMARK_CASE
+ */
+class BenchmarkRegistry
+{
+    public:
+
+        #pragma region Methods
+
+        /**
+         * \brief Registers a case, this is called during the static initialization of the executable
+         * \param in_name Name of the case, used to filter the cases from the command line
+         * \param in_function Function running the case
+         * \return True
+         */
+        static RkBool Register(RkChar const* in_name, RkBool (*in_function)()) noexcept;
+
+        /**
+         * \brief Returns every registered case
+         * \return Cases
+         */
+        [[nodiscard]]
+        static std::vector<BenchmarkCase>& GetCases() noexcept;
+
+        /**
+         * \brief Reports a failed check of the running case
+         * \param in_condition Failed condition
+         * \param in_file File of the check
+         * \param in_line Line of the check
+         */
+        static RkVoid ReportFailure(RkChar const* in_condition, RkChar const* in_file, RkUint32 in_line) noexcept;
+
+        #pragma endregion
+};
+
+/**
+ * \brief Returns the number of allocations made through the global operator new since the start of the executable
+ * \return Allocations count
+ */
+[[nodiscard]]
+RkUint64 AllocationsCount() noexcept;
+
+/**
+ * \brief Returns the processor time consumed by every thread of the executable
+ * \return Processor time in seconds
+ */
+[[nodiscard]]
+RkDouble ProcessCpuSeconds() noexcept;
+
+/**
+ * \brief Returns the time elapsed since a point in time
+ * \param in_start Start of the measurement
+ * \return Elapsed time in seconds
+ */
+[[nodiscard]]
+inline RkDouble SecondsSince(std::chrono::steady_clock::time_point const in_start) noexcept
+{
+    return std::chrono::duration<RkDouble>(std::chrono::steady_clock::now() - in_start).count();
+}
+
+/**
+ * \brief Defines and registers a benchmark case, the body of the case follows the macro
+ * \param in_name Name of the case
+ */
+#define RUKEN_BENCHMARK_CASE(in_name) \
+    static RkBool in_name(); \
+    static RkBool const in_name##_registered = BenchmarkRegistry::Register(#in_name, &in_name); \
+    static RkBool in_name()
+
+/**
+ * \brief Checks a condition inside of a benchmark case, the case fails and returns right away if the condition is false
+ * \param in_condition Condition to check
+ */
+#define RUKEN_BENCHMARK_CHECK(in_condition) \
+    do { if (!(in_condition)) { BenchmarkRegistry::ReportFailure(#in_condition, __FILE__, __LINE__); return false; } } while (false)
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <string>
+#include <algorithm>
+
+#include "Harness.hpp"
+
+USING_RUKEN_NAMESPACE
+
+/**
+ * Usage: RukenBenchmarks [filter...]
+ * Runs every case whose name contains one of the filters, or every case if no filter is given.
+ * Returns the number of failed cases.
+ */
+int main(int const argc, char** argv)
+{
+    std::vector<BenchmarkCase> cases = BenchmarkRegistry::GetCases();
+
+    std::sort(cases.begin(), cases.end(), [](BenchmarkCase const& in_lhs, BenchmarkCase const& in_rhs) {
+        return std::string(in_lhs.name) < std::string(in_rhs.name);
+    });
+
+    int failures = 0;
+
+    for (BenchmarkCase const& benchmark_case : cases)
+    {
+        RkBool selected = argc <= 1;
+
+        for (int index = 1; index < argc && !selected; ++index)
+            selected = std::string(benchmark_case.name).find(argv[index]) != std::string::npos;
+
+        if (!selected)
+            continue;
+
+        std::cout << "[" << benchmark_case.name << "]" << std::endl;
+
+        if (!benchmark_case.function())
+        {
+            std::cout << "[" << benchmark_case.name << "] FAILED" << std::endl;
+
+            ++failures;
+        }
+    }
+
+    return failures;
+}
\ No newline at end of file
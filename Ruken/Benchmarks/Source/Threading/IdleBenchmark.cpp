@@ -0,0 +1,154 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "Harness.hpp"
+
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkUint16 g_workers  = 3u;
+    constexpr RkSize   g_samples  = 200u;
+
+    /**
+     * \brief Returns a percentile of sorted samples
+     * \param in_samples Sorted samples
+     * \param in_percentile Percentile, between 0 and 100
+     * \return Sample
+     */
+    RkDouble Percentile(std::vector<RkDouble> const& in_samples, RkSize const in_percentile) noexcept
+    {
+        return in_samples[std::min(in_samples.size() * in_percentile / 100u, in_samples.size() - 1u)];
+    }
+
+    /**
+     * \brief Measures the cost of idle workers, how fast they wake up and how accurate WaitForQueuedTasks is
+     * \param in_mode Job distribution mode of the scheduler
+     * \return True if WaitForQueuedTasks always waited for every job
+     */
+    RkBool RunIdleMeasurements(ESchedulerMode const in_mode) noexcept
+    {
+        ServiceProvider service_provider;
+
+        service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+        Scheduler* scheduler = service_provider.ProvideService<Scheduler>(g_workers, in_mode);
+
+        // Processor time used by the parked workers, the main thread sleeps in the meantime
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        RkDouble const cpu_start  = ProcessCpuSeconds();
+        auto     const wall_start = std::chrono::steady_clock::now();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        RkDouble const idle_cpu = (ProcessCpuSeconds() - cpu_start) / SecondsSince(wall_start);
+
+        // Time between the submission of a job to parked workers and the start of the job
+        std::vector<RkDouble> wake_up_latencies;
+
+        for (RkSize sample = 0u; sample < g_samples; ++sample)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+            std::atomic<RkBool> started {false};
+            auto                job_start = std::chrono::steady_clock::now();
+            auto const          submitted = std::chrono::steady_clock::now();
+
+            scheduler->ScheduleTask([&started, &job_start] {
+                job_start = std::chrono::steady_clock::now();
+
+                started.store(true, std::memory_order_release);
+            });
+
+            // Spinning instead of waiting, the main thread would otherwise execute the job itself
+            while (!started.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            wake_up_latencies.push_back(std::chrono::duration<RkDouble, std::micro>(job_start - submitted).count());
+        }
+
+        std::sort(wake_up_latencies.begin(), wake_up_latencies.end());
+
+        // Time between the completion of the last job and the return of WaitForQueuedTasks,
+        // the last job is either already running or waiting for a dependency when the wait starts
+        std::vector<RkDouble> barrier_delays;
+        RkBool                barrier_accurate = true;
+
+        for (RkSize sample = 0u; sample < g_samples / 4u; ++sample)
+        {
+            std::atomic<RkBool> done {false};
+            auto                job_end = std::chrono::steady_clock::now();
+
+            JobHandle const dependency = scheduler->ScheduleTask([] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            });
+
+            scheduler->ScheduleTask([&done, &job_end] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                job_end = std::chrono::steady_clock::now();
+
+                done.store(true, std::memory_order_release);
+            }, {dependency});
+
+            scheduler->WaitForQueuedTasks();
+
+            auto const barrier_end = std::chrono::steady_clock::now();
+
+            barrier_accurate = barrier_accurate && done.load(std::memory_order_acquire);
+
+            barrier_delays.push_back(std::chrono::duration<RkDouble, std::micro>(barrier_end - job_end).count());
+        }
+
+        std::sort(barrier_delays.begin(), barrier_delays.end());
+
+        std::cout << "    " << (in_mode == ESchedulerMode::WorkStealing ? "WorkStealing" : "SharedQueue ")
+                  << " workers " << g_workers
+                  << " | idle CPU " << idle_cpu * 100.0 << "% of a core"
+                  << " | wake-up us p50 " << Percentile(wake_up_latencies, 50u) << " p90 " << Percentile(wake_up_latencies, 90u) << " p99 " << Percentile(wake_up_latencies, 99u)
+                  << " | barrier delay us p50 " << Percentile(barrier_delays, 50u) << " p99 " << Percentile(barrier_delays, 99u) << std::endl;
+
+        service_provider.DestroyService<Scheduler>();
+        service_provider.DestroyService<Logger>();
+
+        return barrier_accurate;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(SchedulerIdleAndWakeUp)
+{
+    RUKEN_BENCHMARK_CHECK(RunIdleMeasurements(ESchedulerMode::SharedQueue));
+    RUKEN_BENCHMARK_CHECK(RunIdleMeasurements(ESchedulerMode::WorkStealing));
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <thread>
+#include <functional>
+
+#include "Harness.hpp"
+
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_jobs = 200000u;
+
+    // Typical capture of a job: a few pointers and indices, too big for the small buffer of std::function
+    struct Capture
+    {
+        std::atomic<RkUint64>* counter;
+        RkUint64               values[5];
+    };
+
+    /**
+     * \brief Creates, moves, invokes then destroys jobs of a given type, the way the scheduler handles them
+     * \tparam TJob Type of the job, JobFunction or std::function
+     * \param out_allocations Allocations made per job
+     * \return Nanoseconds per job
+     */
+    template <typename TJob>
+    RkDouble MeasureJobType(RkDouble& out_allocations) noexcept
+    {
+        std::atomic<RkUint64> counter {0u};
+        Capture               capture {&counter, {1u, 2u, 3u, 4u, 5u}};
+
+        RkUint64 const allocations = AllocationsCount();
+        auto     const start       = std::chrono::steady_clock::now();
+
+        for (RkSize index = 0u; index < g_jobs; ++index)
+        {
+            capture.values[0] = index;
+
+            TJob job {[capture] { capture.counter->fetch_add(capture.values[0], std::memory_order_relaxed); }};
+            TJob moved_job {std::move(job)};
+
+            moved_job();
+        }
+
+        RkDouble const seconds = SecondsSince(start);
+
+        out_allocations = static_cast<RkDouble>(AllocationsCount() - allocations) / g_jobs;
+
+        return seconds * 1e9 / g_jobs;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(JobFunctionAllocations)
+{
+    static_assert(sizeof(Capture) <= JobFunction::capacity, "The capture has to fit into a job");
+
+    RkDouble job_function_allocations = 0.0;
+    RkDouble std_function_allocations = 0.0;
+
+    RkDouble const job_function_time = MeasureJobType<JobFunction>          (job_function_allocations);
+    RkDouble const std_function_time = MeasureJobType<std::function<RkVoid()>>(std_function_allocations);
+
+    std::cout << "    JobFunction   " << sizeof(Capture) << "B capture | " << job_function_allocations << " allocations/job | " << job_function_time << " ns/job" << std::endl;
+    std::cout << "    std::function " << sizeof(Capture) << "B capture | " << std_function_allocations << " allocations/job | " << std_function_time << " ns/job" << std::endl;
+
+    RUKEN_BENCHMARK_CHECK(job_function_allocations == 0.0);
+
+    // Going through the scheduler, once its job node pool has grown the submission path should not allocate either
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), ESchedulerMode::WorkStealing);
+
+    std::atomic<RkUint64> counter {0u};
+    Capture               capture {&counter, {1u, 2u, 3u, 4u, 5u}};
+
+    for (RkSize index = 0u; index < g_jobs; ++index)
+        scheduler->ScheduleTask([capture] { capture.counter->fetch_add(1u, std::memory_order_relaxed); });
+
+    scheduler->WaitForQueuedTasks();
+
+    counter.store(0u);
+
+    RkUint64 const allocations = AllocationsCount();
+    auto     const start       = std::chrono::steady_clock::now();
+
+    for (RkSize index = 0u; index < g_jobs; ++index)
+        scheduler->ScheduleTask([capture] { capture.counter->fetch_add(1u, std::memory_order_relaxed); });
+
+    scheduler->WaitForQueuedTasks();
+
+    RkDouble const seconds                = SecondsSince(start);
+    RkDouble const scheduled_allocations  = static_cast<RkDouble>(AllocationsCount() - allocations) / g_jobs;
+
+    std::cout << "    ScheduleTask  " << sizeof(Capture) << "B capture | " << scheduled_allocations << " allocations/job | " << seconds * 1e9 / g_jobs << " ns/job" << std::endl;
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    RUKEN_BENCHMARK_CHECK(counter.load() == g_jobs);
+    RUKEN_BENCHMARK_CHECK(scheduled_allocations < 0.01);
+
+    return true;
+}
\ No newline at end of file
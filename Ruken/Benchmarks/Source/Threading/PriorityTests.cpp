@@ -0,0 +1,236 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "Harness.hpp"
+
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_iterations = 200u;
+
+    /**
+     * \brief Occupies the only worker of a scheduler until released, so that the following jobs queue up
+     */
+    class WorkerBlocker
+    {
+        private:
+
+            std::atomic<RkBool> m_started  {false};
+            std::atomic<RkBool> m_released {false};
+
+        public:
+
+            explicit WorkerBlocker(Scheduler& in_scheduler) noexcept
+            {
+                in_scheduler.ScheduleTask([this] {
+                    m_started.store(true, std::memory_order_release);
+
+                    while (!m_released.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                });
+
+                while (!m_started.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+            }
+
+            RkVoid Release() noexcept
+            {
+                m_released.store(true, std::memory_order_release);
+            }
+    };
+
+    /**
+     * \brief Waits for jobs without helping, so that the worker alone decides of the execution order
+     * \param in_handles Jobs to wait for
+     */
+    RkVoid SpinUntilDone(std::vector<JobHandle> const& in_handles) noexcept
+    {
+        for (JobHandle const& handle : in_handles)
+        {
+            while (!handle.Done())
+                std::this_thread::yield();
+        }
+    }
+
+    /**
+     * \brief Runs a test on a single worker scheduler, for both job distribution modes
+     * \param in_test Test to run
+     * \return True if the test passed for both modes
+     */
+    template <typename TTest>
+    RkBool RunOnSingleWorker(TTest&& in_test) noexcept
+    {
+        for (ESchedulerMode const mode : {ESchedulerMode::SharedQueue, ESchedulerMode::WorkStealing})
+        {
+            ServiceProvider service_provider;
+
+            service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+            Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), mode);
+
+            RkBool const passed = in_test(*scheduler);
+
+            service_provider.DestroyService<Scheduler>();
+            service_provider.DestroyService<Logger>();
+
+            if (!passed)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(SchedulerPriorityOrder)
+{
+    // Critical jobs run before normal ones, which run before background ones, whatever their submission order
+    RUKEN_BENCHMARK_CHECK(RunOnSingleWorker([](Scheduler& in_scheduler) {
+        for (RkSize iteration = 0u; iteration < g_iterations; ++iteration)
+        {
+            std::atomic<RkSize>    order           {0u};
+            std::vector<RkSize>    background_order(10u);
+            RkSize                 normal_order    {0u};
+            RkSize                 critical_order  {0u};
+            std::vector<JobHandle> handles;
+
+            WorkerBlocker blocker(in_scheduler);
+
+            for (RkSize& background : background_order)
+                handles.push_back(in_scheduler.ScheduleTask([&order, &background] { background = order++; }, EJobPriority::Background));
+
+            handles.push_back(in_scheduler.ScheduleTask([&order, &normal_order]   { normal_order   = order++; }, EJobPriority::Normal));
+            handles.push_back(in_scheduler.ScheduleTask([&order, &critical_order] { critical_order = order++; }, EJobPriority::Critical));
+
+            blocker.Release();
+
+            SpinUntilDone(handles);
+
+            if (critical_order != 0u || normal_order != 1u)
+                return false;
+        }
+
+        return true;
+    }));
+
+    return true;
+}
+
+RUKEN_BENCHMARK_CASE(SchedulerPriorityInheritance)
+{
+    // A background job required by a critical job must not wait behind normal jobs, or the critical job would too
+    RUKEN_BENCHMARK_CHECK(RunOnSingleWorker([](Scheduler& in_scheduler) {
+        for (RkSize iteration = 0u; iteration < g_iterations; ++iteration)
+        {
+            std::atomic<RkSize>    order            {0u};
+            RkSize                 background_order {~RkSize(0u)};
+            std::vector<JobHandle> handles;
+
+            WorkerBlocker blocker(in_scheduler);
+
+            // The gate delays the submission of the background job, so that its priority is raised before it is queued
+            JobHandle const gate = in_scheduler.ScheduleTask([] {}, EJobPriority::Critical);
+
+            for (RkSize index = 0u; index < 10u; ++index)
+                handles.push_back(in_scheduler.ScheduleTask([&order] { ++order; }, EJobPriority::Normal));
+
+            JobHandle const background = in_scheduler.ScheduleTask([&order, &background_order] { background_order = order++; }, {gate}, EJobPriority::Background);
+
+            handles.push_back(in_scheduler.ScheduleTask([] {}, {background}, EJobPriority::Critical));
+
+            blocker.Release();
+
+            SpinUntilDone(handles);
+
+            if (background_order != 0u)
+                return false;
+        }
+
+        return true;
+    }));
+
+    return true;
+}
+
+RUKEN_BENCHMARK_CASE(SchedulerIOLane)
+{
+    RUKEN_BENCHMARK_CHECK(RunOnSingleWorker([](Scheduler& in_scheduler) {
+        RUKEN_BENCHMARK_CHECK(!in_scheduler.GetIOWorkers().empty());
+
+        // I/O jobs run on the I/O workers, never on the compute workers
+        std::atomic<RkBool> io_on_compute_worker {false};
+        std::atomic<RkBool> io_done              {false};
+
+        JobHandle const io_job = in_scheduler.ScheduleIOTask([&in_scheduler, &io_on_compute_worker, &io_done] {
+            io_on_compute_worker.store(in_scheduler.GetCurrentWorkerIndex() != in_scheduler.GetWorkers().size());
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            io_done.store(true, std::memory_order_release);
+        });
+
+        // A blocking I/O job doesn't stall the compute work submitted after it
+        std::atomic<RkSize> compute_jobs {0u};
+
+        for (RkSize index = 0u; index < 1000u; ++index)
+            in_scheduler.ScheduleTask([&compute_jobs] { compute_jobs.fetch_add(1u, std::memory_order_relaxed); });
+
+        while (compute_jobs.load() < 1000u && !io_done.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        RkBool const compute_stalled = io_done.load(std::memory_order_acquire);
+
+        // Dependencies work across the lanes, in both directions
+        std::atomic<RkSize> step {0u};
+
+        JobHandle const continuation = io_job.Then([&step, &io_done] {
+            if (io_done.load(std::memory_order_acquire))
+                step.store(1u);
+        });
+
+        JobHandle const dependent_io_job = in_scheduler.ScheduleIOTask([&step] {
+            if (step.load() == 1u)
+                step.store(2u);
+        }, {continuation});
+
+        dependent_io_job.Wait();
+
+        in_scheduler.WaitForQueuedTasks();
+
+        RUKEN_BENCHMARK_CHECK(!compute_stalled);
+        RUKEN_BENCHMARK_CHECK(!io_on_compute_worker.load());
+        RUKEN_BENCHMARK_CHECK(step.load() == 2u);
+
+        return true;
+    }));
+
+    return true;
+}
\ No newline at end of file
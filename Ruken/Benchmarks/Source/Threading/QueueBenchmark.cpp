@@ -0,0 +1,193 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "Harness.hpp"
+
+#include "Threading/ThreadSafeQueue.hpp"
+#include "Threading/ThreadSafeLockQueue.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkUint64 g_items = 400000u;
+
+    using LockingQueue   = ThreadSafeLockQueue<RkUint64>;
+    using UnboundedQueue = ThreadSafeQueue<RkUint64>;
+    using RingQueue      = ThreadSafeQueue<RkUint64, BoundedQueue<RkUint64>>;
+
+    RkBool TryDequeue(LockingQueue&   in_queue, RkUint64& out_item) noexcept { return in_queue.TryDequeue(out_item); }
+    RkBool TryDequeue(UnboundedQueue& in_queue, RkUint64& out_item) noexcept { return in_queue.Dequeue   (out_item); }
+    RkBool TryDequeue(RingQueue&      in_queue, RkUint64& out_item) noexcept { return in_queue.Dequeue   (out_item); }
+
+    /**
+     * \brief Pushes items through a queue from several producers to several consumers
+     * \param inout_queue Queue to test
+     * \param in_producers Number of producer threads
+     * \param in_consumers Number of consumer threads
+     * \param out_valid True if every item has been dequeued exactly once
+     * \return Nanoseconds per item
+     */
+    template <typename TQueue>
+    RkDouble MeasureContention(TQueue& inout_queue, RkUint64 const in_producers, RkUint64 const in_consumers, RkBool& out_valid) noexcept
+    {
+        RkUint64 const items_per_producer = g_items / in_producers;
+        RkUint64 const total_items        = items_per_producer * in_producers;
+
+        std::atomic<RkBool>   start    {false};
+        std::atomic<RkUint64> dequeued {0u};
+        std::atomic<RkUint64> sum      {0u};
+
+        std::vector<std::thread> threads;
+
+        for (RkUint64 producer = 0u; producer < in_producers; ++producer)
+        {
+            threads.emplace_back([&inout_queue, &start, producer, items_per_producer] {
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                // Every item is unique, the consumers sum them up to detect lost or duplicated items
+                for (RkUint64 index = 0u; index < items_per_producer; ++index)
+                    inout_queue.Enqueue(producer * items_per_producer + index + 1u);
+            });
+        }
+
+        for (RkUint64 consumer = 0u; consumer < in_consumers; ++consumer)
+        {
+            threads.emplace_back([&inout_queue, &start, &dequeued, &sum, total_items] {
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                RkUint64 item        = 0u;
+                RkUint64 partial_sum = 0u;
+
+                while (dequeued.load(std::memory_order_relaxed) < total_items)
+                {
+                    if (TryDequeue(inout_queue, item))
+                    {
+                        partial_sum += item;
+
+                        dequeued.fetch_add(1u, std::memory_order_relaxed);
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+
+                sum.fetch_add(partial_sum);
+            });
+        }
+
+        auto const start_time = std::chrono::steady_clock::now();
+
+        start.store(true, std::memory_order_release);
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        RkDouble const seconds = SecondsSince(start_time);
+
+        out_valid = dequeued.load() == total_items && sum.load() == total_items * (total_items + 1u) / 2u;
+
+        return seconds * 1e9 / total_items;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(QueueContention)
+{
+    RkUint64 const max_threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::vector<std::pair<RkUint64, RkUint64>> configurations;
+
+    for (RkUint64 threads = 1u; threads <= max_threads; threads *= 2u)
+    {
+        configurations.emplace_back(threads, threads);
+
+        if (threads > 1u)
+        {
+            configurations.emplace_back(1u, threads);
+            configurations.emplace_back(threads, 1u);
+        }
+    }
+
+    for (auto const& [producers, consumers] : configurations)
+    {
+        RkBool lock_valid      = false;
+        RkBool segmented_valid = false;
+        RkBool bounded_valid   = false;
+
+        LockingQueue   lock_queue;
+        UnboundedQueue segmented_queue;
+        RingQueue      bounded_queue(1024u);
+
+        RkDouble const lock_time      = MeasureContention(lock_queue,      producers, consumers, lock_valid);
+        RkDouble const segmented_time = MeasureContention(segmented_queue, producers, consumers, segmented_valid);
+        RkDouble const bounded_time   = MeasureContention(bounded_queue,   producers, consumers, bounded_valid);
+
+        std::cout << "    producers " << producers << " consumers " << consumers
+                  << " | ThreadSafeLockQueue " << lock_time
+                  << " | SegmentedQueue "      << segmented_time
+                  << " | BoundedQueue "        << bounded_time << " ns/item" << std::endl;
+
+        RUKEN_BENCHMARK_CHECK(lock_valid);
+        RUKEN_BENCHMARK_CHECK(segmented_valid);
+        RUKEN_BENCHMARK_CHECK(bounded_valid);
+    }
+
+    return true;
+}
+
+RUKEN_BENCHMARK_CASE(QueueBoundedCapacity)
+{
+    // Capacities are rounded up to a power of 2, the ring buffer masks the positions to index its slots
+    std::pair<RkSize, RkSize> const capacities[] = {{0u, 2u}, {1u, 2u}, {2u, 2u}, {3u, 4u}, {1000u, 1024u}, {1024u, 1024u}};
+
+    for (auto const& [requested_capacity, expected_capacity] : capacities)
+    {
+        BoundedQueue<RkUint64> queue(requested_capacity);
+
+        RUKEN_BENCHMARK_CHECK(queue.Capacity() == expected_capacity);
+
+        // Filling the queue twice, so that the positions wrap around the ring buffer
+        for (RkUint64 round = 0u; round < 2u; ++round)
+        {
+            for (RkUint64 index = 0u; index < queue.Capacity(); ++index)
+                RUKEN_BENCHMARK_CHECK(queue.TryEnqueue(RkUint64(index)));
+
+            RUKEN_BENCHMARK_CHECK(!queue.TryEnqueue(RkUint64(0u)));
+
+            RkUint64 item = 0u;
+
+            for (RkUint64 index = 0u; index < queue.Capacity(); ++index)
+                RUKEN_BENCHMARK_CHECK(queue.TryDequeue(item) && item == index);
+
+            RUKEN_BENCHMARK_CHECK(queue.Empty());
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "Harness.hpp"
+
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_iterations = 200u;
+}
+
+RUKEN_BENCHMARK_CASE(SchedulerParallelForSuspends)
+{
+    // A job waiting on a ParallelFor has to keep resuming the fibers suspended on its worker,
+    // one of them might be required by a sub-range running on another thread.
+    // The only worker suspends the first job, then starts the ParallelFor while the main thread helps, picking up the second sub-range
+    for (ESchedulerMode const mode : {ESchedulerMode::SharedQueue, ESchedulerMode::WorkStealing})
+    {
+        ServiceProvider service_provider;
+
+        service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+        Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), mode);
+
+        std::atomic<RkSize> deadlocks {0u};
+
+        for (RkSize iteration = 0u; iteration < g_iterations; ++iteration)
+        {
+            std::atomic<RkBool> released {false};
+            std::atomic<RkBool> resumed  {false};
+            std::atomic<RkBool> started  {false};
+
+            // Waits are bounded so that a deadlock gets reported instead of hanging forever
+            auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+            JobHandle const suspended_job = scheduler->ScheduleTask([scheduler, &released, &resumed] {
+                scheduler->WaitUntil([&released] { return released.load(); });
+
+                resumed.store(true);
+            });
+
+            JobHandle const parallel_job = scheduler->ScheduleTask([scheduler, &resumed, &started, &deadlocks, deadline] {
+                started.store(true);
+
+                scheduler->ParallelFor(0u, 2u, 1u, [scheduler, &resumed, &deadlocks, deadline](RkSize const in_index) {
+                    // Leaving some time to the main thread to pick up the second sub-range
+                    if (in_index == 0u)
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds(500));
+                        return;
+                    }
+
+                    scheduler->WaitUntil([&resumed, deadline] { return resumed.load() || std::chrono::steady_clock::now() > deadline; });
+
+                    if (!resumed.load())
+                        deadlocks.fetch_add(1u);
+                });
+            });
+
+            while (!started.load())
+                std::this_thread::yield();
+
+            released.store(true);
+
+            parallel_job .Wait();
+            suspended_job.Wait();
+
+            if (deadlocks.load() != 0u)
+                break;
+        }
+
+        service_provider.DestroyService<Scheduler>();
+        service_provider.DestroyService<Logger>();
+
+        RUKEN_BENCHMARK_CHECK(deadlocks.load() == 0u);
+    }
+
+    return true;
+}
+RUKEN_BENCHMARK_CASE(SchedulerJobDataFollowsSuspension)
+{
+    // The only worker suspends the first job, then runs the second one: each job must only ever see its own data
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(1u), ESchedulerMode::WorkStealing);
+
+    RkSize mismatches = 0u;
+
+    for (RkSize iteration = 0u; iteration < g_iterations; ++iteration)
+    {
+        RkSize const first_data  = 1u;
+        RkSize const second_data = 2u;
+
+        std::atomic<RkBool> started  {false};
+        std::atomic<RkBool> released {false};
+        std::atomic<RkBool> done     {false};
+
+        RkVoid const* resumed_data  = nullptr;
+        RkVoid const* started_data  = &second_data;
+        RkVoid const* restored_data = &second_data;
+
+        JobHandle const suspended_job = scheduler->ScheduleTask([scheduler, &first_data, &started, &released, &done, &resumed_data, &restored_data] {
+            RkVoid const* previous_data = Scheduler::SetJobData(&first_data);
+
+            started.store(true);
+
+            scheduler->WaitUntil([&released] { return released.load(); });
+
+            resumed_data  = Scheduler::GetJobData();
+            restored_data = Scheduler::SetJobData(previous_data);
+
+            done.store(true);
+        });
+
+        // Not helping in the meantime, the second job has to run on the worker while the first one is suspended
+        while (!started.load())
+            std::this_thread::yield();
+
+        JobHandle const second_job = scheduler->ScheduleTask([&second_data, &released, &started_data] {
+            started_data = Scheduler::GetJobData();
+
+            RkVoid const* previous_data = Scheduler::SetJobData(&second_data);
+
+            released.store(true);
+
+            Scheduler::SetJobData(previous_data);
+        });
+
+        while (!done.load())
+            std::this_thread::yield();
+
+        second_job   .Wait();
+        suspended_job.Wait();
+
+        if (resumed_data != &first_data || started_data != nullptr || restored_data != &first_data)
+            ++mismatches;
+    }
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    RUKEN_BENCHMARK_CHECK(mismatches == 0u);
+
+    return true;
+}
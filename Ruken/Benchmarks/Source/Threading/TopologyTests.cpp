@@ -0,0 +1,81 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <vector>
+
+#include "Harness.hpp"
+
+#include "Build/OperatingSystem.hpp"
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Threading/CpuTopology.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+#if defined(RUKEN_OS_LINUX)
+    #include <sched.h>
+#endif
+
+USING_RUKEN_NAMESPACE
+
+RUKEN_BENCHMARK_CASE(CpuTopologyProcessAffinity)
+{
+    // Restricted to the last processor, like a process started with taskset: the topology and the pinned workers must stay within it.
+    // On Linux, the affinity of the calling thread is the one inherited by the threads it creates, and the one reported as the process affinity
+    #if defined(RUKEN_OS_LINUX)
+
+    cpu_set_t previous_affinity;
+
+    RUKEN_BENCHMARK_CHECK(sched_getaffinity(0, sizeof(cpu_set_t), &previous_affinity) == 0);
+
+    RkUint32 const processor = CpuTopology().GetPhysicalCores().back().processors.back();
+
+    RUKEN_BENCHMARK_CHECK(Worker::SetCurrentThreadAffinity({processor}));
+
+    CpuTopology const topology;
+
+    ServiceProvider service_provider;
+
+    service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+    Scheduler* scheduler = service_provider.ProvideService<Scheduler>(static_cast<RkUint16>(0u), ESchedulerMode::WorkStealing, EWorkerPlacement::PhysicalCores);
+
+    std::vector<RkUint32> const worker_affinity = scheduler->GetWorkers().front().GetAffinity();
+    RkSize                const workers_count   = scheduler->GetWorkers().size();
+
+    service_provider.DestroyService<Scheduler>();
+    service_provider.DestroyService<Logger>();
+
+    // Restoring the affinity before any check, the next cases must run on every processor
+    sched_setaffinity(0, sizeof(cpu_set_t), &previous_affinity);
+
+    RUKEN_BENCHMARK_CHECK(topology.GetPhysicalCores().size() == 1u && topology.GetLogicalProcessorsCount() == 1u);
+    RUKEN_BENCHMARK_CHECK(topology.GetPhysicalCores().front().processors.front() == processor);
+
+    // A single core, thus a single worker sharing it with the calling thread
+    RUKEN_BENCHMARK_CHECK(workers_count == 1u && worker_affinity == std::vector<RkUint32> {processor});
+
+    #endif
+
+    return true;
+}
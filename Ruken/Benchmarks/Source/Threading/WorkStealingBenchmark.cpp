@@ -0,0 +1,113 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+#include "Harness.hpp"
+
+#include "Core/ServiceProvider.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    constexpr RkSize g_root_tasks     = 2000u;
+    constexpr RkSize g_nested_tasks   = 100u;
+    constexpr RkSize g_flat_tasks     = 200000u;
+
+    /**
+     * \brief Runs the workloads on a scheduler and prints their throughput
+     * \param in_workers_count Number of workers of the scheduler
+     * \param in_mode Job distribution mode of the scheduler
+     * \return True if every task ran exactly once
+     */
+    RkBool RunWorkloads(RkUint16 const in_workers_count, ESchedulerMode const in_mode) noexcept
+    {
+        ServiceProvider service_provider;
+
+        service_provider.ProvideService<Logger>("Root", ELogLevel::Warning);
+
+        Scheduler* scheduler = service_provider.ProvideService<Scheduler>(in_workers_count, in_mode);
+
+        std::atomic<RkSize> executed {0u};
+
+        // Jobs spawning jobs, the workers mostly push to and pop from their own queue
+        auto start = std::chrono::steady_clock::now();
+
+        for (RkSize root = 0u; root < g_root_tasks; ++root)
+        {
+            scheduler->ScheduleTask([scheduler, &executed] {
+                for (RkSize nested = 0u; nested < g_nested_tasks; ++nested)
+                    scheduler->ScheduleTask([&executed] { executed.fetch_add(1u, std::memory_order_relaxed); });
+
+                executed.fetch_add(1u, std::memory_order_relaxed);
+            });
+        }
+
+        scheduler->WaitForQueuedTasks();
+
+        RkDouble const nested_seconds = SecondsSince(start);
+        RkSize   const nested_count   = executed.exchange(0u);
+
+        // Tasks submitted by an external thread only, every task has to be stolen from the submission queue
+        start = std::chrono::steady_clock::now();
+
+        for (RkSize task = 0u; task < g_flat_tasks; ++task)
+            scheduler->ScheduleTask([&executed] { executed.fetch_add(1u, std::memory_order_relaxed); });
+
+        scheduler->WaitForQueuedTasks();
+
+        RkDouble const flat_seconds = SecondsSince(start);
+        RkSize   const flat_count   = executed.load();
+
+        std::cout << "    " << (in_mode == ESchedulerMode::WorkStealing ? "WorkStealing" : "SharedQueue ")
+                  << " workers " << in_workers_count
+                  << " | nested " << static_cast<RkUint64>(nested_count / nested_seconds) << " tasks/s"
+                  << " | flat "   << static_cast<RkUint64>(flat_count   / flat_seconds)   << " tasks/s" << std::endl;
+
+        service_provider.DestroyService<Scheduler>();
+        service_provider.DestroyService<Logger>();
+
+        return nested_count == g_root_tasks * (g_nested_tasks + 1u) && flat_count == g_flat_tasks;
+    }
+}
+
+RUKEN_BENCHMARK_CASE(SchedulerWorkStealingThroughput)
+{
+    // Powers of two up to a worker per logical processor, minus one for the calling thread
+    RkUint16 const max_workers = static_cast<RkUint16>(std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+
+    for (RkUint16 workers = 1u;; workers = std::min<RkUint16>(workers * 2u, max_workers))
+    {
+        RUKEN_BENCHMARK_CHECK(RunWorkloads(workers, ESchedulerMode::SharedQueue));
+        RUKEN_BENCHMARK_CHECK(RunWorkloads(workers, ESchedulerMode::WorkStealing));
+
+        if (workers == max_workers)
+            return true;
+    }
+}
\ No newline at end of file
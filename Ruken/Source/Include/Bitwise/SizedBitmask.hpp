@@ -67,6 +67,7 @@ class SizedBitmask
 
         static constexpr RkSize sizeof_chunk = sizeof(TChunk) * 8; 
         static constexpr RkSize flags_count  = TSize * sizeof_chunk;
+        static constexpr RkSize chunks_count = TSize;
 
         #pragma region Constructors
 
@@ -151,6 +152,13 @@ class SizedBitmask
          */
         constexpr RkSize HashCode() const noexcept;
 
+        /**
+         * \brief Returns a chunk of the bitmask, holding sizeof_chunk flags
+         * \param in_index Index of the chunk, must be lower than chunks_count
+         * \return Chunk
+         */
+        [[nodiscard]] constexpr TChunk GetChunk(RkSize in_index) const noexcept;
+
         /**
          * \brief Executes a function pointer on each enabled flag in the bitmask.
          * \tparam TLambdaType Type of the lambda, the signature of the function used must be RkVoid (*in_lambda)(TEnumType in_flag)
@@ -60,6 +60,41 @@
     #define RUKEN_THREADING_DISABLE_THREAD_LABELS
 #endif
 
+// Scheduler telemetry: per worker counters, queue latency and run time histograms (see Scheduler::GetStatistics).
+// Enabled in debug only, define RUKEN_THREADING_FORCE_TELEMETRY to enable it in release as well
+#if defined(RUKEN_CONFIG_DEBUG) || defined(RUKEN_THREADING_FORCE_TELEMETRY)
+    #define RUKEN_THREADING_ENABLE_TELEMETRY
+#else
+    #define RUKEN_THREADING_DISABLE_TELEMETRY
+#endif
+
+// Size in bytes of a cache line, used to pad concurrently accessed data and avoid false sharing
+#define RUKEN_THREADING_CACHE_LINE_SIZE 64
+
+// Size in bytes of the inline storage of a job, any capture bigger than this will not compile
+#define RUKEN_THREADING_JOB_CAPACITY 64
+
+// Default idle policy of the threads running out of work: number of iterations spent
+// spinning, then yielding, before parking until new work comes in (see IdlePolicy)
+#define RUKEN_THREADING_IDLE_SPIN_COUNT  64
+#define RUKEN_THREADING_IDLE_YIELD_COUNT 16
+
+// Number of workers dedicated to blocking I/O jobs (see Scheduler::ScheduleIOTask)
+#define RUKEN_THREADING_IO_WORKERS_COUNT 2
+
+// Size in bytes of the stack of the fibers running the jobs, see Scheduler::WaitUntil
+#define RUKEN_THREADING_FIBER_STACK_SIZE (256 * 1024)
+
+// Interval in microseconds at which a worker with suspended jobs checks if they can be resumed, while it has nothing else to do
+#define RUKEN_THREADING_FIBER_POLL_INTERVAL 100
+
+// ------------------------------
+//           Containers
+
+// Alignment in bytes of the containers processed by SIMD kernels (see AlignedAllocator), 64 bytes fit an AVX-512 vector.
+// Must be a power of 2
+#define RUKEN_CONTAINERS_SIMD_ALIGNMENT 64
+
 // ------------------------------
 //       Resource management
 
@@ -72,4 +107,47 @@
 
 // Sets the maximum number of components allowed by the ECS, keep this number
 // as low as possible. Must be a power of 2 with a minimum of 8.
-#define RUKEN_MAX_ECS_COMPONENTS 64
\ No newline at end of file
+#define RUKEN_MAX_ECS_COMPONENTS 64
+
+// Default size in bytes of the chunks storing the entities of an archetype, see Archetype and ChunkPool.
+// Every archetype pins at least one chunk, every page of the command buffers is a chunk and change versions are tracked per chunk:
+// keep this small. An entity admin streaming a few huge archetypes through its systems can use bigger chunks (see EntityAdmin::EntityAdmin).
+// Must be a multiple of RUKEN_ECS_COLUMN_ALIGNMENT
+#define RUKEN_ECS_CHUNK_SIZE (16 * 1024)
+
+// Size in bytes of the blocks of chunks allocated at once by the chunk pool of an entity admin, see ChunkPool.
+// Pools with chunks bigger than a block allocate a single chunk per block
+#define RUKEN_ECS_CHUNK_BLOCK_SIZE (1024 * 1024)
+
+// Alignment in bytes of the chunks and of every column stored into them, columns are padded up to a multiple of it as well (see Component::GetSpan).
+// Must be a power of 2
+#define RUKEN_ECS_COLUMN_ALIGNMENT 64
+
+// Number of entities per page of the sparse arrays of the sparse components, see SparseSet.
+// Pages are only allocated once an entity of their range owns the component. Must be a power of 2
+#define RUKEN_ECS_SPARSE_PAGE_SIZE 4096
+
+// Matches archetypes against the registered queries two fingerprint chunks at a time with SSE2, see ComponentQueryCache
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #define RUKEN_ECS_ENABLE_SIMD_MATCHING
+#else
+    #define RUKEN_ECS_DISABLE_SIMD_MATCHING
+#endif
+
+// Number of shards of the cells of the spatial indices, see SpatialIndex.
+// Cells are spread over the shards by hash, entities moving between cells are then applied to every shard in parallel. Must be a power of 2
+#define RUKEN_ECS_SPATIAL_INDEX_SHARDS 64
+
+// Tests the positions stored by the spatial indices four at a time with SSE, see SpatialIndex
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #define RUKEN_ECS_ENABLE_SIMD_SPATIAL_QUERIES
+#else
+    #define RUKEN_ECS_DISABLE_SIMD_SPATIAL_QUERIES
+#endif
+
+// Checks that systems only access the components they declared, and only write the ones not declared as const (see ComponentAccess)
+#if defined(RUKEN_CONFIG_DEBUG)
+    #define RUKEN_ECS_ENABLE_ACCESS_VALIDATION
+#else
+    #define RUKEN_ECS_DISABLE_ACCESS_VALIDATION
+#endif
\ No newline at end of file
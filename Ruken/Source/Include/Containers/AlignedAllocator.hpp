@@ -0,0 +1,115 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <new>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Allocator handing out aligned and tail padded memory, meant for the containers processed by SIMD kernels.
+ *
+ * Every allocation starts on a TAlignment bytes boundary and its size is rounded up to a multiple of TAlignment bytes:
+ * kernels can load or store whole vectors up to the end of the last one holding an element, no peeling loop is needed.
+ * The values of the padding are unspecified.
+ *
+ * \note Lowercase names are required by the allocator requirements of the standard library
+ * \tparam TType Allocated type
+ * \tparam TAlignment Alignment in bytes, must be a power of 2 at least as large as the alignment of TType
+ */
+template <typename TType, RkSize TAlignment = RUKEN_CONTAINERS_SIMD_ALIGNMENT>
+class AlignedAllocator
+{
+    RUKEN_STATIC_ASSERT((TAlignment & (TAlignment - 1u)) == 0u, "The alignment must be a power of 2");
+    RUKEN_STATIC_ASSERT(TAlignment >= alignof(TType),       "The alignment must be at least as large as the alignment of the allocated type");
+
+    public:
+
+        using value_type = TType;
+
+        static constexpr RkSize alignment = TAlignment;
+
+        template <typename TOther>
+        struct rebind
+        {
+            using other = AlignedAllocator<TOther, TAlignment>;
+        };
+
+        #pragma region Constructors
+
+        constexpr AlignedAllocator() noexcept = default;
+
+        template <typename TOther>
+        constexpr AlignedAllocator(AlignedAllocator<TOther, TAlignment> const& in_other) noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the size in bytes of an allocation, padding included
+         * \param in_count Number of elements
+         * \return Allocation size, a multiple of TAlignment
+         */
+        [[nodiscard]]
+        static constexpr RkSize GetPaddedSize(RkSize in_count) noexcept;
+
+        /**
+         * \brief Allocates uninitialized storage for elements
+         * \param in_count Number of elements
+         * \return Storage aligned on TAlignment bytes, padded up to GetPaddedSize(in_count) bytes
+         */
+        [[nodiscard]]
+        TType* allocate(RkSize in_count);
+
+        /**
+         * \brief Releases storage previously returned by allocate
+         * \param in_data Storage to release
+         * \param in_count Number of elements passed to allocate
+         */
+        RkVoid deallocate(TType* in_data, RkSize in_count) noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        template <typename TOther>
+        constexpr RkBool operator==(AlignedAllocator<TOther, TAlignment> const& in_other) const noexcept;
+
+        template <typename TOther>
+        constexpr RkBool operator!=(AlignedAllocator<TOther, TAlignment> const& in_other) const noexcept;
+
+        #pragma endregion
+};
+
+#include "Containers/AlignedAllocator.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,115 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Non owning view over a contiguous array starting on a TAlignment bytes boundary and padded up to a multiple of TAlignment bytes.
+ *
+ * Spans hand the raw storage of aligned containers (see AlignedVector) or of the columns of the ECS (see Component::GetSpan) to SIMD kernels:
+ * the kernels can use aligned loads and stores from Data() up to PaddedSize() elements without any peeling nor remainder loop.
+ * The values of the padding are unspecified, results computed past Size() must be discarded.
+ *
+ * \tparam TType Element type, may be const qualified
+ * \tparam TAlignment Alignment in bytes of the storage, must be a power of 2
+ */
+template <typename TType, RkSize TAlignment = RUKEN_CONTAINERS_SIMD_ALIGNMENT>
+class AlignedSpan
+{
+    RUKEN_STATIC_ASSERT((TAlignment & (TAlignment - 1u)) == 0u, "The alignment must be a power of 2");
+
+    private:
+
+        #pragma region Members
+
+        TType* m_data;
+        RkSize m_size;
+
+        #pragma endregion
+
+    public:
+
+        static constexpr RkSize alignment = TAlignment;
+
+        #pragma region Constructors
+
+        /**
+         * \brief Aligned span constructor
+         * \param in_data Start of the storage, aligned on TAlignment bytes
+         * \param in_size Number of elements, the storage must be padded up to a multiple of TAlignment bytes
+         */
+        AlignedSpan(TType* in_data, RkSize in_size) noexcept;
+
+        AlignedSpan(AlignedSpan const& in_copy) = default;
+        AlignedSpan(AlignedSpan&&      in_move) = default;
+        ~AlignedSpan()                          = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the start of the storage
+         * \return Storage, aligned on TAlignment bytes
+         */
+        [[nodiscard]]
+        TType* Data() const noexcept;
+
+        /**
+         * \brief Returns the number of elements of the span
+         * \return Size
+         */
+        [[nodiscard]]
+        RkSize Size() const noexcept;
+
+        /**
+         * \brief Returns the number of elements which can be accessed, padding included
+         * \return Size rounded up to a multiple of TAlignment bytes
+         */
+        [[nodiscard]]
+        RkSize PaddedSize() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        AlignedSpan& operator=(AlignedSpan const& in_copy) = default;
+        AlignedSpan& operator=(AlignedSpan&&      in_move) = default;
+
+        TType& operator[](RkSize in_index) const noexcept;
+
+        #pragma endregion
+};
+
+#include "Containers/AlignedSpan.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
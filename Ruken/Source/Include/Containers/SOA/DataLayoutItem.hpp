@@ -29,6 +29,7 @@
 #include "Build/Namespace.hpp"
 #include "Meta/ValueIndexer.hpp"
 
+#include "Containers/AlignedVector.hpp"
 #include "Containers/SOA/DataLayout.hpp"
 #include "Containers/SOA/DataLayoutView.hpp"
 
@@ -49,6 +50,18 @@ struct DataLayoutItem : public std::tuple<TTypes...>
     using Layout   = DataLayout<TContainer, TTypes...>;
     using FullView = DataLayoutView<std::make_index_sequence<sizeof...(TTypes)>, TTypes...>;
 
+    // Same layout, stored into another kind of container
+    template <template <typename> typename TOtherContainer>
+    using RebindLayout = DataLayout<TOtherContainer, TTypes...>;
+
+    // Same layout, every field being stored into an aligned and tail padded column for SIMD kernels, see AlignedVector
+    using AlignedLayout = DataLayout<AlignedVector, TTypes...>;
+
+    template <RkSize TIndex>
+    using FieldType = SelectType<TIndex, TTypes...>;
+
+    static constexpr RkSize fields_count = sizeof...(TTypes);
+
     template <RkSize... TItems>
     using MakeView = DataLayoutView<std::index_sequence<TItems...>, SelectType<TItems, TTypes...>...>;
 };
@@ -24,7 +24,7 @@
 
 #pragma once
 
-#include "Threading/ThreadSafeLockQueue.hpp"
+#include "Threading/ThreadSafeQueue.hpp"
 
 #include "Debug/Logging/Formatters/LogFormatter.hpp"
 
@@ -43,7 +43,7 @@ class __declspec(novtable) LogHandler
 
         LogFormatter const& m_formatter {};
 
-        ThreadSafeLockQueue<LogRecord> m_records {};
+        ThreadSafeQueue<LogRecord> m_records {};
 
         #pragma endregion
 
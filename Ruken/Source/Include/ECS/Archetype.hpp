@@ -24,39 +24,129 @@
 
 #pragma once
 
-#include <tuple>
+#include <array>
+#include <vector>
+#include <utility>
 
+#include "Build/Config.hpp"
 #include "Build/Namespace.hpp"
 #include "Types/FundamentalTypes.hpp"
 
 #include "ECS/EntityID.hpp"
-#include "ECS/ArchetypeBase.hpp"
-
-#include "Meta/ValueIndexer.hpp"
-#include "Meta/IndexSequence/QuicksortIndexSequence.hpp"
+#include "ECS/EntityRange.hpp"
+#include "ECS/ChunkPool.hpp"
+#include "ECS/ArchetypeChunk.hpp"
+#include "ECS/ComponentDescriptor.hpp"
+#include "ECS/ArchetypeFingerprint.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
-template <typename... TComponents>
-class Archetype: public ArchetypeBase
+/**
+ * \brief An archetype stores every entity owning the exact same set of components.
+ *
+ * Entities are stored into fixed size chunks (see ArchetypeChunk) allocated from the chunk pool of the entity admin.
+ * Each chunk is split into one column per field of every component of the archetype, each column holding
+ * as many values as the chunk can hold entities. Columns are aligned on RUKEN_ECS_COLUMN_ALIGNMENT bytes
+ * and padded up to a multiple of it, SIMD kernels can thus process whole vectors up to the end of each column.
+ *
+ * Chunks are never moved nor reallocated once created: the address of the components of an entity
+ * remains stable as long as the entity stays in its archetype, and each chunk can be processed independently (see ComponentSystem::Update).
+ *
+ * Entities are packed: every chunk but the last one is full, and entities are identified by their row into the archetype.
+ * Destroying an entity moves the last entity of the archetype into the freed row (swap and pop),
+ * the ID of every entity is thus stored alongside its components, in an additional column (see GetEntities).
+ *
+ * The layout of an archetype is computed at runtime from the descriptors of its components (see ComponentDescriptor),
+ * an archetype can thus be created from its fingerprint only.
+ *
+ * Shared components don't get any column: every entity of the archetype shares the same value, stored once (see SharedComponent).
+ * Entities owning the same components but different shared values are stored into different archetypes.
+ *
+ * Adding or removing a component moves an entity into another archetype (see EntityAdmin::AddComponent),
+ * the archetypes reached that way are cached by each archetype as edges indexed by component id.
+ *
+ * Every chunk stores, for each component, the version at which it was last changed and last added to (see GetChangeVersion and GetAddVersion).
+ * Inserting an entity into a chunk flags every component of the chunk as added and changed, moving an entity into another row flags them as changed.
+ * Systems flag the components they write, allowing other systems to skip the chunks which didn't change since their last update (see ComponentQuery).
+ */
+class Archetype
 {
+    public:
+
+        // Interned values of the shared components of an archetype, indexed by component id (see SharedComponentTable)
+        using SharedValues = std::array<RkUint8 const*, RUKEN_MAX_ECS_COMPONENTS>;
+
     private:
 
+        /**
+         * \brief Storage of a field of a component, in every chunk of the archetype
+         */
+        struct Column
+        {
+            RkSize         component_id;
+            RkSize         field;
+            RkSize         size;
+            RkSize         offset;
+            RkUint8 const* default_value;
+        };
+
+        static constexpr RkSize invalid_column = ~RkSize(0u);
+
+        // Pseudo component id of the column storing the ID of the entities, always the first column
+        static constexpr RkSize entity_column = RUKEN_MAX_ECS_COMPONENTS;
+
         #pragma region Members
 
-        std::tuple<TComponents...> m_components;
+        ArchetypeFingerprint        m_fingerprint;
+        ChunkPool&                  m_chunk_pool;
+        RkUint32 const&             m_version;
+        std::vector<Column>         m_columns;
+        std::vector<ArchetypeChunk> m_chunks;
+        RkSize                      m_chunk_capacity;
+        RkSize                      m_entities_count;
+
+        // Offset of the versions of the components into every chunk: change versions, then add versions, indexed by the first column of each component
+        RkSize m_versions_offset;
+
+        // Index of the first column of every component, indexed by component id
+        std::array<RkSize, RUKEN_MAX_ECS_COMPONENTS> m_component_columns;
+
+        // Archetypes reached by adding or removing a component, indexed by component id
+        std::array<Archetype*, RUKEN_MAX_ECS_COMPONENTS> m_add_edges;
+        std::array<Archetype*, RUKEN_MAX_ECS_COMPONENTS> m_remove_edges;
+
+        SharedValues m_shared_values;
 
         #pragma endregion
 
         #pragma region Methods
 
         /**
-         * \brief Create entity helper 
-         * \tparam TIds Indices of the tuple elements
-         * \return New entity id
+         * \brief Lays out the columns, then the versions of the components into a chunk
+         * \param in_capacity Number of entities held by the chunk
+         * \return Size in bytes required by the columns and the versions
          */
-        template<RkSize... TIds>
-        EntityID CreateEntityHelper(std::index_sequence<TIds...>) noexcept;
+        RkSize LayoutColumns(RkSize in_capacity) noexcept;
+
+        /**
+         * \brief Returns the chunk the next entity will be pushed into, allocates a new chunk if the last one is full
+         * \return Last chunk
+         */
+        ArchetypeChunk& GetInsertionChunk() noexcept;
+
+        /**
+         * \brief Returns the versions of the components of a chunk
+         * \param in_chunk Chunk
+         * \return Change versions, followed by the add versions
+         */
+        [[nodiscard]]
+        RkUint32* GetVersions(ArchetypeChunk const& in_chunk) const noexcept;
+
+        template <typename TComponent, RkSize... TIds>
+        TComponent GetComponentHelper(RkSize in_chunk, std::index_sequence<TIds...>) const noexcept;
+
+        template <typename TComponent, RkSize... TIds>
+        TComponent GetSharedComponentHelper(std::index_sequence<TIds...>) const noexcept;
 
         #pragma endregion
 
@@ -64,85 +154,206 @@ class Archetype: public ArchetypeBase
 
         #pragma region Constructors
 
-        Archetype();
-        Archetype(Archetype const& in_copy) = default;
-        Archetype(Archetype&&      in_move) = default;
-        ~Archetype()                        = default;
+        /**
+         * \brief Archetype constructor
+         * \param in_chunk_pool Pool the chunks of the archetype are allocated from
+         * \param in_version Current version of the entity admin, flagging the components of the chunks entities are inserted into
+         * \param in_components Descriptors of the components of the archetype, sorted by id
+         * \param in_shared_values Values of the shared components of the archetype, the other entries are ignored
+         */
+        Archetype(ChunkPool&                                     in_chunk_pool,
+                  RkUint32                                const& in_version,
+                  std::vector<ComponentDescriptor const*> const& in_components,
+                  SharedValues                            const& in_shared_values) noexcept;
+
+        Archetype(Archetype const& in_copy) = delete;
+        Archetype(Archetype&&      in_move) = delete;
+        ~Archetype() noexcept;
 
         #pragma endregion
 
         #pragma region Methods
 
         /**
-         * \brief Returns the first occurence of the component in the archetype
-         * \tparam TComponent Component to look for
-         * \return First component storage occurence
+         * \brief Gets the fingerprint of the archetype
+         * \return Fingerprint
+         */
+        [[nodiscard]]
+        ArchetypeFingerprint const& GetFingerprint() const noexcept;
+
+        /**
+         * \brief Creates an entity in the archetype, every component being default initialized
+         * \param in_entity ID of the new entity
+         * \return Row of the entity into the archetype
+         */
+        RkSize CreateEntity(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Creates entities at the end of the archetype, every component being default initialized.
+         *        Columns are filled chunk by chunk, with a single fill per column and chunk
+         * \param in_entities IDs of the new entities
+         * \return Row of the first entity into the archetype, the next ones follow it
+         */
+        RkSize CreateEntities(EntityRange const& in_entities) noexcept;
+
+        /**
+         * \brief Creates entities at the end of the archetype, their components being copied from contiguous columns (see EntityAdmin::Load).
+         *        Each column is copied chunk by chunk, with a single copy per column and chunk
+         * \param in_columns One contiguous array of in_count values per column of the archetype, in column order:
+         *                   entity IDs first, then every field of every non shared component by increasing component id
+         * \param in_count Number of entities to create
+         * \return Row of the first entity into the archetype, the next ones follow it
+         */
+        RkSize CreateEntities(std::vector<RkUint8 const*> const& in_columns, RkSize in_count) noexcept;
+
+        /**
+         * \brief Returns the number of columns of the archetype, including the entity column
+         * \return Columns count
          */
-        template<typename TComponent>
-        auto GetComponent() noexcept;
+        [[nodiscard]]
+        RkSize GetColumnsCount() const noexcept;
 
         /**
-         * \brief Returns the component storage at the `TIndex` position of the archetype
-         * \tparam TIndex Index to look for
-         * \return Component storage reference
+         * \brief Creates a copy of an entity of another archetype.
+         *        Components owned by both archetypes are copied column by column, the other ones are default initialized.
+         *        The source entity is left untouched and must be destroyed by the caller
+         * \param in_source Archetype of the entity to copy
+         * \param in_source_row Row of the entity to copy
+         * \return Row of the entity into this archetype
          */
-        template<RkSize TIndex>
-        auto GetComponent() noexcept;
+        RkSize CreateEntityFrom(Archetype const& in_source, RkSize in_source_row) noexcept;
 
         /**
-         * \brief Creates an entity in the archetype
-         * \return The new ID of this entity.
-         * \see EntityID for lifetime info
+         * \brief Destroys an entity of the archetype in O(1), by moving the last entity of the archetype into its row.
+         *        The last chunk is released to the chunk pool once empty
+         * \param in_row Row of the entity to destroy
+         * \return ID of the entity moved into in_row, which must be relocated by the caller.
+         *         Invalid ID if the destroyed entity was the last one
          */
-        EntityID CreateEntity() noexcept;
+        EntityID DestroyEntity(RkSize in_row) noexcept;
 
         /**
          * \brief Returns the total count of entity stored in this archetype
          * \return Entities count
          */
+        [[nodiscard]]
         RkSize EntitiesCount() const noexcept;
 
-        #pragma endregion
+        /**
+         * \brief Returns the maximum number of entities stored into a single chunk
+         * \return Chunk capacity
+         */
+        [[nodiscard]]
+        RkSize GetChunkCapacity() const noexcept;
 
-        #pragma region Operators
+        /**
+         * \brief Returns the number of chunks of the archetype
+         * \return Chunks count
+         */
+        [[nodiscard]]
+        RkSize GetChunksCount() const noexcept;
 
-        Archetype& operator=(Archetype const& in_copy) = default;
-        Archetype& operator=(Archetype&&      in_move) = default;
+        /**
+         * \brief Returns a chunk of the archetype
+         * \param in_chunk Index of the chunk
+         * \return Chunk
+         */
+        [[nodiscard]]
+        ArchetypeChunk const& GetChunk(RkSize in_chunk) const noexcept;
 
-        #pragma endregion
-};
+        /**
+         * \brief Returns the IDs of the entities stored into a chunk
+         * \param in_chunk Index of the chunk
+         * \return Array of GetChunk(in_chunk).count entity IDs
+         */
+        [[nodiscard]]
+        EntityID const* GetEntities(RkSize in_chunk) const noexcept;
 
-namespace internal
-{
-    // Hidden template magic used to make the "MakeArchetype" work
+        /**
+         * \brief Returns the column of a field of a component, in a chunk
+         * \param in_chunk Index of the chunk
+         * \param in_component_id Unique id of the component, see Component::id
+         * \param in_field Index of the field in the component item
+         * \return Start of the column, nullptr if the archetype doesn't own the component
+         */
+        [[nodiscard]]
+        RkUint8* GetColumn(RkSize in_chunk, RkSize in_component_id, RkSize in_field) const noexcept;
 
-    template <std::size_t TIndex, typename... TComponents>
-    using ComponentIndexerT = typename decltype(Select<TIndex>(
-        Indexer<std::index_sequence<TComponents::id...>, TComponents...>{}
-    ))::Type;
+        /**
+         * \brief Returns the version at which a component of a chunk was last changed
+         * \param in_chunk Index of the chunk
+         * \param in_component_id Unique id of the component, must be owned by the archetype
+         * \return Change version
+         */
+        [[nodiscard]]
+        RkUint32 GetChangeVersion(RkSize in_chunk, RkSize in_component_id) const noexcept;
 
-    template <std::size_t TLhs, std::size_t TRhs>
-    struct LessComparator : std::integral_constant<RkBool, (TLhs < TRhs)>
-    {};
+        /**
+         * \brief Flags a component of a chunk as changed
+         * \param in_chunk Index of the chunk
+         * \param in_component_id Unique id of the component, must be owned by the archetype
+         * \param in_version Version of the change
+         */
+        RkVoid SetChangeVersion(RkSize in_chunk, RkSize in_component_id, RkUint32 in_version) noexcept;
 
-    template <typename TTuple, typename TSequence>
-    struct ArchetypeFactory;
+        /**
+         * \brief Returns the version at which an entity was last inserted into a chunk, and thus its components added
+         * \param in_chunk Index of the chunk
+         * \param in_component_id Unique id of the component, must be owned by the archetype
+         * \return Add version
+         */
+        [[nodiscard]]
+        RkUint32 GetAddVersion(RkSize in_chunk, RkSize in_component_id) const noexcept;
 
-    template <template <typename...> class TTuple, std::size_t... TIds, typename... TComponents>
-    struct ArchetypeFactory<TTuple<TComponents...>, std::index_sequence<TIds...>>
-    {
-        using Type = Archetype<internal::ComponentIndexerT<TIds, TComponents...>...>;
-    };
-}
+        /**
+         * \brief Returns the values of the shared components of the archetype
+         * \return Interned values indexed by component id, nullptr for the components which are not shared
+         */
+        [[nodiscard]]
+        SharedValues const& GetSharedValues() const noexcept;
 
-/**
- * \brief Creates an archetype by reordering components based on their id.
- *        This makes sure that the only one archetype type is used per component combination.
- *
- * \tparam TComponents Components of the archetype to create
- */
-template <typename... TComponents>
-using MakeArchetype = typename internal::ArchetypeFactory<std::tuple<TComponents...>, QuicksortIndexSequenceT<internal::LessComparator, std::index_sequence<TComponents::id...>>>::Type;
+        /**
+         * \brief Returns the storage of a component in a chunk
+         * \tparam TComponent Component to look for, must be owned by the archetype
+         * \param in_chunk Index of the chunk
+         * \return Component viewing the columns of the chunk, or the value of the archetype for a shared component
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        TComponent GetComponent(RkSize in_chunk) const noexcept;
+
+        /**
+         * \brief Returns the archetype reached by adding a component to this archetype, if known
+         * \param in_component_id Unique id of the added component
+         * \return Cached archetype, nullptr if not cached yet
+         */
+        [[nodiscard]]
+        Archetype* GetAddEdge(RkSize in_component_id) const noexcept;
+
+        /**
+         * \brief Returns the archetype reached by removing a component from this archetype, if known
+         * \param in_component_id Unique id of the removed component
+         * \return Cached archetype, nullptr if not cached yet
+         */
+        [[nodiscard]]
+        Archetype* GetRemoveEdge(RkSize in_component_id) const noexcept;
+
+        /**
+         * \brief Caches the archetypes reached by adding a component to this archetype, and by removing it from the target
+         * \param in_component_id Unique id of the added component
+         * \param in_target Archetype owning every component of this archetype, plus the added one
+         */
+        RkVoid LinkAddEdge(RkSize in_component_id, Archetype& in_target) noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        Archetype& operator=(Archetype const& in_copy) = delete;
+        Archetype& operator=(Archetype&&      in_move) = delete;
+
+        #pragma endregion
+};
 
 #include "ECS/Archetype.inl"
 
@@ -26,47 +26,24 @@
 
 #include "Build/Namespace.hpp"
 
-#include "ECS/ArchetypeFingerprint.hpp"
+#include "Types/FundamentalTypes.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
-class ArchetypeBase
+/**
+ * \brief Fixed size block storing a contiguous run of entities of an archetype.
+ *
+ * Every column of the archetype (a field of one of its components) gets its own slice of the chunk,
+ * entities are thus stored as a structure of arrays local to the chunk, see Archetype.
+ * Every chunk but the last one of an archetype is full.
+ */
+struct ArchetypeChunk
 {
-    protected:
-
-        #pragma region Members
-
-        ArchetypeFingerprint m_fingerprint;
-
-        #pragma endregion 
-
-    public:
-
-        #pragma region Constructors
-
-        ArchetypeBase()                             = default;
-        ArchetypeBase(ArchetypeBase const& in_copy) = default;
-        ArchetypeBase(ArchetypeBase&&      in_move) = default;
-        ~ArchetypeBase()                            = default;
-
-        #pragma endregion
-
-        #pragma region Methods
-
-        /**
-         * \brief Gets the fingerprint of the archetype
-         * \return Fingerprint
-         */
-        ArchetypeFingerprint const& GetFingerprint() const noexcept;
-
-        #pragma endregion
-
-        #pragma region Operators
-
-        ArchetypeBase& operator=(ArchetypeBase const& in_copy) = default;
-        ArchetypeBase& operator=(ArchetypeBase&&      in_move) = default;
+    // Storage of the chunk, allocated by the chunk pool of the entity admin (see ChunkPool)
+    RkUint8* data;
 
-        #pragma endregion
+    // Number of entities stored into the chunk
+    RkSize count;
 };
 
-END_RUKEN_NAMESPACE
+END_RUKEN_NAMESPACE
\ No newline at end of file
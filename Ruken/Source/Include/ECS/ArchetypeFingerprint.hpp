@@ -50,6 +50,7 @@ class ArchetypeFingerprint : public SizedBitmask<RUKEN_MAX_ECS_COMPONENTS / 64,
 
         /**
          * \brief Creates a new fingerprint and setups traits based on the passed components
+         * \note Sparse components are skipped, they are not stored into the archetypes (see SparseComponent)
          */
         template <typename... TComponents>
         static ArchetypeFingerprint CreateFingerPrintFrom() noexcept;
@@ -0,0 +1,129 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Pool of the fixed size chunks storing the entities of the archetypes, see Archetype.
+ *
+ * Chunks are all of the same size, given to the pool at construction, and aligned on RUKEN_ECS_COLUMN_ALIGNMENT bytes.
+ * They are allocated by blocks of RUKEN_ECS_CHUNK_BLOCK_SIZE bytes which are never released until the destruction of the pool,
+ * released chunks are kept in a free list and handed out again by the next allocations.
+ *
+ * Once the pool has warmed up, creating or destroying entities never allocates memory.
+ *
+ * \warning Every chunk must have been released before the destruction of the pool
+ */
+class ChunkPool : Unique
+{
+    private:
+
+        #pragma region Members
+
+        RkSize                m_chunk_size;
+        RkSize                m_chunks_per_block;
+        mutable std::mutex    m_mutex;
+        std::vector<RkUint8*> m_blocks;
+        std::vector<RkUint8*> m_free_chunks;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Allocates a new block of chunks and pushes them into the free list
+         */
+        RkVoid Grow() noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Chunk pool constructor
+         * \param in_chunk_size Size in bytes of the chunks, must be a multiple of RUKEN_ECS_COLUMN_ALIGNMENT
+         */
+        explicit ChunkPool(RkSize in_chunk_size = RUKEN_ECS_CHUNK_SIZE) noexcept;
+
+        ChunkPool(ChunkPool const& in_copy) = delete;
+        ChunkPool(ChunkPool&&      in_move) = delete;
+        ~ChunkPool() noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Allocates a chunk
+         * \return Uninitialized chunk of GetChunkSize() bytes
+         * \note This method may be called from any thread
+         */
+        [[nodiscard]]
+        RkUint8* Allocate() noexcept;
+
+        /**
+         * \brief Releases a chunk, making it available for the next allocations
+         * \param in_chunk Chunk previously allocated by this pool
+         * \note This method may be called from any thread
+         */
+        RkVoid Release(RkUint8* in_chunk) noexcept;
+
+        /**
+         * \brief Returns the size of the chunks of the pool
+         * \return Size in bytes
+         */
+        [[nodiscard]]
+        RkSize GetChunkSize() const noexcept;
+
+        /**
+         * \brief Returns the number of chunks allocated by the pool, either used or free
+         * \return Chunks count
+         */
+        [[nodiscard]]
+        RkSize GetCapacity() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        ChunkPool& operator=(ChunkPool const& in_copy) = delete;
+        ChunkPool& operator=(ChunkPool&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
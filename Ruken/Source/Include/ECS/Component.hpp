@@ -27,12 +27,26 @@
 #include "Build/Namespace.hpp"
 
 #include "Meta/Assert.hpp"
+#include "ECS/ComponentAccess.hpp"
+#include "Containers/AlignedSpan.hpp"
 #include "Containers/SOA/DataLayout.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
 /**
- * \brief This class is the actual component class used to store the items.
+ * \brief Column of a component field, see Component
+ */
+template <typename TType>
+using ComponentColumn = TType*;
+
+/**
+ * \brief This class is the actual component class used to access the items.
+ *
+ * Components are stored by the chunks of the archetypes (see Archetype), a component instance
+ * is a view over the columns of a single chunk: one contiguous array per field of the component item.
+ * Items are indexed from 0 to GetItemCount() within the chunk.
+ * Columns are aligned and tail padded on RUKEN_ECS_COLUMN_ALIGNMENT bytes, SIMD kernels can process them through GetSpan.
+ *
  * \tparam TItem Associated item of the component, must be a subtype of ComponentItem
  * \tparam TUniqueId Unique ID of the component.
  *                   Ideally this would be generated automatically at compile time but doing so in c++ is
@@ -49,22 +63,31 @@ class Component
 
         #pragma region Members
 
-        // Storage of the component
-        typename TItem::Layout::ContainerType m_storage;
+        // Columns of the component in the viewed chunk
+        typename TItem::template RebindLayout<ComponentColumn>::ContainerType m_storage;
+        RkSize                                                                m_count;
 
         #pragma endregion 
 
     public:
 
-        using Layout = typename TItem::Layout;
+        using Layout = typename TItem::template RebindLayout<ComponentColumn>;
         using Item   = TItem;
         using ItemId = RkSize;
 
-        static constexpr RkSize id = TUniqueId;
+        static constexpr RkSize id     = TUniqueId;
+        static constexpr RkBool shared = false;
+        static constexpr RkBool sparse = false;
 
         #pragma region Constructors
 
-        Component()                         = default;
+        /**
+         * \brief Component constructor
+         * \param in_storage Columns of the component, one per field of the item
+         * \param in_count Number of items in the columns
+         */
+        Component(typename Layout::ContainerType const& in_storage, RkSize in_count) noexcept;
+
         Component(Component const& in_copy) = default;
         Component(Component&&      in_move) = default;
         ~Component()                        = default;
@@ -73,20 +96,57 @@ class Component
 
         #pragma region Methods
 
-        /**
-         * \brief Creates an item into the component
-         * \param in_item item to push back
-         * \return Created item id
-         */
-        ItemId CreateItem(TItem&& in_item);
-        ItemId CreateItem();
-
         /**
          * \brief Returns the count of items in this component
          * \return Component item count
          */
         RkSize GetItemCount() const noexcept;
 
+        /**
+         * \brief Returns a view over some fields of an item
+         * \tparam TView View type, see ComponentItem::MakeView and ComponentItem::FullView
+         * \param in_item_id Item to fetch
+         * \return View instance containing references to the fields of the item
+         */
+        template <typename TView>
+        [[nodiscard]]
+        auto GetItem(ItemId in_item_id) noexcept;
+
+        /**
+         * \brief Overwrites every field of an item
+         * \param in_item_id Item to overwrite
+         * \param in_item New value of the item
+         */
+        RkVoid SetItem(ItemId in_item_id, TItem const& in_item) noexcept;
+
+        /**
+         * \brief Returns the storage of a field of the component.
+         *        Every field is stored contiguously, iterating over it gives a linear access to memory
+         * \tparam TMember Index of the field in the component item
+         * \return Field storage, an array of GetItemCount() values indexed by item id
+         */
+        template <RkSize TMember>
+        [[nodiscard]]
+        auto* GetStorage() noexcept;
+
+        template <RkSize TMember>
+        [[nodiscard]]
+        auto const* GetStorage() const noexcept;
+
+        /**
+         * \brief Returns the storage of a field of the component as an aligned span, to be processed by SIMD kernels.
+         *        The span covers every item of the chunk and can be accessed up to its padded size, see AlignedSpan
+         * \tparam TMember Index of the field in the component item
+         * \return Field storage, aligned and padded on RUKEN_ECS_COLUMN_ALIGNMENT bytes
+         */
+        template <RkSize TMember>
+        [[nodiscard]]
+        AlignedSpan<typename TItem::template FieldType<TMember>, RUKEN_ECS_COLUMN_ALIGNMENT> GetSpan() noexcept;
+
+        template <RkSize TMember>
+        [[nodiscard]]
+        AlignedSpan<typename TItem::template FieldType<TMember> const, RUKEN_ECS_COLUMN_ALIGNMENT> GetSpan() const noexcept;
+
         #pragma endregion 
 
         #pragma region Operators
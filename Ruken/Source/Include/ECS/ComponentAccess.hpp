@@ -0,0 +1,139 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/ArchetypeFingerprint.hpp"
+
+// Checks an access to a component against the access declared by the system job running on the calling thread, if any
+#if defined(RUKEN_ECS_ENABLE_ACCESS_VALIDATION)
+    #define RUKEN_ECS_VALIDATE_ACCESS(in_component_id, in_write) ComponentAccess::Validate(in_component_id, in_write)
+#else
+    #define RUKEN_ECS_VALIDATE_ACCESS(in_component_id, in_write)
+#endif
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Describes the components accessed by a system, and whether they are only read or also written.
+ *
+ * Two systems conflict if one of them writes a component accessed by the other one,
+ * systems that don't conflict can be updated concurrently (see EntityAdmin::UpdateSystems).
+ */
+class ComponentAccess
+{
+    private:
+
+        #pragma region Members
+
+        ArchetypeFingerprint m_read;
+        ArchetypeFingerprint m_write;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        ComponentAccess()                               = default;
+        ComponentAccess(ComponentAccess const& in_copy) = default;
+        ComponentAccess(ComponentAccess&&      in_move) = default;
+        ~ComponentAccess()                              = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Creates the access of a set of components
+         * \tparam TComponents Accessed components, const qualified components are only read
+         * \return Component access
+         */
+        template <typename... TComponents>
+        [[nodiscard]]
+        static ComponentAccess CreateFrom() noexcept;
+
+        /**
+         * \brief Adds components to the access
+         * \tparam TComponents Accessed components, const qualified components are only read
+         */
+        template <typename... TComponents>
+        RkVoid Add() noexcept;
+
+        /**
+         * \brief Checks if a component can be read
+         * \param in_component_id Unique id of the component
+         * \return True if the component is either read or written
+         */
+        [[nodiscard]]
+        RkBool CanRead(RkSize in_component_id) const noexcept;
+
+        /**
+         * \brief Checks if a component can be written
+         * \param in_component_id Unique id of the component
+         * \return True if the component is written
+         */
+        [[nodiscard]]
+        RkBool CanWrite(RkSize in_component_id) const noexcept;
+
+        /**
+         * \brief Checks if two accesses cannot happen concurrently
+         * \param in_other Other access
+         * \return True if any of the accesses writes a component accessed by the other one
+         */
+        [[nodiscard]]
+        RkBool ConflictsWith(ComponentAccess const& in_other) const noexcept;
+
+        #if defined(RUKEN_ECS_ENABLE_ACCESS_VALIDATION)
+
+        /**
+         * \brief Checks that the system job running on the calling thread, if any, declared an access to a component (see SystemJobContext)
+         * \param in_component_id Unique id of the accessed component
+         * \param in_write True if the component is accessed for writing
+         * \note Undeclared accesses are fatal, see RUKEN_ASSERT_MESSAGE
+         */
+        static RkVoid Validate(RkSize in_component_id, RkBool in_write) noexcept;
+
+        #endif
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        ComponentAccess& operator=(ComponentAccess const& in_copy) = default;
+        ComponentAccess& operator=(ComponentAccess&&      in_move) = default;
+
+        #pragma endregion
+};
+
+#include "ECS/ComponentAccess.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
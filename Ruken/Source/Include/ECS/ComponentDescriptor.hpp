@@ -0,0 +1,176 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Describes the memory layout of a component without knowing its type.
+ *
+ * Archetypes are created at runtime from a set of component ids (see ArchetypeFingerprint),
+ * their storage is thus laid out from the descriptors of their components instead of the component types.
+ * Every field of a component is stored into its own column, moving or initializing an entity is then a matter of copying bytes.
+ * The values of the shared components are stored once per archetype instead, as items laid out field after field (see SharedComponentTable).
+ * Sparse components are stored outside of the archetypes, one column per field as well (see SparseSet).
+ *
+ * \note Fields of the components must be trivially copyable and trivially destructible
+ */
+class ComponentDescriptor
+{
+    public:
+
+        /**
+         * \brief Describes a field of a component item
+         */
+        struct Field
+        {
+            RkSize               size;
+            RkSize               alignment;
+            RkSize               offset;
+            std::vector<RkUint8> default_value;
+        };
+
+    private:
+
+        #pragma region Members
+
+        RkSize             m_id;
+        RkBool             m_shared;
+        RkBool             m_sparse;
+        RkSize             m_item_size;
+        std::vector<Field> m_fields;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        template <typename TComponent, RkSize... TIds>
+        static ComponentDescriptor CreateHelper(std::index_sequence<TIds...>) noexcept;
+
+        template <typename TField>
+        static Field CreateField(TField const& in_default_value) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        ComponentDescriptor() noexcept;
+
+        /**
+         * \brief Creates the descriptor of a component from its fields, such as the fields loaded from a snapshot (see EntityAdmin::Load)
+         * \param in_id Unique id of the component
+         * \param in_shared True for a shared component, see SharedComponent
+         * \param in_sparse True for a sparse component, see SparseComponent
+         * \param in_fields Fields of the component in declaration order, their offsets are computed by the descriptor
+         */
+        ComponentDescriptor(RkSize in_id, RkBool in_shared, RkBool in_sparse, std::vector<Field>&& in_fields) noexcept;
+
+        ComponentDescriptor(ComponentDescriptor const& in_copy) = default;
+        ComponentDescriptor(ComponentDescriptor&&      in_move) = default;
+        ~ComponentDescriptor()                                  = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Creates the descriptor of a component
+         * \tparam TComponent Component to describe, see Component
+         * \return Component descriptor, default values of the fields are taken from a default constructed component item
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        static ComponentDescriptor Create() noexcept;
+
+        /**
+         * \brief Returns the descriptor of a component, created on first use
+         * \tparam TComponent Component to describe, see Component
+         * \return Component descriptor, alive until the end of the program
+         * \note This method may be called from any thread
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        static ComponentDescriptor const& Get() noexcept;
+
+        /**
+         * \brief Returns the unique id of the described component
+         * \return Component id
+         */
+        [[nodiscard]]
+        RkSize GetId() const noexcept;
+
+        /**
+         * \brief Returns the fields of the described component, in declaration order
+         * \return Fields
+         */
+        [[nodiscard]]
+        std::vector<Field> const& GetFields() const noexcept;
+
+        /**
+         * \brief Checks if the described component is a shared component, see SharedComponent
+         * \return True if the values of the component are stored once per archetype instead of once per entity
+         */
+        [[nodiscard]]
+        RkBool IsShared() const noexcept;
+
+        /**
+         * \brief Checks if the described component is a sparse component, see SparseComponent
+         * \return True if the component is stored into a sparse set instead of the archetypes
+         */
+        [[nodiscard]]
+        RkBool IsSparse() const noexcept;
+
+        /**
+         * \brief Returns the size of an item laid out field after field, each field being aligned at its offset (see Field::offset)
+         * \return Item size in bytes
+         */
+        [[nodiscard]]
+        RkSize GetItemSize() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        ComponentDescriptor& operator=(ComponentDescriptor const& in_copy) = default;
+        ComponentDescriptor& operator=(ComponentDescriptor&&      in_move) = default;
+
+        #pragma endregion
+};
+
+#include "ECS/ComponentDescriptor.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
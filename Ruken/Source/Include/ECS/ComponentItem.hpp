@@ -35,7 +35,8 @@
 BEGIN_RUKEN_NAMESPACE
 
 /**
- * \brief This class describes the memory layout of your component to the ECS
+ * \brief This class describes the memory layout of your component to the ECS.
+ *        Items can also be stored outside of the ECS into aligned columns, see DataLayoutItem::AlignedLayout
  * \tparam TTypes Item types
  */
 template <typename... TTypes>
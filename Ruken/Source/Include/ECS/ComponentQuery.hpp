@@ -24,16 +24,36 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Build/Namespace.hpp"
+#include "Meta/Assert.hpp"
 #include "Types/FundamentalTypes.hpp"
+#include "ECS/EntityID.hpp"
+#include "ECS/SparseSet.hpp"
 #include "ECS/ArchetypeFingerprint.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
-class ArchetypeBase;
+class Archetype;
 
+/**
+ * \brief Selects the archetypes owning a set of components, and none of another set.
+ *
+ * Once registered by an entity admin (see EntityAdmin::RegisterQuery), a query caches its matching archetypes
+ * and the entity admin keeps this cache up to date as new archetypes get created, see ComponentQueryCache.
+ *
+ * Chunks of the matching archetypes can be further filtered by the versions of their components (see Archetype::GetChangeVersion):
+ * changed and added filters only select the chunks in which one of the filtered components changed, or has been added, since a given version.
+ *
+ * Sparse components (see SparseComponent) are not part of the fingerprints of the archetypes, they are matched entity by entity instead:
+ * the entity column of each chunk is intersected with the sparse sets of the included and excluded sparse components (see ForEachRange).
+ */
 class ComponentQuery
 {
+    friend class EntityAdmin;
+    friend class ComponentQueryCache;
+
     private:
 
         #pragma region Members
@@ -41,6 +61,34 @@ class ComponentQuery
         ArchetypeFingerprint m_included;
         ArchetypeFingerprint m_excluded;
 
+        // Matching archetypes, in creation order
+        std::vector<Archetype*> m_archetypes;
+
+        // Components filtering the chunks of the matching archetypes
+        std::vector<RkSize> m_changed_filter;
+        std::vector<RkSize> m_added_filter;
+
+        // Sparse components, matched entity by entity
+        std::vector<RkSize> m_sparse_included;
+        std::vector<RkSize> m_sparse_excluded;
+
+        // Sparse sets of the sparse components, bound by the entity admin registering the query
+        std::vector<SparseSet const*> m_included_sets;
+        std::vector<SparseSet const*> m_excluded_sets;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Matches a block of entities against the sparse components of the query
+         * \param in_entities Alive entities
+         * \param in_count Number of entities, 64 at most
+         * \return Bit mask of the matching entities: bit i is set if the entity i owns every included sparse component and none of the excluded ones
+         */
+        [[nodiscard]]
+        RkUint64 MatchEntities(EntityID const* in_entities, RkSize in_count) const noexcept;
+
         #pragma endregion
 
     public:
@@ -58,7 +106,7 @@ class ComponentQuery
 
         /**
          * \brief Setups the inclusion query of the group.
-         *        Passed components will be *required* by the query.
+         *        Passed components will be *required* by the query, sparse components included (see ForEachRange).
          * \tparam TComponents Required components of the query
          */
         template <typename... TComponents>
@@ -73,12 +121,80 @@ class ComponentQuery
         template <typename... TComponents>
         RkVoid SetupExclusionQuery() noexcept;
 
+        /**
+         * \brief Setups the changed filter of the query.
+         *        Only the chunks in which one of the passed components changed will be selected, see MatchChunk
+         * \tparam TComponents Filtered components, must be required by the query as well
+         */
+        template <typename... TComponents>
+        RkVoid SetupChangedFilter() noexcept;
+
+        /**
+         * \brief Setups the added filter of the query.
+         *        Only the chunks in which one of the passed components has been added to an entity will be selected, see MatchChunk
+         * \tparam TComponents Filtered components, must be required by the query as well
+         */
+        template <typename... TComponents>
+        RkVoid SetupAddedFilter() noexcept;
+
         /**
          * \brief Checks if the passed archetype matches the query
          * \param in_archetype Archetype to match
          * \return True if the query matched, false otherwise
          */
-        RkBool Match(ArchetypeBase const& in_archetype) const noexcept;
+        RkBool Match(Archetype const& in_archetype) const noexcept;
+
+        /**
+         * \brief Checks if a chunk of a matching archetype passes the changed and added filters of the query.
+         *        A filter passes if any of its components changed (or has been added) after the passed version, or if it is empty
+         * \param in_archetype Archetype matching the query
+         * \param in_chunk Index of the chunk
+         * \param in_version Version to compare with, usually the version of the last update of a system
+         * \return True if the chunk passes every filter
+         */
+        [[nodiscard]]
+        RkBool MatchChunk(Archetype const& in_archetype, RkSize in_chunk, RkUint32 in_version) const noexcept;
+
+        /**
+         * \brief Checks if the query has a changed or an added filter
+         * \return True if the chunks of the matching archetypes must be filtered, see MatchChunk
+         */
+        [[nodiscard]]
+        RkBool HasChunkFilter() const noexcept;
+
+        /**
+         * \brief Checks if the query includes or excludes sparse components, whose entities must be matched one by one, see ForEachRange
+         * \return True if the rows of the chunks of the matching archetypes must be filtered
+         */
+        [[nodiscard]]
+        RkBool HasSparseFilter() const noexcept;
+
+        /**
+         * \brief Returns the smallest sparse set of the included sparse components.
+         *        Only its entities can match the query, no entity can match if it is empty
+         * \return Smallest included sparse set, nullptr if the query doesn't include any sparse component or hasn't been registered
+         */
+        [[nodiscard]]
+        SparseSet const* GetSmallestSparseSet() const noexcept;
+
+        /**
+         * \brief Splits the rows of a chunk into ranges of consecutive rows whose entities match the sparse components of the query.
+         *        Entities are matched 64 at a time against every sparse set, blocks matching entirely or not at all are handled at once
+         * \tparam TFunction Function type, taking the first row and the row past the last row of a range
+         * \param in_entities Entity column of the chunk, see Archetype::GetEntities
+         * \param in_count Number of entities in the chunk
+         * \param in_function Called once per range, in row order. Called once for the whole chunk if the query has no sparse filter
+         * \note The query must have been registered by an entity admin
+         */
+        template <typename TFunction>
+        RkVoid ForEachRange(EntityID const* in_entities, RkSize in_count, TFunction&& in_function) const noexcept;
+
+        /**
+         * \brief Returns the archetypes matching the query
+         * \return Matching archetypes, in creation order. Empty if the query hasn't been registered by an entity admin
+         */
+        [[nodiscard]]
+        std::vector<Archetype*> const& GetArchetypes() const noexcept;
 
         #pragma endregion
 
@@ -0,0 +1,115 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/ComponentQuery.hpp"
+#include "ECS/ArchetypeFingerprint.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class Archetype;
+
+/**
+ * \brief Keeps the matching archetypes of every registered query up to date, see ComponentQuery::GetArchetypes.
+ *
+ * Matches are only computed when a query is registered (against every known archetype)
+ * or when an archetype is created (against every registered query), never while iterating over the queries.
+ *
+ * The masks of the queries and the fingerprints of the archetypes are stored chunk by chunk (structure of arrays),
+ * a new archetype or query is thus matched against all the others in bulk, several of them at a time (see RUKEN_ECS_ENABLE_SIMD_MATCHING).
+ */
+class ComponentQueryCache
+{
+    private:
+
+        using Chunk = decltype(ArchetypeFingerprint().GetChunk(0u));
+
+        static constexpr RkSize chunks_count = ArchetypeFingerprint::chunks_count;
+
+        #pragma region Members
+
+        // Registered queries, with their inclusion and exclusion masks
+        std::vector<ComponentQuery*>                 m_queries;
+        std::array<std::vector<Chunk>, chunks_count> m_included;
+        std::array<std::vector<Chunk>, chunks_count> m_excluded;
+
+        // Known archetypes, with their fingerprints
+        std::vector<Archetype*>                      m_archetypes;
+        std::array<std::vector<Chunk>, chunks_count> m_fingerprints;
+
+        // Mismatching flags computed by the last bulk match, kept to avoid allocations
+        std::vector<Chunk> m_mismatches;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        ComponentQueryCache() noexcept;
+        ComponentQueryCache(ComponentQueryCache const& in_copy) = delete;
+        ComponentQueryCache(ComponentQueryCache&&      in_move) = delete;
+        ~ComponentQueryCache()                                  = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Registers a query, then caches every known archetype matching it
+         * \param in_query Query to register, must be unregistered before being destroyed
+         */
+        RkVoid AddQuery(ComponentQuery& in_query) noexcept;
+
+        /**
+         * \brief Unregisters a query and clears its cached archetypes
+         * \param in_query Registered query
+         */
+        RkVoid RemoveQuery(ComponentQuery& in_query) noexcept;
+
+        /**
+         * \brief Caches a new archetype into every registered query it matches
+         * \param in_archetype New archetype
+         */
+        RkVoid AddArchetype(Archetype& in_archetype) noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        ComponentQueryCache& operator=(ComponentQueryCache const& in_copy) = delete;
+        ComponentQueryCache& operator=(ComponentQueryCache&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
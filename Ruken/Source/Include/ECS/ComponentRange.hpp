@@ -0,0 +1,120 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+#include "Build/Namespace.hpp"
+#include "Meta/ValueIndexer.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Contiguous range of entities of a single chunk of an archetype, processed at once by a system.
+ *
+ * Entities of a chunk are identified by their index into every component of the chunk (see Archetype),
+ * a range thus gives access to the components of the system and to the indices of the entities to process.
+ * Iterating over the fields of the components (see Component::GetStorage) gives a linear access to memory.
+ *
+ * \tparam TComponents Components of the system, const qualified if they are only read
+ */
+template <typename... TComponents>
+class ComponentRange
+{
+    private:
+
+        #pragma region Members
+
+        std::tuple<TComponents...> m_components;
+        RkSize                     m_begin;
+        RkSize                     m_end;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Component range constructor
+         * \param in_components Components of the chunk
+         * \param in_begin Index of the first entity of the range
+         * \param in_end Index past the last entity of the range
+         */
+        ComponentRange(std::tuple<TComponents...> const& in_components, RkSize in_begin, RkSize in_end) noexcept;
+
+        ComponentRange(ComponentRange const& in_copy) = default;
+        ComponentRange(ComponentRange&&      in_move) = default;
+        ~ComponentRange()                             = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns a component of the chunk
+         * \tparam TComponent Component to look for, must be one of the components of the system
+         * \return Component storage reference, const if the system only reads the component
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        auto& Get() noexcept;
+
+        /**
+         * \brief Returns the index of the first entity of the range
+         * \return First entity index
+         */
+        [[nodiscard]]
+        RkSize Begin() const noexcept;
+
+        /**
+         * \brief Returns the index past the last entity of the range
+         * \return End index
+         */
+        [[nodiscard]]
+        RkSize End() const noexcept;
+
+        /**
+         * \brief Returns the number of entities in the range
+         * \return Entities count
+         */
+        [[nodiscard]]
+        RkSize Size() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        ComponentRange& operator=(ComponentRange const& in_copy) = delete;
+        ComponentRange& operator=(ComponentRange&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+#include "ECS/ComponentRange.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -24,17 +24,57 @@
 
 #pragma once
 
+#include "Build/Config.hpp"
 #include "Build/Namespace.hpp"
 #include "Types/FundamentalTypes.hpp"
+
+#include "ECS/Archetype.hpp"
+#include "ECS/ComponentRange.hpp"
+#include "ECS/SystemJobContext.hpp"
 #include "ECS/ComponentSystemBase.hpp"
 
+#include "Threading/Scheduler.hpp"
+
 BEGIN_RUKEN_NAMESPACE
 
+/**
+ * \brief A system processes every entity owning a set of components.
+ *
+ * Entities are processed by ranges (see ComponentRange), one per chunk of the matching archetypes.
+ * The chunks of every matching archetype are processed in parallel by the workers of the scheduler.
+ *
+ * Components only read by the system must be const qualified, systems that don't write
+ * any component accessed by each other are then updated concurrently (see EntityAdmin::UpdateSystems).
+ * The components which are not const qualified are flagged as changed in every processed chunk, see Archetype::SetChangeVersion.
+ *
+ * Sparse components (see SparseComponent) split the chunks into ranges of consecutive entities owning them, see ComponentQuery::ForEachRange.
+ *
+ * \tparam TComponents Components of the system, required by its query. Const qualified if only read
+ */
 template <typename... TComponents>
 class ComponentSystem : public ComponentSystemBase
 {
+    private:
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns a component of a chunk, stored by the archetype or by a sparse set
+         * \tparam TComponent Component of the system
+         * \param in_archetype Archetype matching the query of the system
+         * \param in_chunk Index of the chunk
+         * \return Component instance
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        TComponent GetComponent(Archetype const& in_archetype, RkSize in_chunk) const noexcept;
+
+        #pragma endregion
+
     public:
 
+        using Range = ComponentRange<TComponents...>;
+
         #pragma region Constructors
 
         ComponentSystem() noexcept;
@@ -46,10 +86,21 @@ class ComponentSystem : public ComponentSystemBase
 
         #pragma region Methods
 
-        /*
-        virtual RkVoid OnUpdate() const noexcept = 0;
-        virtual RkVoid OnQuery () const noexcept = 0;
-        */
+        /**
+         * \brief Processes a range of entities.
+         *        Ranges are processed in parallel, this method must only access the entities of the range
+         *        and must not wait for other jobs.
+         *        Structural changes must be recorded into the command buffer of the system, see GetCommandBuffer
+         * \param in_range Range of entities to process
+         */
+        virtual RkVoid OnUpdate(Range& in_range) noexcept = 0;
+
+        /**
+         * \brief Updates every entity matching the query of the system.
+         *        Returns once every entity has been processed, see Scheduler::ParallelFor
+         * \param in_scheduler Scheduler used to process the entities in parallel
+         */
+        RkVoid Update(Scheduler& in_scheduler) noexcept override;
 
         #pragma endregion
 
@@ -24,36 +24,207 @@
 
 #pragma once
 
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <type_traits>
+
 #include "Build/Namespace.hpp"
 
 #include "Types/FundamentalTypes.hpp"
 
+#include "ECS/EntityID.hpp"
+#include "ECS/SparseSet.hpp"
 #include "ECS/ComponentQuery.hpp"
+#include "ECS/ComponentAccess.hpp"
+#include "ECS/EntityCommandBuffer.hpp"
+#include "ECS/SharedComponentTable.hpp"
 #include "ECS/ArchetypeFingerprint.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
+class Scheduler;
+class Archetype;
+class EntityAdmin;
+
+/**
+ * \brief Base class of every system, see ComponentSystem
+ *
+ * Every system owns a query, registered by the entity admin when the system gets created.
+ * Matching archetypes are cached by the query as they get created, updating a system thus never looks for its archetypes.
+ *
+ * Systems cannot create or destroy entities, nor add or remove components while they are updated:
+ * these structural changes are recorded into command buffers instead (see GetCommandBuffer).
+ *
+ * Every update of a system is given a version by the entity admin. A system can filter out the chunks
+ * in which the components it is interested in didn't change, or weren't added, since its last update (see SetupChangedFilter).
+ *
+ * Systems can read shared components like any other component (see SharedComponent), and access the singletons of the entity admin
+ * once they declared them (see SetupSingletons).
+ * Sparse components are accessed like any other component as well (see SparseComponent), the rows of the entities not owning them being skipped.
+ */
 class ComponentSystemBase
 {
+    friend class EntityAdmin;
+
     private:
 
-        #pragma region Mebers
+        #pragma region Members
+
+        RkBool          m_enabled;
+        ComponentQuery  m_query;
+        ComponentAccess m_access;
+
+        // Entity admin owning the system and creation order of the system, set by the entity admin
+        EntityAdmin* m_admin;
+        RkUint32     m_order;
+
+        // Version of the current update and of the last completed update of the system, set by the entity admin
+        RkUint32 m_version;
+        RkUint32 m_last_version;
 
-        RkBool        m_enabled;
-        ComponentQuery m_query;
+        // True if the entity admin records the entities leaving the archetypes for this system, see SetupRemovedEntities
+        RkBool m_track_removed_entities;
+
+        // Scratch memory of GatherChunks, kept between updates to avoid reallocating it
+        std::unordered_map<Archetype const*, RkSize> m_archetype_indices;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the shared values and singletons of the entity admin owning the system
+         * \return Shared component table
+         */
+        [[nodiscard]]
+        SharedComponentTable& GetSharedValues() const noexcept;
 
         #pragma endregion
 
     protected:
 
+        // Chunks are gathered from the entities of the smallest included sparse set instead of scanning every matching chunk,
+        // if this set holds less than one entity out of this many entities of the matching archetypes (see GatherChunks)
+        static constexpr RkSize sparse_gather_ratio = 32u;
+
+        #pragma region Members
+
+        // Chunks of the matching archetypes processed by the current update, as (archetype, chunk index) pairs
+        std::vector<std::pair<Archetype*, RkSize>> m_chunks;
+
+        // Chunks gathered from the smallest included sparse set only (see GatherChunks): rows of the entities of the set,
+        // as (archetype index into the matching archetypes, row into the archetype) pairs sorted by archetype then row,
+        // and range of rows of every chunk of m_chunks. Both are empty if the chunks have been scanned
+        std::vector<std::pair<RkSize, RkSize>> m_sparse_rows;
+        std::vector<std::pair<RkSize, RkSize>> m_chunk_rows;
+
+        // Entities which left an archetype since the last update of the system, gathered by GatherRemovedEntities
+        std::vector<EntityID> m_removed_entities;
+
+        #pragma endregion
+
         #pragma region Methods
 
         /**
-         * \brief Sets up the target fingerprint of the system
-         * \tparam TComponents Components of the system
+         * \brief Sets up the query and the access of the system, requiring every component of the system
+         * \tparam TComponents Components of the system, const qualified if they are only read. Shared components are always read only
+         */
+        template <typename... TComponents>
+        RkVoid SetupQuery() noexcept;
+
+        /**
+         * \brief Skips the entities owning any of the passed components, see ComponentQuery::SetupExclusionQuery
+         * \tparam TComponents Excluded components, sparse components only exclude the rows of their entities
+         */
+        template <typename... TComponents>
+        RkVoid SetupExclusionQuery() noexcept;
+
+        /**
+         * \brief Declares the singletons accessed by the system, systems writing a singleton read by the other ones are thus updated before them
+         * \tparam TComponents Components identifying the singletons, const qualified if they are only read
+         */
+        template <typename... TComponents>
+        RkVoid SetupSingletons() noexcept;
+
+        /**
+         * \brief Returns a singleton of the entity admin, see EntityAdmin::GetSingleton
+         * \tparam TComponent Component identifying the singleton, declared by SetupSingletons. Const qualified if only read
+         * \return Value of the singleton
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        auto& GetSingleton() const noexcept;
+
+        /**
+         * \brief Only processes the chunks in which one of the passed components changed since the last update of the system.
+         *        Changes made by the system itself are ignored, see ComponentQuery::SetupChangedFilter
+         * \tparam TComponents Filtered components, must be components of the system
          */
         template <typename... TComponents>
-        RkVoid SetupTargetFingerprint() noexcept;
+        RkVoid SetupChangedFilter() noexcept;
+
+        /**
+         * \brief Only processes the chunks in which one of the passed components has been added since the last update of the system,
+         *        see ComponentQuery::SetupAddedFilter
+         * \tparam TComponents Filtered components, must be components of the system
+         */
+        template <typename... TComponents>
+        RkVoid SetupAddedFilter() noexcept;
+
+        /**
+         * \brief Has the entity admin record the entities leaving the archetypes, destroyed or moved into another archetype, see GatherRemovedEntities.
+         *        Must be called by the constructor of the system
+         */
+        RkVoid SetupRemovedEntities() noexcept;
+
+        /**
+         * \brief Gathers the entities which left an archetype since the last update of the system into m_removed_entities, in O(removed entities).
+         *        These entities might since have been destroyed, moved back into a matching archetype, or their ID recycled, see MatchEntity
+         */
+        RkVoid GatherRemovedEntities() noexcept;
+
+        /**
+         * \brief Gathers the chunks of the matching archetypes processed by the current update into m_chunks, by archetype then chunk order.
+         *
+         * Chunks not passing the changed and added filters of the query are skipped (see ComponentQuery::MatchChunk).
+         * If the query includes sparse components and the smallest of their sets holds few entities,
+         * only the chunks holding the entities of this set are gathered: they are looked up from the set instead of scanning every chunk,
+         * along with the rows of these entities (see m_chunk_rows).
+         */
+        RkVoid GatherChunks() noexcept;
+
+        /**
+         * \brief Checks if an entity is alive and stored by an archetype matching the query of the system, see ComponentQuery::Match
+         * \param in_entity Entity ID, possibly stale
+         * \return True if the entity matches the query, regardless of its sparse components
+         */
+        [[nodiscard]]
+        RkBool MatchEntity(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Returns a sparse set of the entity admin owning the system
+         * \param in_component_id Unique id of a sparse component
+         * \return Sparse set of the component, see SparseComponent
+         */
+        [[nodiscard]]
+        SparseSet const& GetSparseSet(RkSize in_component_id) const noexcept;
+
+        /**
+         * \brief Returns the command buffer of the calling thread, played back once every system has been updated
+         * \return Command buffer of the calling thread, see EntityAdmin::GetCommandBuffer
+         */
+        [[nodiscard]]
+        EntityCommandBuffer& GetCommandBuffer() const noexcept;
+
+        /**
+         * \brief Returns the sort key of the commands recorded while processing a chunk, see SystemJobContext.
+         *        Commands are played back by system creation order, then by chunk
+         * \param in_chunk Index of the chunk into the chunks processed by the current update
+         * \return Sort key
+         */
+        [[nodiscard]]
+        RkUint64 GetSortKey(RkSize in_chunk) const noexcept;
 
         #pragma endregion
 
@@ -75,6 +246,40 @@ class ComponentSystemBase
          */
         RkBool Enabled() const;
 
+        /**
+         * \brief Returns the query of the system
+         * \return Query
+         */
+        [[nodiscard]]
+        ComponentQuery const& GetQuery() const noexcept;
+
+        /**
+         * \brief Returns the components accessed by the system
+         * \return Component access
+         */
+        [[nodiscard]]
+        ComponentAccess const& GetAccess() const noexcept;
+
+        /**
+         * \brief Returns the version of the current update of the system, flagging the components written by the system
+         * \return Version
+         */
+        [[nodiscard]]
+        RkUint32 GetVersion() const noexcept;
+
+        /**
+         * \brief Returns the version of the last completed update of the system, 0 if it has never been updated
+         * \return Version
+         */
+        [[nodiscard]]
+        RkUint32 GetLastVersion() const noexcept;
+
+        /**
+         * \brief Updates every entity matching the query of the system
+         * \param in_scheduler Scheduler used to process the entities in parallel
+         */
+        virtual RkVoid Update(Scheduler& in_scheduler) noexcept = 0;
+
         #pragma endregion
 
         #pragma region Operators
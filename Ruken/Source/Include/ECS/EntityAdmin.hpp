@@ -24,36 +24,280 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
+#include <utility>
+#include <algorithm>
+#include <string_view>
 #include <unordered_map>
 
 #include "Build/Namespace.hpp"
 
 #include "ECS/EntityID.hpp"
+#include "ECS/EntityRange.hpp"
+#include "ECS/ChunkPool.hpp"
 #include "ECS/Archetype.hpp"
-#include "ECS/ArchetypeBase.hpp"
+#include "ECS/SparseSet.hpp"
+#include "ECS/EntityTable.hpp"
+#include "ECS/ComponentRange.hpp"
+#include "ECS/ComponentQueryCache.hpp"
+#include "ECS/EntityCommandBuffer.hpp"
+#include "ECS/ComponentDescriptor.hpp"
 #include "ECS/ComponentSystemBase.hpp"
+#include "ECS/SharedComponentTable.hpp"
+
+#include "Threading/JobHandle.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
+class Scheduler;
+
+/**
+ * \brief The entity admin owns every entity, archetype and system of a world.
+ *
+ * The query of every system, as well as any query registered by the user, is matched once against every archetype,
+ * when the query or the archetype gets created (see ComponentQueryCache).
+ * Updating the systems then only iterates over the cached matching archetypes, see ComponentSystemBase.
+ *
+ * Systems declare which components they read and write (see ComponentSystem), systems are updated
+ * concurrently unless one of them writes a component accessed by the other.
+ *
+ * Archetypes are created at runtime from their fingerprint, using the descriptors of the components
+ * registered by the entity admin as they get used. Their chunks are allocated from a pool owned by the entity admin.
+ *
+ * Entities are identified by generational IDs, resolved into their archetype and row by the entity table of the admin (see EntityTable).
+ * Adding or removing a component moves the entity into the archetype matching its new set of components,
+ * transitions between archetypes are cached by the archetypes themselves (see Archetype::GetAddEdge).
+ * Creating, destroying or moving entities must not happen while the systems are updated:
+ * systems record these structural changes into per thread command buffers instead,
+ * played back once every system has been updated (see PlaybackCommands).
+ *
+ * Chunks keep track of the version at which each of their components was last changed or added,
+ * systems can thus only process the entities which changed since their last update (see ComponentSystemBase::SetupChangedFilter).
+ * Components written outside of the systems must be flagged manually, see Archetype::SetChangeVersion and GetVersion.
+ *
+ * Shared components are stored once per archetype, archetypes being identified by their fingerprint and the values of their shared components.
+ * Singletons are stored once per entity admin (see SharedComponentTable).
+ *
+ * Sparse components are stored into a sparse set per component instead of the archetypes (see SparseComponent):
+ * adding or removing them never moves the entity, the queries intersect the entities of their archetypes with the sparse sets instead.
+ *
+ * Entities can be saved to and loaded from snapshots storing the columns of every archetype as contiguous blocks (see WorldSnapshot).
+ */
 class EntityAdmin
 {
+    friend class ComponentSystemBase;
+
     private:
 
+        /**
+         * \brief Identifies an archetype: its components, and the values of its shared components in component id order
+         */
+        struct ArchetypeKey
+        {
+            ArchetypeFingerprint        fingerprint;
+            std::vector<RkUint8 const*> shared_values;
+
+            RkBool operator==(ArchetypeKey const& in_other) const noexcept;
+        };
+
+        struct ArchetypeKeyHash
+        {
+            RkSize operator()(ArchetypeKey const& in_key) const noexcept;
+        };
+
         #pragma region Members
 
-        std::vector       <ComponentSystemBase*>                 m_systems;
-        std::unordered_map<ArchetypeFingerprint, ArchetypeBase*> m_archetypes;
+        Scheduler& m_scheduler;
+
+        // Must outlive the archetypes
+        ChunkPool m_chunk_pool;
+
+        // Descriptors of the registered components, indexed by component id
+        std::array<ComponentDescriptor, RUKEN_MAX_ECS_COMPONENTS> m_components;
+        ArchetypeFingerprint                                      m_registered_components;
+        ArchetypeFingerprint                                      m_shared_components;
+        ArchetypeFingerprint                                      m_sparse_components;
+
+        // Sparse sets of the sparse components, indexed by component id
+        std::array<SparseSet, RUKEN_MAX_ECS_COMPONENTS> m_sparse_sets;
+
+        // Archetypes, identified by their components and shared values. Shared values and singletons must outlive the archetypes
+
+        std::vector       <ComponentSystemBase*>                         m_systems;
+        std::unordered_map<ArchetypeKey, Archetype*, ArchetypeKeyHash>   m_archetypes;
+        EntityTable                                                      m_entities;
+        ComponentQueryCache                                              m_queries;
+        SharedComponentTable                                             m_shared_values;
+
+        // Current version, flagging the components changed or added outside of the systems (see Archetype::GetChangeVersion).
+        // Each update of the systems gives one version to every system, then a new one to the playback of the commands
+        RkUint32 m_version;
+
+        // Entities which left an archetype, destroyed or moved into another archetype, along with the version of the admin at that time.
+        // Only recorded once a system tracks them (see ComponentSystemBase::SetupRemovedEntities), then dropped once every such system processed them
+        RkBool                                     m_track_removed_entities;
+        std::vector<std::pair<RkUint32, EntityID>> m_removed_entities;
+
+        // Command buffer of every worker of the scheduler, plus one for the thread updating the systems. Must not outlive the chunk pool
+        std::vector<EntityCommandBuffer> m_command_buffers;
+
+        // Batches of every command buffer, sorted by the playback
+        std::vector<std::pair<EntityCommandBuffer*, EntityCommandBuffer::Batch const*>> m_command_batches;
+
+        // Jobs updating the systems during the current frame, indexed like the systems
+        std::vector<JobHandle> m_system_jobs;
+        std::vector<JobHandle> m_system_dependencies;
         
         #pragma endregion 
 
+        #pragma region Methods
+
+        /**
+         * \brief Registers the descriptor of a component, if not already done
+         * \tparam TComponent Component to register
+         */
+        template <typename TComponent>
+        RkVoid RegisterComponent() noexcept;
+
+        /**
+         * \brief Registers the descriptor of a component, if not already done
+         * \param in_component Descriptor of the component
+         */
+        RkVoid RegisterComponent(ComponentDescriptor const& in_component) noexcept;
+
+        /**
+         * \brief Creates an entity at the end of an archetype, every component being default initialized
+         * \param in_archetype Archetype of the entity
+         * \return The new ID of this entity
+         */
+        EntityID CreateEntity(Archetype& in_archetype) noexcept;
+
+        /**
+         * \brief Creates entities at the end of an archetype, every component being default initialized
+         * \param in_archetype Archetype of the entities
+         * \param in_count Number of entities to create
+         * \return IDs of the new entities
+         */
+        EntityRange CreateEntities(Archetype& in_archetype, RkSize in_count) noexcept;
+
+        /**
+         * \brief Adds a default initialized component to an entity, see AddComponent<TComponent>
+         * \param in_entity Entity to update
+         * \param in_component_id Unique id of the component, must have been registered
+         * \return True if the component has been added, false if the entity is dead or already owns the component
+         */
+        RkBool AddComponent(EntityID in_entity, RkSize in_component_id) noexcept;
+
+        /**
+         * \brief Removes a component from an entity, see RemoveComponent<TComponent>
+         * \param in_entity Entity to update
+         * \param in_component_id Unique id of the component
+         * \return True if the component has been removed, false if the entity is dead or doesn't own the component
+         */
+        RkBool RemoveComponent(EntityID in_entity, RkSize in_component_id) noexcept;
+
+        /**
+         * \brief Sets the value of a shared component of an entity, see SetSharedComponent<TComponent>
+         * \param in_entity Entity to update
+         * \param in_component_id Unique id of the shared component, must have been registered
+         * \param in_value Interned value, see SharedComponentTable::Intern
+         * \return True if the value has been set, false if the entity is dead
+         */
+        RkBool SetSharedComponent(EntityID in_entity, RkSize in_component_id, RkUint8 const* in_value) noexcept;
+
+        /**
+         * \brief Returns the archetype matching a fingerprint, creates it if it doesn't exist yet.
+         *        Shared components get their default value
+         * \param in_fingerprint Fingerprint of the archetype, every component must have been registered
+         * \return Archetype
+         */
+        Archetype& GetArchetype(ArchetypeFingerprint const& in_fingerprint) noexcept;
+
+        /**
+         * \brief Returns the archetype matching a fingerprint and values of shared components, creates it if it doesn't exist yet
+         * \param in_fingerprint Fingerprint of the archetype, every component must have been registered
+         * \param in_shared_values Interned values of the shared components of the fingerprint, the other entries are ignored
+         * \return Archetype
+         */
+        Archetype& GetArchetype(ArchetypeFingerprint const& in_fingerprint, Archetype::SharedValues const& in_shared_values) noexcept;
+
+        /**
+         * \brief Returns the archetype reached by adding a component to an archetype, creates it if needed
+         * \param in_source Source archetype, not owning the component
+         * \param in_component_id Unique id of the added component, must have been registered
+         * \return Target archetype
+         */
+        Archetype& GetAddTarget(Archetype& in_source, RkSize in_component_id) noexcept;
+
+        /**
+         * \brief Returns the archetype reached by removing a component from an archetype, creates it if needed
+         * \param in_source Source archetype, owning the component
+         * \param in_component_id Unique id of the removed component
+         * \return Target archetype
+         */
+        Archetype& GetRemoveTarget(Archetype& in_source, RkSize in_component_id) noexcept;
+
+        /**
+         * \brief Moves an entity into another archetype, copying the components owned by both archetypes
+         * \param in_entity Alive entity to move
+         * \param in_target Target archetype
+         */
+        RkVoid MoveEntity(EntityID in_entity, Archetype& in_target) noexcept;
+
+        /**
+         * \brief Records an entity leaving its archetype, if a system tracks them (see m_removed_entities)
+         * \param in_entity Entity being destroyed or moved into another archetype
+         */
+        RkVoid RecordRemovedEntity(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Removes the row of an entity from its archetype, relocating the entity moved into this row
+         * \param in_location Location of the removed entity
+         */
+        RkVoid RemoveRow(EntityLocation const& in_location) noexcept;
+
+        /**
+         * \brief Binds the sparse sets of the sparse components included or excluded by a query, see ComponentQuery::ForEachRange
+         * \param in_query Query to bind
+         */
+        RkVoid BindSparseSets(ComponentQuery& in_query) const noexcept;
+
+        /**
+         * \brief Adds an entity to the sparse sets of the sparse components of a list of components
+         * \tparam TComponents Components of the entity, the non sparse components are skipped
+         * \param in_entities Alive entities
+         */
+        template <typename... TComponents>
+        RkVoid AddSparseComponents(EntityRange const& in_entities) noexcept;
+
+        /**
+         * \brief Returns a component of a chunk, stored by the archetype or by a sparse set
+         * \tparam TComponent Component to return
+         * \param in_archetype Archetype owning the component, unless the component is sparse
+         * \param in_chunk Index of the chunk
+         * \return Component instance
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        TComponent GetComponent(Archetype const& in_archetype, RkSize in_chunk) const noexcept;
+
+        #pragma endregion
+
     public:
 
         #pragma region Constructors
 
-        EntityAdmin()                           = default;
-        EntityAdmin(EntityAdmin const& in_copy) = default;
-        EntityAdmin(EntityAdmin&&      in_move) = default;
+        /**
+         * \brief Entity admin constructor
+         * \param in_scheduler Scheduler used to update the systems
+         * \param in_chunk_size Size in bytes of the chunks storing the entities of the archetypes and the commands of the command buffers.
+         *                      Bigger chunks only pay off for a few huge archetypes streamed through systems accessing a few columns, see RUKEN_ECS_CHUNK_SIZE
+         */
+        explicit EntityAdmin(Scheduler& in_scheduler, RkSize in_chunk_size = RUKEN_ECS_CHUNK_SIZE) noexcept;
+
+        EntityAdmin(EntityAdmin const& in_copy) = delete;
+        EntityAdmin(EntityAdmin&&      in_move) = delete;
         ~EntityAdmin();
 
         #pragma endregion
@@ -61,31 +305,236 @@ class EntityAdmin
         #pragma region Methods
 
         /**
-         * \brief 
+         * \brief Creates a system, matching its query against every existing archetype
          * \tparam TSystem System type to push to the entity admin 
+         * \param in_args Arguments forwarded to the constructor of the system
+         * \return Created system, owned by the entity admin
          */
-        template <typename TSystem>
-        RkVoid CreateSystem() noexcept;
+        template <typename TSystem, typename... TArgs>
+        TSystem& CreateSystem(TArgs&&... in_args) noexcept;
 
         /**
-         * \brief Updates every system
+         * \brief Registers a query, its matching archetypes are then cached and kept up to date, see ComponentQuery::GetArchetypes
+         * \param in_query Query to register, must be unregistered before being destroyed
+         */
+        RkVoid RegisterQuery(ComponentQuery& in_query) noexcept;
+
+        /**
+         * \brief Unregisters a query, clearing its cached archetypes
+         * \param in_query Registered query
+         */
+        RkVoid UnregisterQuery(ComponentQuery& in_query) noexcept;
+
+        /**
+         * \brief Updates every enabled system, then returns once they are all done.
+         *
+         * A dependency graph of the systems is built from their component accesses: every system
+         * waits for the previously created systems it conflicts with, conflicting systems are thus
+         * updated in creation order while the others are updated concurrently.
+         * The entities of each system are processed in parallel as well, see ComponentSystem::Update.
+         * The commands recorded by the systems are then played back, see PlaybackCommands.
          */
         RkVoid UpdateSystems() noexcept;
 
         /**
-         * \brief 
-         * \tparam TComponents 
-         * \return 
+         * \brief Returns the command buffer of the calling thread
+         * \return Command buffer
+         * \note The calling thread must be a worker of the scheduler of the entity admin, or the thread updating the systems
+         */
+        [[nodiscard]]
+        EntityCommandBuffer& GetCommandBuffer() noexcept;
+
+        /**
+         * \brief Plays back then clears every command buffer.
+         *
+         * Batches of commands of every buffer are played back by increasing sort key, commands of a batch in recording order,
+         * the commands recorded by the systems are thus played back in the same order whatever the thread they were recorded by.
+         * Commands targeting an entity which is dead by then are ignored.
+         *
+         * \note This method must not be called while the systems are updated
+         */
+        RkVoid PlaybackCommands() noexcept;
+
+        /**
+         * \brief Creates an entity, every component being default initialized
+         * \tparam TComponents Components of the entity
+         * \return The new ID of this entity
          */
         template <typename... TComponents>
         EntityID CreateEntity() noexcept;
 
+        /**
+         * \brief Creates entities in bulk, every component being default initialized.
+         *        Much faster than creating the entities one by one, see Archetype::CreateEntities
+         * \tparam TComponents Components of the entities
+         * \param in_count Number of entities to create
+         * \return IDs of the new entities, which are contiguous
+         */
+        template <typename... TComponents>
+        EntityRange CreateEntities(RkSize in_count) noexcept;
+
+        /**
+         * \brief Creates entities in bulk, then initializes their components chunk by chunk
+         * \tparam TComponents Components of the entities
+         * \tparam TInitializer Function type, taking a ComponentRange<TComponents...>&
+         * \param in_count Number of entities to create
+         * \param in_initializer Called once per chunk holding new entities, with the range of the new entities of this chunk.
+         *                       Ranges are passed in creation order, the new entities thus follow the order of the returned IDs
+         * \return IDs of the new entities, which are contiguous
+         */
+        template <typename... TComponents, typename TInitializer>
+        EntityRange CreateEntities(RkSize in_count, TInitializer&& in_initializer) noexcept;
+
+        /**
+         * \brief Destroys an entity in O(1), its ID and every copy of it become stale.
+         *        The last entity of its archetype is moved into its row, see Archetype::DestroyEntity
+         * \param in_entity Entity to destroy
+         * \return True if the entity has been destroyed, false if it was already dead
+         */
+        RkBool DestroyEntity(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Adds a default initialized component to an entity, moving it into the matching archetype.
+         *        Sparse components are added to their sparse set instead, in O(1)
+         * \tparam TComponent Component to add
+         * \param in_entity Entity to update
+         * \return True if the component has been added, false if the entity is dead or already owns the component
+         */
+        template <typename TComponent>
+        RkBool AddComponent(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Adds a component to an entity, moving it into the matching archetype.
+         *        Sparse components are added to their sparse set instead, in O(1)
+         * \tparam TComponent Component to add
+         * \param in_entity Entity to update
+         * \param in_item Value of the component
+         * \return True if the component has been added, false if the entity is dead or already owns the component
+         */
+        template <typename TComponent>
+        RkBool AddComponent(EntityID in_entity, typename TComponent::Item const& in_item) noexcept;
+
+        /**
+         * \brief Removes a component from an entity, moving it into the matching archetype.
+         *        Sparse components are removed from their sparse set instead, in O(1)
+         * \tparam TComponent Component to remove
+         * \param in_entity Entity to update
+         * \return True if the component has been removed, false if the entity is dead or doesn't own the component
+         */
+        template <typename TComponent>
+        RkBool RemoveComponent(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Sets the value of a shared component of an entity, adding the component if needed.
+         *        The entity is moved into the archetype of the new value, unless it already had this value
+         * \tparam TComponent Shared component, see SharedComponent
+         * \param in_entity Entity to update
+         * \param in_item New value, interned by the entity admin
+         * \return True if the value has been set, false if the entity is dead
+         */
+        template <typename TComponent>
+        RkBool SetSharedComponent(EntityID in_entity, typename TComponent::Item const& in_item) noexcept;
+
+        /**
+         * \brief Returns the value of a shared component of an entity
+         * \tparam TComponent Shared component, see SharedComponent
+         * \param in_entity Alive entity owning the component
+         * \return View over the value, shared by every entity of the archetype of the entity
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        TComponent GetSharedComponent(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Sets the value of a singleton, see SharedComponentTable::SetSingleton
+         * \tparam TComponent Component identifying the singleton
+         * \param in_item New value
+         */
+        template <typename TComponent>
+        RkVoid SetSingleton(typename TComponent::Item const& in_item) noexcept;
+
+        /**
+         * \brief Returns a singleton, see SharedComponentTable::GetSingleton
+         * \tparam TComponent Component identifying the singleton, const qualified if the singleton is only read
+         * \return Value of the singleton, which must have been set
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        auto& GetSingleton() noexcept;
+
+        /**
+         * \brief Checks if an entity owns a component
+         * \tparam TComponent Component to look for
+         * \param in_entity Entity to check
+         * \return True if the entity is alive and owns the component
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        RkBool HasComponent(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Checks if an entity is alive
+         * \param in_entity Entity ID, possibly stale
+         * \return True if the entity is alive, false if it has been destroyed
+         */
+        [[nodiscard]]
+        RkBool IsAlive(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Returns the number of alive entities
+         * \return Entities count
+         */
+        [[nodiscard]]
+        RkSize EntitiesCount() const noexcept;
+
+        /**
+         * \brief Returns the current version of the entity admin, to be used to flag the components changed outside of the systems
+         * \return Version, newer than the version of every completed update of the systems
+         */
+        [[nodiscard]]
+        RkUint32 GetVersion() const noexcept;
+
+        /**
+         * \brief Saves every entity into a snapshot file, see WorldSnapshot.
+         *        Every column of every archetype is written as a single block, with a single write per column and chunk
+         * \param in_path Path of the file, overwritten if it exists
+         * \return True if the snapshot has been saved
+         * \note Singletons are not saved, their values are not described by any component descriptor
+         */
+        [[nodiscard]]
+        RkBool Save(std::string_view in_path) const noexcept;
+
+        /**
+         * \brief Loads the entities of a snapshot file, mapped into memory (see MappedFile)
+         * \param in_path Path of the file
+         * \return True if the snapshot has been loaded, see Load(RkUint8 const*, RkSize)
+         */
+        [[nodiscard]]
+        RkBool Load(std::string_view in_path) noexcept;
+
+        /**
+         * \brief Loads the entities of a snapshot, keeping their IDs.
+         *
+         * The snapshot is validated as a whole before loading anything: its components must have the same layout
+         * as the ones registered by the entity admin, components which are not registered yet are registered from the snapshot.
+         * Archetypes are then loaded with a single copy per column and chunk, see Archetype::CreateEntities.
+         * Loaded components are flagged as added and changed at the current version.
+         *
+         * \param in_data Snapshot, aligned on 8 bytes at least
+         * \param in_size Size of the snapshot in bytes
+         * \return True if the snapshot has been loaded, false if the entity admin isn't empty or if the snapshot is invalid
+         * \note This method must not be called while the systems are updated
+         * \warning The entity table is replaced by the one of the snapshot, IDs of the entities destroyed before the loading must not be used anymore
+         */
+        [[nodiscard]]
+        RkBool Load(RkUint8 const* in_data, RkSize in_size) noexcept;
+
         #pragma endregion
 
         #pragma region Operators
 
-        EntityAdmin& operator=(EntityAdmin const& in_copy) = default;
-        EntityAdmin& operator=(EntityAdmin&&      in_move) = default;
+        EntityAdmin& operator=(EntityAdmin const& in_copy) = delete;
+        EntityAdmin& operator=(EntityAdmin&&      in_move) = delete;
 
         #pragma endregion
 };
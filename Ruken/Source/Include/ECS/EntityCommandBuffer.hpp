@@ -0,0 +1,237 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <utility>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/EntityID.hpp"
+#include "ECS/ChunkPool.hpp"
+#include "ECS/ComponentDescriptor.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class EntityAdmin;
+
+/**
+ * \brief Records structural changes (creating or destroying entities, adding or removing components)
+ *        to be played back later by an entity admin, see EntityAdmin::PlaybackCommands.
+ *
+ * Archetypes cannot be modified while systems iterate over them, systems thus record their structural changes
+ * into the command buffer of their thread (see ComponentSystemBase::GetCommandBuffer). Each thread owns its buffer:
+ * recording a command never locks nor synchronizes with other threads.
+ *
+ * Commands are written one after the other into pages allocated from the chunk pool of the entity admin (linear arena).
+ * Pages are kept once the commands have been played back, recording commands thus stops allocating memory once the buffer has warmed up.
+ *
+ * Commands are grouped into batches sharing the same sort key. Batches of every buffer are played back by increasing sort key,
+ * commands of a batch in recording order. Systems use the index of the processed chunk as sort key,
+ * the playback order of their commands thus doesn't depend on the thread the chunks have been processed by.
+ * The sort key is taken from the job recording the commands (see SystemJobContext), not from the buffer:
+ * jobs suspended while processing a chunk keep their key even if their worker processed other chunks in the meantime.
+ * Commands recorded outside of the jobs of the systems use default_sort_key.
+ *
+ * Creating an entity returns a placeholder ID, which can be used by the next commands of the same buffer only.
+ * Placeholders are replaced by the ID of the created entity when the commands are played back.
+ */
+class alignas(RUKEN_THREADING_CACHE_LINE_SIZE) EntityCommandBuffer
+{
+    friend class EntityAdmin;
+
+    public:
+
+        // Sort key of the commands recorded outside of a system, played back after the commands of the systems
+        static constexpr RkUint64 default_sort_key = ~RkUint64(0u);
+
+    private:
+
+        enum class ECommandType : RkUint32
+        {
+            CreateEntity,
+            DestroyEntity,
+            AddComponent,
+            RemoveComponent
+        };
+
+        /**
+         * \brief Header of a command, followed by its payload:
+         *        - CreateEntity: descriptors of the components of the entity
+         *        - AddComponent: raw bytes of every field of the component, if the component isn't default initialized
+         */
+        struct Command
+        {
+            ECommandType               type;
+            RkUint32                   payload_size;
+            EntityID                   entity;
+            ComponentDescriptor const* component;
+        };
+
+        struct Page
+        {
+            RkUint8* data;
+            RkSize   size;
+        };
+
+        struct Batch
+        {
+            RkUint64 sort_key;
+            RkSize   page;
+            RkSize   offset;
+            RkSize   count;
+        };
+
+        #pragma region Members
+
+        ChunkPool*         m_chunk_pool;
+        std::vector<Page>  m_pages;
+        std::vector<Batch> m_batches;
+        RkSize             m_page;
+
+        // Number of entities created by the recorded commands, and their IDs once played back
+        RkUint32              m_created_count;
+        std::vector<EntityID> m_created;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Appends a command to the current batch
+         * \param in_type Type of the command
+         * \param in_entity Entity targeted by the command
+         * \param in_component Component targeted by the command, if any
+         * \param in_payload_size Size in bytes of the payload following the command
+         * \return Start of the payload
+         */
+        RkUint8* Record(ECommandType in_type, EntityID in_entity, ComponentDescriptor const* in_component, RkSize in_payload_size) noexcept;
+
+        /**
+         * \brief Replaces a placeholder by the ID of the entity it stands for, once played back
+         * \param in_entity Entity ID or placeholder
+         * \return Entity ID
+         */
+        [[nodiscard]]
+        EntityID Resolve(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Calls a function with every command of a batch, in recording order
+         * \param in_batch Batch of this buffer
+         * \param in_function Function called with the command and the start of its payload
+         */
+        template <typename TFunction>
+        RkVoid ForEachCommand(Batch const& in_batch, TFunction&& in_function) const noexcept;
+
+        template <typename TComponent, RkSize... TIds>
+        RkVoid AddComponentHelper(EntityID in_entity, typename TComponent::Item const& in_item, std::index_sequence<TIds...>) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Entity command buffer constructor
+         * \param in_chunk_pool Pool the pages of the buffer are allocated from
+         */
+        explicit EntityCommandBuffer(ChunkPool& in_chunk_pool) noexcept;
+
+        EntityCommandBuffer(EntityCommandBuffer const& in_copy) = delete;
+        EntityCommandBuffer(EntityCommandBuffer&&      in_move) = default;
+        ~EntityCommandBuffer() noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Records the creation of an entity, every component being default initialized
+         * \tparam TComponents Components of the entity
+         * \return Placeholder ID of the entity, only valid for the next commands of this buffer
+         */
+        template <typename... TComponents>
+        EntityID CreateEntity() noexcept;
+
+        /**
+         * \brief Records the destruction of an entity, ignored if the entity is dead by then
+         * \param in_entity Entity to destroy, or placeholder
+         */
+        RkVoid DestroyEntity(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Records the addition of a default initialized component, ignored if the entity is dead or already owns the component by then
+         * \tparam TComponent Component to add
+         * \param in_entity Entity to update, or placeholder
+         */
+        template <typename TComponent>
+        RkVoid AddComponent(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Records the addition of a component, ignored if the entity is dead or already owns the component by then
+         * \tparam TComponent Component to add
+         * \param in_entity Entity to update, or placeholder
+         * \param in_item Value of the component, copied into the buffer
+         */
+        template <typename TComponent>
+        RkVoid AddComponent(EntityID in_entity, typename TComponent::Item const& in_item) noexcept;
+
+        /**
+         * \brief Records the removal of a component, ignored if the entity is dead or doesn't own the component by then
+         * \tparam TComponent Component to remove
+         * \param in_entity Entity to update, or placeholder
+         */
+        template <typename TComponent>
+        RkVoid RemoveComponent(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Checks if the buffer holds no command
+         * \return True if the buffer is empty
+         */
+        [[nodiscard]]
+        RkBool Empty() const noexcept;
+
+        /**
+         * \brief Drops every recorded command, keeping the pages of the buffer for the next commands
+         */
+        RkVoid Clear() noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        EntityCommandBuffer& operator=(EntityCommandBuffer const& in_copy) = delete;
+        EntityCommandBuffer& operator=(EntityCommandBuffer&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+#include "ECS/EntityCommandBuffer.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -28,27 +28,51 @@
 
 #include "Types/NamedType.hpp"
 #include "Types/Operators/Comparison.hpp"
-#include "Types/Operators/Arithmetic/Decrement.hpp"
-#include "Types/Operators/Arithmetic/Increment.hpp"
 
 #include "Types/FundamentalTypes.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
 /**
- * \brief Entity ID class. This class is actually a strong typing of the RkSize type
+ * \brief Entity ID class. This class is actually a strong typing of the RkUint64 type
  *
- * And entity ID is constant and valid for the whole application lifetime
- * or until the attached entity is deleted or moved into another archetype
- * (which should almost only happen when a scene is deleted/reloaded/loaded or
- * in the context of a non runtime app like an editor)
+ * An entity ID packs the index of the entity into the entity table of its entity admin (lower 32 bits)
+ * with the generation of this index (upper 32 bits). Indices of destroyed entities get recycled
+ * with a new generation, an ID thus stays unique and can be checked for staleness (see EntityAdmin::IsAlive)
+ * even after its entity has been destroyed.
+ *
+ * The ID of an entity remains the same if the entity is moved into another archetype.
+ * A default constructed ID never refers to an entity.
  */
-struct EntityID : public NamedType <RkSize, EntityID>,
-                  public Comparison<EntityID>,
-                  public Decrement <EntityID>,
-                  public Increment <EntityID>
+struct EntityID : public NamedType <RkUint64, EntityID>,
+                  public Comparison<EntityID>
 {
     using NamedType::NamedType;
+
+    /**
+     * \brief Creates an entity ID
+     * \param in_index Index of the entity into the entity table
+     * \param in_generation Generation of the index
+     * \return Entity ID
+     */
+    [[nodiscard]]
+    static constexpr EntityID Create(RkUint32 in_index, RkUint32 in_generation) noexcept;
+
+    /**
+     * \brief Returns the index of the entity into the entity table
+     * \return Entity index
+     */
+    [[nodiscard]]
+    constexpr RkUint32 GetIndex() const noexcept;
+
+    /**
+     * \brief Returns the generation of the entity index
+     * \return Generation, never 0 for a valid ID
+     */
+    [[nodiscard]]
+    constexpr RkUint32 GetGeneration() const noexcept;
 };
 
+#include "ECS/EntityID.inl"
+
 END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/EntityID.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Contiguous range of entity IDs, returned by the bulk creation of entities (see EntityAdmin::CreateEntities).
+ *
+ * Entities of a range have consecutive indices and share the same generation,
+ * the range is thus stored as its first ID and its size only.
+ */
+class EntityRange
+{
+    private:
+
+        #pragma region Members
+
+        EntityID m_first;
+        RkSize   m_size;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Entity range constructor
+         * \param in_first First ID of the range
+         * \param in_size Number of IDs in the range
+         */
+        constexpr EntityRange(EntityID in_first, RkSize in_size) noexcept;
+
+        constexpr EntityRange(EntityRange const& in_copy) = default;
+        constexpr EntityRange(EntityRange&&      in_move) = default;
+        ~EntityRange()                                    = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the number of IDs in the range
+         * \return Range size
+         */
+        [[nodiscard]]
+        constexpr RkSize Size() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        /**
+         * \brief Returns an ID of the range
+         * \param in_index Index of the ID into the range, must be lower than Size()
+         * \return Entity ID
+         */
+        [[nodiscard]]
+        constexpr EntityID operator[](RkSize in_index) const noexcept;
+
+        constexpr EntityRange& operator=(EntityRange const& in_copy) = default;
+        constexpr EntityRange& operator=(EntityRange&&      in_move) = default;
+
+        #pragma endregion
+};
+
+#include "ECS/EntityRange.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
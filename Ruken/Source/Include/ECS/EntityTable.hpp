@@ -0,0 +1,188 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/EntityID.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class Archetype;
+
+/**
+ * \brief Location of an entity: its archetype, and its row into that archetype
+ */
+struct EntityLocation
+{
+    Archetype* archetype;
+    RkSize     row;
+};
+
+/**
+ * \brief Sparse table resolving entity IDs into entity locations.
+ *
+ * Every entity owns a slot of the table, indexed by EntityID::GetIndex.
+ * Destroying an entity bumps the generation of its slot, outdating every existing ID referring to it,
+ * then pushes the slot into a free list which is used by the next entities to create.
+ * Creating, resolving or destroying an entity is thus O(1), and stale IDs are detected by comparing generations.
+ */
+class EntityTable
+{
+    private:
+
+        struct Slot
+        {
+            EntityLocation location;
+            RkUint32       generation;
+            RkUint32       next_free;
+        };
+
+        static constexpr RkUint32 invalid_index = 0xFFFFFFFFu;
+
+        #pragma region Members
+
+        std::vector<Slot> m_slots;
+        RkUint32          m_free_head;
+        RkSize            m_alive_count;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        EntityTable() noexcept;
+        EntityTable(EntityTable const& in_copy) = default;
+        EntityTable(EntityTable&&      in_move) = default;
+        ~EntityTable()                          = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Creates an entity, recycling the slot of a destroyed entity if possible
+         * \param in_location Location of the new entity
+         * \return ID of the new entity
+         */
+        EntityID Create(EntityLocation const& in_location) noexcept;
+
+        /**
+         * \brief Creates entities with contiguous IDs, always using new slots.
+         *        The entities are located at consecutive rows of the same archetype
+         * \param in_location Location of the first entity
+         * \param in_count Number of entities to create
+         * \return ID of the first entity, the IDs of the next ones follow it (see EntityRange)
+         */
+        EntityID CreateRange(EntityLocation const& in_location, RkSize in_count) noexcept;
+
+        /**
+         * \brief Destroys an entity, its ID and every copy of it become stale
+         * \param in_entity Alive entity to destroy
+         */
+        RkVoid Destroy(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Checks if an ID refers to an alive entity
+         * \param in_entity Entity ID, possibly stale
+         * \return True if the entity is alive, false if it has been destroyed or if the ID is invalid
+         */
+        [[nodiscard]]
+        RkBool IsAlive(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Returns the location of an entity
+         * \param in_entity Alive entity
+         * \return Entity location
+         */
+        [[nodiscard]]
+        EntityLocation const& GetLocation(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Updates the location of an entity, after it has been moved
+         * \param in_entity Alive entity
+         * \param in_location New location
+         */
+        RkVoid SetLocation(EntityID in_entity, EntityLocation const& in_location) noexcept;
+
+        /**
+         * \brief Returns the number of alive entities
+         * \return Entities count
+         */
+        [[nodiscard]]
+        RkSize GetAliveCount() const noexcept;
+
+        /**
+         * \brief Returns the number of slots of the table, either used or free
+         * \return Slots count
+         */
+        [[nodiscard]]
+        RkSize GetSlotsCount() const noexcept;
+
+        /**
+         * \brief Returns the generation of a slot: the generation of its entity, or of the next entity using it if the slot is free
+         * \param in_index Index of the slot
+         * \return Generation
+         */
+        [[nodiscard]]
+        RkUint32 GetGeneration(RkUint32 in_index) const noexcept;
+
+        /**
+         * \brief Replaces every slot by free slots, used to restore the table from a snapshot (see EntityAdmin::Load).
+         *        The entities are then restored one by one (see Restore), and the free list rebuilt (see RebuildFreeList)
+         * \param in_generations Generation of every slot
+         * \param in_count Number of slots
+         * \warning Every entity of the table is lost, their IDs must not be used anymore
+         */
+        RkVoid Reset(RkUint32 const* in_generations, RkSize in_count) noexcept;
+
+        /**
+         * \brief Restores an entity into its slot, which must be free and have the same generation, see Reset
+         * \param in_entity Entity to restore
+         * \param in_location Location of the entity
+         */
+        RkVoid Restore(EntityID in_entity, EntityLocation const& in_location) noexcept;
+
+        /**
+         * \brief Links every free slot into the free list, once every entity has been restored. Lower indices are reused first
+         */
+        RkVoid RebuildFreeList() noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        EntityTable& operator=(EntityTable const& in_copy) = default;
+        EntityTable& operator=(EntityTable&&      in_move) = default;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,131 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "ECS/ComponentAccess.hpp"
+#include "Containers/SOA/DataLayout.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Field of the value of a shared component, see SharedComponent
+ */
+template <typename TType>
+using SharedComponentField = TType const*;
+
+/**
+ * \brief A shared component holds a single value for every entity of an archetype.
+ *
+ * Entities owning the same shared components but different values are stored into different archetypes,
+ * the value of a shared component is thus stored once per archetype instead of once per entity (see SharedComponentTable).
+ * Systems read it once per range, every entity of a range sharing the same value: rendering every entity of a material is a matter
+ * of iterating over the ranges of the archetypes of this material, without any per entity indirection.
+ *
+ * A shared component instance is a read only view over the value of an archetype.
+ * Values are changed per entity with EntityAdmin::SetSharedComponent, which moves the entity into the archetype of the new value.
+ *
+ * \tparam TItem Associated item of the component, must be a subtype of ComponentItem
+ * \tparam TUniqueId Unique ID of the component, shared with the other components, see Component
+ */
+template <typename TItem, RkSize TUniqueId>
+class SharedComponent
+{
+     RUKEN_STATIC_ASSERT(TUniqueId < RUKEN_MAX_ECS_COMPONENTS, "Please increate the maximum amount of ECS components to run this program.");
+
+    private:
+
+        #pragma region Members
+
+        // Fields of the viewed value
+        typename TItem::template RebindLayout<SharedComponentField>::ContainerType m_value;
+
+        #pragma endregion
+
+    public:
+
+        using Layout = typename TItem::template RebindLayout<SharedComponentField>;
+        using Item   = TItem;
+
+        static constexpr RkSize id     = TUniqueId;
+        static constexpr RkBool shared = true;
+        static constexpr RkBool sparse = false;
+
+        #pragma region Constructors
+
+        /**
+         * \brief Shared component constructor
+         * \param in_value Fields of the value
+         */
+        explicit SharedComponent(typename Layout::ContainerType const& in_value) noexcept;
+
+        SharedComponent(SharedComponent const& in_copy) = default;
+        SharedComponent(SharedComponent&&      in_move) = default;
+        ~SharedComponent()                              = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns a field of the value
+         * \tparam TMember Index of the field in the component item
+         * \return Field, shared by every entity of the archetype
+         */
+        template <RkSize TMember>
+        [[nodiscard]]
+        auto const& Get() const noexcept;
+
+        /**
+         * \brief Returns a copy of the value
+         * \return Component item
+         */
+        [[nodiscard]]
+        TItem GetItem() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SharedComponent& operator=(SharedComponent const& in_copy) = default;
+        SharedComponent& operator=(SharedComponent&&      in_move) = default;
+
+        #pragma endregion
+};
+
+/**
+ * \brief Shorthand to declare a shared component alias named "<in_component_name>Component"
+ * \note The component item must be named "<in_component_name>ComponentItem"
+ * \param in_component_table Component table enum, see RUKEN_DEFINE_COMPONENT
+ * \param in_component_name Name of the component as described in the above component table enum
+ */
+#define RUKEN_DEFINE_SHARED_COMPONENT(in_component_table, in_component_name)\
+    using in_component_name##Component = SharedComponent<in_component_name##ComponentItem, static_cast<RkSize>(in_component_table::in_component_name)>
+
+#include "ECS/SharedComponent.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
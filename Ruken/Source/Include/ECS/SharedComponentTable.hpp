@@ -0,0 +1,173 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "Types/FundamentalTypes.hpp"
+#include "Containers/AlignedVector.hpp"
+
+#include "ECS/ComponentAccess.hpp"
+#include "ECS/ComponentDescriptor.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Stores the values of the shared components (see SharedComponent) and the singletons of an entity admin.
+ *
+ * Values of the shared components are interned: equal values are stored once, at an address which never changes.
+ * Archetypes are then identified by their fingerprint and the addresses of their shared values (see EntityAdmin::GetArchetype),
+ * and read their values without any lookup. Values are laid out field after field (see ComponentDescriptor::GetItemSize)
+ * and are kept until the destruction of the table.
+ *
+ * Singletons are components stored once per entity admin, such as the camera or the time step of a world.
+ * Systems access them like any other component (see ComponentSystemBase::SetupSingletons).
+ */
+class SharedComponentTable
+{
+    private:
+
+        /**
+         * \brief Interned value of a shared component
+         */
+        struct Value
+        {
+            RkSize                 hash;
+            AlignedVector<RkUint8> item;
+        };
+
+        #pragma region Members
+
+        // Interned values, indexed by component id
+        std::array<std::vector<Value>, RUKEN_MAX_ECS_COMPONENTS> m_values;
+
+        // Singletons, indexed by component id
+        std::array<std::shared_ptr<RkVoid>, RUKEN_MAX_ECS_COMPONENTS> m_singletons;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        template <typename TComponent, RkSize... TIds>
+        RkUint8 const* InternHelper(typename TComponent::Item const& in_item, std::index_sequence<TIds...>) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        SharedComponentTable()                                    = default;
+        SharedComponentTable(SharedComponentTable const& in_copy) = delete;
+        SharedComponentTable(SharedComponentTable&&      in_move) = delete;
+        ~SharedComponentTable()                                   = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the interned copy of a value of a shared component, interning it if needed
+         * \param in_component Descriptor of the shared component
+         * \param in_fields Fields of the value, packed one after the other in declaration order
+         * \return Interned value, laid out field after field. Equal values always return the same address
+         */
+        [[nodiscard]]
+        RkUint8 const* Intern(ComponentDescriptor const& in_component, RkUint8 const* in_fields) noexcept;
+
+        /**
+         * \brief Returns the interned copy of the default value of a shared component
+         * \param in_component Descriptor of the shared component
+         * \return Interned value
+         */
+        [[nodiscard]]
+        RkUint8 const* Intern(ComponentDescriptor const& in_component) noexcept;
+
+        /**
+         * \brief Returns the interned copy of a value of a shared component
+         * \tparam TComponent Shared component
+         * \param in_item Value
+         * \return Interned value
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        RkUint8 const* Intern(typename TComponent::Item const& in_item) noexcept;
+
+        /**
+         * \brief Returns the number of distinct values of a shared component
+         * \param in_component_id Unique id of the shared component
+         * \return Values count
+         */
+        [[nodiscard]]
+        RkSize GetValuesCount(RkSize in_component_id) const noexcept;
+
+        /**
+         * \brief Sets the value of a singleton, creating it if needed
+         * \tparam TComponent Component identifying the singleton
+         * \param in_item New value
+         */
+        template <typename TComponent>
+        RkVoid SetSingleton(typename TComponent::Item const& in_item) noexcept;
+
+        /**
+         * \brief Returns a singleton
+         * \tparam TComponent Component identifying the singleton, const qualified if the singleton is only read
+         * \return Value of the singleton, which must have been set. Const if the component is const qualified
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        auto& GetSingleton() const noexcept;
+
+        /**
+         * \brief Checks if a singleton has been set
+         * \tparam TComponent Component identifying the singleton
+         * \return True if the singleton exists
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        RkBool HasSingleton() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SharedComponentTable& operator=(SharedComponentTable const& in_copy) = delete;
+        SharedComponentTable& operator=(SharedComponentTable&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+#include "ECS/SharedComponentTable.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
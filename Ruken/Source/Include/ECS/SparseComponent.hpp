@@ -0,0 +1,154 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "ECS/EntityID.hpp"
+#include "ECS/SparseSet.hpp"
+#include "ECS/ComponentAccess.hpp"
+#include "Containers/SOA/DataLayout.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Dense column of a sparse component field, see SparseComponent
+ */
+template <typename TType>
+using SparseComponentColumn = TType*;
+
+/**
+ * \brief A sparse component is stored into a sparse set keyed by entity instead of the columns of the archetypes (see SparseSet).
+ *
+ * Adding or removing a sparse component never moves the entity into another archetype: both are O(1) and leave the archetypes untouched.
+ * Sparse components thus fit the tags toggled every frame (visibility, dirty flags...), which would otherwise keep migrating entities between archetypes.
+ * The price is paid by the systems: the entities of the matching archetypes are intersected with the sparse sets row by row (see ComponentQuery::ForEachRange)
+ * and every access to a sparse item goes through the sparse array of its set.
+ *
+ * The storage strategy of a component is chosen at compile time, by declaring it with RUKEN_DEFINE_SPARSE_COMPONENT instead of RUKEN_DEFINE_COMPONENT.
+ *
+ * A sparse component instance is a view over the items of the entities of a chunk, indexed by their row into the chunk like any other component.
+ *
+ * \tparam TItem Associated item of the component, must be a subtype of ComponentItem
+ * \tparam TUniqueId Unique ID of the component, shared with the other components, see Component
+ */
+template <typename TItem, RkSize TUniqueId>
+class SparseComponent
+{
+     RUKEN_STATIC_ASSERT(TUniqueId < RUKEN_MAX_ECS_COMPONENTS, "Please increate the maximum amount of ECS components to run this program.");
+
+    private:
+
+        #pragma region Members
+
+        // Dense columns of the set, and entity column of the viewed chunk
+        typename TItem::template RebindLayout<SparseComponentColumn>::ContainerType m_storage;
+        SparseSet const*                                                            m_set;
+        EntityID const*                                                             m_entities;
+
+        #pragma endregion
+
+    public:
+
+        using Layout = typename TItem::template RebindLayout<SparseComponentColumn>;
+        using Item   = TItem;
+        using ItemId = RkSize;
+
+        static constexpr RkSize id     = TUniqueId;
+        static constexpr RkBool shared = false;
+        static constexpr RkBool sparse = true;
+
+        #pragma region Constructors
+
+        /**
+         * \brief Sparse component constructor
+         * \param in_storage Dense columns of the set, one per field of the item
+         * \param in_set Sparse set storing the component
+         * \param in_entities Entity column of the viewed chunk, see Archetype::GetEntities
+         */
+        SparseComponent(typename Layout::ContainerType const& in_storage, SparseSet const& in_set, EntityID const* in_entities) noexcept;
+
+        SparseComponent(SparseComponent const& in_copy) = default;
+        SparseComponent(SparseComponent&&      in_move) = default;
+        ~SparseComponent()                              = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns a view over some fields of the item of an entity
+         * \tparam TView View type, see ComponentItem::MakeView and ComponentItem::FullView
+         * \param in_item_id Row of the entity into the chunk, the entity must own the component
+         * \return View instance containing references to the fields of the item
+         */
+        template <typename TView>
+        [[nodiscard]]
+        auto GetItem(ItemId in_item_id) noexcept;
+
+        /**
+         * \brief Overwrites every field of the item of an entity
+         * \param in_item_id Row of the entity into the chunk, the entity must own the component
+         * \param in_item New value of the item
+         */
+        RkVoid SetItem(ItemId in_item_id, TItem const& in_item) noexcept;
+
+        /**
+         * \brief Returns a field of the item of an entity
+         * \tparam TMember Index of the field in the component item
+         * \param in_item_id Row of the entity into the chunk, the entity must own the component
+         * \return Field reference
+         */
+        template <RkSize TMember>
+        [[nodiscard]]
+        auto& Get(ItemId in_item_id) noexcept;
+
+        template <RkSize TMember>
+        [[nodiscard]]
+        auto const& Get(ItemId in_item_id) const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SparseComponent& operator=(SparseComponent const& in_copy) = default;
+        SparseComponent& operator=(SparseComponent&&      in_move) = default;
+
+        #pragma endregion
+};
+
+/**
+ * \brief Shorthand to declare a sparse component alias named "<in_component_name>Component"
+ * \note The component item must be named "<in_component_name>ComponentItem"
+ * \param in_component_table Component table enum, see RUKEN_DEFINE_COMPONENT
+ * \param in_component_name Name of the component as described in the above component table enum
+ */
+#define RUKEN_DEFINE_SPARSE_COMPONENT(in_component_table, in_component_name)\
+    using in_component_name##Component = SparseComponent<in_component_name##ComponentItem, static_cast<RkSize>(in_component_table::in_component_name)>
+
+#include "ECS/SparseComponent.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
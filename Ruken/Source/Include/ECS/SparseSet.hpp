@@ -0,0 +1,196 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/EntityID.hpp"
+#include "ECS/ComponentDescriptor.hpp"
+#include "Containers/AlignedVector.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Stores a sparse component (see SparseComponent) for a subset of the entities of an entity admin.
+ *
+ * Entities owning the component are packed into dense arrays: their IDs, then one column per field of the component.
+ * The sparse array maps the index of an entity (see EntityID::GetIndex) to its position into the dense arrays,
+ * it is split into pages of RUKEN_ECS_SPARSE_PAGE_SIZE entries allocated on demand.
+ *
+ * Adding, removing and looking up an entity are O(1): removing an entity moves the last entity of the dense arrays into its position.
+ * The dense arrays are thus unordered, and positions are only stable until the next removal.
+ *
+ * \note The entity admin removes destroyed entities from every sparse set, the entry of an index thus always belongs to the alive entity of this index
+ */
+class SparseSet
+{
+    private:
+
+        static constexpr RkSize   page_size     = RUKEN_ECS_SPARSE_PAGE_SIZE;
+        static constexpr RkUint32 invalid_index = ~RkUint32(0u);
+
+        RUKEN_STATIC_ASSERT((page_size & (page_size - 1u)) == 0u, "The page size of the sparse sets must be a power of 2");
+
+        #pragma region Members
+
+        // Descriptor of the stored component, owned by the entity admin
+        ComponentDescriptor const* m_component;
+
+        // Dense position of every entity index, empty pages have no entity
+        std::vector<std::vector<RkUint32>> m_pages;
+
+        // Dense arrays
+        std::vector<EntityID>               m_entities;
+        std::vector<AlignedVector<RkUint8>> m_columns;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        template <typename TComponent, RkSize... TIds>
+        TComponent GetComponentHelper(EntityID const* in_entities, std::index_sequence<TIds...>) const noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        SparseSet() noexcept;
+
+        SparseSet(SparseSet const& in_copy) = delete;
+        SparseSet(SparseSet&&      in_move) = default;
+        ~SparseSet()                        = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Clears the set and sets up its columns
+         * \param in_component Descriptor of the stored component, must outlive the set
+         */
+        RkVoid Reset(ComponentDescriptor const& in_component) noexcept;
+
+        /**
+         * \brief Adds an entity to the set, every field being default initialized
+         * \param in_entity Alive entity
+         * \return True if the entity has been added, false if it already was in the set
+         */
+        RkBool Add(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Removes an entity from the set
+         * \param in_entity Entity to remove
+         * \return True if the entity has been removed, false if it was not in the set
+         */
+        RkBool Remove(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Checks if an entity is in the set
+         * \param in_entity Entity ID, possibly stale
+         * \return True if this very entity is in the set
+         */
+        [[nodiscard]]
+        RkBool Contains(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Checks if the alive entity of an index is in the set, without reading the dense arrays
+         * \param in_index Index of an alive entity, see EntityID::GetIndex
+         * \return True if the entity is in the set
+         */
+        [[nodiscard]]
+        RkBool ContainsIndex(RkUint32 in_index) const noexcept;
+
+        /**
+         * \brief Checks which entities of a block are in the set, without reading the dense arrays.
+         *        Used to intersect the entities of the archetypes with the set, see ComponentQuery::ForEachRange
+         * \param in_entities Alive entities
+         * \param in_count Number of entities, 64 at most
+         * \return Bit mask of the entities in the set, bit i standing for the entity i
+         */
+        [[nodiscard]]
+        RkUint64 MatchEntities(EntityID const* in_entities, RkSize in_count) const noexcept;
+
+        /**
+         * \brief Returns the position of an entity into the dense arrays
+         * \param in_index Index of an entity of the set, see EntityID::GetIndex
+         * \return Dense position, valid until the next removal
+         */
+        [[nodiscard]]
+        RkSize GetDenseIndex(RkUint32 in_index) const noexcept;
+
+        /**
+         * \brief Returns the number of entities in the set
+         * \return Entities count
+         */
+        [[nodiscard]]
+        RkSize GetSize() const noexcept;
+
+        /**
+         * \brief Returns the entities of the set
+         * \return Dense array of GetSize() entities, in no particular order
+         */
+        [[nodiscard]]
+        EntityID const* GetEntities() const noexcept;
+
+        /**
+         * \brief Returns the dense column of a field
+         * \param in_field Index of the field in the component item
+         * \return Column of GetSize() values, indexed like GetEntities()
+         */
+        [[nodiscard]]
+        RkUint8* GetColumn(RkSize in_field) const noexcept;
+
+        /**
+         * \brief Returns a view over the component of the entities of a chunk, see SparseComponent
+         * \tparam TComponent Stored component
+         * \param in_entities Entity column of the chunk, see Archetype::GetEntities
+         * \return Sparse component instance
+         */
+        template <typename TComponent>
+        [[nodiscard]]
+        TComponent GetComponent(EntityID const* in_entities) const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SparseSet& operator=(SparseSet const& in_copy) = delete;
+        SparseSet& operator=(SparseSet&&      in_move) = default;
+
+        #pragma endregion
+};
+
+#include "ECS/SparseSet.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,412 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <utility>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "Vector/Vector.hpp"
+
+#include "ECS/EntityID.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class Scheduler;
+
+/**
+ * \brief Hashed grid of entity positions, answering radius and nearest neighbour queries.
+ *
+ * Space is divided into cubic cells of a fixed size, only the cells holding entities are stored and looked up by the hash of their coordinates.
+ * Cells are spread over shards (see RUKEN_ECS_SPATIAL_INDEX_SHARDS), every shard owning its own hash table and memory:
+ * entities moving between cells are thus applied to every shard in parallel.
+ *
+ * The positions of a cell are stored into blocks of 16 entities, by groups of 4 entities laid out coordinate after coordinate:
+ * queries test the entities of a group at once (see RUKEN_ECS_ENABLE_SIMD_SPATIAL_QUERIES). Unused lanes hold unreachable positions and never match.
+ * Queries look up several cells at a time, the memory accesses of the lookups then overlap.
+ *
+ * Positions are updated by batches (see BeginUpdate): entities staying in their cell are updated in place and concurrently,
+ * the others are moved between cells once every batch has been processed. See SpatialIndexSystem to index the entities of an entity admin.
+ *
+ * \note Cells emptied by the updates are kept until the index gets cleared, queries skip them
+ */
+class SpatialIndex
+{
+    public:
+
+        /**
+         * \brief Sphere of a radius query
+         */
+        struct Sphere
+        {
+            Vector3f center;
+            RkFloat  radius;
+        };
+
+        /**
+         * \brief Entities found by a batch of queries, see QueryRadius
+         */
+        struct QueryResults
+        {
+            // Entities of the query i are entities[offsets[i]] to entities[offsets[i + 1]], in no particular order
+            std::vector<RkSize>   offsets;
+            std::vector<EntityID> entities;
+
+            // Entities found by every job, kept between batches to avoid reallocating them
+            std::vector<std::vector<EntityID>> jobs;
+        };
+
+    private:
+
+        static constexpr RkSize   block_size    = 16u;
+        static constexpr RkSize   group_size    = 4u;
+        static constexpr RkSize   shards_count  = RUKEN_ECS_SPATIAL_INDEX_SHARDS;
+        static constexpr RkUint32 invalid_index = ~RkUint32(0u);
+        static constexpr RkUint64 empty_key     = ~RkUint64(0u);
+
+        // Number of queries of a batch processed by a single job
+        static constexpr RkSize query_grain = 64u;
+
+        // Number of cells looked up at once by a query, the cache misses of their lookups then overlap
+        static constexpr RkSize cells_batch = 32u;
+
+        // Number of entities ahead of the current one whose position is prefetched while updating a batch
+        static constexpr RkSize prefetch_distance = 8u;
+
+        // Minimum number of entities moving between cells for the shards to be updated in parallel
+        static constexpr RkSize parallel_moves = 4096u;
+
+        RUKEN_STATIC_ASSERT((shards_count & (shards_count - 1u)) == 0u, "The number of shards of the spatial indices must be a power of 2");
+
+        /**
+         * \brief Positions of 4 entities, tested at once by the queries
+         */
+        struct Group
+        {
+            RkFloat x[group_size];
+            RkFloat y[group_size];
+            RkFloat z[group_size];
+        };
+
+        /**
+         * \brief Positions of up to 16 entities of a cell, blocks of a cell are linked in insertion order.
+         *        Groups keep the coordinates of an entity close to each other, updating a position thus touches a single cache line most of the time
+         */
+        struct alignas(RUKEN_CONTAINERS_SIMD_ALIGNMENT) Block
+        {
+            Group    groups  [block_size / group_size];
+            EntityID entities[block_size];
+            RkUint32 previous;
+            RkUint32 next;
+        };
+
+        /**
+         * \brief Cell of a shard, entities fill the blocks of the cell in order: only the last block may be partially filled
+         */
+        struct Cell
+        {
+            RkUint64 key; // empty_key for an empty slot of the hash table
+            RkUint32 first_block;
+            RkUint32 last_block;
+            RkUint32 count;
+        };
+
+        /**
+         * \brief Cells whose key hashes to the same shard
+         */
+        struct Shard
+        {
+            // Open addressing hash table of the cells, whose size is a power of 2
+            std::vector<Cell>     cells;
+            RkSize                cells_count;
+            std::vector<Block>    blocks;
+            std::vector<RkUint32> free_blocks;
+
+            // Moves of the current update leaving the shard and entering it, as indices into m_moves
+            std::vector<RkUint32> removals;
+            std::vector<RkUint32> insertions;
+        };
+
+        /**
+         * \brief Position of an entity in the index, indexed by entity index (see EntityID::GetIndex)
+         */
+        struct Location
+        {
+            EntityID entity; // Default constructed if the index isn't tracking any entity of this index
+            RkUint64 key;
+            RkUint32 block;
+            RkUint32 lane;
+        };
+
+        /**
+         * \brief Entity entering the index or moving to another cell
+         */
+        struct Move
+        {
+            EntityID entity;
+            Vector3f position;
+            RkUint64 key;
+        };
+
+        #pragma region Members
+
+        RkFloat m_cell_size;
+        RkFloat m_inverse_cell_size;
+        RkSize  m_size;
+
+        std::array<Shard, shards_count> m_shards;
+        std::vector<Location>           m_locations;
+
+        // Moves recorded by the batches of the current update, along with the (offset, count) of the moves of every batch
+        std::vector<Move>                      m_moves;
+        std::vector<std::pair<RkSize, RkSize>> m_batches;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the key of the cell containing a position
+         * \param in_position Position
+         * \return Cell key, packing the cell coordinates on 21 bits each
+         */
+        [[nodiscard]]
+        RkUint64 GetKey(Vector3f const& in_position) const noexcept;
+
+        /**
+         * \brief Returns the shard of a cell
+         * \param in_key Cell key
+         * \return Shard index
+         */
+        [[nodiscard]]
+        static RkSize GetShard(RkUint64 in_key) noexcept;
+
+        /**
+         * \brief Looks up the slot of a cell into the hash table of a shard
+         * \param in_shard Shard of the cell, whose table must not be empty
+         * \param in_key Cell key
+         * \return Slot of the cell, or empty slot ending its probe sequence if the cell has never been occupied
+         */
+        [[nodiscard]]
+        static RkSize FindSlot(Shard const& in_shard, RkUint64 in_key) noexcept;
+
+        /**
+         * \brief Looks up a cell, creating it if needed
+         * \param in_shard Shard of the cell
+         * \param in_key Cell key
+         * \return Cell, valid until the next cell is created into the shard
+         */
+        [[nodiscard]]
+        static Cell& FindOrCreateCell(Shard& in_shard, RkUint64 in_key) noexcept;
+
+        /**
+         * \brief Looks up several cells, prefetching their slots then their first block so that the cache misses of the lookups overlap
+         * \param in_keys Cell keys
+         * \param in_count Number of keys, cells_batch at most
+         * \param out_cells Occupied cells among the looked up ones, along with their shard
+         * \return Number of occupied cells
+         */
+        RkSize FindCells(RkUint64 const* in_keys, RkSize in_count, std::pair<Shard const*, Cell const*>* out_cells) const noexcept;
+
+        /**
+         * \brief Appends an entity to a cell, m_locations must already hold the index of the entity
+         * \param in_shard Shard of the cell
+         * \param in_entity Entity to insert, not tracked by the index
+         * \param in_position Position of the entity
+         * \param in_key Key of the cell containing the position
+         */
+        RkVoid Insert(Shard& in_shard, EntityID in_entity, Vector3f const& in_position, RkUint64 in_key) noexcept;
+
+        /**
+         * \brief Removes an entity from its cell, the last entity of the cell taking its place
+         * \param in_shard Shard of the cell of the entity
+         * \param in_location Location of the entity, reset by this method
+         */
+        RkVoid Erase(Shard& in_shard, Location& in_location) noexcept;
+
+        /**
+         * \brief Applies the removals or the insertions routed to a shard by EndUpdate
+         * \param in_shard Shard to update
+         * \param in_removals True to apply the removals, false to apply the insertions
+         */
+        RkVoid ApplyMoves(Shard& in_shard, RkBool in_removals) noexcept;
+
+        /**
+         * \brief Appends the entities of a block within a sphere
+         * \param in_block Block to test
+         * \param in_count Number of entities of the block
+         * \param in_sphere Query sphere
+         * \param out_entities Entities found
+         */
+        static RkVoid QueryBlock(Block const& in_block, RkSize in_count, Sphere const& in_sphere, std::vector<EntityID>& out_entities) noexcept;
+
+        /**
+         * \brief Looks for the nearest entity of a block
+         * \param in_block Block to test
+         * \param in_count Number of entities of the block
+         * \param in_position Query position
+         * \param inout_distance Squared distance of the nearest entity found so far, updated if an entity of the block is strictly nearer
+         * \param inout_entity Nearest entity found so far
+         */
+        static RkVoid FindNearestInBlock(Block const& in_block, RkSize in_count, Vector3f const& in_position, RkFloat& inout_distance, EntityID& inout_entity) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Creates an empty index
+         * \param in_cell_size Size of the cells, ideally in the order of the radius of the queries
+         */
+        explicit SpatialIndex(RkFloat in_cell_size) noexcept;
+
+        SpatialIndex(SpatialIndex const& in_copy) = delete;
+        SpatialIndex(SpatialIndex&&      in_move) = default;
+        ~SpatialIndex()                           = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Inserts an entity, or updates its position if it is already in the index
+         * \param in_entity Entity
+         * \param in_position Position of the entity
+         */
+        RkVoid Update(EntityID in_entity, Vector3f const& in_position) noexcept;
+
+        /**
+         * \brief Removes an entity from the index
+         * \param in_entity Entity to remove
+         * \return True if the entity has been removed, false if it was not in the index
+         */
+        RkBool Remove(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Removes every entity for which a predicate returns true
+         * \tparam TPredicate Predicate type, taking an EntityID and returning a RkBool
+         * \param in_predicate Predicate, called once for every entity of the index
+         * \return Number of removed entities
+         */
+        template <typename TPredicate>
+        RkSize RemoveIf(TPredicate&& in_predicate) noexcept;
+
+        /**
+         * \brief Removes every entity and cell
+         */
+        RkVoid Clear() noexcept;
+
+        /**
+         * \brief Prepares an update of the positions of several batches of entities, see UpdateBatch
+         * \param in_batches_count Number of batches of the update
+         * \param in_entities_count Total number of entities of the batches
+         */
+        RkVoid BeginUpdate(RkSize in_batches_count, RkSize in_entities_count) noexcept;
+
+        /**
+         * \brief Inserts the entities of a batch, or updates their positions if they are already in the index.
+         *        Entities staying in their cell are updated right away, the others once every batch has been processed (see EndUpdate).
+         *        Batches can be processed concurrently, as long as every entity belongs to a single batch
+         * \param in_batch Index of the batch
+         * \param in_offset Number of entities of the previous batches
+         * \param in_entities Entities of the batch
+         * \param in_positions Positions of the entities
+         * \param in_count Number of entities of the batch
+         */
+        RkVoid UpdateBatch(RkSize in_batch, RkSize in_offset, EntityID const* in_entities, Vector3f const* in_positions, RkSize in_count) noexcept;
+
+        /**
+         * \brief Moves the entities of the batches which changed of cell, every shard being updated in parallel if there are many of them
+         * \param in_scheduler Scheduler used to update the shards
+         */
+        RkVoid EndUpdate(Scheduler& in_scheduler) noexcept;
+
+        /**
+         * \brief Checks if an entity is in the index
+         * \param in_entity Entity to look for
+         * \return True if this very entity is in the index
+         */
+        [[nodiscard]]
+        RkBool Contains(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Appends the entities within a sphere
+         * \param in_sphere Query sphere, entities on its surface are included
+         * \param out_entities Entities found, in no particular order
+         */
+        RkVoid QueryRadius(Sphere const& in_sphere, std::vector<EntityID>& out_entities) const noexcept;
+
+        /**
+         * \brief Looks for the entities within several spheres, the queries being split between the workers of the scheduler
+         * \param in_scheduler Scheduler running the queries
+         * \param in_spheres Query spheres
+         * \param in_count Number of queries
+         * \param out_results Entities found by every query
+         */
+        RkVoid QueryRadius(Scheduler& in_scheduler, Sphere const* in_spheres, RkSize in_count, QueryResults& out_results) const noexcept;
+
+        /**
+         * \brief Looks for the nearest entity of a position
+         * \param in_position Query position
+         * \param in_max_distance Distance beyond which entities are ignored
+         * \return Nearest entity, or a default constructed ID if there is no entity within the maximum distance
+         */
+        [[nodiscard]]
+        EntityID FindNearest(Vector3f const& in_position, RkFloat in_max_distance) const noexcept;
+
+        /**
+         * \brief Returns the number of entities in the index
+         * \return Entities count
+         */
+        [[nodiscard]]
+        RkSize GetSize() const noexcept;
+
+        /**
+         * \brief Returns the size of the cells
+         * \return Cell size
+         */
+        [[nodiscard]]
+        RkFloat GetCellSize() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SpatialIndex& operator=(SpatialIndex const& in_copy) = delete;
+        SpatialIndex& operator=(SpatialIndex&&      in_move) = default;
+
+        #pragma endregion
+};
+
+#include "ECS/SpatialIndex.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
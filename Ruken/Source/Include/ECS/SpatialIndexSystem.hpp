@@ -0,0 +1,121 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Meta/Assert.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "ECS/Archetype.hpp"
+#include "ECS/SpatialIndex.hpp"
+#include "ECS/SystemJobContext.hpp"
+#include "ECS/ComponentSystemBase.hpp"
+
+#include "Threading/Scheduler.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief System indexing the positions of the entities owning a component, see SpatialIndex.
+ *
+ * Only the chunks in which the component changed since the last update of the system are processed (see SetupChangedFilter),
+ * every chunk being a batch of the update of the index: chunks are processed in parallel, then the entities which changed of cell are moved.
+ *
+ * Destroyed entities and entities which lost the component don't show up in the changed chunks:
+ * the entity admin records the entities leaving the archetypes (see ComponentSystemBase::SetupRemovedEntities),
+ * the ones which no longer match the query are then removed from the index one by one, without scanning it.
+ *
+ * \tparam TComponent Component storing the positions, see Component
+ * \tparam TMember Index of the position field in the component item, a Vector3f
+ *
+ * \note The index is written while the system is updated: it must be queried outside of EntityAdmin::UpdateSystems,
+ *       or by systems created after this one and conflicting with it, see ComponentAccess::ConflictsWith
+ */
+template <typename TComponent, RkSize TMember = 0u>
+class SpatialIndexSystem : public ComponentSystemBase
+{
+    RUKEN_STATIC_ASSERT(!TComponent::shared && !TComponent::sparse, "Indexed positions must be stored by the archetypes, see Component");
+    RUKEN_STATIC_ASSERT((std::is_same_v<typename TComponent::Item::template FieldType<TMember>, Vector3f>), "Indexed positions must be Vector3f fields");
+
+    private:
+
+        #pragma region Members
+
+        SpatialIndex m_index;
+
+        // Number of entities of the chunks processed before every chunk of the current update
+        std::vector<RkSize> m_offsets;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Creates the system, see EntityAdmin::CreateSystem
+         * \param in_cell_size Size of the cells of the index, see SpatialIndex
+         */
+        explicit SpatialIndexSystem(RkFloat in_cell_size) noexcept;
+
+        SpatialIndexSystem(SpatialIndexSystem const& in_copy) = delete;
+        SpatialIndexSystem(SpatialIndexSystem&&      in_move) = default;
+        virtual ~SpatialIndexSystem()                         = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the index of the positions, as of the last update of the system
+         * \return Spatial index
+         */
+        [[nodiscard]]
+        SpatialIndex const& GetIndex() const noexcept;
+
+        /**
+         * \brief Updates the positions of the entities of the changed chunks, and removes the entities which left the matching archetypes
+         * \param in_scheduler Scheduler used to process the chunks in parallel
+         */
+        RkVoid Update(Scheduler& in_scheduler) noexcept override;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SpatialIndexSystem& operator=(SpatialIndexSystem const& in_copy) = delete;
+        SpatialIndexSystem& operator=(SpatialIndexSystem&&      in_move) = default;
+
+        #pragma endregion
+};
+
+#include "ECS/SpatialIndexSystem.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
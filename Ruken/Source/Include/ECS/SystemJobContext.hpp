@@ -0,0 +1,64 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class ComponentAccess;
+
+/**
+ * \brief State of the system job running on the calling thread, set by the chunk jobs of the systems while they process their chunks.
+ *
+ * The context is stored as the data of the job (see Scheduler::SetJobData) rather than per thread:
+ * a job suspended by a ParallelFor or a WaitUntil keeps its context while its worker runs the chunks of other systems.
+ */
+struct SystemJobContext
+{
+    // Access of the system, see ComponentAccess::Validate
+    ComponentAccess const* access;
+
+    // Sort key of the commands recorded by the job, see EntityCommandBuffer
+    RkUint64 sort_key;
+
+    /**
+     * \brief Sets the context of the job running on the calling thread
+     * \param in_context Context, nullptr outside of the jobs of the systems
+     * \return Previous context of the job
+     */
+    static SystemJobContext const* SetCurrent(SystemJobContext const* in_context) noexcept;
+
+    /**
+     * \brief Returns the context of the job running on the calling thread
+     * \return Context, nullptr outside of the jobs of the systems
+     */
+    [[nodiscard]]
+    static SystemJobContext const* GetCurrent() noexcept;
+};
+
+END_RUKEN_NAMESPACE
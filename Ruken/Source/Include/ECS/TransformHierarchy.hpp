@@ -0,0 +1,260 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Build/Namespace.hpp"
+
+#include "Vector/Vector.hpp"
+
+#include "ECS/EntityID.hpp"
+#include "Types/FundamentalTypes.hpp"
+#include "Containers/SOA/DataLayoutItem.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class Scheduler;
+
+/**
+ * \brief Parent/child relationships of entities, along with their local and world transforms.
+ *
+ * Nodes are stored into aligned SOA columns (see DataLayoutItem::AlignedLayout), sorted breadth first:
+ * every level of the hierarchy is a contiguous range of nodes, children being grouped by parent in the order of their parents.
+ * A node thus always comes after its parent and refers to it by index, without any pointer.
+ *
+ * World transforms are computed by Propagate, one level after the other, every level being processed in parallel.
+ * Only the dirty subtrees are recomputed: nodes whose local transform changed since the last propagation, and their descendants.
+ *
+ * Structural changes (Add, SetParent, Remove) only flag the hierarchy, it is sorted again by the next propagation.
+ *
+ * \note World scales are the component-wise products of the local scales, non uniform scales under rotations are thus not sheared
+ */
+class TransformHierarchy
+{
+    public:
+
+        /**
+         * \brief Local or world transform of a node
+         */
+        struct Transform
+        {
+            Vector3f position;
+            Vector4f rotation; // Unit quaternion, (x, y, z, w)
+            Vector3f scale;
+
+            /**
+             * \brief Returns the identity transform
+             * \return Identity transform
+             */
+            [[nodiscard]]
+            static Transform Identity() noexcept;
+        };
+
+        // Index of a node in the columns
+        using NodeIndex = RkUint32;
+
+        static constexpr NodeIndex invalid_node = ~NodeIndex(0u);
+
+    private:
+
+        // Entity, parent node, local transform, world transform, dirty flag
+        using NodeItem = DataLayoutItem<AlignedVector, EntityID, NodeIndex,
+                                        Vector3f, Vector4f, Vector3f,
+                                        Vector3f, Vector4f, Vector3f,
+                                        RkUint8>;
+
+        using Layout = NodeItem::AlignedLayout;
+
+        static constexpr RkSize entity_column         = 0u;
+        static constexpr RkSize parent_column         = 1u;
+        static constexpr RkSize local_position_column = 2u;
+        static constexpr RkSize local_rotation_column = 3u;
+        static constexpr RkSize local_scale_column    = 4u;
+        static constexpr RkSize world_position_column = 5u;
+        static constexpr RkSize world_rotation_column = 6u;
+        static constexpr RkSize world_scale_column    = 7u;
+        static constexpr RkSize dirty_column          = 8u;
+
+        // Minimum number of nodes of a level processed by a single job
+        static constexpr RkSize propagation_grain = 2048u;
+
+        #pragma region Members
+
+        Layout::ContainerType  m_nodes;
+        std::vector<NodeIndex> m_nodes_of_entities;
+        std::vector<RkSize>    m_levels;
+        RkSize                 m_removed_count;
+        RkSize                 m_dirty_count;
+        RkBool                 m_sorted;
+
+        // Scratch memory of the sort, kept between sorts to avoid reallocating it
+        Layout::ContainerType  m_sorted_nodes;
+        std::vector<NodeIndex> m_order;
+        std::vector<NodeIndex> m_children;
+        std::vector<NodeIndex> m_children_offsets;
+        std::vector<NodeIndex> m_sorted_indices;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the node of an entity
+         * \param in_entity Entity, which must be part of the hierarchy
+         * \return Node index
+         */
+        [[nodiscard]]
+        NodeIndex GetNode(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Flags a node as dirty, its world transform and the ones of its descendants will be recomputed by the next propagation
+         * \param in_node Node to flag
+         */
+        RkVoid MarkDirty(NodeIndex in_node) noexcept;
+
+        /**
+         * \brief Sorts the nodes breadth first, drops the removed nodes and rebuilds the levels
+         */
+        RkVoid Sort() noexcept;
+
+        /**
+         * \brief Computes the world transforms of the nodes of a range which are dirty or whose parent is dirty.
+         *        Recomputed nodes are flagged as dirty in turn, for their own children
+         * \param in_begin First node of the range
+         * \param in_end Node past the last node of the range
+         * \note The range must be within a single level, whose parent level has already been processed
+         */
+        RkVoid PropagateRange(RkSize in_begin, RkSize in_end) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        TransformHierarchy() noexcept;
+
+        TransformHierarchy(TransformHierarchy const& in_copy) = delete;
+        TransformHierarchy(TransformHierarchy&&      in_move) = default;
+        ~TransformHierarchy()                                 = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Adds an entity to the hierarchy
+         * \param in_entity Entity to add, must not be part of the hierarchy already
+         * \param in_local Transform of the entity relative to its parent
+         * \param in_parent Parent of the entity, which must be part of the hierarchy. A default constructed ID adds the entity as a root
+         */
+        RkVoid Add(EntityID in_entity, Transform const& in_local, EntityID in_parent = EntityID()) noexcept;
+
+        /**
+         * \brief Removes an entity from the hierarchy, its children become roots
+         * \param in_entity Entity to remove, must be part of the hierarchy
+         */
+        RkVoid Remove(EntityID in_entity) noexcept;
+
+        /**
+         * \brief Changes the parent of an entity, the local transform of the entity is kept
+         * \param in_entity Entity to move, must be part of the hierarchy
+         * \param in_parent New parent, which must be part of the hierarchy and must not be a descendant of the entity.
+         *                  A default constructed ID turns the entity into a root
+         */
+        RkVoid SetParent(EntityID in_entity, EntityID in_parent) noexcept;
+
+        /**
+         * \brief Checks if an entity is part of the hierarchy
+         * \param in_entity Entity to look for
+         * \return True if the entity has been added and not removed since
+         */
+        [[nodiscard]]
+        RkBool Contains(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Returns the parent of an entity
+         * \param in_entity Entity, which must be part of the hierarchy
+         * \return Parent, or a default constructed ID for a root
+         */
+        [[nodiscard]]
+        EntityID GetParent(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Sets the transform of an entity relative to its parent
+         * \param in_entity Entity, which must be part of the hierarchy
+         * \param in_local New local transform
+         */
+        RkVoid SetLocalTransform(EntityID in_entity, Transform const& in_local) noexcept;
+
+        /**
+         * \brief Returns the transform of an entity relative to its parent
+         * \param in_entity Entity, which must be part of the hierarchy
+         * \return Local transform
+         */
+        [[nodiscard]]
+        Transform GetLocalTransform(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Returns the world transform of an entity, as computed by the last propagation
+         * \param in_entity Entity, which must be part of the hierarchy
+         * \return World transform
+         */
+        [[nodiscard]]
+        Transform GetWorldTransform(EntityID in_entity) const noexcept;
+
+        /**
+         * \brief Recomputes the world transforms of the dirty subtrees, level by level.
+         *        Every level is split between the workers of the scheduler, see Scheduler::ParallelFor
+         * \param in_scheduler Scheduler running the propagation
+         */
+        RkVoid Propagate(Scheduler& in_scheduler) noexcept;
+
+        /**
+         * \brief Returns the number of entities in the hierarchy
+         * \return Entities count
+         */
+        [[nodiscard]]
+        RkSize GetSize() const noexcept;
+
+        /**
+         * \brief Returns the number of levels of the hierarchy, as of the last propagation
+         * \return Levels count, roots being the first level
+         */
+        [[nodiscard]]
+        RkSize GetLevelsCount() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        TransformHierarchy& operator=(TransformHierarchy const& in_copy) = delete;
+        TransformHierarchy& operator=(TransformHierarchy&&      in_move) = default;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,100 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Binary layout of the snapshots of the entities of an entity admin, see EntityAdmin::Save and EntityAdmin::Load.
+ *
+ * A snapshot is made of the following sections, each one starting on a section_alignment boundary:
+ * - A Header.
+ * - The descriptor of every component: a ComponentHeader, a FieldHeader per field, then the default values of the fields packed one after the other.
+ * - The generation of every slot of the entity table (RkUint32, never 0), stale IDs thus remain stale once the snapshot is loaded.
+ * - The archetypes: an ArchetypeHeader, the ids of its components by increasing id (RkUint32),
+ *   then the values of its shared components by increasing id, their fields packed one after the other.
+ *   The columns of the archetype follow, each column being a contiguous block of entities_count values
+ *   starting on a column_alignment boundary: entity IDs first, then every field of every non shared component by increasing component id.
+ * - The sparse sets (see SparseSet): a SparseSetHeader, then the dense columns of the set laid out like the columns of the archetypes,
+ *   entity IDs first then every field of the component.
+ *
+ * Columns are raw copies of the columns of the chunks, values are thus stored in native byte order.
+ * Archetypes are loaded with a single copy per column and chunk, from a file mapped into memory (see MappedFile).
+ */
+struct WorldSnapshot
+{
+    // "RKWS" in native byte order, a snapshot saved with another byte order is thus rejected
+    static constexpr RkUint32 magic   = 0x53574B52u;
+    static constexpr RkUint32 version = 2u;
+
+    static constexpr RkSize section_alignment = 8u;
+
+    struct Header
+    {
+        RkUint32 magic;
+        RkUint32 version;
+        RkUint32 column_alignment;
+        RkUint32 components_count;
+        RkUint32 archetypes_count;
+        RkUint32 sparse_sets_count;
+        RkUint32 slots_count;
+        RkUint32 reserved;
+        RkUint64 entities_count;
+    };
+
+    struct ComponentHeader
+    {
+        RkUint32 id;
+        RkUint32 shared;
+        RkUint32 fields_count;
+        RkUint32 sparse;
+    };
+
+    struct FieldHeader
+    {
+        RkUint32 size;
+        RkUint32 alignment;
+    };
+
+    struct ArchetypeHeader
+    {
+        RkUint64 entities_count;
+        RkUint32 components_count;
+        RkUint32 shared_values_size;
+    };
+
+    struct SparseSetHeader
+    {
+        RkUint64 entities_count;
+        RkUint32 component_id;
+        RkUint32 fields_count;
+    };
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -67,7 +67,7 @@ using SelectType = typename decltype(Select<TIndex>(
  * \tparam TTypes Parameter pack to look into
  */
 template <typename TType, typename... TTypes>
-inline constexpr std::size_t SelectIndex = typename decltype(InvertedSelect<TType>(
+inline constexpr std::size_t SelectIndex = decltype(InvertedSelect<TType>(
     Indexer<std::index_sequence_for<TTypes...>, TTypes...>{}
 ))::index;
 
@@ -101,7 +101,7 @@ static IndexedValue<TIndex, TValue> ValueInvertedSelect(IndexedValue<TIndex, TVa
  * \see http://loungecpp.wikidot.com/tips-and-tricks:indices
  */
 template <std::size_t TIndex, std::size_t... TValues>
-inline constexpr std::size_t SelectValue = typename decltype(ValueSelect<TIndex>(
+inline constexpr std::size_t SelectValue = decltype(ValueSelect<TIndex>(
     ValueIndexer<std::make_index_sequence<sizeof...(TValues)>, TValues...>{}
 ))::value;
 
@@ -112,7 +112,7 @@ inline constexpr std::size_t SelectValue = typename decltype(ValueSelect<TIndex>
  * \tparam TValues Index sequence to look into
  */
 template <std::size_t TValue, std::size_t... TValues>
-inline constexpr std::size_t SelectValueIndex = typename decltype(ValueInvertedSelect<TValue>(
+inline constexpr std::size_t SelectValueIndex = decltype(ValueInvertedSelect<TValue>(
     ValueIndexer<std::make_index_sequence<sizeof...(TValues)>, TValues...>{}
 ))::index;
 
@@ -24,8 +24,6 @@
 
 #pragma once
 
-#include "Utility/Todo.hpp"
-
 #include "Build/Namespace.hpp"
 #include "Types/FundamentalTypes.hpp"
 
@@ -33,6 +31,10 @@
 #include "Resource/ResourceManifest.hpp"
 #include "Resource/Enums/EResourceStatus.hpp"
 
+#include "Threading/Scheduler.hpp"
+#include "Threading/IdlePolicy.hpp"
+
+#include <chrono>
 #include <type_traits>
 
 BEGIN_RUKEN_NAMESPACE
@@ -115,9 +117,12 @@ class Handle
         ResourceManifest::ReferenceCountType ReferenceCount() const noexcept;
 
         /**
-         * \brief Waits until the resource becomes available
+         * \brief Waits until the resource becomes available.
+         *        The calling thread spins, yields, then parks until the status of the resource changes (see IdlePolicy).
+         *        Called from a job of the scheduler, the job is suspended instead and its worker executes other jobs in the meantime
+         * \param in_timeout Maximum time to wait for, in seconds. A negative timeout waits indefinitely
          * \note If the underlying resource manager hasn't been set, this method won't have any effects
-         * \return True if the resource is valid, false otherwise.
+         * \return True if the resource is available, false if the resource is invalid or if the timeout expired
          */
         RkBool WaitForValidity(RkFloat in_timeout) const noexcept;
 
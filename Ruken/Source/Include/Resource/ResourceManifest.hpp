@@ -25,12 +25,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 
 #include "Build/Namespace.hpp"
 #include "Types/FundamentalTypes.hpp"
 #include "Resource/Enums/EResourceStatus.hpp"
 #include "Resource/Enums/EResourceGCStrategy.hpp"
 #include "Resource/ResourceIdentifier.hpp"
+#include "Threading/EventCount.hpp"
 
 #ifndef RUKEN_RESOURCE_MANIFEST_STORE_IDENTIFIER
     #define RUKEN_RESOURCE_MANIFEST_DONT_STORE_IDENTIFIER
@@ -55,6 +57,9 @@ struct ResourceManifest
 
         #pragma region Members
 
+        // Notified every time the status of any manifest changes
+        static EventCount m_status_event;
+
 #ifdef RUKEN_RESOURCE_MANIFEST_STORE_IDENTIFIER
         // This is only used for debug messages
         const ResourceIdentifier m_identifier;
@@ -106,6 +111,21 @@ struct ResourceManifest
         [[nodiscard]] ResourceIdentifier        GetIdentifier() const noexcept;
 #endif
 
+        /**
+         * \brief Updates the status of the resource and wakes up any thread waiting for a status change
+         * \param in_status New status
+         */
+        RkVoid SetStatus(EResourceStatus in_status) noexcept;
+
+        /**
+         * \brief Parks the calling thread until the status of the resource differs from the given one
+         * \param in_status Status to wait a change from
+         * \param in_deadline Time point after which the thread is unparked in any case
+         * \return False if the deadline has been reached, true otherwise
+         * \note This method may return spuriously, the status should be checked again
+         */
+        RkBool WaitForStatusChange(EResourceStatus in_status, std::chrono::steady_clock::time_point in_deadline) const noexcept;
+
         #pragma endregion 
 
         #pragma region Operators
@@ -0,0 +1,149 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Lock free bounded multi producer multi consumer queue (Vyukov).
+ *
+ * Items are stored into a ring buffer of fixed capacity, every slot carries a sequence number
+ * telling producers and consumers whether the slot is ready to be written or read.
+ * Producers and consumers only contend on their own position counter, slots are padded to a cache line
+ * so that neighbour slots being written and read never share one.
+ *
+ * \tparam TType Type contained into the queue, must be nothrow move constructible
+ *
+ * \see "Bounded MPMC queue" (Dmitry Vyukov, 1024cores.net)
+ */
+template <typename TType>
+class BoundedQueue : Unique
+{
+    static_assert(std::is_nothrow_move_constructible_v<TType>, "TType must be nothrow move constructible");
+
+    private:
+
+        /**
+         * \brief Slot of the ring buffer
+         */
+        struct alignas(RUKEN_THREADING_CACHE_LINE_SIZE) Slot
+        {
+            std::atomic<RkSize> sequence;
+            alignas(TType) RkUint8 storage[sizeof(TType)];
+        };
+
+        #pragma region Members
+
+        std::unique_ptr<Slot[]> m_slots;
+        RkSize                  m_mask;
+
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkSize> m_enqueue_position;
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkSize> m_dequeue_position;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Rounds a capacity up to a power of 2, slots are indexed by masking the positions
+         * \param in_capacity Requested capacity
+         * \return Capacity of the ring buffer, at least 2
+         */
+        [[nodiscard]]
+        static RkSize RoundCapacity(RkSize in_capacity) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Bounded queue constructor
+         * \param in_capacity Capacity of the queue, rounded up to a power of 2 (at least 2)
+         */
+        explicit BoundedQueue(RkSize in_capacity = 1024);
+
+        BoundedQueue(BoundedQueue const& in_copy) = delete;
+        BoundedQueue(BoundedQueue&&      in_move) = delete;
+        ~BoundedQueue() noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Tries to enqueue an item
+         * \param in_item Item to enqueue, left untouched if the queue is full
+         * \return True if the item has been enqueued, false if the queue was full
+         */
+        RkBool TryEnqueue(TType&& in_item) noexcept;
+
+        /**
+         * \brief Tries to dequeue an item
+         * \param out_item Dequeued item
+         * \return True if the content of out_item is valid, false if the queue was empty
+         */
+        RkBool TryDequeue(TType& out_item) noexcept;
+
+        /**
+         * \brief Checks if the queue is empty
+         * \return True if the queue is empty, false otherwise
+         * \note The result is only a snapshot and might be outdated as soon as this method returns
+         */
+        [[nodiscard]]
+        RkBool Empty() const noexcept;
+
+        /**
+         * \brief Returns the capacity of the queue
+         * \return Maximum number of items the queue can hold
+         */
+        [[nodiscard]]
+        RkSize Capacity() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        BoundedQueue& operator=(BoundedQueue const& in_copy) = delete;
+        BoundedQueue& operator=(BoundedQueue&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+#include "Threading/BoundedQueue.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Build/Namespace.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Describes the processors of the machine: logical processors, the physical cores they belong to and their NUMA node.
+ *
+ * The topology is detected once at construction using sysfs on Linux and GetLogicalProcessorInformationEx on Windows.
+ * If the detection fails (or on unsupported platforms), every logical processor is considered
+ * as a physical core of its own, on a single NUMA node.
+ *
+ * Only the processors the process is allowed to run on (see taskset, cgroups cpusets or job objects) are reported,
+ * cores without any such processor are dropped.
+ *
+ * \note On Windows, only the processors of the first processor group (64 processors) are reported
+ */
+class CpuTopology
+{
+    public:
+
+        /**
+         * \brief Physical core, and the logical processors (SMT siblings) it exposes
+         */
+        struct PhysicalCore
+        {
+            std::vector<RkUint32> processors;
+            RkUint32              numa_node;
+        };
+
+    private:
+
+        #pragma region Members
+
+        std::vector<PhysicalCore> m_cores;
+        std::vector<RkUint32>     m_processor_nodes;
+        RkUint32                  m_numa_nodes_count;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Detects the topology of the machine
+         * \return True if the detection succeeded
+         */
+        RkBool Detect() noexcept;
+
+        /**
+         * \brief Removes the logical processors the process isn't allowed to run on, and the cores left without processors
+         */
+        RkVoid RestrictToProcessAffinity() noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        CpuTopology() noexcept;
+
+        CpuTopology(CpuTopology const& in_copy) = default;
+        CpuTopology(CpuTopology&&      in_move) = default;
+        ~CpuTopology()                          = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the physical cores of the machine the process may run on, sorted by NUMA node
+         * \return Physical cores
+         */
+        [[nodiscard]]
+        std::vector<PhysicalCore> const& GetPhysicalCores() const noexcept;
+
+        /**
+         * \brief Returns the number of logical processors of the machine the process may run on
+         * \return Logical processors count
+         */
+        [[nodiscard]]
+        RkSize GetLogicalProcessorsCount() const noexcept;
+
+        /**
+         * \brief Returns the number of NUMA nodes of the machine
+         * \return NUMA nodes count, at least 1
+         */
+        [[nodiscard]]
+        RkUint32 GetNumaNodesCount() const noexcept;
+
+        /**
+         * \brief Returns the NUMA node of a logical processor
+         * \param in_processor Index of the logical processor
+         * \return NUMA node of the processor, 0 if the processor is unknown
+         */
+        [[nodiscard]]
+        RkUint32 GetNumaNode(RkUint32 in_processor) const noexcept;
+
+        /**
+         * \brief Returns the logical processor the calling thread is currently running on
+         * \return Index of the logical processor, 0 if this information isn't available
+         * \note The calling thread might have migrated by the time this method returns, unless it is pinned
+         */
+        [[nodiscard]]
+        static RkUint32 GetCurrentProcessor() noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        CpuTopology& operator=(CpuTopology const& in_copy) = default;
+        CpuTopology& operator=(CpuTopology&&      in_move) = default;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
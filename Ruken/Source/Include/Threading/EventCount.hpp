@@ -0,0 +1,127 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief An event count allows threads to park until a condition, checked outside of any lock, becomes true.
+ *
+ * Waiting follows a 3 steps protocol:
+ * \code
+ * RkUint32 const key = event.PrepareWait();
+ * if (condition) { event.CancelWait(); return; }
+ * event.Wait(key);
+ * \endcode
+ * Notifying threads must make the condition true before calling Notify, no notification can then be missed.
+ * Notifying is almost free (a fence and a load) as long as no thread is parked.
+ *
+ * \see Dmitry Vyukov's event count
+ */
+class EventCount : Unique
+{
+    private:
+
+        #pragma region Members
+
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkUint32> m_waiters;
+        std::atomic<RkUint32>                                          m_epoch;
+        std::mutex                                                     m_mutex;
+        std::condition_variable                                        m_condition;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        EventCount() noexcept;
+
+        EventCount(EventCount const& in_copy) = delete;
+        EventCount(EventCount&&      in_move) = delete;
+        ~EventCount()                         = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Registers the calling thread as a waiter, the condition must be checked again after this call
+         * \return Key to pass to Wait() or WaitUntil()
+         */
+        [[nodiscard]]
+        RkUint32 PrepareWait() noexcept;
+
+        /**
+         * \brief Unregisters the calling thread, to call instead of Wait() if the condition became true
+         */
+        RkVoid CancelWait() noexcept;
+
+        /**
+         * \brief Parks the calling thread until a notification occurs after the call to PrepareWait()
+         * \param in_key Key returned by PrepareWait()
+         */
+        RkVoid Wait(RkUint32 in_key) noexcept;
+
+        /**
+         * \brief Parks the calling thread until a notification occurs after the call to PrepareWait(), or until the deadline
+         * \param in_key Key returned by PrepareWait()
+         * \param in_deadline Time point after which the thread is unparked in any case
+         * \return False if the deadline has been reached, true otherwise
+         */
+        RkBool WaitUntil(RkUint32 in_key, std::chrono::steady_clock::time_point in_deadline) noexcept;
+
+        /**
+         * \brief Unparks one of the waiting threads, if any
+         */
+        RkVoid NotifyOne() noexcept;
+
+        /**
+         * \brief Unparks every waiting thread
+         */
+        RkVoid NotifyAll() noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        EventCount& operator=(EventCount const& in_copy) = delete;
+        EventCount& operator=(EventCount&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
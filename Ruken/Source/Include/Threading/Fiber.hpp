@@ -0,0 +1,120 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief User mode execution context with its own stack, cooperatively scheduled.
+ *
+ * A fiber is either created from the calling thread (representing the thread's own stack) or with a fresh stack
+ * and an entry point. Switching from a fiber to another saves the state of the running fiber and resumes the target,
+ * no kernel scheduling is involved.
+ *
+ * Implemented on top of the fiber API on Windows and of ucontext on Linux.
+ *
+ * \warning A fiber must only be switched to from the thread that created it, the entry point of a fiber must never return
+ *          (switch back to the thread fiber instead) and the thread fiber must be destroyed by its own thread
+ */
+class Fiber : Unique
+{
+    public:
+
+        using Entry = RkVoid (*)(RkVoid*);
+
+    private:
+
+        #pragma region Members
+
+        // Platform specific context (LPVOID fiber on Windows, ucontext and stack on Linux)
+        RkVoid* m_handle;
+        Entry   m_entry;
+        RkVoid* m_argument;
+        RkBool  m_thread_fiber;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Creates a fiber representing the calling thread, the thread can then switch to other fibers
+         */
+        Fiber() noexcept;
+
+        /**
+         * \brief Creates a new fiber, the fiber will start running its entry point the first time it is switched to
+         * \param in_entry Entry point of the fiber, must never return
+         * \param in_argument Argument given to the entry point
+         * \param in_stack_size Size of the stack of the fiber in bytes
+         */
+        Fiber(Entry in_entry, RkVoid* in_argument, RkSize in_stack_size) noexcept;
+
+        Fiber(Fiber const& in_copy) = delete;
+        Fiber(Fiber&&      in_move) = delete;
+        ~Fiber() noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Runs the entry point of a fiber, first function called on the stack of the fiber
+         * \param in_fiber Fiber to run
+         * \note Only meant to be called by the platform specific entry points
+         */
+        static RkVoid Run(Fiber* in_fiber) noexcept;
+
+        /**
+         * \brief Suspends this fiber and resumes another one
+         * \param in_fiber Fiber to resume
+         * \warning This fiber must be the one currently running on the calling thread
+         */
+        RkVoid SwitchTo(Fiber& in_fiber) noexcept;
+
+        /**
+         * \brief Checks if the fiber has been successfully created
+         * \return True if the fiber can be switched to
+         */
+        [[nodiscard]]
+        RkBool Valid() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        Fiber& operator=(Fiber const& in_copy) = delete;
+        Fiber& operator=(Fiber&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
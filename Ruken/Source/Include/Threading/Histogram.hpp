@@ -0,0 +1,166 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Thread safe log-linear histogram (HDR style) of unsigned values, such as durations in nanoseconds.
+ *
+ * Values are bucketed by power of 2, every power of 2 being split into sub_buckets_count linear sub-buckets.
+ * This keeps a constant relative precision (1 / sub_buckets_count) over the whole 64 bits range
+ * within a fixed amount of memory, and makes recording a value a couple of relaxed atomic operations.
+ *
+ * \note Percentiles are approximated by the upper bound of the bucket they fall into
+ */
+class Histogram
+{
+    public:
+
+        // Sub-buckets per power of 2, the relative error of a recorded value is at most 1 / sub_buckets_count
+        static constexpr RkSize sub_buckets_bits  = 4u;
+        static constexpr RkSize sub_buckets_count = 1u << sub_buckets_bits;
+        static constexpr RkSize buckets_count     = (64u - sub_buckets_bits + 1u) * sub_buckets_count;
+
+    private:
+
+        #pragma region Members
+
+        std::atomic<RkUint64> m_buckets[buckets_count];
+        std::atomic<RkUint64> m_sum;
+        std::atomic<RkUint64> m_max;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the bucket a value falls into
+         * \param in_value Value
+         * \return Bucket index
+         */
+        [[nodiscard]]
+        static RkSize GetBucket(RkUint64 in_value) noexcept;
+
+        /**
+         * \brief Returns the highest value falling into a bucket
+         * \param in_bucket Bucket index
+         * \return Upper bound of the bucket
+         */
+        [[nodiscard]]
+        static RkUint64 GetBucketUpperBound(RkSize in_bucket) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        Histogram() noexcept;
+
+        /**
+         * \brief Copies a snapshot of another histogram
+         * \param in_copy Histogram to copy, might be recorded into concurrently
+         */
+        Histogram(Histogram const& in_copy) noexcept;
+        Histogram(Histogram&&      in_move) noexcept;
+        ~Histogram() = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Records a value
+         * \param in_value Value to record
+         */
+        RkVoid Record(RkUint64 in_value) noexcept;
+
+        /**
+         * \brief Records a value without any atomic read-modify-write operation
+         * \param in_value Value to record
+         * \warning The calling thread must be the only one recording values into the histogram, it can still be read concurrently
+         */
+        RkVoid RecordExclusive(RkUint64 in_value) noexcept;
+
+        /**
+         * \brief Adds every value recorded by another histogram to this one
+         * \param in_other Histogram to merge
+         */
+        RkVoid Merge(Histogram const& in_other) noexcept;
+
+        /**
+         * \brief Clears every recorded value
+         * \note Values recorded concurrently might be partially cleared
+         */
+        RkVoid Reset() noexcept;
+
+        /**
+         * \brief Returns the number of recorded values
+         * \return Recorded values count
+         * \note This sums up every bucket of the histogram
+         */
+        [[nodiscard]]
+        RkUint64 GetCount() const noexcept;
+
+        /**
+         * \brief Returns the mean of the recorded values
+         * \return Mean, 0 if no value has been recorded
+         */
+        [[nodiscard]]
+        RkDouble GetMean() const noexcept;
+
+        /**
+         * \brief Returns the highest recorded value
+         * \return Maximum, 0 if no value has been recorded
+         */
+        [[nodiscard]]
+        RkUint64 GetMax() const noexcept;
+
+        /**
+         * \brief Returns the value below which a given percentage of the recorded values fall
+         * \param in_percentile Percentile, between 0 and 100
+         * \return Approximated value at the percentile, 0 if no value has been recorded
+         */
+        [[nodiscard]]
+        RkUint64 GetValueAtPercentile(RkDouble in_percentile) const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        Histogram& operator=(Histogram const& in_copy) noexcept;
+        Histogram& operator=(Histogram&&      in_move) noexcept;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
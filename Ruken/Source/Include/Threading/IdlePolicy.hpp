@@ -0,0 +1,64 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Describes how a thread running out of work waits for more.
+ *
+ * The thread first spins for a few iterations (lowest latency, burns a whole core),
+ * then yields its time slice for a few more and finally parks until it gets notified (no CPU usage).
+ */
+struct IdlePolicy
+{
+    #pragma region Members
+
+    // Number of iterations spent spinning with a pause instruction
+    RkUint32 spin_count {RUKEN_THREADING_IDLE_SPIN_COUNT};
+
+    // Number of iterations spent yielding the time slice to other threads
+    RkUint32 yield_count {RUKEN_THREADING_IDLE_YIELD_COUNT};
+
+    #pragma endregion
+
+    #pragma region Methods
+
+    /**
+     * \brief Executes one idle iteration
+     * \param in_out_iteration Number of idle iterations done since the last time the thread had work, incremented by this call
+     * \return True if an iteration has been executed, false if the thread should now park
+     */
+    RkBool Idle(RkUint32& in_out_iteration) const noexcept;
+
+    #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Move only callable executed by the scheduler, any return value will be discarded.
+ *
+ * Unlike std::function, the callable is always stored inline into a fixed size buffer
+ * (RUKEN_THREADING_JOB_CAPACITY bytes), so that creating, moving and destroying a job never allocates.
+ * Trying to store a callable that doesn't fit into the buffer results in a compilation error.
+ *
+ * \note Since jobs are move only, callables capturing move only types (std::unique_ptr...) are supported
+ */
+class JobFunction
+{
+    private:
+
+        /**
+         * \brief Type erased operations of the stored callable
+         */
+        struct Operations
+        {
+            RkVoid (*invoke) (RkVoid* in_storage);
+            RkVoid (*move)   (RkVoid* in_destination, RkVoid* in_source) noexcept;
+            RkVoid (*destroy)(RkVoid* in_storage)                        noexcept;
+        };
+
+        #pragma region Members
+
+        alignas(std::max_align_t) RkUint8 m_storage[RUKEN_THREADING_JOB_CAPACITY];
+        Operations const*                 m_operations;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        template <typename TCallable>
+        static RkVoid Invoke(RkVoid* in_storage);
+
+        template <typename TCallable>
+        static RkVoid Move(RkVoid* in_destination, RkVoid* in_source) noexcept;
+
+        template <typename TCallable>
+        static RkVoid Destroy(RkVoid* in_storage) noexcept;
+
+        /**
+         * \brief Returns the operations table of a callable type
+         * \tparam TCallable Type of the callable
+         * \return Operations table
+         */
+        template <typename TCallable>
+        static Operations const* GetOperations() noexcept;
+
+        #pragma endregion
+
+    public:
+
+        // Size in bytes of the inline storage
+        static constexpr RkSize capacity = RUKEN_THREADING_JOB_CAPACITY;
+
+        #pragma region Constructors
+
+        JobFunction()               noexcept;
+        JobFunction(std::nullptr_t) noexcept;
+
+        /**
+         * \brief Creates a job from a callable
+         * \tparam TCallable Type of the callable, must fit into the inline storage and be nothrow move constructible
+         * \param in_callable Callable to store
+         */
+        template <typename TCallable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TCallable>, JobFunction> &&
+                                                                  !std::is_same_v<std::decay_t<TCallable>, std::nullptr_t>>>
+        JobFunction(TCallable&& in_callable) noexcept;
+
+        JobFunction(JobFunction const& in_copy) = delete;
+        JobFunction(JobFunction&&      in_move) noexcept;
+        ~JobFunction();
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Destroys the stored callable, if any
+         */
+        RkVoid Reset() noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        /**
+         * \brief Invokes the stored callable
+         * \warning The job must be valid
+         */
+        RkVoid operator()();
+
+        /**
+         * \brief Checks if the job stores a callable
+         */
+        explicit operator RkBool() const noexcept;
+
+        JobFunction& operator=(JobFunction const& in_copy) = delete;
+        JobFunction& operator=(JobFunction&&      in_move) noexcept;
+        JobFunction& operator=(std::nullptr_t)             noexcept;
+
+        #pragma endregion
+};
+
+#include "Threading/JobFunction.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
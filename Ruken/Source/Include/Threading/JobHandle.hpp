@@ -0,0 +1,113 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include "Build/Namespace.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "Threading/JobNode.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief A job handle is a lightweight reference to a job scheduled by the Scheduler.
+ *
+ * Handles allow to wait for a specific job, to use it as a dependency of other jobs or to chain continuations.
+ * The referenced job is kept alive as long as a handle points to it. May be used on any thread.
+ *
+ * \note A default constructed handle is invalid and is considered as completed.
+ * \warning Jobs are allocated from a pool owned by the scheduler, handles must not outlive their scheduler.
+ */
+class JobHandle
+{
+    friend class Scheduler;
+
+    private:
+
+        #pragma region Members
+
+        JobNode* m_node;
+
+        #pragma endregion
+
+        #pragma region Constructors
+
+        // Creation from a job node, scheduler exclusive
+        explicit JobHandle(JobNode* in_node) noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        JobHandle() noexcept;
+        JobHandle(JobHandle const& in_copy) noexcept;
+        JobHandle(JobHandle&&      in_move) noexcept;
+        ~JobHandle();
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Checks if the handle references a job
+         * \return True if the handle is valid
+         */
+        [[nodiscard]]
+        RkBool Valid() const noexcept;
+
+        /**
+         * \brief Checks if the referenced job has been executed.
+         * \return True if the job completed or if the handle is invalid
+         */
+        [[nodiscard]]
+        RkBool Done() const noexcept;
+
+        /**
+         * \brief Waits until the referenced job completes.
+         *        The calling thread helps executing pending jobs in the meantime.
+         * \see Scheduler::Wait
+         */
+        RkVoid Wait() const noexcept;
+
+        /**
+         * \brief Schedules a continuation, executed once the referenced job completes
+         * \param in_continuation Continuation to schedule
+         * \return Handle to the continuation, invalid if this handle is invalid
+         */
+        JobHandle Then(JobFunction&& in_continuation) const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        JobHandle& operator=(JobHandle const& in_copy) noexcept;
+        JobHandle& operator=(JobHandle&&      in_move) noexcept;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
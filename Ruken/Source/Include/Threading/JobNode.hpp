@@ -0,0 +1,174 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "Threading/JobFunction.hpp"
+#include "Threading/EJobPriority.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+class Scheduler;
+class JobNodePool;
+
+/**
+ * \brief A job node is the internal representation of a scheduled job.
+ * \note  A JobNode cannot be moved or copied and must be unique.
+ *
+ * Nodes are reference counted by the scheduler and by every JobHandle pointing to them.
+ * Dependencies are expressed through intrusive links: a node waiting on other jobs registers
+ * one of its own links into the continuation stack of each of these jobs.
+ * Once a job completes, the continuation stack is closed and every dependent node gets its
+ * pending dependencies count decremented, and is submitted to the scheduler if it reaches 0.
+ *
+ * Every operation done on this object is driven by the scheduler.
+ */
+struct JobNode
+{
+    /**
+     * \brief Intrusive link used to register a node as a continuation of another one
+     */
+    struct Link
+    {
+        JobNode* dependent {nullptr};
+        Link*    next      {nullptr};
+    };
+
+    // Number of links stored inline, any additional dependency allocates its own links
+    static constexpr RkSize inline_links_count = 2u;
+
+    #pragma region Members
+
+    // Task to execute
+    JobFunction task;
+
+    // Scheduler owning the node
+    Scheduler* scheduler;
+
+    // Pool the node has been allocated from
+    JobNodePool* pool;
+
+    // Priority class of the node, might be raised by dependent nodes until the node gets submitted
+    std::atomic<EJobPriority> priority;
+
+    // Blocking I/O job, executed by the I/O workers of the scheduler
+    RkBool io_bound;
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    // Time at which the node has been submitted, see WorkerTelemetry::Now()
+    RkUint64 submit_time;
+
+    #endif
+
+    // Number of handles (and the scheduler itself) referencing the node
+    std::atomic<RkUint32> references;
+
+    // Number of unfinished dependencies, plus one while the node is being set up
+    std::atomic<RkUint32> pending_dependencies;
+
+    // Stack of nodes waiting for this one to complete, closed once the node completed
+    std::atomic<Link*> continuations;
+
+    // Links used to register this node as a continuation of its dependencies
+    Link                    inline_links[inline_links_count];
+    std::unique_ptr<Link[]> extra_links;
+
+    #pragma endregion
+
+    #pragma region Constructors
+
+    JobNode(JobFunction&& in_task, Scheduler* in_scheduler, JobNodePool* in_pool, RkSize in_dependencies_count) noexcept;
+
+    JobNode(JobNode const& in_copy) = delete;
+    JobNode(JobNode&&      in_move) = delete;
+    ~JobNode()                      = default;
+
+    #pragma endregion
+
+    #pragma region Methods
+
+    /**
+     * \brief Returns the link to use to register this node as a continuation of its nth dependency
+     * \param in_index Index of the dependency
+     * \return Link
+     */
+    [[nodiscard]]
+    Link* GetLink(RkSize in_index) noexcept;
+
+    /**
+     * \brief Registers a link into the continuation stack of the node
+     * \param in_link Link of the dependent node
+     * \return True if the link has been registered, false if the node already completed
+     */
+    RkBool AddContinuation(Link* in_link) noexcept;
+
+    /**
+     * \brief Marks the node as completed and returns every registered continuation
+     * \return Continuation stack
+     */
+    [[nodiscard]]
+    Link* CloseContinuations() noexcept;
+
+    /**
+     * \brief Checks if the node has completed
+     * \return True if the node has been executed
+     */
+    [[nodiscard]]
+    RkBool Completed() const noexcept;
+
+    /**
+     * \brief Raises the priority of the node, lower priorities are ignored
+     * \param in_priority Priority to raise to
+     */
+    RkVoid RaisePriority(EJobPriority in_priority) noexcept;
+
+    /**
+     * \brief Adds a reference to the node
+     */
+    RkVoid AddReference() noexcept;
+
+    /**
+     * \brief Removes a reference from the node, releasing it to its pool if that was the last one
+     */
+    RkVoid RemoveReference() noexcept;
+
+    #pragma endregion
+
+    #pragma region Operators
+
+    JobNode& operator=(JobNode const& in_copy) = delete;
+    JobNode& operator=(JobNode&&      in_move) = delete;
+
+    #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,150 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+#include "Threading/JobNode.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Lock free pool of job nodes.
+ *
+ * Nodes are allocated by blocks that are never released until the destruction of the pool,
+ * free nodes are linked into a lock free stack indexing the slots of these blocks.
+ * The head of the stack packs the index of the first free slot with a tag incremented on every operation,
+ * preventing the ABA problem without relying on a double width compare and swap.
+ *
+ * Once the pool has warmed up, allocating and releasing a node never allocates memory.
+ * If every block is in use, the pool falls back on individual heap allocations.
+ *
+ * \warning Every node must have been released before the destruction of the pool
+ */
+class JobNodePool : Unique
+{
+    private:
+
+        /**
+         * \brief Storage of a node, the node must be the first member of the slot
+         */
+        struct Slot
+        {
+            alignas(JobNode) RkUint8 storage[sizeof(JobNode)];
+            std::atomic<RkUint32>    next;
+            RkUint32                 index;
+        };
+
+        static constexpr RkUint32 block_size    = 1024u;
+        static constexpr RkUint32 max_blocks    = 4096u;
+        static constexpr RkUint32 invalid_index = 0xFFFFFFFFu;
+
+        #pragma region Members
+
+        // Free stack head, index of the first free slot in the lower bits and tag in the upper bits
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkUint64> m_head;
+
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::mutex m_growth_mutex;
+        RkUint32                                            m_blocks_count;
+        std::unique_ptr<Slot[]>                             m_blocks[max_blocks];
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns the slot at the given index
+         * \param in_index Index of the slot
+         * \return Slot
+         */
+        [[nodiscard]]
+        Slot& GetSlot(RkUint32 in_index) const noexcept;
+
+        /**
+         * \brief Pushes a chain of linked slots onto the free stack
+         * \param in_first First slot of the chain
+         * \param in_last Last slot of the chain
+         */
+        RkVoid Push(Slot& in_first, Slot& in_last) noexcept;
+
+        /**
+         * \brief Allocates a new block of slots
+         * \return A free slot for the caller, or nullptr if the maximum number of blocks has been reached
+         */
+        Slot* Grow() noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        JobNodePool() noexcept;
+
+        JobNodePool(JobNodePool const& in_copy) = delete;
+        JobNodePool(JobNodePool&&      in_move) = delete;
+        ~JobNodePool()                          = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Allocates and constructs a new node
+         * \param in_task Task of the node
+         * \param in_scheduler Scheduler owning the node
+         * \param in_dependencies_count Number of dependencies of the node
+         * \return Allocated node
+         * \note This method may be called from any thread
+         */
+        [[nodiscard]]
+        JobNode* Allocate(JobFunction&& in_task, Scheduler* in_scheduler, RkSize in_dependencies_count) noexcept;
+
+        /**
+         * \brief Destroys a node and gives it back to the pool
+         * \param in_node Node to release, must have been allocated by this pool
+         * \note This method may be called from any thread
+         */
+        RkVoid Release(JobNode* in_node) noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        JobNodePool& operator=(JobNodePool const& in_copy) = delete;
+        JobNodePool& operator=(JobNodePool&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
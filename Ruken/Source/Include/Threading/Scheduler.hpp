@@ -25,8 +25,13 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
 #include <vector>
 #include <functional>
+#include <type_traits>
 
 #include "Build/Namespace.hpp"
 
@@ -36,25 +41,151 @@
 #include "Types/Unique.hpp"
 #include "Types/FundamentalTypes.hpp"
 
+#include "Threading/Fiber.hpp"
 #include "Threading/Worker.hpp"
+#include "Threading/IdlePolicy.hpp"
+#include "Threading/CpuTopology.hpp"
+#include "Threading/EventCount.hpp"
+#include "Threading/JobNode.hpp"
+#include "Threading/JobHandle.hpp"
+#include "Threading/JobNodePool.hpp"
+#include "Threading/EJobPriority.hpp"
+#include "Threading/ESchedulerMode.hpp"
+#include "Threading/SchedulerTelemetry.hpp"
+#include "Threading/EWorkerPlacement.hpp"
+#include "Threading/WorkStealingQueue.hpp"
+#include "Threading/ThreadSafeQueue.hpp"
 #include "Threading/ThreadSafeLockQueue.hpp"
 
 BEGIN_RUKEN_NAMESPACE
 
 /**
  * \brief This class is responsible for the repartition of different tasks between workers
+ *
+ * Workers run jobs on fibers: a job waiting for something (see WaitUntil) is suspended and the worker
+ * picks up other jobs in the meantime, resuming the suspended job once its condition is met.
+ * Suspended jobs are always resumed by the worker they were suspended on.
  */
 class Scheduler final: public Service<Scheduler>, Unique
 {
-    public: using Job = std::function<RkVoid()>;
+    public: using Job = JobFunction;
 
     private:
 
+        // Number of priority classes, see EJobPriority
+        static constexpr RkSize priorities_count = 3u;
+
+        /**
+         * \brief Per worker data used by the work stealing mode
+         */
+        struct WorkerContext
+        {
+            // One deque per priority class
+            WorkStealingQueue<JobNode*> queues[priorities_count];
+            RkUint32                    random_state;
+            RkUint32                    node;
+        };
+
+        /**
+         * \brief Per NUMA node data used by the work stealing mode
+         */
+        struct NodeContext
+        {
+            // Injection queues of the jobs scheduled from outside of the scheduler, by threads running on this node
+            ThreadSafeQueue<JobNode*> queues[priorities_count];
+
+            // Indices of the workers placed on this node
+            std::vector<RkUint16> workers;
+        };
+
+        /**
+         * \brief Job suspended on a fiber, waiting for a condition to be met
+         */
+        struct SuspendedFiber
+        {
+            Fiber*       fiber;
+            RkBool     (*ready)(RkVoid const*);
+            RkVoid const* predicate;
+
+            // Data of the suspended job, restored when it resumes (see SetJobData)
+            RkVoid const* job_data;
+        };
+
+        /**
+         * \brief Per worker fibers, only ever accessed by their worker
+         */
+        struct FiberContext
+        {
+            // Fiber of the worker thread itself, only used to start and stop the worker
+            std::unique_ptr<Fiber> thread_fiber;
+
+            // Fiber currently running the worker loop
+            Fiber* current;
+
+            std::vector<std::unique_ptr<Fiber>> fibers;
+            std::vector<Fiber*>                 free_fibers;
+            std::vector<SuspendedFiber>         suspended_fibers;
+        };
+
+        /**
+         * \brief Shared state of a ParallelFor call
+         * \tparam TFunction Type of the function to execute over the range
+         */
+        template <typename TFunction>
+        struct ParallelForContext
+        {
+            TFunction&          function;
+            RkSize              grain;
+            std::atomic<RkSize> pending_ranges;
+        };
+
         #pragma region Members
 
-        std::vector<Worker>      m_workers;
-        std::atomic_bool         m_running;
-        ThreadSafeLockQueue<Job> m_job_queue;
+        // Declared first, every node must be released before the pool gets destroyed
+        JobNodePool                   m_job_pool;
+        ESchedulerMode                m_mode;
+        EWorkerPlacement              m_placement;
+        CpuTopology                   m_topology;
+        std::vector<Worker>           m_workers;
+        std::atomic_bool              m_running;
+
+        // Shared queue mode only, one queue per priority class
+        ThreadSafeQueue<JobNode*>     m_job_queues[priorities_count];
+
+        // Work stealing mode only
+        std::unique_ptr<WorkerContext[]> m_contexts;
+        std::unique_ptr<NodeContext[]>   m_nodes;
+        RkUint32                         m_nodes_count;
+
+        // Number of critical jobs waiting in the queues, lets workers skip the search of critical jobs most of the time
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkUint64> m_critical_jobs;
+
+        // Workers dedicated to blocking I/O jobs, and their queue
+        std::vector<Worker>           m_io_workers;
+        ThreadSafeLockQueue<JobNode*> m_io_queue;
+
+        std::unique_ptr<FiberContext[]> m_fibers;
+
+        // Number of jobs currently suspended, completing jobs only wake up workers when there are some
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkUint64> m_suspended_fibers;
+
+        IdlePolicy m_idle_policy;
+
+        // Number of scheduled jobs that didn't complete yet, including the ones waiting for their dependencies
+        std::atomic<RkUint64> m_pending_jobs;
+
+        // Notified when jobs get submitted, idle workers park on it
+        EventCount m_work_event;
+
+        // Notified when jobs complete or get submitted, threads waiting for some jobs to complete park on it
+        EventCount m_completion_event;
+
+        #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+        // One per worker, then one per I/O worker, and a last one shared by every other thread
+        std::unique_ptr<WorkerTelemetry[]> m_telemetry;
+
+        #endif
 
         Logger* m_logger;
 
@@ -64,8 +195,185 @@ class Scheduler final: public Service<Scheduler>, Unique
 
         /**
          * \brief Job given to every worker used my the scheduler
+         * \param in_worker_index Index of the worker running the job
+         */
+        RkVoid WorkersJob(RkUint16 in_worker_index) noexcept;
+
+        /**
+         * \brief Loop of the workers, looking for jobs to execute until the scheduler gets shut down
+         */
+        RkVoid WorkersLoop() noexcept;
+
+        /**
+         * \brief Entry point of the fibers of the workers
+         * \param in_scheduler Scheduler owning the fiber
          */
-        RkVoid WorkersJob() noexcept;
+        static RkVoid FiberEntry(RkVoid* in_scheduler) noexcept;
+
+        /**
+         * \brief Returns an unused fiber of the calling worker, creating one if necessary
+         * \param in_context Fibers of the calling worker
+         * \return Fiber, starting (or continuing) the worker loop once switched to
+         */
+        Fiber* AcquireFiber(FiberContext& in_context) noexcept;
+
+        /**
+         * \brief Suspends the job running on the calling worker until a condition is met.
+         *        The worker carries on with the next jobs on another fiber in the meantime.
+         * \param in_ready Checks the predicate, called by the worker every time it looks for work
+         * \param in_predicate Predicate, living on the stack of the suspended fiber
+         */
+        RkVoid Suspend(RkBool (*in_ready)(RkVoid const*), RkVoid const* in_predicate) noexcept;
+
+        /**
+         * \brief Resumes a job of the calling worker whose condition is met, if any
+         * \return True if a job has been resumed (and suspended again, or completed, since then)
+         */
+        RkBool ResumeSuspendedFiber() noexcept;
+
+        /**
+         * \brief Checks if the calling thread is a worker of this scheduler running a fiber
+         * \return True if the running job can be suspended
+         */
+        [[nodiscard]]
+        RkBool CanSuspend() const noexcept;
+
+        /**
+         * \brief Checks a predicate given to Suspend()
+         * \param in_predicate Predicate to check
+         * \return Value of the predicate
+         */
+        template <typename TPredicate>
+        static RkBool CheckPredicate(RkVoid const* in_predicate) noexcept;
+
+        /**
+         * \brief Job given to every I/O worker used by the scheduler
+         * \param in_worker_index Index of the I/O worker running the job
+         */
+        RkVoid IOWorkersJob(RkUint16 in_worker_index) noexcept;
+
+        #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+        /**
+         * \brief Returns the telemetry of the calling thread
+         * \return Telemetry of the calling worker, or the one shared by the threads that aren't workers
+         */
+        [[nodiscard]]
+        WorkerTelemetry& GetThreadTelemetry() noexcept;
+
+        #endif
+
+        /**
+         * \brief Creates a job and submits it once its dependencies completed
+         * \param in_task Task of the job
+         * \param in_dependencies Dependencies of the job
+         * \param in_priority Priority class of the job
+         * \param in_io_bound True if the job should be executed by an I/O worker
+         * \return Handle to the created job, invalid if the scheduler has been shut down
+         */
+        JobHandle CreateJob(Job&& in_task, std::vector<JobHandle> const& in_dependencies, EJobPriority in_priority, RkBool in_io_bound) noexcept;
+
+        /**
+         * \brief Places the workers on the physical cores of the machine, grouping them by NUMA node
+         */
+        RkVoid PlaceWorkers() noexcept;
+
+        /**
+         * \brief Returns the NUMA node the calling thread is running on
+         * \return Index of the node, 0 if the scheduler isn't NUMA aware
+         */
+        [[nodiscard]]
+        RkUint32 GetCurrentNode() const noexcept;
+
+        /**
+         * \brief Tries to steal a job from a randomly picked worker
+         * \param in_random_state Xorshift state of the thief
+         * \param in_victims Indices of the workers to steal from
+         * \param in_thief_index Index of the thief, or the workers count if the thief isn't a worker
+         * \param out_job Stolen job
+         * \return True if a job has been stolen, false otherwise
+         */
+        RkBool StealJob(RkUint32& in_random_state, std::vector<RkUint16> const& in_victims, RkSize in_thief_index, EJobPriority in_priority, JobNode*& out_job) noexcept;
+
+        /**
+         * \brief Tries to find a job on a NUMA node, first from its injection queue, then from its workers
+         * \param in_node Index of the node
+         * \param in_random_state Xorshift state of the thief
+         * \param in_thief_index Index of the thief, or the workers count if the thief isn't a worker
+         * \param in_priority Priority class of the job to find
+         * \param out_job Found job
+         * \return True if a job has been found, false otherwise
+         */
+        RkBool TryGetNodeJob(RkUint32 in_node, RkUint32& in_random_state, RkSize in_thief_index, EJobPriority in_priority, JobNode*& out_job) noexcept;
+
+        /**
+         * \brief Makes a job available to the workers, its dependencies must be completed
+         * \param in_job Job to submit
+         */
+        RkVoid Submit(JobNode* in_job) noexcept;
+
+        /**
+         * \brief Executes a job, then releases its continuations
+         * \param in_job Job to execute
+         */
+        RkVoid Execute(JobNode* in_job) noexcept;
+
+        /**
+         * \brief Tries to find a pending job of the given priority class for the calling thread, work stealing mode only
+         * \param in_priority Priority class of the job to find
+         * \param out_job Found job
+         * \return True if a job has been found, false otherwise
+         */
+        RkBool TryGetJob(EJobPriority in_priority, JobNode*& out_job) noexcept;
+
+        /**
+         * \brief Tries to find a pending job for the calling thread, by priority order
+         * \param out_job Found job
+         * \return True if a job has been found, false otherwise
+         */
+        RkBool TryGetJob(JobNode*& out_job) noexcept;
+
+        /**
+         * \brief Tries to execute one pending job on the calling thread
+         * \return True if a job has been executed, false if no job could be found
+         */
+        RkBool ExecutePendingJob() noexcept;
+
+        /**
+         * \brief Executes pending jobs on the calling thread until the predicate becomes true.
+         *        Once there is nothing left to execute, the thread follows the idle policy of the scheduler.
+         * \param in_predicate Predicate to wait for, checked again every time a job completes
+         * \param in_poll True if the predicate doesn't depend on jobs only, the thread then wakes up periodically to check it
+         * \note This method returns as well once the scheduler has been shut down
+         */
+        template <typename TPredicate>
+        RkVoid HelpUntil(TPredicate const& in_predicate, RkBool in_poll = false) noexcept;
+
+        /**
+         * \brief Checks if the calling thread still has jobs waiting to be picked up.
+         *        Used by parallel algorithms to only split their range when other threads need work.
+         * \return True if jobs are still pending in the queue used by the calling thread
+         */
+        [[nodiscard]]
+        RkBool HasPendingJobs() noexcept;
+
+        /**
+         * \brief Invokes a ParallelFor function over a range
+         * \param in_function Function, taking either a range (begin, end) or an index
+         * \param in_begin First index of the range
+         * \param in_end Index past the last index of the range
+         */
+        template <typename TFunction>
+        static RkVoid InvokeRange(TFunction& in_function, RkSize in_begin, RkSize in_end);
+
+        /**
+         * \brief Processes a range of a ParallelFor call, lazily splitting it in halves while other threads are starving
+         * \param in_context ParallelFor context
+         * \param in_begin First index of the range
+         * \param in_end Index past the last index of the range
+         */
+        template <typename TFunction>
+        RkVoid ProcessRange(ParallelForContext<TFunction>& in_context, RkSize in_begin, RkSize in_end) noexcept;
 
         #pragma endregion
 
@@ -76,9 +384,17 @@ class Scheduler final: public Service<Scheduler>, Unique
         /**
          * \brief Scheduler constructor
          * \param in_service_provider Service provider
-         * \param in_workers_count Number of managed workers
+         * \param in_workers_count Number of managed workers, if 0 the scheduler spawns a worker per logical processor
+         *                         (or per physical core if the workers are pinned) minus one for the calling thread
+         * \param in_mode Job distribution mode, see ESchedulerMode
+         * \param in_placement Placement of the workers on the processors of the machine, see EWorkerPlacement
+         * \param in_idle_policy Describes how idle workers and waiting threads wait for more work, see IdlePolicy
          */
-        Scheduler(ServiceProvider& in_service_provider, RkUint16 in_workers_count = 0u);
+        Scheduler(ServiceProvider&  in_service_provider,
+                  RkUint16          in_workers_count = 0u,
+                  ESchedulerMode    in_mode          = ESchedulerMode::SharedQueue,
+                  EWorkerPlacement  in_placement     = EWorkerPlacement::Unpinned,
+                  IdlePolicy const& in_idle_policy   = IdlePolicy());
 
         Scheduler(Scheduler const& in_copy)     = delete;
         Scheduler(Scheduler&& in_move) noexcept = delete;
@@ -90,24 +406,194 @@ class Scheduler final: public Service<Scheduler>, Unique
 
         /**
          * \brief Schedules a task on one of the available threads
+         * \param in_task Task to schedule, any return value will be discarded.
+         *                Its captures must fit into RUKEN_THREADING_JOB_CAPACITY bytes, see JobFunction
+         * \param in_priority Priority class of the task, see EJobPriority
+         * \return Handle to the scheduled job
+         * \note If Shutdown() has been called, this method has no effect and returns an invalid handle
+         */
+        JobHandle ScheduleTask(Job&& in_task, EJobPriority in_priority = EJobPriority::Normal) noexcept;
+
+        /**
+         * \brief Schedules a task that will only be executed once all of its dependencies completed
+         * \param in_task Task to schedule, any return value will be discarded
+         * \param in_dependencies Jobs to wait for, invalid handles are ignored
+         * \param in_priority Priority class of the task, see EJobPriority
+         * \return Handle to the scheduled job
+         * \note If Shutdown() has been called, this method has no effect and returns an invalid handle
+         */
+        JobHandle ScheduleTask(Job&& in_task, std::vector<JobHandle> const& in_dependencies, EJobPriority in_priority = EJobPriority::Normal) noexcept;
+
+        /**
+         * \brief Schedules a task doing blocking I/O (disk reads...) on one of the I/O workers.
+         *        I/O workers are separate from the compute workers, blocking them never delays any other job.
+         * \param in_task Task to schedule, any return value will be discarded
+         * \return Handle to the scheduled job, which can be used as a dependency of any other job
+         * \note If Shutdown() has been called, this method has no effect and returns an invalid handle
+         */
+        JobHandle ScheduleIOTask(Job&& in_task) noexcept;
+
+        /**
+         * \brief Schedules a task doing blocking I/O, once all of its dependencies completed
          * \param in_task Task to schedule, any return value will be discarded
-         * \note If Shutdown() has been called, this method has no effect
+         * \param in_dependencies Jobs to wait for, invalid handles are ignored
+         * \return Handle to the scheduled job, which can be used as a dependency of any other job
+         * \note If Shutdown() has been called, this method has no effect and returns an invalid handle
          */
-        RkVoid ScheduleTask(Job&& in_task) noexcept;
+        JobHandle ScheduleIOTask(Job&& in_task, std::vector<JobHandle> const& in_dependencies) noexcept;
 
         /**
-         * \brief Waits until all the queued tasks are completed
+         * \brief Waits until the referenced job completes.
+         *        Called from a job, the job is suspended and its worker executes other jobs in the meantime.
+         *        Otherwise, the calling thread helps executing pending jobs, then parks according to the idle policy.
+         * \param in_handle Job to wait for
+         */
+        RkVoid Wait(JobHandle const& in_handle) noexcept;
+
+        /**
+         * \brief Waits until a condition is met (resource loaded, fence signaled...).
+         *        Called from a job, the job is suspended and its worker executes other jobs in the meantime,
+         *        the predicate is then checked every time the worker looks for work.
+         *        Otherwise, the calling thread helps executing pending jobs and periodically checks the predicate.
+         * \tparam TPredicate Type of the predicate, RkBool()
+         * \param in_predicate Predicate to wait for, must be cheap and must not block
+         * \note Suspended jobs that didn't resume before Shutdown() are dropped along with their stack
+         */
+        template <typename TPredicate>
+        RkVoid WaitUntil(TPredicate const& in_predicate) noexcept;
+
+        /**
+         * \brief Executes a function over a range of indices, in parallel.
+         *
+         * The range is recursively split in halves, only when other threads are starving, and never
+         * below the grain size. The calling thread processes a part of the range itself, then waits like WaitUntil
+         * until every sub-range has been processed: a job suspends its fiber, any other thread helps executing pending jobs.
+         * This method returns once the whole range is done.
+         *
+         * \tparam TFunction Type of the function
+         * \param in_begin First index of the range
+         * \param in_end Index past the last index of the range
+         * \param in_grain Minimum number of indices processed by a single job
+         * \param in_function Function to execute, either RkVoid(RkSize begin, RkSize end) which is called once per sub-range
+         *                    or RkVoid(RkSize index) which is called once per index
+         * \note If Shutdown() has been called, the whole range is processed on the calling thread
+         */
+        template <typename TFunction>
+        RkVoid ParallelFor(RkSize in_begin, RkSize in_end, RkSize in_grain, TFunction&& in_function) noexcept;
+
+        /**
+         * \brief Reduces a range of indices, in parallel.
+         *
+         * Every sub-range produced by ParallelFor is reduced on its own, starting from the identity,
+         * then combined with the others. Since sub-ranges complete in an unspecified order,
+         * the reduction must be associative and commutative.
+         *
+         * \tparam TValue Type of the reduced value
+         * \tparam TFunction Type of the function
+         * \tparam TReduction Type of the reduction
+         * \param in_begin First index of the range
+         * \param in_end Index past the last index of the range
+         * \param in_grain Minimum number of indices processed by a single job
+         * \param in_identity Identity value of the reduction
+         * \param in_function Function producing values, either TValue(RkSize begin, RkSize end) which reduces a whole sub-range
+         *                    or TValue(RkSize index) which produces the value of a single index
+         * \param in_reduction Reduction, TValue(TValue const& lhs, TValue const& rhs)
+         * \return Reduced value, in_identity if the range is empty
+         */
+        template <typename TValue, typename TFunction, typename TReduction>
+        [[nodiscard]]
+        TValue ParallelReduce(RkSize in_begin, RkSize in_end, RkSize in_grain, TValue const& in_identity, TFunction&& in_function, TReduction&& in_reduction) noexcept;
+
+        /**
+         * \brief Waits until every scheduled task completed, including the ones still waiting for their dependencies.
+         *        The calling thread helps executing pending jobs in the meantime, then parks according to the idle policy.
+         * \note This can't be called from a job of this scheduler (including I/O jobs) since the calling job is still pending,
+         *       wait on the handles of the jobs instead
          */
         RkVoid WaitForQueuedTasks() noexcept;
 
         /**
-         * \brief Waits for all current active tasks to be done and drops any queued jobs. This also detaches any workers.
+         * \brief Waits for all current active tasks to be done and drops any queued jobs. This also joins any workers.
          * \note This method can only be called once
          */
         RkVoid Shutdown() noexcept;
 
         std::vector<Worker> const& GetWorkers() const noexcept;
 
+        /**
+         * \brief Returns the scheduler owning the calling thread, if the calling thread is a worker running a job.
+         *        Lets code running in jobs wait without blocking their worker, see WaitUntil
+         * \return Scheduler, nullptr if the calling thread isn't a worker (or is an I/O worker)
+         */
+        [[nodiscard]]
+        static Scheduler* GetCurrentScheduler() noexcept;
+
+        /**
+         * \brief Sets the data of the job running on the calling thread.
+         *        Unlike a thread local variable, the data follows the job when it gets suspended (see WaitUntil):
+         *        the worker runs its next jobs without any data, then restores it when the job resumes.
+         *        Jobs setting data must restore the previous data before returning
+         * \param in_data Data of the job, nullptr for none
+         * \return Previous data of the job
+         */
+        static RkVoid const* SetJobData(RkVoid const* in_data) noexcept;
+
+        /**
+         * \brief Returns the data of the job running on the calling thread, see SetJobData
+         * \return Data of the job, nullptr if none has been set
+         */
+        [[nodiscard]]
+        static RkVoid const* GetJobData() noexcept;
+
+        /**
+         * \brief Returns the index of the worker owning the calling thread
+         * \return Worker index, GetWorkers().size() if the calling thread isn't a worker of this scheduler
+         */
+        [[nodiscard]]
+        RkSize GetCurrentWorkerIndex() const noexcept;
+
+        /**
+         * \brief Returns the workers dedicated to blocking I/O jobs
+         * \return I/O workers
+         */
+        [[nodiscard]]
+        std::vector<Worker> const& GetIOWorkers() const noexcept;
+
+        /**
+         * \brief Returns the job distribution mode of the scheduler
+         * \return Scheduler mode
+         */
+        [[nodiscard]]
+        ESchedulerMode GetMode() const noexcept;
+
+        /**
+         * \brief Returns the placement of the workers of the scheduler
+         * \return Workers placement
+         */
+        [[nodiscard]]
+        EWorkerPlacement GetPlacement() const noexcept;
+
+        /**
+         * \brief Returns the processors topology detected by the scheduler
+         * \return Processors topology
+         */
+        [[nodiscard]]
+        CpuTopology const& GetTopology() const noexcept;
+
+        /**
+         * \brief Takes a snapshot of the telemetry of the scheduler: per worker counters,
+         *        number of queued jobs and latency histograms, accumulated since the creation of the scheduler
+         * \return Scheduler statistics, empty if the telemetry is disabled (see RUKEN_THREADING_ENABLE_TELEMETRY)
+         * \note The counters of the workers are read while they keep running, the snapshot is only approximately consistent
+         */
+        [[nodiscard]]
+        SchedulerStatistics GetStatistics() const noexcept;
+
+        /**
+         * \brief Dumps a snapshot of the telemetry of the scheduler into its logger, see GetStatistics
+         */
+        RkVoid LogStatistics() const noexcept;
+
         #pragma endregion 
 
         #pragma region Operators
@@ -118,4 +604,6 @@ class Scheduler final: public Service<Scheduler>, Unique
         #pragma endregion
 };
 
+#include "Threading/Scheduler.inl"
+
 END_RUKEN_NAMESPACE
\ No newline at end of file
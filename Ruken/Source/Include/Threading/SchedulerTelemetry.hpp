@@ -0,0 +1,171 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/FundamentalTypes.hpp"
+
+#include "Threading/Histogram.hpp"
+
+// Only expands its arguments if the scheduler telemetry is enabled, see RUKEN_THREADING_ENABLE_TELEMETRY
+#if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+    #define RUKEN_THREADING_TELEMETRY(...) __VA_ARGS__
+#else
+    #define RUKEN_THREADING_TELEMETRY(...)
+#endif
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Live telemetry of a thread executing jobs for the scheduler.
+ *
+ * Every worker owns its own instance, padded to avoid false sharing, which is only ever written by this worker
+ * and can thus be updated without any atomic read-modify-write operation.
+ * Threads that aren't workers but still execute jobs (see Scheduler::Wait) share a single instance, marked as shared.
+ * All durations and timestamps are in nanoseconds, see Now().
+ */
+struct alignas(RUKEN_THREADING_CACHE_LINE_SIZE) WorkerTelemetry
+{
+    #pragma region Members
+
+    // Jobs submitted and started by the thread, their difference over every thread gives the number of queued jobs
+    std::atomic<RkUint64> jobs_submitted  {0u};
+    std::atomic<RkUint64> jobs_executed   {0u};
+
+    // Steal attempts, one per deque looked into, and how many of them returned a job
+    std::atomic<RkUint64> steal_attempts  {0u};
+    std::atomic<RkUint64> steal_successes {0u};
+
+    // Time spent without any job to execute, including the time spent parked
+    std::atomic<RkUint64> idle_time       {0u};
+    std::atomic<RkUint64> parked_time     {0u};
+
+    // Start of the current idle and parked periods, 0 if not idle (or parked)
+    std::atomic<RkUint64> idle_since      {0u};
+    std::atomic<RkUint64> parked_since    {0u};
+
+    // Start of the thread, 0 for threads that aren't workers
+    std::atomic<RkUint64> start_time      {0u};
+
+    // Time spent by the jobs started by the thread, between their submission and their start, and then until their completion
+    Histogram queue_latency;
+    Histogram run_time;
+
+    // Written by several threads at once
+    RkBool shared {false};
+
+    #pragma endregion
+
+    #pragma region Methods
+
+    /**
+     * \brief Adds a value to a counter of the telemetry
+     * \param in_counter Counter
+     * \param in_value Value to add
+     */
+    RkVoid Add(std::atomic<RkUint64>& in_counter, RkUint64 in_value) noexcept;
+
+    /**
+     * \brief Records a value into a histogram of the telemetry
+     * \param in_histogram Histogram
+     * \param in_value Value to record
+     */
+    RkVoid Record(Histogram& in_histogram, RkUint64 in_value) noexcept;
+
+    /**
+     * \brief Returns the current time of the monotonic clock used by the telemetry
+     * \return Timestamp in nanoseconds
+     */
+    [[nodiscard]]
+    static RkUint64 Now() noexcept;
+
+    /**
+     * \brief Marks the beginning of an idle period, if not already idle
+     * \param in_now Current time
+     */
+    RkVoid BeginIdle(RkUint64 in_now) noexcept;
+
+    /**
+     * \brief Marks the end of the current idle period, if any
+     */
+    RkVoid EndIdle() noexcept;
+
+    /**
+     * \brief Marks the beginning of a parked period, the thread must be idle
+     */
+    RkVoid BeginPark() noexcept;
+
+    /**
+     * \brief Marks the end of the current parked period
+     */
+    RkVoid EndPark() noexcept;
+
+    #pragma endregion
+};
+
+/**
+ * \brief Snapshot of the telemetry of a thread executing jobs
+ */
+struct WorkerStatistics
+{
+    RkUint64 jobs_executed   {0u};
+    RkUint64 steal_attempts  {0u};
+    RkUint64 steal_successes {0u};
+
+    // Time spent executing jobs (or waiting for them), and without any job, in nanoseconds. Always 0 for threads that aren't workers
+    RkUint64 busy_time       {0u};
+    RkUint64 idle_time       {0u};
+    RkUint64 parked_time     {0u};
+};
+
+/**
+ * \brief Snapshot of the telemetry of a scheduler, see Scheduler::GetStatistics
+ * \note Every value is empty if the telemetry is disabled, see RUKEN_THREADING_ENABLE_TELEMETRY
+ */
+struct SchedulerStatistics
+{
+    std::vector<WorkerStatistics> workers;
+    std::vector<WorkerStatistics> io_workers;
+
+    // Threads that aren't workers but executed jobs while waiting for them
+    WorkerStatistics external;
+
+    // Jobs submitted to the queues that didn't start yet
+    RkUint64 queued_jobs  {0u};
+
+    // Jobs that didn't complete yet, including the ones waiting for their dependencies
+    RkUint64 pending_jobs {0u};
+
+    // Time spent by the jobs in the queues, and executing, in nanoseconds. Jobs suspended on a fiber keep running until they complete
+    Histogram queue_latency;
+    Histogram run_time;
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Lock free unbounded multi producer multi consumer queue.
+ *
+ * Items are stored into a linked list of fixed size segments. Each slot of a segment is used exactly once:
+ * producers and consumers claim slots by incrementing the enqueue (resp. dequeue) index of the segment,
+ * and move on to the next segment once every slot of the current one has been claimed.
+ *
+ * Consumed segments are only released once no operation is in flight anymore, since a concurrent
+ * producer or consumer might still be reading them. The last released segment is kept aside and reused,
+ * a queue that doesn't grow does not allocate.
+ *
+ * \tparam TType Type contained into the queue, must be nothrow move constructible
+ * \tparam TSegmentCapacity Number of items per segment
+ *
+ * \note Under a constant stream of operations from many threads, consumed segments might be released late
+ */
+template <typename TType, RkSize TSegmentCapacity = 256>
+class SegmentedQueue : Unique
+{
+    static_assert(std::is_nothrow_move_constructible_v<TType>, "TType must be nothrow move constructible");
+    static_assert(TSegmentCapacity > 0u,                       "TSegmentCapacity must be greater than 0");
+
+    private:
+
+        /**
+         * \brief Slot of a segment, written once then read once
+         */
+        struct Slot
+        {
+            std::atomic<RkBool> ready;
+            alignas(TType) RkUint8 storage[sizeof(TType)];
+        };
+
+        /**
+         * \brief Segment of the queue
+         */
+        struct Segment
+        {
+            alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkSize> enqueue_index;
+            alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkSize> dequeue_index;
+            alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<Segment*> next;
+
+            // Next segment waiting to be released
+            Segment* next_retired;
+
+            Slot slots[TSegmentCapacity];
+
+            Segment() noexcept;
+
+            RkVoid Reset() noexcept;
+        };
+
+        /**
+         * \brief Keeps track of an operation in flight, releases the retired segments when it is the last one to complete
+         */
+        class OperationGuard
+        {
+            private:
+
+                SegmentedQueue const& m_queue;
+
+            public:
+
+                explicit OperationGuard(SegmentedQueue const& in_queue) noexcept;
+                ~OperationGuard() noexcept;
+        };
+
+        #pragma region Members
+
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<Segment*> m_head;
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<Segment*> m_tail;
+
+        // Number of operations in flight, and segments waiting for it to drop to 0 before being released
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) mutable std::atomic<RkSize> m_operations;
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) mutable std::atomic<Segment*> m_retired;
+        mutable std::atomic<Segment*> m_spare;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Returns an empty segment, either the spare one or a new one
+         * \return Segment
+         */
+        Segment* AcquireSegment() noexcept;
+
+        /**
+         * \brief Releases segments that are not referenced anymore, one of them is kept as the spare segment
+         * \param in_segments Linked list (through next_retired) of segments to release
+         */
+        RkVoid ReleaseSegments(Segment* in_segments) const noexcept;
+
+        /**
+         * \brief Adds segments to the retired list
+         * \param in_first First segment of the list to add
+         * \param in_last Last segment of the list to add
+         */
+        RkVoid RetireSegments(Segment* in_first, Segment* in_last) const noexcept;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        SegmentedQueue() noexcept;
+
+        SegmentedQueue(SegmentedQueue const& in_copy) = delete;
+        SegmentedQueue(SegmentedQueue&&      in_move) = delete;
+        ~SegmentedQueue() noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Enqueues an item, allocating a new segment if the last one is full
+         * \param in_item Item to enqueue
+         * \return Always true, the queue is unbounded
+         */
+        RkBool TryEnqueue(TType&& in_item) noexcept;
+
+        /**
+         * \brief Tries to dequeue an item
+         * \param out_item Dequeued item
+         * \return True if the content of out_item is valid, false if the queue was empty
+         */
+        RkBool TryDequeue(TType& out_item) noexcept;
+
+        /**
+         * \brief Checks if the queue is empty
+         * \return True if the queue is empty, false otherwise
+         * \note The result is only a snapshot and might be outdated as soon as this method returns
+         */
+        [[nodiscard]]
+        RkBool Empty() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        SegmentedQueue& operator=(SegmentedQueue const& in_copy) = delete;
+        SegmentedQueue& operator=(SegmentedQueue&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+#include "Threading/SegmentedQueue.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
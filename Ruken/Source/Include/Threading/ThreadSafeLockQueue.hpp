@@ -110,6 +110,13 @@ class ThreadSafeLockQueue
          */
         RkBool Dequeue(TType& out_item) noexcept;
 
+        /**
+         * \brief Tries to dequeue an item without ever blocking the caller thread
+         * \param out_item Dequeued item
+         * \return True if the content of out_item is valid, false if the queue was empty
+         */
+        RkBool TryDequeue(TType& out_item) noexcept;
+
         #pragma endregion 
 
         #pragma region Operators
@@ -24,29 +24,41 @@
 
 #pragma once
 
+#include <thread>
+#include <utility>
+
 #include "Build/Namespace.hpp"
 
-#include "Containers/Queue.hpp"
-#include "Threading/Synchronized.hpp"
+#include "Types/Unique.hpp"
 #include "Types/FundamentalTypes.hpp"
 
+#include "Threading/BoundedQueue.hpp"
+#include "Threading/SegmentedQueue.hpp"
+
 BEGIN_RUKEN_NAMESPACE
 
 /**
- * \brief Thread safe queue encapsulation
+ * \brief Thread safe, lock free, multi producer multi consumer queue encapsulation.
+ *
+ * The storage of the queue is either unbounded (SegmentedQueue, default) or bounded (BoundedQueue):
+ * \code
+ * ThreadSafeQueue<LogRecord>                          unbounded_queue;
+ * ThreadSafeQueue<LogRecord, BoundedQueue<LogRecord>> bounded_queue(4096);
+ * \endcode
+ *
  * \tparam TType Type contained into the queue
+ * \tparam TStorage Underlying lock free queue, providing TryEnqueue, TryDequeue and Empty
+ *
+ * \note Unlike ThreadSafeLockQueue, this queue never blocks, consumers have to poll it
  */
-template <typename TType>
-class ThreadSafeQueue
+template <typename TType, typename TStorage = SegmentedQueue<TType>>
+class ThreadSafeQueue : Unique
 {
     private:
 
         #pragma region Members
 
-        Synchronized<Queue<TType>> m_queue;
-
-        using QueueReadAccess  = decltype(m_queue)::ReadAccess;
-        using QueueWriteAccess = decltype(m_queue)::WriteAccess;
+        TStorage m_queue;
 
         #pragma endregion
 
@@ -54,10 +66,17 @@ class ThreadSafeQueue
 
         #pragma region Constructors
 
-        ThreadSafeQueue()                                    = default;
-        ThreadSafeQueue(ThreadSafeQueue const& in_copy)        = default;
-        ThreadSafeQueue(ThreadSafeQueue&& in_move) noexcept = default;
-        ~ThreadSafeQueue()                                    = default;
+        ThreadSafeQueue() = default;
+
+        /**
+         * \brief Bounded thread safe queue constructor
+         * \param in_capacity Capacity of the queue, see BoundedQueue
+         */
+        explicit ThreadSafeQueue(RkSize in_capacity);
+
+        ThreadSafeQueue(ThreadSafeQueue const& in_copy) = delete;
+        ThreadSafeQueue(ThreadSafeQueue&&      in_move) = delete;
+        ~ThreadSafeQueue()                              = default;
 
         #pragma endregion
 
@@ -66,32 +85,41 @@ class ThreadSafeQueue
         /**
          * \brief Checks if the queue is empty
          * \return True if the queue is empty, false otherwise
+         * \note The result is only a snapshot and might be outdated as soon as this method returns
          */
+        [[nodiscard]]
         RkBool Empty() const noexcept;
 
         /**
-         * \brief Enqueue an item
+         * \brief Enqueues an item. If the queue is bounded and full, yields until a consumer makes some room
          * \param in_item Item to enqueue
          */
         RkVoid Enqueue(TType&& in_item) noexcept;
 
+        /**
+         * \brief Tries to enqueue an item
+         * \param in_item Item to enqueue, left untouched on failure
+         * \return True if the item has been enqueued, false if the queue is bounded and full
+         */
+        RkBool TryEnqueue(TType&& in_item) noexcept;
+
         /**
          * \brief Tries to dequeue an item
-         * \warning If the queue is empty, the result of this function and the content of out_item are undefined
          * \param out_item Dequeued item
+         * \return True if the content of out_item is valid, false if the queue was empty
          */
-        RkVoid Dequeue(TType& out_item) noexcept;
+        RkBool Dequeue(TType& out_item) noexcept;
 
         #pragma endregion
 
         #pragma region Operators
 
-        ThreadSafeQueue& operator=(ThreadSafeQueue const& in_copy)        = default;
-        ThreadSafeQueue& operator=(ThreadSafeQueue&& in_move) noexcept    = default;
+        ThreadSafeQueue& operator=(ThreadSafeQueue const& in_copy) = delete;
+        ThreadSafeQueue& operator=(ThreadSafeQueue&&      in_move) = delete;
 
         #pragma endregion
 };
 
 #include "Threading/ThreadSafeQueue.inl"
 
-END_RUKEN_NAMESPACE
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+#include "Build/Config.hpp"
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Lock free work stealing deque (Chase-Lev).
+ *
+ * The owner thread pushes and pops items at the bottom of the deque (LIFO, cache friendly)
+ * while any other thread may steal items from the top (FIFO).
+ * The underlying ring buffer grows automatically, retired buffers are kept alive until the
+ * destruction of the deque since thieves might still be reading from them.
+ *
+ * \tparam TType Type contained into the deque, must be trivially copyable (usually a pointer)
+ *
+ * \see "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Zappa Nardelli)
+ */
+template <typename TType>
+class WorkStealingQueue : Unique
+{
+    static_assert(std::is_trivially_copyable_v<TType>, "TType must be trivially copyable");
+
+    private:
+
+        /**
+         * \brief Circular buffer used by the deque
+         */
+        struct Buffer
+        {
+            RkInt64                              mask;
+            std::unique_ptr<std::atomic<TType>[]> items;
+
+            explicit Buffer(RkInt64 in_capacity);
+
+            RkInt64 Capacity()                             const noexcept;
+            TType   Load    (RkInt64 in_index)             const noexcept;
+            RkVoid  Store   (RkInt64 in_index, TType in_item)    noexcept;
+        };
+
+        #pragma region Members
+
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkInt64> m_top;
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<RkInt64> m_bottom;
+        alignas(RUKEN_THREADING_CACHE_LINE_SIZE) std::atomic<Buffer*> m_buffer;
+
+        // Owner only, every buffer ever allocated by the deque
+        std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Doubles the capacity of the deque
+         * \param in_top Current top index
+         * \param in_bottom Current bottom index
+         * \return New buffer
+         */
+        Buffer* Grow(RkInt64 in_top, RkInt64 in_bottom);
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Work stealing queue constructor
+         * \param in_capacity Initial capacity of the deque, must be a power of 2
+         */
+        explicit WorkStealingQueue(RkInt64 in_capacity = 1024);
+
+        WorkStealingQueue(WorkStealingQueue const& in_copy) = delete;
+        WorkStealingQueue(WorkStealingQueue&&      in_move) = delete;
+        ~WorkStealingQueue()                                = default;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Pushes an item at the bottom of the deque
+         * \param in_item Item to push
+         * \warning This method must only be called by the owner thread of the deque
+         */
+        RkVoid Push(TType in_item);
+
+        /**
+         * \brief Pops an item from the bottom of the deque
+         * \param out_item Popped item
+         * \return True if the content of out_item is valid, false if the deque was empty
+         * \warning This method must only be called by the owner thread of the deque
+         */
+        RkBool Pop(TType& out_item) noexcept;
+
+        /**
+         * \brief Steals an item from the top of the deque
+         * \param out_item Stolen item
+         * \return True if the content of out_item is valid, false if the deque was empty or if another thread won the race
+         * \note This method may be called from any thread
+         */
+        RkBool Steal(TType& out_item) noexcept;
+
+        /**
+         * \brief Checks if the deque is empty
+         * \return True if the deque is empty, false otherwise
+         * \note The result is only a snapshot and might be outdated as soon as this method returns
+         */
+        [[nodiscard]]
+        RkBool Empty() const noexcept;
+
+        /**
+         * \brief Returns the approximative number of items in the deque
+         * \return Items count
+         */
+        [[nodiscard]]
+        RkSize Size() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        WorkStealingQueue& operator=(WorkStealingQueue const& in_copy) = delete;
+        WorkStealingQueue& operator=(WorkStealingQueue&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+#include "Threading/WorkStealingQueue.inl"
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -26,14 +26,21 @@
 
 #include <thread>
 #include <string>
+#include <vector>
+#include <functional>
 
+#include "Build/Config.hpp"
 #include "Build/Namespace.hpp"
 
 #include "Types/NonCopyable.hpp"
 #include "Types/FundamentalTypes.hpp"
 
+#include "Threading/EThreadPriority.hpp"
+
 BEGIN_RUKEN_NAMESPACE
 
+class Logger;
+
 class Worker : NonCopyable
 {
     private:
@@ -42,12 +49,35 @@ class Worker : NonCopyable
 
         std::thread m_thread;
 
+        // Applied to the underlying thread every time a new job gets executed
+        std::vector<RkUint32> m_affinity;
+        EThreadPriority       m_priority;
+
+        // Reports the affinities which couldn't be applied, may be null
+        Logger const* m_logger;
+
         #ifdef RUKEN_THREADING_ENABLE_THREAD_LABELS
             std::string m_label;
         #endif
 
         #pragma endregion
 
+        #pragma region Methods
+
+        /**
+         * \brief Applies the affinity and the priority of a worker to the calling thread
+         * \param in_affinity Affinity of the worker
+         * \param in_priority Priority of the worker
+         * \param in_logger Logger reporting an affinity which couldn't be applied, may be null
+         * \param in_label Label of the worker, used by the report
+         */
+        static RkVoid ApplyToCurrentThread(std::vector<RkUint32> const& in_affinity,
+                                           EThreadPriority              in_priority,
+                                           Logger const*                in_logger,
+                                           std::string const&           in_label) noexcept;
+
+        #pragma endregion
+
     public:
 
         #pragma region Constructors
@@ -63,6 +93,56 @@ class Worker : NonCopyable
 
         #pragma region Methods
 
+        /**
+         * \brief Restricts the calling thread to a set of logical processors
+         * \param in_processors Indices of the allowed logical processors, an empty set allows every processor
+         * \return True if the affinity has been applied, false if it isn't supported or if the call failed
+         */
+        static RkBool SetCurrentThreadAffinity(std::vector<RkUint32> const& in_processors) noexcept;
+
+        /**
+         * \brief Changes the scheduling priority of the calling thread
+         * \param in_priority New priority
+         * \return True if the priority has been applied, false if it isn't supported or if the call failed
+         * \note Raising the priority above normal might require elevated privileges on Linux
+         */
+        static RkBool SetCurrentThreadPriority(EThreadPriority in_priority) noexcept;
+
+        /**
+         * \brief Sets the logical processors the worker is allowed to run on
+         * \param in_processors Indices of the allowed logical processors, an empty set allows every processor
+         * \note The affinity is applied to the next executed jobs
+         */
+        RkVoid SetAffinity(std::vector<RkUint32> const& in_processors) noexcept;
+
+        /**
+         * \brief Returns the logical processors the worker is allowed to run on
+         * \return Allowed logical processors, empty if the worker isn't pinned
+         */
+        [[nodiscard]]
+        std::vector<RkUint32> const& GetAffinity() const noexcept;
+
+        /**
+         * \brief Sets the logger reporting the affinities which couldn't be applied to the worker
+         * \param in_logger Logger, null to ignore these failures
+         * \note The logger is used by the next executed jobs
+         */
+        RkVoid SetLogger(Logger const* in_logger) noexcept;
+
+        /**
+         * \brief Sets the scheduling priority of the worker
+         * \param in_priority Priority
+         * \note The priority is applied to the next executed jobs
+         */
+        RkVoid SetPriority(EThreadPriority in_priority) noexcept;
+
+        /**
+         * \brief Returns the scheduling priority of the worker
+         * \return Priority
+         */
+        [[nodiscard]]
+        EThreadPriority GetPriority() const noexcept;
+
         #ifdef RUKEN_THREADING_ENABLE_THREAD_LABELS
 
         /**
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <utility>
 #include <type_traits>
 
 #include "Build/Namespace.hpp"
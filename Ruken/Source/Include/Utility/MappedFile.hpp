@@ -0,0 +1,105 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "Build/Namespace.hpp"
+
+#include "Types/Unique.hpp"
+#include "Types/FundamentalTypes.hpp"
+
+BEGIN_RUKEN_NAMESPACE
+
+/**
+ * \brief Read only view of a whole file, mapped into memory.
+ *
+ * Pages of the file are loaded by the operating system as they get accessed and are shared with its file cache,
+ * reading a mapped file doesn't copy it into an intermediate buffer.
+ *
+ * Implemented on top of file mappings on Windows and of mmap on Linux.
+ */
+class MappedFile : Unique
+{
+    private:
+
+        #pragma region Members
+
+        RkUint8 const* m_data;
+        RkSize         m_size;
+
+        #pragma endregion
+
+    public:
+
+        #pragma region Constructors
+
+        /**
+         * \brief Maps a file into memory
+         * \param in_path Path of the file
+         * \note If the file cannot be opened, or is empty, the mapping is invalid (see IsValid)
+         */
+        explicit MappedFile(std::string_view in_path) noexcept;
+
+        MappedFile(MappedFile const& in_copy) = delete;
+        MappedFile(MappedFile&&      in_move) = delete;
+        ~MappedFile() noexcept;
+
+        #pragma endregion
+
+        #pragma region Methods
+
+        /**
+         * \brief Checks if the file has been mapped
+         * \return True if the file has been mapped
+         */
+        [[nodiscard]]
+        RkBool IsValid() const noexcept;
+
+        /**
+         * \brief Returns the content of the file
+         * \return Mapped content, aligned on a page boundary. Null if the mapping is invalid
+         */
+        [[nodiscard]]
+        RkUint8 const* GetData() const noexcept;
+
+        /**
+         * \brief Returns the size of the file
+         * \return Size in bytes
+         */
+        [[nodiscard]]
+        RkSize GetSize() const noexcept;
+
+        #pragma endregion
+
+        #pragma region Operators
+
+        MappedFile& operator=(MappedFile const& in_copy) = delete;
+        MappedFile& operator=(MappedFile&&      in_move) = delete;
+
+        #pragma endregion
+};
+
+END_RUKEN_NAMESPACE
\ No newline at end of file
@@ -71,6 +71,7 @@ class VulkanFence
          * \brief If the condition is satisfied when this function is called, then it returns immediately.
          *        If the condition is not satisfied at the time this function is called,
          *        then this function will block and wait for the condition to become satisfied.
+         * \note Called from a job of the scheduler, the job is suspended instead and its worker executes other jobs in the meantime
          */
         RkVoid Wait() const noexcept;
 
@@ -133,6 +133,12 @@ constexpr RkSize SizedBitmask<TSize, TChunk>::HashCode() const noexcept
     return hash;
 }
 
+template <RkSize TSize, typename TChunk>
+constexpr TChunk SizedBitmask<TSize, TChunk>::GetChunk(RkSize const in_index) const noexcept
+{
+    return m_data[in_index];
+}
+
 template <RkSize TSize, typename TChunk>
 template <typename TLambdaType, typename TPreCast>
 constexpr RkVoid SizedBitmask<TSize, TChunk>::Foreach(TLambdaType in_lambda) const noexcept
@@ -0,0 +1,61 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TType, RkSize TAlignment>
+template <typename TOther>
+constexpr AlignedAllocator<TType, TAlignment>::AlignedAllocator(AlignedAllocator<TOther, TAlignment> const&) noexcept
+{}
+
+template <typename TType, RkSize TAlignment>
+constexpr RkSize AlignedAllocator<TType, TAlignment>::GetPaddedSize(RkSize const in_count) noexcept
+{
+    return (in_count * sizeof(TType) + TAlignment - 1u) & ~(TAlignment - 1u);
+}
+
+template <typename TType, RkSize TAlignment>
+TType* AlignedAllocator<TType, TAlignment>::allocate(RkSize const in_count)
+{
+    return static_cast<TType*>(::operator new(GetPaddedSize(in_count), std::align_val_t(TAlignment)));
+}
+
+template <typename TType, RkSize TAlignment>
+RkVoid AlignedAllocator<TType, TAlignment>::deallocate(TType* in_data, RkSize) noexcept
+{
+    ::operator delete(in_data, std::align_val_t(TAlignment));
+}
+
+template <typename TType, RkSize TAlignment>
+template <typename TOther>
+constexpr RkBool AlignedAllocator<TType, TAlignment>::operator==(AlignedAllocator<TOther, TAlignment> const&) const noexcept
+{
+    // Stateless allocator, any instance can release the storage allocated by another one
+    return true;
+}
+
+template <typename TType, RkSize TAlignment>
+template <typename TOther>
+constexpr RkBool AlignedAllocator<TType, TAlignment>::operator!=(AlignedAllocator<TOther, TAlignment> const&) const noexcept
+{
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TType, RkSize TAlignment>
+AlignedSpan<TType, TAlignment>::AlignedSpan(TType* in_data, RkSize const in_size) noexcept:
+    m_data {in_data},
+    m_size {in_size}
+{
+    RUKEN_ASSERT_MESSAGE((reinterpret_cast<RkSize>(in_data) & (TAlignment - 1u)) == 0u, "The storage of an aligned span must be aligned");
+}
+
+template <typename TType, RkSize TAlignment>
+TType* AlignedSpan<TType, TAlignment>::Data() const noexcept
+{
+    return m_data;
+}
+
+template <typename TType, RkSize TAlignment>
+RkSize AlignedSpan<TType, TAlignment>::Size() const noexcept
+{
+    return m_size;
+}
+
+template <typename TType, RkSize TAlignment>
+RkSize AlignedSpan<TType, TAlignment>::PaddedSize() const noexcept
+{
+    return ((m_size * sizeof(TType) + TAlignment - 1u) & ~(TAlignment - 1u)) / sizeof(TType);
+}
+
+template <typename TType, RkSize TAlignment>
+TType& AlignedSpan<TType, TAlignment>::operator[](RkSize const in_index) const noexcept
+{
+    return m_data[in_index];
+}
\ No newline at end of file
@@ -46,14 +46,10 @@ RkVoid FileHandler::Flush()
     if (!m_stream.is_open())
         return;
 
-    while (!m_records.Empty())
-    {
-        LogRecord record;
-
-        m_records.Dequeue(record);
+    LogRecord record;
 
+    while (m_records.Dequeue(record))
         m_stream << m_formatter.Format(record);
-    }
 }
 
 #pragma endregion
\ No newline at end of file
@@ -41,14 +41,10 @@ StreamHandler::StreamHandler(LogFormatter const& in_formatter, std::ostream cons
 
 RkVoid StreamHandler::Flush()
 {
-    while (!m_records.Empty())
-    {
-        LogRecord record;
-
-        m_records.Dequeue(record);
+    LogRecord record;
 
+    while (m_records.Dequeue(record))
         m_stream << m_formatter.Format(record);
-    }
 }
 
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,391 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <cstring>
+#include <algorithm>
+
+#include "Meta/Assert.hpp"
+
+#include "ECS/Archetype.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    /**
+     * \brief Fills a column with copies of a value
+     * \param out_column Start of the filled values
+     * \param in_value Value to copy
+     * \param in_size Size in bytes of the value
+     * \param in_count Number of copies
+     */
+    RkVoid FillColumn(RkUint8* out_column, RkUint8 const* in_value, RkSize const in_size, RkSize const in_count) noexcept
+    {
+        RkSize const total_size = in_size * in_count;
+
+        if (total_size == 0u)
+            return;
+
+        if (std::all_of(in_value, in_value + in_size, [] (RkUint8 const in_byte) { return in_byte == 0u; }))
+        {
+            std::memset(out_column, 0, total_size);
+            return;
+        }
+
+        // Doubling the filled part at each copy, which always holds a whole number of values
+        std::memcpy(out_column, in_value, in_size);
+
+        for (RkSize filled_size = in_size; filled_size < total_size;)
+        {
+            RkSize const copy_size = std::min(filled_size, total_size - filled_size);
+
+            std::memcpy(out_column + filled_size, out_column, copy_size);
+
+            filled_size += copy_size;
+        }
+    }
+}
+
+Archetype::Archetype(ChunkPool&                                     in_chunk_pool,
+                     RkUint32                                const& in_version,
+                     std::vector<ComponentDescriptor const*> const& in_components,
+                     SharedValues                            const& in_shared_values) noexcept:
+    m_fingerprint       {},
+    m_chunk_pool        {in_chunk_pool},
+    m_version           {in_version},
+    m_columns           {},
+    m_chunks            {},
+    m_chunk_capacity    {0u},
+    m_entities_count    {0u},
+    m_versions_offset   {0u},
+    m_component_columns {},
+    m_add_edges         {},
+    m_remove_edges      {},
+    m_shared_values     {}
+{
+    m_component_columns.fill(invalid_column);
+    m_shared_values    .fill(nullptr);
+
+    m_columns.push_back(Column {entity_column, 0u, sizeof(EntityID), 0u, nullptr});
+
+    RkSize row_size = sizeof(EntityID);
+
+    for (ComponentDescriptor const* component : in_components)
+    {
+        m_fingerprint.Add(component->GetId());
+
+        // Shared values are stored once, outside of the chunks
+        if (component->IsShared())
+        {
+            m_shared_values[component->GetId()] = in_shared_values[component->GetId()];
+            continue;
+        }
+
+        m_component_columns[component->GetId()] = m_columns.size();
+
+        std::vector<ComponentDescriptor::Field> const& fields = component->GetFields();
+
+        for (RkSize field = 0u; field < fields.size(); ++field)
+        {
+            m_columns.push_back(Column {component->GetId(), field, fields[field].size, 0u, fields[field].default_value.data()});
+
+            row_size += fields[field].size;
+        }
+    }
+
+    // Filling the chunk as much as possible, columns alignment might require to give up a few entities
+    m_chunk_capacity = m_chunk_pool.GetChunkSize() / row_size;
+
+    while (m_chunk_capacity > 0u && LayoutColumns(m_chunk_capacity) > m_chunk_pool.GetChunkSize())
+        --m_chunk_capacity;
+
+    RUKEN_ASSERT_MESSAGE(m_chunk_capacity > 0u, "The components of an archetype don't fit into a single chunk, please increase the chunk size of the entity admin");
+}
+
+Archetype::~Archetype() noexcept
+{
+    for (ArchetypeChunk const& chunk : m_chunks)
+        m_chunk_pool.Release(chunk.data);
+}
+
+RkSize Archetype::LayoutColumns(RkSize const in_capacity) noexcept
+{
+    RkSize offset = 0u;
+
+    for (Column& column : m_columns)
+    {
+        offset        = (offset + RUKEN_ECS_COLUMN_ALIGNMENT - 1u) & ~RkSize(RUKEN_ECS_COLUMN_ALIGNMENT - 1u);
+        column.offset = offset;
+        offset       += column.size * in_capacity;
+    }
+
+    // Every column, including the last one, is padded up to the column alignment
+    m_versions_offset = (offset + RUKEN_ECS_COLUMN_ALIGNMENT - 1u) & ~RkSize(RUKEN_ECS_COLUMN_ALIGNMENT - 1u);
+
+    return m_versions_offset + 2u * m_columns.size() * sizeof(RkUint32);
+}
+
+ArchetypeFingerprint const& Archetype::GetFingerprint() const noexcept
+{
+    return m_fingerprint;
+}
+
+ArchetypeChunk& Archetype::GetInsertionChunk() noexcept
+{
+    if (m_chunks.empty() || m_chunks.back().count == m_chunk_capacity)
+        m_chunks.push_back(ArchetypeChunk {m_chunk_pool.Allocate(), 0u});
+
+    // Every component of the chunk is about to be added and changed
+    RkUint32* versions = GetVersions(m_chunks.back());
+
+    std::fill(versions, versions + 2u * m_columns.size(), m_version);
+
+    return m_chunks.back();
+}
+
+RkUint32* Archetype::GetVersions(ArchetypeChunk const& in_chunk) const noexcept
+{
+    return reinterpret_cast<RkUint32*>(in_chunk.data + m_versions_offset);
+}
+
+RkSize Archetype::CreateEntity(EntityID const in_entity) noexcept
+{
+    ArchetypeChunk& chunk = GetInsertionChunk();
+
+    std::memcpy(chunk.data + chunk.count * sizeof(EntityID), &in_entity, sizeof(EntityID));
+
+    for (RkSize index = 1u; index < m_columns.size(); ++index)
+    {
+        Column const& column = m_columns[index];
+
+        std::memcpy(chunk.data + column.offset + chunk.count * column.size, column.default_value, column.size);
+    }
+
+    ++chunk.count;
+
+    return m_entities_count++;
+}
+
+RkSize Archetype::CreateEntities(EntityRange const& in_entities) noexcept
+{
+    RkSize const first_row = m_entities_count;
+
+    m_chunks.reserve((m_entities_count + in_entities.Size() + m_chunk_capacity - 1u) / m_chunk_capacity);
+
+    for (RkSize created = 0u; created < in_entities.Size();)
+    {
+        ArchetypeChunk& chunk = GetInsertionChunk();
+        RkSize const    count = std::min(m_chunk_capacity - chunk.count, in_entities.Size() - created);
+
+        EntityID* entities = reinterpret_cast<EntityID*>(chunk.data) + chunk.count;
+
+        for (RkSize index = 0u; index < count; ++index)
+            entities[index] = in_entities[created + index];
+
+        for (RkSize index = 1u; index < m_columns.size(); ++index)
+        {
+            Column const& column = m_columns[index];
+
+            FillColumn(chunk.data + column.offset + chunk.count * column.size, column.default_value, column.size, count);
+        }
+
+        chunk.count      += count;
+        created          += count;
+        m_entities_count += count;
+    }
+
+    return first_row;
+}
+
+RkSize Archetype::CreateEntities(std::vector<RkUint8 const*> const& in_columns, RkSize const in_count) noexcept
+{
+    RUKEN_ASSERT_MESSAGE(in_columns.size() == m_columns.size(), "Every column of the archetype must be provided");
+
+    RkSize const first_row = m_entities_count;
+
+    m_chunks.reserve((m_entities_count + in_count + m_chunk_capacity - 1u) / m_chunk_capacity);
+
+    for (RkSize created = 0u; created < in_count;)
+    {
+        ArchetypeChunk& chunk = GetInsertionChunk();
+        RkSize const    count = std::min(m_chunk_capacity - chunk.count, in_count - created);
+
+        for (RkSize index = 0u; index < m_columns.size(); ++index)
+        {
+            Column const& column = m_columns[index];
+
+            std::memcpy(chunk.data + column.offset + chunk.count * column.size, in_columns[index] + created * column.size, count * column.size);
+        }
+
+        chunk.count      += count;
+        created          += count;
+        m_entities_count += count;
+    }
+
+    return first_row;
+}
+
+RkSize Archetype::CreateEntityFrom(Archetype const& in_source, RkSize const in_source_row) noexcept
+{
+    ArchetypeChunk&       chunk        = GetInsertionChunk();
+    ArchetypeChunk const& source_chunk = in_source.m_chunks[in_source_row / in_source.m_chunk_capacity];
+
+    RkSize const source_row = in_source_row % in_source.m_chunk_capacity;
+
+    // The entity column is the first one of both archetypes
+    std::memcpy(chunk.data + chunk.count * sizeof(EntityID), source_chunk.data + source_row * sizeof(EntityID), sizeof(EntityID));
+
+    for (RkSize index = 1u; index < m_columns.size(); ++index)
+    {
+        Column const& column        = m_columns[index];
+        RkUint8*      target        = chunk.data + column.offset + chunk.count * column.size;
+        RkSize const  source_column = in_source.m_component_columns[column.component_id];
+
+        if (source_column == invalid_column)
+        {
+            std::memcpy(target, column.default_value, column.size);
+        }
+        else
+        {
+            Column const& source = in_source.m_columns[source_column + column.field];
+
+            std::memcpy(target, source_chunk.data + source.offset + source_row * source.size, column.size);
+        }
+    }
+
+    ++chunk.count;
+
+    return m_entities_count++;
+}
+
+EntityID Archetype::DestroyEntity(RkSize const in_row) noexcept
+{
+    ArchetypeChunk& last_chunk = m_chunks.back();
+    ArchetypeChunk& chunk      = m_chunks[in_row / m_chunk_capacity];
+
+    RkSize const row      = in_row % m_chunk_capacity;
+    RkSize const last_row = last_chunk.count - 1u;
+
+    EntityID moved_entity;
+
+    if (&chunk != &last_chunk || row != last_row)
+    {
+        for (Column const& column : m_columns)
+            std::memcpy(chunk.data + column.offset + row * column.size, last_chunk.data + column.offset + last_row * column.size, column.size);
+
+        // The row now holds another entity, every component of the chunk changed
+        RkUint32* versions = GetVersions(chunk);
+
+        std::fill(versions, versions + m_columns.size(), m_version);
+
+        moved_entity = GetEntities(in_row / m_chunk_capacity)[row];
+    }
+
+    --m_entities_count;
+
+    if (--last_chunk.count == 0u)
+    {
+        m_chunk_pool.Release(last_chunk.data);
+        m_chunks.pop_back();
+    }
+
+    return moved_entity;
+}
+
+RkSize Archetype::EntitiesCount() const noexcept
+{
+    return m_entities_count;
+}
+
+RkSize Archetype::GetChunkCapacity() const noexcept
+{
+    return m_chunk_capacity;
+}
+
+RkSize Archetype::GetColumnsCount() const noexcept
+{
+    return m_columns.size();
+}
+
+RkSize Archetype::GetChunksCount() const noexcept
+{
+    return m_chunks.size();
+}
+
+ArchetypeChunk const& Archetype::GetChunk(RkSize const in_chunk) const noexcept
+{
+    return m_chunks[in_chunk];
+}
+
+EntityID const* Archetype::GetEntities(RkSize const in_chunk) const noexcept
+{
+    // The entity column is the first one, at the very start of the chunk
+    return reinterpret_cast<EntityID const*>(m_chunks[in_chunk].data);
+}
+
+Archetype::SharedValues const& Archetype::GetSharedValues() const noexcept
+{
+    return m_shared_values;
+}
+
+RkUint32 Archetype::GetChangeVersion(RkSize const in_chunk, RkSize const in_component_id) const noexcept
+{
+    return GetVersions(m_chunks[in_chunk])[m_component_columns[in_component_id]];
+}
+
+RkVoid Archetype::SetChangeVersion(RkSize const in_chunk, RkSize const in_component_id, RkUint32 const in_version) noexcept
+{
+    GetVersions(m_chunks[in_chunk])[m_component_columns[in_component_id]] = in_version;
+}
+
+RkUint32 Archetype::GetAddVersion(RkSize const in_chunk, RkSize const in_component_id) const noexcept
+{
+    return GetVersions(m_chunks[in_chunk])[m_columns.size() + m_component_columns[in_component_id]];
+}
+
+Archetype* Archetype::GetAddEdge(RkSize const in_component_id) const noexcept
+{
+    return m_add_edges[in_component_id];
+}
+
+Archetype* Archetype::GetRemoveEdge(RkSize const in_component_id) const noexcept
+{
+    return m_remove_edges[in_component_id];
+}
+
+RkVoid Archetype::LinkAddEdge(RkSize const in_component_id, Archetype& in_target) noexcept
+{
+    m_add_edges              [in_component_id] = &in_target;
+    in_target.m_remove_edges [in_component_id] = this;
+}
+
+RkUint8* Archetype::GetColumn(RkSize const in_chunk, RkSize const in_component_id, RkSize const in_field) const noexcept
+{
+    RkSize const column = m_component_columns[in_component_id];
+
+    if (column == invalid_column)
+        return nullptr;
+
+    return m_chunks[in_chunk].data + m_columns[column + in_field].offset;
+}
\ No newline at end of file
@@ -22,43 +22,30 @@
  *  SOFTWARE.
  */
 
-template <typename... TComponents>
-template <RkSize... TIds>
-EntityID Archetype<TComponents...>::CreateEntityHelper(std::index_sequence<TIds...>) noexcept
+template <typename TComponent, RkSize... TIds>
+TComponent Archetype::GetComponentHelper(RkSize const in_chunk, std::index_sequence<TIds...>) const noexcept
 {
-	(std::get<TIds>(m_components).CreateItem(), ...);
-    return EntityID {EntitiesCount() - 1};
-}
+    using Columns = typename TComponent::Layout::ContainerType;
 
-template <typename ... TComponents>
-Archetype<TComponents...>::Archetype():
-    m_components {}
-{
-    m_fingerprint = ArchetypeFingerprint::CreateFingerPrintFrom<TComponents...>(); 
+    return TComponent(Columns {reinterpret_cast<typename TComponent::Item::template FieldType<TIds>*>(GetColumn(in_chunk, TComponent::id, TIds))...},
+                      m_chunks[in_chunk].count);
 }
 
-template <typename ... TComponents>
-template <typename TComponent>
-auto Archetype<TComponents...>::GetComponent() noexcept
+template <typename TComponent, RkSize... TIds>
+TComponent Archetype::GetSharedComponentHelper(std::index_sequence<TIds...>) const noexcept
 {
-    return std::reference_wrapper(std::get<TComponent>(m_components));
-}
+    using Fields = typename TComponent::Layout::ContainerType;
 
-template <typename ... TComponents>
-template <RkSize TIndex>
-auto Archetype<TComponents...>::GetComponent() noexcept
-{
-    return std::reference_wrapper(std::get<TIndex>(m_components));
-}
+    std::vector<ComponentDescriptor::Field> const& fields = ComponentDescriptor::Get<TComponent>().GetFields();
 
-template <typename ... TComponents>
-EntityID Archetype<TComponents...>::CreateEntity() noexcept
-{
-    return CreateEntityHelper(std::make_index_sequence<sizeof...(TComponents)>());
+    return TComponent(Fields {reinterpret_cast<typename TComponent::Item::template FieldType<TIds> const*>(m_shared_values[TComponent::id] + fields[TIds].offset)...});
 }
 
-template <typename ... TComponents>
-RkSize Archetype<TComponents...>::EntitiesCount() const noexcept
+template <typename TComponent>
+TComponent Archetype::GetComponent(RkSize const in_chunk) const noexcept
 {
-    return std::get<0>(m_components).GetItemCount();
+    if constexpr (TComponent::shared)
+        return GetSharedComponentHelper<TComponent>(std::make_index_sequence<TComponent::Item::fields_count>());
+    else
+        return GetComponentHelper<TComponent>(in_chunk, std::make_index_sequence<TComponent::Item::fields_count>());
 }
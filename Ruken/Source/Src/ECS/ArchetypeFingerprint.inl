@@ -26,7 +26,9 @@ template <typename... TComponents>
 ArchetypeFingerprint ArchetypeFingerprint::CreateFingerPrintFrom() noexcept
 {
     ArchetypeFingerprint fingerprint;
-    (fingerprint.Add(TComponents::id), ...);
+
+    // Sparse components are not stored into the archetypes
+    ((TComponents::sparse ? RkVoid() : fingerprint.Add(TComponents::id)), ...);
 
     return fingerprint;
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <new>
+#include <algorithm>
+
+#include "Meta/Assert.hpp"
+
+#include "ECS/ChunkPool.hpp"
+
+USING_RUKEN_NAMESPACE
+
+ChunkPool::ChunkPool(RkSize const in_chunk_size) noexcept:
+    m_chunk_size       {in_chunk_size},
+    m_chunks_per_block {std::max<RkSize>(RUKEN_ECS_CHUNK_BLOCK_SIZE / in_chunk_size, 1u)},
+    m_mutex            {},
+    m_blocks           {},
+    m_free_chunks      {}
+{
+    RUKEN_ASSERT_MESSAGE(m_chunk_size > 0u && m_chunk_size % RUKEN_ECS_COLUMN_ALIGNMENT == 0u, "The size of the chunks must be a multiple of RUKEN_ECS_COLUMN_ALIGNMENT");
+}
+
+ChunkPool::~ChunkPool() noexcept
+{
+    for (RkUint8* block : m_blocks)
+        ::operator delete(block, std::align_val_t(RUKEN_ECS_COLUMN_ALIGNMENT));
+}
+
+RkVoid ChunkPool::Grow() noexcept
+{
+    RkUint8* block = static_cast<RkUint8*>(::operator new(m_chunk_size * m_chunks_per_block, std::align_val_t(RUKEN_ECS_COLUMN_ALIGNMENT)));
+
+    m_blocks.push_back(block);
+
+    // Pushing the chunks in reverse order so they get allocated in address order
+    for (RkSize index = m_chunks_per_block; index > 0u; --index)
+        m_free_chunks.push_back(block + (index - 1u) * m_chunk_size);
+}
+
+RkUint8* ChunkPool::Allocate() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_free_chunks.empty())
+        Grow();
+
+    RkUint8* chunk = m_free_chunks.back();
+
+    m_free_chunks.pop_back();
+
+    return chunk;
+}
+
+RkVoid ChunkPool::Release(RkUint8* in_chunk) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_free_chunks.push_back(in_chunk);
+}
+
+RkSize ChunkPool::GetChunkSize() const noexcept
+{
+    return m_chunk_size;
+}
+
+RkSize ChunkPool::GetCapacity() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_blocks.size() * m_chunks_per_block;
+}
\ No newline at end of file
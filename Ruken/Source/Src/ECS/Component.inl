@@ -23,23 +23,67 @@
  */
 
 template <typename TItem, RkSize TUniqueId>
-typename Component<TItem, TUniqueId>::ItemId Component<TItem, TUniqueId>::CreateItem(TItem&& in_item)
+Component<TItem, TUniqueId>::Component(typename Layout::ContainerType const& in_storage, RkSize const in_count) noexcept:
+    m_storage {in_storage},
+    m_count   {in_count}
+{}
+
+template <typename TItem, RkSize TUniqueId>
+RkSize Component<TItem, TUniqueId>::GetItemCount() const noexcept
+{
+    return m_count;
+}
+
+template <typename TItem, RkSize TUniqueId>
+template <typename TView>
+auto Component<TItem, TUniqueId>::GetItem(ItemId const in_item_id) noexcept
 {
-    Layout::PushBack(m_storage, std::forward<TItem>(in_item));
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
 
-    return ItemId(Layout::Size(m_storage) - 1);
+    return Layout::template Get<TView>(m_storage, in_item_id);
 }
 
 template <typename TItem, RkSize TUniqueId>
-typename Component<TItem, TUniqueId>::ItemId Component<TItem, TUniqueId>::CreateItem()
+RkVoid Component<TItem, TUniqueId>::SetItem(ItemId const in_item_id, TItem const& in_item) noexcept
 {
-    Layout::PushBack(m_storage, std::forward<TItem>(TItem{}));
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
 
-    return ItemId(Layout::Size(m_storage) - 1);
+    Layout::template Get<typename TItem::FullView>(m_storage, in_item_id) = in_item;
 }
 
 template <typename TItem, RkSize TUniqueId>
-RkSize Component<TItem, TUniqueId>::GetItemCount() const noexcept
+template <RkSize TMember>
+auto* Component<TItem, TUniqueId>::GetStorage() noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
+
+    return std::get<TMember>(m_storage);
+}
+
+template <typename TItem, RkSize TUniqueId>
+template <RkSize TMember>
+auto const* Component<TItem, TUniqueId>::GetStorage() const noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, false);
+
+    return std::get<TMember>(m_storage);
+}
+
+
+template <typename TItem, RkSize TUniqueId>
+template <RkSize TMember>
+AlignedSpan<typename TItem::template FieldType<TMember>, RUKEN_ECS_COLUMN_ALIGNMENT> Component<TItem, TUniqueId>::GetSpan() noexcept
 {
-    return Layout::Size(m_storage);
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
+
+    return AlignedSpan<typename TItem::template FieldType<TMember>, RUKEN_ECS_COLUMN_ALIGNMENT>(std::get<TMember>(m_storage), m_count);
 }
+
+template <typename TItem, RkSize TUniqueId>
+template <RkSize TMember>
+AlignedSpan<typename TItem::template FieldType<TMember> const, RUKEN_ECS_COLUMN_ALIGNMENT> Component<TItem, TUniqueId>::GetSpan() const noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, false);
+
+    return AlignedSpan<typename TItem::template FieldType<TMember> const, RUKEN_ECS_COLUMN_ALIGNMENT>(std::get<TMember>(m_storage), m_count);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Meta/Assert.hpp"
+
+#include "ECS/ComponentAccess.hpp"
+#include "ECS/SystemJobContext.hpp"
+
+USING_RUKEN_NAMESPACE
+
+RkBool ComponentAccess::CanRead(RkSize const in_component_id) const noexcept
+{
+    return m_read.HasOne(in_component_id) || m_write.HasOne(in_component_id);
+}
+
+RkBool ComponentAccess::CanWrite(RkSize const in_component_id) const noexcept
+{
+    return m_write.HasOne(in_component_id);
+}
+
+RkBool ComponentAccess::ConflictsWith(ComponentAccess const& in_other) const noexcept
+{
+    return m_write.HasOne(in_other.m_read) || m_write.HasOne(in_other.m_write) || in_other.m_write.HasOne(m_read);
+}
+
+#if defined(RUKEN_ECS_ENABLE_ACCESS_VALIDATION)
+
+RkVoid ComponentAccess::Validate(RkSize const in_component_id, RkBool const in_write) noexcept
+{
+    SystemJobContext const* context = SystemJobContext::GetCurrent();
+
+    // Accesses happening outside of any system are not checked
+    if (!context || !context->access)
+        return;
+
+    if (in_write)
+        RUKEN_ASSERT_MESSAGE(context->access->CanWrite(in_component_id), "A system wrote a component it didn't declare, or only declared as read only (const)");
+    else
+        RUKEN_ASSERT_MESSAGE(context->access->CanRead(in_component_id), "A system read a component it didn't declare");
+}
+
+#endif
\ No newline at end of file
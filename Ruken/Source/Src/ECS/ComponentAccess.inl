@@ -22,11 +22,18 @@
  *  SOFTWARE.
  */
 
-#include "ECS/ArchetypeBase.hpp"
+template <typename... TComponents>
+ComponentAccess ComponentAccess::CreateFrom() noexcept
+{
+    ComponentAccess access;
 
-USING_RUKEN_NAMESPACE
+    access.Add<TComponents...>();
 
-ArchetypeFingerprint const& ArchetypeBase::GetFingerprint() const noexcept
-{
-    return m_fingerprint;
+    return access;
 }
+
+template <typename... TComponents>
+RkVoid ComponentAccess::Add() noexcept
+{
+    ((std::is_const_v<TComponents> ? m_read.Add(TComponents::id) : m_write.Add(TComponents::id)), ...);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "ECS/ComponentDescriptor.hpp"
+
+USING_RUKEN_NAMESPACE
+
+ComponentDescriptor::ComponentDescriptor() noexcept:
+    m_id        {RUKEN_MAX_ECS_COMPONENTS},
+    m_shared    {false},
+    m_sparse    {false},
+    m_item_size {0u},
+    m_fields    {}
+{}
+
+ComponentDescriptor::ComponentDescriptor(RkSize const in_id, RkBool const in_shared, RkBool const in_sparse, std::vector<Field>&& in_fields) noexcept:
+    m_id        {in_id},
+    m_shared    {in_shared},
+    m_sparse    {in_sparse},
+    m_item_size {0u},
+    m_fields    {std::move(in_fields)}
+{
+    // Laying out the fields of an item one after the other
+    for (Field& field : m_fields)
+    {
+        field.offset = (m_item_size + field.alignment - 1u) & ~(field.alignment - 1u);
+        m_item_size  = field.offset + field.size;
+    }
+}
+
+RkSize ComponentDescriptor::GetId() const noexcept
+{
+    return m_id;
+}
+
+std::vector<ComponentDescriptor::Field> const& ComponentDescriptor::GetFields() const noexcept
+{
+    return m_fields;
+}
+
+RkBool ComponentDescriptor::IsShared() const noexcept
+{
+    return m_shared;
+}
+
+RkBool ComponentDescriptor::IsSparse() const noexcept
+{
+    return m_sparse;
+}
+
+RkSize ComponentDescriptor::GetItemSize() const noexcept
+{
+    return m_item_size;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TField>
+ComponentDescriptor::Field ComponentDescriptor::CreateField(TField const& in_default_value) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<TField> && std::is_trivially_destructible_v<TField>,
+                  "Component fields are moved around as raw bytes, they must be trivially copyable and destructible");
+
+    static_assert(alignof(TField) <= RUKEN_ECS_COLUMN_ALIGNMENT, "Component fields cannot be aligned beyond RUKEN_ECS_COLUMN_ALIGNMENT");
+
+    RkUint8 const* bytes = reinterpret_cast<RkUint8 const*>(&in_default_value);
+
+    return Field {sizeof(TField), alignof(TField), 0u, std::vector<RkUint8>(bytes, bytes + sizeof(TField))};
+}
+
+template <typename TComponent, RkSize... TIds>
+ComponentDescriptor ComponentDescriptor::CreateHelper(std::index_sequence<TIds...>) noexcept
+{
+    typename TComponent::Item const default_item {};
+
+    return ComponentDescriptor(TComponent::id, TComponent::shared, TComponent::sparse, {CreateField<typename TComponent::Item::template FieldType<TIds>>(std::get<TIds>(default_item))...});
+}
+
+template <typename TComponent>
+ComponentDescriptor ComponentDescriptor::Create() noexcept
+{
+    return CreateHelper<TComponent>(std::make_index_sequence<TComponent::Item::fields_count>());
+}
+
+template <typename TComponent>
+ComponentDescriptor const& ComponentDescriptor::Get() noexcept
+{
+    static ComponentDescriptor const descriptor = Create<TComponent>();
+
+    return descriptor;
+}
\ No newline at end of file
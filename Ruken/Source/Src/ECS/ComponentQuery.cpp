@@ -22,12 +22,23 @@
  *  SOFTWARE.
  */
 
+#include <algorithm>
+
 #include "ECS/ComponentQuery.hpp"
-#include "ECS/ArchetypeBase.hpp"
+#include "ECS/Archetype.hpp"
 
 USING_RUKEN_NAMESPACE
 
-RkBool ComponentQuery::Match(ArchetypeBase const& in_archetype) const noexcept
+namespace
+{
+    // Versions wrap around, a version is newer than another if it is less than half the range ahead of it
+    RkBool IsNewer(RkUint32 const in_version, RkUint32 const in_reference) noexcept
+    {
+        return static_cast<RkInt32>(in_version - in_reference) > 0;
+    }
+}
+
+RkBool ComponentQuery::Match(Archetype const& in_archetype) const noexcept
 {
     // Checking inclusion
     if (!in_archetype.GetFingerprint().HasAll(m_included))
@@ -39,3 +50,57 @@ RkBool ComponentQuery::Match(ArchetypeBase const& in_archetype) const noexcept
 
     return true;
 }
+
+RkBool ComponentQuery::MatchChunk(Archetype const& in_archetype, RkSize const in_chunk, RkUint32 const in_version) const noexcept
+{
+    RkBool changed = m_changed_filter.empty();
+    RkBool added   = m_added_filter  .empty();
+
+    for (RkSize index = 0u; !changed && index < m_changed_filter.size(); ++index)
+        changed = IsNewer(in_archetype.GetChangeVersion(in_chunk, m_changed_filter[index]), in_version);
+
+    for (RkSize index = 0u; !added && index < m_added_filter.size(); ++index)
+        added = IsNewer(in_archetype.GetAddVersion(in_chunk, m_added_filter[index]), in_version);
+
+    return changed && added;
+}
+
+RkBool ComponentQuery::HasChunkFilter() const noexcept
+{
+    return !m_changed_filter.empty() || !m_added_filter.empty();
+}
+
+RkUint64 ComponentQuery::MatchEntities(EntityID const* in_entities, RkSize const in_count) const noexcept
+{
+    RUKEN_ASSERT_MESSAGE(m_included_sets.size() == m_sparse_included.size() && m_excluded_sets.size() == m_sparse_excluded.size(),
+                         "Sparse components can only be matched once the query has been registered by an entity admin");
+
+    RkUint64 mask = in_count == 64u ? ~RkUint64(0u) : (RkUint64(1u) << in_count) - 1u;
+
+    for (SparseSet const* set : m_included_sets)
+        mask &= set->MatchEntities(in_entities, in_count);
+
+    for (SparseSet const* set : m_excluded_sets)
+        mask &= ~set->MatchEntities(in_entities, in_count);
+
+    return mask;
+}
+
+RkBool ComponentQuery::HasSparseFilter() const noexcept
+{
+    return !m_sparse_included.empty() || !m_sparse_excluded.empty();
+}
+
+SparseSet const* ComponentQuery::GetSmallestSparseSet() const noexcept
+{
+    auto const smallest = std::min_element(m_included_sets.begin(), m_included_sets.end(), [] (SparseSet const* in_lhs, SparseSet const* in_rhs) {
+        return in_lhs->GetSize() < in_rhs->GetSize();
+    });
+
+    return smallest == m_included_sets.end() ? nullptr : *smallest;
+}
+
+std::vector<Archetype*> const& ComponentQuery::GetArchetypes() const noexcept
+{
+    return m_archetypes;
+}
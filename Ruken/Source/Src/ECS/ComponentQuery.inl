@@ -25,11 +25,84 @@
 template <typename ... TComponents>
 RkVoid ComponentQuery::SetupInclusionQuery() noexcept
 {
-    (m_included.Add(TComponents::id), ...);
+    ((TComponents::sparse ? m_sparse_included.push_back(TComponents::id) : m_included.Add(TComponents::id)), ...);
 }
 
 template <typename ... TComponents>
 RkVoid ComponentQuery::SetupExclusionQuery() noexcept
 {
-    (m_excluded.Add(TComponents::id), ...);
+    ((TComponents::sparse ? m_sparse_excluded.push_back(TComponents::id) : m_excluded.Add(TComponents::id)), ...);
+}
+
+template <typename ... TComponents>
+RkVoid ComponentQuery::SetupChangedFilter() noexcept
+{
+    RUKEN_STATIC_ASSERT((!TComponents::shared && ...), "Shared components are not versioned, archetypes are partitioned by their values instead");
+
+    RUKEN_STATIC_ASSERT((!TComponents::sparse && ...), "Sparse components are not versioned, they are not stored into the chunks");
+
+    RUKEN_ASSERT_MESSAGE(m_included.HasAll(TComponents::id...), "Filtered components must be required by the query");
+
+    (m_changed_filter.push_back(TComponents::id), ...);
+}
+
+template <typename ... TComponents>
+RkVoid ComponentQuery::SetupAddedFilter() noexcept
+{
+    RUKEN_STATIC_ASSERT((!TComponents::shared && ...), "Shared components are not versioned, archetypes are partitioned by their values instead");
+
+    RUKEN_STATIC_ASSERT((!TComponents::sparse && ...), "Sparse components are not versioned, they are not stored into the chunks");
+
+    RUKEN_ASSERT_MESSAGE(m_included.HasAll(TComponents::id...), "Filtered components must be required by the query");
+
+    (m_added_filter.push_back(TComponents::id), ...);
+}
+
+template <typename TFunction>
+RkVoid ComponentQuery::ForEachRange(EntityID const* in_entities, RkSize const in_count, TFunction&& in_function) const noexcept
+{
+    if (!HasSparseFilter())
+    {
+        if (in_count > 0u)
+            in_function(RkSize(0u), in_count);
+
+        return;
+    }
+
+    // First row of the range being built, in_count if there is none
+    RkSize begin = in_count;
+
+    for (RkSize block = 0u; block < in_count; block += 64u)
+    {
+        RkSize   const size = in_count - block < 64u ? in_count - block : 64u;
+        RkUint64 const full = size == 64u ? ~RkUint64(0u) : (RkUint64(1u) << size) - 1u;
+        RkUint64 const mask = MatchEntities(in_entities + block, size);
+
+        if (mask == full)
+        {
+            if (begin == in_count)
+                begin = block;
+
+            continue;
+        }
+
+        for (RkSize bit = 0u; bit < size; ++bit)
+        {
+            RkBool const match = (mask >> bit & 1u) != 0u;
+
+            if (match && begin == in_count)
+            {
+                begin = block + bit;
+            }
+            else if (!match && begin != in_count)
+            {
+                in_function(begin, block + bit);
+
+                begin = in_count;
+            }
+        }
+    }
+
+    if (begin != in_count)
+        in_function(begin, in_count);
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "Build/Config.hpp"
+
+#if defined(RUKEN_ECS_ENABLE_SIMD_MATCHING)
+    #include <emmintrin.h>
+#endif
+
+#include "ECS/Archetype.hpp"
+#include "ECS/ComponentQueryCache.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    using Chunk = decltype(ArchetypeFingerprint().GetChunk(0u));
+
+    #if defined(RUKEN_ECS_ENABLE_SIMD_MATCHING)
+
+    static_assert(sizeof(Chunk) == 8u, "SIMD matching expects 64 bits fingerprint chunks");
+
+    #endif
+
+    /**
+     * \brief Accumulates the mismatches of many queries against a chunk of the fingerprint of an archetype:
+     *        a required component is missing, or an excluded one is present
+     * \param in_included Chunk of the inclusion mask of every query
+     * \param in_excluded Chunk of the exclusion mask of every query
+     * \param in_fingerprint Chunk of the fingerprint of the archetype
+     * \param out_mismatches Mismatches of every query, any non zero value is a mismatch
+     * \param in_count Number of queries
+     */
+    RkVoid MatchQueries(Chunk const* in_included, Chunk const* in_excluded, Chunk const in_fingerprint, Chunk* out_mismatches, RkSize const in_count) noexcept
+    {
+        RkSize index = 0u;
+
+        #if defined(RUKEN_ECS_ENABLE_SIMD_MATCHING)
+
+        __m128i const fingerprint = _mm_set1_epi64x(static_cast<long long>(in_fingerprint));
+
+        for (; index + 2u <= in_count; index += 2u)
+        {
+            __m128i const included   = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in_included    + index));
+            __m128i const excluded   = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in_excluded    + index));
+            __m128i const mismatches = _mm_loadu_si128(reinterpret_cast<__m128i const*>(out_mismatches + index));
+
+            // _mm_andnot_si128(a, b) computes ~a & b
+            __m128i const missing   = _mm_andnot_si128(fingerprint, included);
+            __m128i const forbidden = _mm_and_si128   (fingerprint, excluded);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out_mismatches + index), _mm_or_si128(mismatches, _mm_or_si128(missing, forbidden)));
+        }
+
+        #endif
+
+        for (; index < in_count; ++index)
+            out_mismatches[index] |= (in_included[index] & ~in_fingerprint) | (in_excluded[index] & in_fingerprint);
+    }
+
+    /**
+     * \brief Accumulates the mismatches of a query against a chunk of the fingerprint of many archetypes
+     * \param in_fingerprints Chunk of the fingerprint of every archetype
+     * \param in_included Chunk of the inclusion mask of the query
+     * \param in_excluded Chunk of the exclusion mask of the query
+     * \param out_mismatches Mismatches of every archetype, any non zero value is a mismatch
+     * \param in_count Number of archetypes
+     */
+    RkVoid MatchArchetypes(Chunk const* in_fingerprints, Chunk const in_included, Chunk const in_excluded, Chunk* out_mismatches, RkSize const in_count) noexcept
+    {
+        RkSize index = 0u;
+
+        #if defined(RUKEN_ECS_ENABLE_SIMD_MATCHING)
+
+        __m128i const included = _mm_set1_epi64x(static_cast<long long>(in_included));
+        __m128i const excluded = _mm_set1_epi64x(static_cast<long long>(in_excluded));
+
+        for (; index + 2u <= in_count; index += 2u)
+        {
+            __m128i const fingerprints = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in_fingerprints + index));
+            __m128i const mismatches   = _mm_loadu_si128(reinterpret_cast<__m128i const*>(out_mismatches  + index));
+
+            __m128i const missing   = _mm_andnot_si128(fingerprints, included);
+            __m128i const forbidden = _mm_and_si128   (fingerprints, excluded);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out_mismatches + index), _mm_or_si128(mismatches, _mm_or_si128(missing, forbidden)));
+        }
+
+        #endif
+
+        for (; index < in_count; ++index)
+            out_mismatches[index] |= (in_included & ~in_fingerprints[index]) | (in_excluded & in_fingerprints[index]);
+    }
+}
+
+ComponentQueryCache::ComponentQueryCache() noexcept:
+    m_queries      {},
+    m_included     {},
+    m_excluded     {},
+    m_archetypes   {},
+    m_fingerprints {},
+    m_mismatches   {}
+{}
+
+RkVoid ComponentQueryCache::AddQuery(ComponentQuery& in_query) noexcept
+{
+    m_queries.push_back(&in_query);
+
+    for (RkSize chunk = 0u; chunk < chunks_count; ++chunk)
+    {
+        m_included[chunk].push_back(in_query.m_included.GetChunk(chunk));
+        m_excluded[chunk].push_back(in_query.m_excluded.GetChunk(chunk));
+    }
+
+    m_mismatches.assign(m_archetypes.size(), Chunk(0u));
+
+    for (RkSize chunk = 0u; chunk < chunks_count; ++chunk)
+        MatchArchetypes(m_fingerprints[chunk].data(), in_query.m_included.GetChunk(chunk), in_query.m_excluded.GetChunk(chunk), m_mismatches.data(), m_archetypes.size());
+
+    in_query.m_archetypes.clear();
+
+    for (RkSize index = 0u; index < m_archetypes.size(); ++index)
+    {
+        if (m_mismatches[index] == 0u)
+            in_query.m_archetypes.push_back(m_archetypes[index]);
+    }
+}
+
+RkVoid ComponentQueryCache::RemoveQuery(ComponentQuery& in_query) noexcept
+{
+    auto const found = std::find(m_queries.begin(), m_queries.end(), &in_query);
+
+    if (found == m_queries.end())
+        return;
+
+    RkSize const index = found - m_queries.begin();
+
+    // Swap and pop, the order of the queries doesn't matter
+    m_queries[index] = m_queries.back();
+    m_queries.pop_back();
+
+    for (RkSize chunk = 0u; chunk < chunks_count; ++chunk)
+    {
+        m_included[chunk][index] = m_included[chunk].back();
+        m_excluded[chunk][index] = m_excluded[chunk].back();
+
+        m_included[chunk].pop_back();
+        m_excluded[chunk].pop_back();
+    }
+
+    in_query.m_archetypes.clear();
+}
+
+RkVoid ComponentQueryCache::AddArchetype(Archetype& in_archetype) noexcept
+{
+    ArchetypeFingerprint const& fingerprint = in_archetype.GetFingerprint();
+
+    m_archetypes.push_back(&in_archetype);
+
+    for (RkSize chunk = 0u; chunk < chunks_count; ++chunk)
+        m_fingerprints[chunk].push_back(fingerprint.GetChunk(chunk));
+
+    m_mismatches.assign(m_queries.size(), Chunk(0u));
+
+    for (RkSize chunk = 0u; chunk < chunks_count; ++chunk)
+        MatchQueries(m_included[chunk].data(), m_excluded[chunk].data(), fingerprint.GetChunk(chunk), m_mismatches.data(), m_queries.size());
+
+    for (RkSize index = 0u; index < m_queries.size(); ++index)
+    {
+        if (m_mismatches[index] == 0u)
+            m_queries[index]->m_archetypes.push_back(&in_archetype);
+    }
+}
\ No newline at end of file
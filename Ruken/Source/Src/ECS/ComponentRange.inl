@@ -0,0 +1,56 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename... TComponents>
+ComponentRange<TComponents...>::ComponentRange(std::tuple<TComponents...> const& in_components, RkSize const in_begin, RkSize const in_end) noexcept:
+    m_components {in_components},
+    m_begin      {in_begin},
+    m_end        {in_end}
+{}
+
+template <typename... TComponents>
+template <typename TComponent>
+auto& ComponentRange<TComponents...>::Get() noexcept
+{
+    // Looking for the component regardless of its qualification
+    return std::get<SelectIndex<std::remove_const_t<TComponent>, std::remove_const_t<TComponents>...>>(m_components);
+}
+
+template <typename... TComponents>
+RkSize ComponentRange<TComponents...>::Begin() const noexcept
+{
+    return m_begin;
+}
+
+template <typename... TComponents>
+RkSize ComponentRange<TComponents...>::End() const noexcept
+{
+    return m_end;
+}
+
+template <typename... TComponents>
+RkSize ComponentRange<TComponents...>::Size() const noexcept
+{
+    return m_end - m_begin;
+}
\ No newline at end of file
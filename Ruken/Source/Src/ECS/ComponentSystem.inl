@@ -25,5 +25,80 @@
 template <typename... TComponents>
 ComponentSystem<TComponents...>::ComponentSystem() noexcept
 {
-    SetupTargetFingerprint<TComponents...>();
+    SetupQuery<TComponents...>();
+}
+
+template <typename... TComponents>
+template <typename TComponent>
+TComponent ComponentSystem<TComponents...>::GetComponent(Archetype const& in_archetype, RkSize const in_chunk) const noexcept
+{
+    if constexpr (TComponent::sparse)
+        return GetSparseSet(TComponent::id).template GetComponent<TComponent>(in_archetype.GetEntities(in_chunk));
+    else
+        return in_archetype.template GetComponent<TComponent>(in_chunk);
+}
+
+template <typename... TComponents>
+RkVoid ComponentSystem<TComponents...>::Update(Scheduler& in_scheduler) noexcept
+{
+    // Gathering the chunks of every archetype first, so that small archetypes get processed concurrently as well
+    GatherChunks();
+
+    in_scheduler.ParallelFor(0u, m_chunks.size(), 1u, [this] (RkSize const in_begin, RkSize const in_end) {
+        // The context follows the job if OnUpdate gets suspended, the commands it records keep the sort key of their chunk
+        SystemJobContext        context          {&GetAccess(), EntityCommandBuffer::default_sort_key};
+        SystemJobContext const* previous_context = SystemJobContext::SetCurrent(&context);
+
+        for (RkSize index = in_begin; index < in_end; ++index)
+        {
+            auto const [archetype, chunk] = m_chunks[index];
+
+            context.sort_key = GetSortKey(index);
+
+            // The query guarantees that every component of the system is owned by the archetype, or by the entities of the ranges for sparse components
+            std::tuple<std::remove_const_t<TComponents>...> const components {GetComponent<std::remove_const_t<TComponents>>(*archetype, chunk)...};
+
+            EntityID const* entities  = archetype->GetEntities(chunk);
+            RkBool          processed = false;
+
+            auto const process = [&] (RkSize const in_range_begin, RkSize const in_range_end) {
+                Range range(components, in_range_begin, in_range_end);
+
+                OnUpdate(range);
+
+                processed = true;
+            };
+
+            // Rows of the entities not matching the sparse components of the query are skipped, the chunk is then split into several ranges
+            if (m_chunk_rows.empty())
+            {
+                GetQuery().ForEachRange(entities, archetype->GetChunk(chunk).count, process);
+            }
+            else
+            {
+                // Only the consecutive rows of the entities of the smallest sparse set are matched against the other sparse sets
+                auto const [rows_begin, rows_end] = m_chunk_rows[index];
+                RkSize const capacity             = archetype->GetChunkCapacity();
+
+                for (RkSize row = rows_begin; row < rows_end;)
+                {
+                    RkSize const begin = m_sparse_rows[row].second % capacity;
+                    RkSize       end   = begin + 1u;
+
+                    while (++row < rows_end && m_sparse_rows[row].second % capacity == end)
+                        ++end;
+
+                    GetQuery().ForEachRange(entities + begin, end - begin, [&] (RkSize const in_range_begin, RkSize const in_range_end) {
+                        process(begin + in_range_begin, begin + in_range_end);
+                    });
+                }
+            }
+
+            // Flagging every component written by the system as changed, sparse components are not versioned
+            if (processed)
+                ((std::is_const_v<TComponents> || TComponents::sparse ? RkVoid() : archetype->SetChangeVersion(chunk, TComponents::id, GetVersion())), ...);
+        }
+
+        SystemJobContext::SetCurrent(previous_context);
+    });
 }
\ No newline at end of file
@@ -22,15 +22,170 @@
  *  SOFTWARE.
  */
 
+#include <algorithm>
+
+#include "ECS/Archetype.hpp"
+#include "ECS/EntityAdmin.hpp"
 #include "ECS/ComponentSystemBase.hpp"
 
 USING_RUKEN_NAMESPACE
 
 ComponentSystemBase::ComponentSystemBase() noexcept:
-    m_enabled {true}
+    m_enabled                {true},
+    m_query                  {},
+    m_access                 {},
+    m_admin                  {nullptr},
+    m_order                  {0u},
+    m_version                {0u},
+    m_last_version           {0u},
+    m_track_removed_entities {false},
+    m_archetype_indices      {},
+    m_chunks                 {},
+    m_sparse_rows            {},
+    m_chunk_rows             {},
+    m_removed_entities       {}
 {}
 
 RkBool ComponentSystemBase::Enabled() const
 {
     return m_enabled;
 }
+
+ComponentQuery const& ComponentSystemBase::GetQuery() const noexcept
+{
+    return m_query;
+}
+
+ComponentAccess const& ComponentSystemBase::GetAccess() const noexcept
+{
+    return m_access;
+}
+
+SharedComponentTable& ComponentSystemBase::GetSharedValues() const noexcept
+{
+    return m_admin->m_shared_values;
+}
+
+SparseSet const& ComponentSystemBase::GetSparseSet(RkSize const in_component_id) const noexcept
+{
+    return m_admin->m_sparse_sets[in_component_id];
+}
+
+RkBool ComponentSystemBase::MatchEntity(EntityID const in_entity) const noexcept
+{
+    return m_admin->m_entities.IsAlive(in_entity) && m_query.Match(*m_admin->m_entities.GetLocation(in_entity).archetype);
+}
+
+RkVoid ComponentSystemBase::SetupRemovedEntities() noexcept
+{
+    m_track_removed_entities = true;
+}
+
+RkVoid ComponentSystemBase::GatherRemovedEntities() noexcept
+{
+    m_removed_entities.clear();
+
+    auto const& removed_entities = m_admin->m_removed_entities;
+
+    // Entities are recorded by increasing version, the ones processed by the previous updates come first
+    auto removed = std::upper_bound(removed_entities.begin(), removed_entities.end(), m_last_version, [] (RkUint32 const in_version, auto const& in_removed) {
+        return in_version < in_removed.first;
+    });
+
+    for (; removed != removed_entities.end(); ++removed)
+        m_removed_entities.push_back(removed->second);
+}
+
+RkVoid ComponentSystemBase::GatherChunks() noexcept
+{
+    m_chunks     .clear();
+    m_sparse_rows.clear();
+    m_chunk_rows .clear();
+
+    SparseSet               const* smallest_set = m_query.GetSmallestSparseSet();
+    std::vector<Archetype*> const& archetypes   = m_query.GetArchetypes();
+
+    // Chunks which didn't change since the last update are skipped, if the system filters them
+    RkBool const filtered = m_query.HasChunkFilter();
+
+    // No entity can match if the sparse set of a required sparse component is empty
+    if (smallest_set && smallest_set->GetSize() == 0u)
+        return;
+
+    RkSize entities_count = 0u;
+
+    for (Archetype const* archetype : archetypes)
+        entities_count += archetype->EntitiesCount();
+
+    if (!smallest_set || smallest_set->GetSize() * sparse_gather_ratio >= entities_count)
+    {
+        for (Archetype* archetype : archetypes)
+        {
+            for (RkSize chunk = 0u; chunk < archetype->GetChunksCount(); ++chunk)
+            {
+                if (!filtered || m_query.MatchChunk(*archetype, chunk, m_last_version))
+                    m_chunks.emplace_back(archetype, chunk);
+            }
+        }
+
+        return;
+    }
+
+    // Looking up the rows of the entities of the smallest set
+    m_archetype_indices.clear();
+
+    for (RkSize index = 0u; index < archetypes.size(); ++index)
+        m_archetype_indices.emplace(archetypes[index], index);
+
+    for (RkSize index = 0u; index < smallest_set->GetSize(); ++index)
+    {
+        EntityLocation const& location = m_admin->m_entities.GetLocation(smallest_set->GetEntities()[index]);
+
+        auto const found = m_archetype_indices.find(location.archetype);
+
+        if (found != m_archetype_indices.end())
+            m_sparse_rows.emplace_back(found->second, location.row);
+    }
+
+    // Sorting the rows like the scan of the archetypes would, the sort keys of the commands thus don't depend on the order of the set
+    std::sort(m_sparse_rows.begin(), m_sparse_rows.end());
+
+    for (RkSize begin = 0u; begin < m_sparse_rows.size();)
+    {
+        Archetype* const archetype = archetypes[m_sparse_rows[begin].first];
+        RkSize     const capacity  = archetype->GetChunkCapacity();
+        RkSize     const chunk     = m_sparse_rows[begin].second / capacity;
+        RkSize           end       = begin + 1u;
+
+        while (end < m_sparse_rows.size() && archetypes[m_sparse_rows[end].first] == archetype && m_sparse_rows[end].second / capacity == chunk)
+            ++end;
+
+        if (!filtered || m_query.MatchChunk(*archetype, chunk, m_last_version))
+        {
+            m_chunks    .emplace_back(archetype, chunk);
+            m_chunk_rows.emplace_back(begin, end);
+        }
+
+        begin = end;
+    }
+}
+
+EntityCommandBuffer& ComponentSystemBase::GetCommandBuffer() const noexcept
+{
+    return m_admin->GetCommandBuffer();
+}
+
+RkUint32 ComponentSystemBase::GetVersion() const noexcept
+{
+    return m_version;
+}
+
+RkUint32 ComponentSystemBase::GetLastVersion() const noexcept
+{
+    return m_last_version;
+}
+
+RkUint64 ComponentSystemBase::GetSortKey(RkSize const in_chunk) const noexcept
+{
+    return static_cast<RkUint64>(m_order) << 32u | in_chunk;
+}
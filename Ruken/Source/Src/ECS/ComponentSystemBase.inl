@@ -23,7 +23,41 @@
  */
 
 template <typename ... TComponents>
-RkVoid ComponentSystemBase::SetupTargetFingerprint() noexcept
+RkVoid ComponentSystemBase::SetupQuery() noexcept
 {
-    (m_target_fingerprint.AddTrait(TComponents::TypeId()), ...);
+    RUKEN_STATIC_ASSERT(((!TComponents::shared || std::is_const_v<TComponents>) && ...), "Shared components are read only, see EntityAdmin::SetSharedComponent");
+
+    m_query.SetupInclusionQuery<std::remove_const_t<TComponents>...>();
+
+    m_access = ComponentAccess::CreateFrom<TComponents...>();
+}
+
+template <typename ... TComponents>
+RkVoid ComponentSystemBase::SetupExclusionQuery() noexcept
+{
+    m_query.SetupExclusionQuery<std::remove_const_t<TComponents>...>();
+}
+
+template <typename ... TComponents>
+RkVoid ComponentSystemBase::SetupChangedFilter() noexcept
+{
+    m_query.SetupChangedFilter<std::remove_const_t<TComponents>...>();
+}
+
+template <typename ... TComponents>
+RkVoid ComponentSystemBase::SetupAddedFilter() noexcept
+{
+    m_query.SetupAddedFilter<std::remove_const_t<TComponents>...>();
+}
+
+template <typename ... TComponents>
+RkVoid ComponentSystemBase::SetupSingletons() noexcept
+{
+    m_access.Add<TComponents...>();
+}
+
+template <typename TComponent>
+auto& ComponentSystemBase::GetSingleton() const noexcept
+{
+    return GetSharedValues().GetSingleton<TComponent>();
 }
\ No newline at end of file
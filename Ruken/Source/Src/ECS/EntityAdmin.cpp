@@ -22,10 +22,218 @@
  *  SOFTWARE.
  */
 
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+#include "Meta/Assert.hpp"
+
 #include "ECS/EntityAdmin.hpp"
+#include "ECS/WorldSnapshot.hpp"
+
+#include "Utility/MappedFile.hpp"
+#include "Threading/Scheduler.hpp"
 
 USING_RUKEN_NAMESPACE
 
+namespace
+{
+    /**
+     * \brief Writes a snapshot into a file, keeping track of the offset to align the sections and columns
+     */
+    class SnapshotWriter
+    {
+        private:
+
+            std::ofstream m_file;
+            RkSize        m_offset;
+
+        public:
+
+            explicit SnapshotWriter(std::string_view const in_path) noexcept:
+                m_file   {std::string(in_path), std::ios::binary | std::ios::trunc},
+                m_offset {0u}
+            {}
+
+            [[nodiscard]]
+            RkBool IsValid() const noexcept
+            {
+                return m_file.good();
+            }
+
+            RkVoid Write(RkVoid const* in_data, RkSize const in_size) noexcept
+            {
+                m_file.write(static_cast<RkChar const*>(in_data), static_cast<std::streamsize>(in_size));
+
+                m_offset += in_size;
+            }
+
+            template <typename TType>
+            RkVoid Write(TType const& in_value) noexcept
+            {
+                Write(&in_value, sizeof(TType));
+            }
+
+            RkVoid Align(RkSize const in_alignment) noexcept
+            {
+                static RkUint8 const padding[RUKEN_ECS_COLUMN_ALIGNMENT] {};
+
+                Write(padding, (in_alignment - m_offset % in_alignment) % in_alignment);
+            }
+    };
+
+    /**
+     * \brief Reads a snapshot from memory, every read being bounds checked
+     */
+    class SnapshotReader
+    {
+        private:
+
+            RkUint8 const* m_data;
+            RkSize         m_size;
+            RkSize         m_offset;
+
+        public:
+
+            SnapshotReader(RkUint8 const* in_data, RkSize const in_size) noexcept:
+                m_data   {in_data},
+                m_size   {in_size},
+                m_offset {0u}
+            {}
+
+            /**
+             * \brief Reads an array of values
+             * \param in_count Number of values
+             * \return Values, or null if the snapshot is too small
+             */
+            template <typename TType>
+            [[nodiscard]]
+            TType const* Read(RkSize const in_count = 1u) noexcept
+            {
+                if (in_count > (m_size - m_offset) / sizeof(TType))
+                    return nullptr;
+
+                TType const* values = reinterpret_cast<TType const*>(m_data + m_offset);
+
+                m_offset += in_count * sizeof(TType);
+
+                return values;
+            }
+
+            /**
+             * \brief Checks that an array of values fits in the rest of the snapshot, without reading it
+             * \param in_count Number of values
+             * \return False if the snapshot is too small
+             */
+            template <typename TType>
+            [[nodiscard]]
+            RkBool CanRead(RkSize const in_count) const noexcept
+            {
+                return in_count <= (m_size - m_offset) / sizeof(TType);
+            }
+
+            /**
+             * \brief Skips the padding up to the next multiple of an alignment
+             * \param in_alignment Alignment, power of 2
+             * \return False if the snapshot is too small
+             */
+            [[nodiscard]]
+            RkBool Align(RkSize const in_alignment) noexcept
+            {
+                RkSize const offset = (m_offset + in_alignment - 1u) & ~(in_alignment - 1u);
+
+                if (offset > m_size)
+                    return false;
+
+                m_offset = offset;
+
+                return true;
+            }
+    };
+
+    /**
+     * \brief Returns the size of the fields of a component, packed one after the other
+     * \param in_component Component descriptor
+     * \return Size in bytes
+     */
+    RkSize GetPackedSize(ComponentDescriptor const& in_component) noexcept
+    {
+        RkSize size = 0u;
+
+        for (ComponentDescriptor::Field const& field : in_component.GetFields())
+            size += field.size;
+
+        return size;
+    }
+
+    /**
+     * \brief Checks if two descriptors describe the same layout
+     * \param in_lhs First descriptor
+     * \param in_rhs Second descriptor
+     * \return True if both components have the same fields and are both shared or both not shared
+     */
+    RkBool HaveSameLayout(ComponentDescriptor const& in_lhs, ComponentDescriptor const& in_rhs) noexcept
+    {
+        std::vector<ComponentDescriptor::Field> const& lhs_fields = in_lhs.GetFields();
+        std::vector<ComponentDescriptor::Field> const& rhs_fields = in_rhs.GetFields();
+
+        if (in_lhs.IsShared() != in_rhs.IsShared() || in_lhs.IsSparse() != in_rhs.IsSparse() || lhs_fields.size() != rhs_fields.size())
+            return false;
+
+        for (RkSize index = 0u; index < lhs_fields.size(); ++index)
+        {
+            if (lhs_fields[index].size != rhs_fields[index].size || lhs_fields[index].alignment != rhs_fields[index].alignment)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+EntityAdmin::EntityAdmin(Scheduler& in_scheduler, RkSize const in_chunk_size) noexcept:
+    m_scheduler              {in_scheduler},
+    m_chunk_pool             {in_chunk_size},
+    m_components             {},
+    m_registered_components  {},
+    m_shared_components      {},
+    m_sparse_components      {},
+    m_sparse_sets            {},
+    m_systems                {},
+    m_archetypes             {},
+    m_entities               {},
+    m_queries                {},
+    m_shared_values          {},
+    m_version                {1u},
+    m_track_removed_entities {false},
+    m_removed_entities       {},
+    m_command_buffers        {},
+    m_command_batches        {},
+    m_system_jobs            {},
+    m_system_dependencies    {}
+{
+    m_command_buffers.reserve(m_scheduler.GetWorkers().size() + 1u);
+
+    for (RkSize index = 0u; index <= m_scheduler.GetWorkers().size(); ++index)
+        m_command_buffers.emplace_back(m_chunk_pool);
+}
+
+RkBool EntityAdmin::ArchetypeKey::operator==(ArchetypeKey const& in_other) const noexcept
+{
+    return fingerprint == in_other.fingerprint && shared_values == in_other.shared_values;
+}
+
+RkSize EntityAdmin::ArchetypeKeyHash::operator()(ArchetypeKey const& in_key) const noexcept
+{
+    RkSize hash = std::hash<ArchetypeFingerprint>()(in_key.fingerprint);
+
+    for (RkUint8 const* value : in_key.shared_values)
+        hash = hash * 31u + std::hash<RkUint8 const*>()(value);
+
+    return hash;
+}
+
 EntityAdmin::~EntityAdmin()
 {
     for (auto const& archetype: m_archetypes)
@@ -35,7 +243,918 @@ EntityAdmin::~EntityAdmin()
         delete system;
 }
 
+RkVoid EntityAdmin::RegisterComponent(ComponentDescriptor const& in_component) noexcept
+{
+    if (m_registered_components.HasOne(in_component.GetId()))
+        return;
+
+    m_components[in_component.GetId()] = in_component;
+
+    m_registered_components.Add(in_component.GetId());
+
+    if (in_component.IsShared())
+        m_shared_components.Add(in_component.GetId());
+
+    if (in_component.IsSparse())
+    {
+        m_sparse_components.Add(in_component.GetId());
+
+        m_sparse_sets[in_component.GetId()].Reset(m_components[in_component.GetId()]);
+    }
+}
+
+EntityID EntityAdmin::CreateEntity(Archetype& in_archetype) noexcept
+{
+    // The entity is about to be pushed at the end of the archetype
+    EntityID const entity = m_entities.Create(EntityLocation {&in_archetype, in_archetype.EntitiesCount()});
+
+    in_archetype.CreateEntity(entity);
+
+    return entity;
+}
+
+EntityRange EntityAdmin::CreateEntities(Archetype& in_archetype, RkSize const in_count) noexcept
+{
+    EntityRange const entities(m_entities.CreateRange(EntityLocation {&in_archetype, in_archetype.EntitiesCount()}, in_count), in_count);
+
+    in_archetype.CreateEntities(entities);
+
+    return entities;
+}
+
+RkBool EntityAdmin::AddComponent(EntityID const in_entity, RkSize const in_component_id) noexcept
+{
+    if (!m_entities.IsAlive(in_entity))
+        return false;
+
+    // Sparse components never move the entity
+    if (m_sparse_components.HasOne(in_component_id))
+        return m_sparse_sets[in_component_id].Add(in_entity);
+
+    Archetype& source = *m_entities.GetLocation(in_entity).archetype;
+
+    if (source.GetFingerprint().HasOne(in_component_id))
+        return false;
+
+    // The target archetype of a shared component depends on its value
+    if (m_components[in_component_id].IsShared())
+        return SetSharedComponent(in_entity, in_component_id, m_shared_values.Intern(m_components[in_component_id]));
+
+    MoveEntity(in_entity, GetAddTarget(source, in_component_id));
+
+    return true;
+}
+
+RkBool EntityAdmin::RemoveComponent(EntityID const in_entity, RkSize const in_component_id) noexcept
+{
+    if (!m_entities.IsAlive(in_entity))
+        return false;
+
+    if (m_sparse_components.HasOne(in_component_id))
+        return m_sparse_sets[in_component_id].Remove(in_entity);
+
+    Archetype& source = *m_entities.GetLocation(in_entity).archetype;
+
+    if (!source.GetFingerprint().HasOne(in_component_id))
+        return false;
+
+    MoveEntity(in_entity, GetRemoveTarget(source, in_component_id));
+
+    return true;
+}
+
+RkBool EntityAdmin::SetSharedComponent(EntityID const in_entity, RkSize const in_component_id, RkUint8 const* in_value) noexcept
+{
+    if (!m_entities.IsAlive(in_entity))
+        return false;
+
+    Archetype& source = *m_entities.GetLocation(in_entity).archetype;
+
+    if (source.GetFingerprint().HasOne(in_component_id) && source.GetSharedValues()[in_component_id] == in_value)
+        return true;
+
+    ArchetypeFingerprint    fingerprint   = source.GetFingerprint();
+    Archetype::SharedValues shared_values = source.GetSharedValues();
+
+    fingerprint.Add(in_component_id);
+
+    shared_values[in_component_id] = in_value;
+
+    MoveEntity(in_entity, GetArchetype(fingerprint, shared_values));
+
+    return true;
+}
+
+Archetype& EntityAdmin::GetArchetype(ArchetypeFingerprint const& in_fingerprint) noexcept
+{
+    static Archetype::SharedValues const no_shared_values {};
+
+    if (!in_fingerprint.HasOne(m_shared_components))
+        return GetArchetype(in_fingerprint, no_shared_values);
+
+    Archetype::SharedValues shared_values {};
+
+    for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+    {
+        if (in_fingerprint.HasOne(id) && m_shared_components.HasOne(id))
+            shared_values[id] = m_shared_values.Intern(m_components[id]);
+    }
+
+    return GetArchetype(in_fingerprint, shared_values);
+}
+
+Archetype& EntityAdmin::GetArchetype(ArchetypeFingerprint const& in_fingerprint, Archetype::SharedValues const& in_shared_values) noexcept
+{
+    ArchetypeKey key {in_fingerprint, {}};
+
+    if (in_fingerprint.HasOne(m_shared_components))
+    {
+        for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+        {
+            if (in_fingerprint.HasOne(id) && m_shared_components.HasOne(id))
+                key.shared_values.push_back(in_shared_values[id]);
+        }
+    }
+
+    auto const found = m_archetypes.find(key);
+
+    if (found != m_archetypes.end())
+        return *found->second;
+
+    RUKEN_ASSERT_MESSAGE(m_registered_components.HasAll(in_fingerprint), "An archetype cannot be created before the registration of its components");
+
+    std::vector<ComponentDescriptor const*> components;
+
+    for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+    {
+        if (in_fingerprint.HasOne(id))
+            components.push_back(&m_components[id]);
+    }
+
+    Archetype* archetype = new Archetype(m_chunk_pool, m_version, components, in_shared_values);
+
+    m_archetypes[std::move(key)] = archetype;
+
+    m_queries.AddArchetype(*archetype);
+
+    return *archetype;
+}
+
+Archetype& EntityAdmin::GetAddTarget(Archetype& in_source, RkSize const in_component_id) noexcept
+{
+    if (Archetype* target = in_source.GetAddEdge(in_component_id))
+        return *target;
+
+    RUKEN_ASSERT_MESSAGE(!m_shared_components.HasOne(in_component_id), "Shared components must be added with SetSharedComponent");
+
+    ArchetypeFingerprint fingerprint = in_source.GetFingerprint();
+
+    fingerprint.Add(in_component_id);
+
+    Archetype& target = GetArchetype(fingerprint, in_source.GetSharedValues());
+
+    in_source.LinkAddEdge(in_component_id, target);
+
+    return target;
+}
+
+Archetype& EntityAdmin::GetRemoveTarget(Archetype& in_source, RkSize const in_component_id) noexcept
+{
+    if (Archetype* target = in_source.GetRemoveEdge(in_component_id))
+        return *target;
+
+    ArchetypeFingerprint fingerprint = in_source.GetFingerprint();
+
+    fingerprint.Remove(in_component_id);
+
+    Archetype& target = GetArchetype(fingerprint, in_source.GetSharedValues());
+
+    // The add edge of the target is never followed for shared components, their target depends on their value
+    target.LinkAddEdge(in_component_id, in_source);
+
+    return target;
+}
+
+RkVoid EntityAdmin::MoveEntity(EntityID const in_entity, Archetype& in_target) noexcept
+{
+    EntityLocation const location = m_entities.GetLocation(in_entity);
+    RkSize         const row      = in_target.CreateEntityFrom(*location.archetype, location.row);
+
+    RemoveRow(location);
+
+    m_entities.SetLocation(in_entity, EntityLocation {&in_target, row});
+
+    RecordRemovedEntity(in_entity);
+}
+
+RkVoid EntityAdmin::RecordRemovedEntity(EntityID const in_entity) noexcept
+{
+    if (m_track_removed_entities)
+        m_removed_entities.emplace_back(m_version, in_entity);
+}
+
+RkVoid EntityAdmin::RemoveRow(EntityLocation const& in_location) noexcept
+{
+    EntityID const moved_entity = in_location.archetype->DestroyEntity(in_location.row);
+
+    if (m_entities.IsAlive(moved_entity))
+        m_entities.SetLocation(moved_entity, in_location);
+}
+
+RkBool EntityAdmin::DestroyEntity(EntityID const in_entity) noexcept
+{
+    if (!m_entities.IsAlive(in_entity))
+        return false;
+
+    RemoveRow(m_entities.GetLocation(in_entity));
+
+    // Sparse sets must only hold alive entities, see SparseSet
+    for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+    {
+        if (m_sparse_components.HasOne(id))
+            m_sparse_sets[id].Remove(in_entity);
+    }
+
+    m_entities.Destroy(in_entity);
+
+    RecordRemovedEntity(in_entity);
+
+    return true;
+}
+
+RkBool EntityAdmin::IsAlive(EntityID const in_entity) const noexcept
+{
+    return m_entities.IsAlive(in_entity);
+}
+
+RkSize EntityAdmin::EntitiesCount() const noexcept
+{
+    return m_entities.GetAliveCount();
+}
+
+RkUint32 EntityAdmin::GetVersion() const noexcept
+{
+    return m_version;
+}
+
+RkBool EntityAdmin::Save(std::string_view const in_path) const noexcept
+{
+    SnapshotWriter writer(in_path);
+
+    if (!writer.IsValid())
+        return false;
+
+    std::vector<Archetype const*> archetypes;
+
+    for (auto const& archetype : m_archetypes)
+    {
+        if (archetype.second->EntitiesCount() > 0u)
+            archetypes.push_back(archetype.second);
+    }
+
+    std::vector<RkUint32> component_ids;
+    std::vector<RkUint32> sparse_set_ids;
+
+    for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+    {
+        if (m_registered_components.HasOne(id))
+            component_ids.push_back(static_cast<RkUint32>(id));
+
+        if (m_sparse_components.HasOne(id) && m_sparse_sets[id].GetSize() > 0u)
+            sparse_set_ids.push_back(static_cast<RkUint32>(id));
+    }
+
+    writer.Write(WorldSnapshot::Header {
+        WorldSnapshot::magic,
+        WorldSnapshot::version,
+        RUKEN_ECS_COLUMN_ALIGNMENT,
+        static_cast<RkUint32>(component_ids.size()),
+        static_cast<RkUint32>(archetypes.size()),
+        static_cast<RkUint32>(sparse_set_ids.size()),
+        static_cast<RkUint32>(m_entities.GetSlotsCount()),
+        0u,
+        m_entities.GetAliveCount()
+    });
+
+    for (RkUint32 const id : component_ids)
+    {
+        std::vector<ComponentDescriptor::Field> const& fields = m_components[id].GetFields();
+
+        writer.Write(WorldSnapshot::ComponentHeader {id, m_components[id].IsShared(), static_cast<RkUint32>(fields.size()), m_components[id].IsSparse()});
+
+        for (ComponentDescriptor::Field const& field : fields)
+            writer.Write(WorldSnapshot::FieldHeader {static_cast<RkUint32>(field.size), static_cast<RkUint32>(field.alignment)});
+
+        for (ComponentDescriptor::Field const& field : fields)
+            writer.Write(field.default_value.data(), field.size);
+
+        writer.Align(WorldSnapshot::section_alignment);
+    }
+
+    std::vector<RkUint32> generations(m_entities.GetSlotsCount());
+
+    for (RkSize index = 0u; index < generations.size(); ++index)
+        generations[index] = m_entities.GetGeneration(static_cast<RkUint32>(index));
+
+    writer.Write(generations.data(), generations.size() * sizeof(RkUint32));
+    writer.Align(WorldSnapshot::section_alignment);
+
+    std::vector<RkUint8> shared_values;
+
+    for (Archetype const* archetype : archetypes)
+    {
+        component_ids.clear();
+        shared_values.clear();
+
+        for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+        {
+            if (!archetype->GetFingerprint().HasOne(id))
+                continue;
+
+            component_ids.push_back(static_cast<RkUint32>(id));
+
+            if (!m_components[id].IsShared())
+                continue;
+
+            // Shared values are laid out as items, fields are packed to be interned back by the loading
+            RkUint8 const* value = archetype->GetSharedValues()[id];
+
+            for (ComponentDescriptor::Field const& field : m_components[id].GetFields())
+                shared_values.insert(shared_values.end(), value + field.offset, value + field.offset + field.size);
+        }
+
+        writer.Write(WorldSnapshot::ArchetypeHeader {
+            archetype->EntitiesCount(),
+            static_cast<RkUint32>(component_ids.size()),
+            static_cast<RkUint32>(shared_values.size())
+        });
+
+        writer.Write(component_ids.data(), component_ids.size() * sizeof(RkUint32));
+        writer.Write(shared_values.data(), shared_values.size());
+
+        writer.Align(RUKEN_ECS_COLUMN_ALIGNMENT);
+
+        for (RkSize chunk = 0u; chunk < archetype->GetChunksCount(); ++chunk)
+            writer.Write(archetype->GetEntities(chunk), archetype->GetChunk(chunk).count * sizeof(EntityID));
+
+        for (RkUint32 const id : component_ids)
+        {
+            if (m_components[id].IsShared())
+                continue;
+
+            std::vector<ComponentDescriptor::Field> const& fields = m_components[id].GetFields();
+
+            for (RkSize field = 0u; field < fields.size(); ++field)
+            {
+                writer.Align(RUKEN_ECS_COLUMN_ALIGNMENT);
+
+                for (RkSize chunk = 0u; chunk < archetype->GetChunksCount(); ++chunk)
+                    writer.Write(archetype->GetColumn(chunk, id, field), archetype->GetChunk(chunk).count * fields[field].size);
+            }
+        }
+
+        writer.Align(WorldSnapshot::section_alignment);
+    }
+
+    for (RkUint32 const id : sparse_set_ids)
+    {
+        SparseSet                               const& sparse_set = m_sparse_sets[id];
+        std::vector<ComponentDescriptor::Field> const& fields     = m_components[id].GetFields();
+
+        writer.Write(WorldSnapshot::SparseSetHeader {sparse_set.GetSize(), id, static_cast<RkUint32>(fields.size())});
+
+        writer.Align(RUKEN_ECS_COLUMN_ALIGNMENT);
+        writer.Write(sparse_set.GetEntities(), sparse_set.GetSize() * sizeof(EntityID));
+
+        for (RkSize field = 0u; field < fields.size(); ++field)
+        {
+            writer.Align(RUKEN_ECS_COLUMN_ALIGNMENT);
+            writer.Write(sparse_set.GetColumn(field), sparse_set.GetSize() * fields[field].size);
+        }
+
+        writer.Align(WorldSnapshot::section_alignment);
+    }
+
+    return writer.IsValid();
+}
+
+RkBool EntityAdmin::Load(std::string_view const in_path) noexcept
+{
+    MappedFile const file(in_path);
+
+    if (!file.IsValid())
+        return false;
+
+    return Load(file.GetData(), file.GetSize());
+}
+
+RkBool EntityAdmin::Load(RkUint8 const* in_data, RkSize const in_size) noexcept
+{
+    RUKEN_ASSERT_MESSAGE(reinterpret_cast<std::uintptr_t>(in_data) % WorldSnapshot::section_alignment == 0u, "Snapshots must be aligned on 8 bytes");
+
+    // Archetype of the snapshot, validated before anything gets loaded
+    struct ArchetypeRecord
+    {
+        ArchetypeFingerprint        fingerprint;
+        RkUint8 const*              shared_values;
+        RkSize                      entities_count;
+        std::vector<RkUint8 const*> columns;
+    };
+
+    // Sparse set of the snapshot, validated as well
+    struct SparseSetRecord
+    {
+        RkSize                      component_id;
+        RkSize                      entities_count;
+        std::vector<RkUint8 const*> columns;
+    };
+
+    if (m_entities.GetAliveCount() != 0u)
+        return false;
+
+    SnapshotReader reader(in_data, in_size);
+
+    WorldSnapshot::Header const* header = reader.Read<WorldSnapshot::Header>();
+
+    if (!header || header->magic != WorldSnapshot::magic || header->version != WorldSnapshot::version)
+        return false;
+
+    RkSize const column_alignment = header->column_alignment;
+
+    if (column_alignment < WorldSnapshot::section_alignment || (column_alignment & (column_alignment - 1u)) != 0u)
+        return false;
+
+    // Components, which must match the registered ones
+    std::array<ComponentDescriptor, RUKEN_MAX_ECS_COMPONENTS> components;
+    ArchetypeFingerprint                                      snapshot_components;
+
+    for (RkSize index = 0u; index < header->components_count; ++index)
+    {
+        WorldSnapshot::ComponentHeader const* component = reader.Read<WorldSnapshot::ComponentHeader>();
+
+        if (!component || component->id >= RUKEN_MAX_ECS_COMPONENTS || snapshot_components.HasOne(component->id))
+            return false;
+
+        WorldSnapshot::FieldHeader const* fields = reader.Read<WorldSnapshot::FieldHeader>(component->fields_count);
+
+        if (!fields)
+            return false;
+
+        std::vector<ComponentDescriptor::Field> descriptor_fields;
+
+        for (RkSize field = 0u; field < component->fields_count; ++field)
+        {
+            RkUint8 const* default_value = reader.Read<RkUint8>(fields[field].size);
+            RkSize   const alignment     = fields[field].alignment;
+
+            if (!default_value || alignment == 0u || alignment > RUKEN_ECS_COLUMN_ALIGNMENT || (alignment & (alignment - 1u)) != 0u)
+                return false;
+
+            descriptor_fields.push_back({fields[field].size, alignment, 0u, std::vector<RkUint8>(default_value, default_value + fields[field].size)});
+        }
+
+        if (!reader.Align(WorldSnapshot::section_alignment))
+            return false;
+
+        components[component->id] = ComponentDescriptor(component->id, component->shared != 0u, component->sparse != 0u, std::move(descriptor_fields));
+
+        if (m_registered_components.HasOne(component->id) && !HaveSameLayout(m_components[component->id], components[component->id]))
+            return false;
+
+        snapshot_components.Add(component->id);
+    }
+
+    // Entity table
+    RkUint32 const* generations = reader.Read<RkUint32>(header->slots_count);
+
+    if (!generations || !reader.Align(WorldSnapshot::section_alignment))
+        return false;
+
+    // Generation 0 is the one of default constructed IDs, see EntityTable::Create
+    if (std::find(generations, generations + header->slots_count, 0u) != generations + header->slots_count)
+        return false;
+
+    // Archetypes, every entity must refer to a distinct slot of the same generation.
+    // Each one takes at least its header, the count is checked before anything gets allocated
+    if (!reader.CanRead<WorldSnapshot::ArchetypeHeader>(header->archetypes_count))
+        return false;
+
+    std::vector<ArchetypeRecord> archetypes(header->archetypes_count);
+    std::vector<RkBool>          used_slots(header->slots_count, false);
+    RkSize                       entities_count = 0u;
+
+    for (ArchetypeRecord& archetype : archetypes)
+    {
+        WorldSnapshot::ArchetypeHeader const* archetype_header = reader.Read<WorldSnapshot::ArchetypeHeader>();
+
+        if (!archetype_header || archetype_header->entities_count > in_size / sizeof(EntityID))
+            return false;
+
+        RkUint32 const* ids = reader.Read<RkUint32>(archetype_header->components_count);
+
+        if (!ids)
+            return false;
+
+        RkSize              shared_values_size = 0u;
+        std::vector<RkSize> column_sizes       = {sizeof(EntityID)};
+
+        for (RkSize index = 0u; index < archetype_header->components_count; ++index)
+        {
+            // Ids must be sorted to match the order of the columns
+            if (ids[index] >= RUKEN_MAX_ECS_COMPONENTS || !snapshot_components.HasOne(ids[index]) || (index > 0u && ids[index] <= ids[index - 1u]))
+                return false;
+
+            ComponentDescriptor const& component = components[ids[index]];
+
+            // Sparse components are never stored into the archetypes
+            if (component.IsSparse())
+                return false;
+
+            archetype.fingerprint.Add(ids[index]);
+
+            if (component.IsShared())
+            {
+                shared_values_size += GetPackedSize(component);
+                continue;
+            }
+
+            for (ComponentDescriptor::Field const& field : component.GetFields())
+                column_sizes.push_back(field.size);
+        }
+
+        if (shared_values_size != archetype_header->shared_values_size)
+            return false;
+
+        archetype.shared_values  = reader.Read<RkUint8>(shared_values_size);
+        archetype.entities_count = archetype_header->entities_count;
+
+        for (RkSize const column_size : column_sizes)
+        {
+            if (archetype.entities_count > in_size / column_size || !reader.Align(column_alignment))
+                return false;
+
+            archetype.columns.push_back(reader.Read<RkUint8>(archetype.entities_count * column_size));
+
+            if (!archetype.columns.back())
+                return false;
+        }
+
+        if (!archetype.shared_values || !reader.Align(WorldSnapshot::section_alignment))
+            return false;
+
+        EntityID const* entities = reinterpret_cast<EntityID const*>(archetype.columns.front());
+
+        for (RkSize index = 0u; index < archetype.entities_count; ++index)
+        {
+            RkUint32 const slot = entities[index].GetIndex();
+
+            if (slot >= header->slots_count || used_slots[slot] || generations[slot] != entities[index].GetGeneration())
+                return false;
+
+            used_slots[slot] = true;
+        }
+
+        entities_count += archetype.entities_count;
+    }
+
+    if (entities_count != header->entities_count)
+        return false;
+
+    // Sparse sets, every entity must be alive and appear once per set
+    if (!reader.CanRead<WorldSnapshot::SparseSetHeader>(header->sparse_sets_count))
+        return false;
+
+    std::vector<SparseSetRecord> sparse_sets(header->sparse_sets_count);
+    std::vector<RkSize>          sparse_marks(header->slots_count, 0u);
+    ArchetypeFingerprint         snapshot_sparse_sets;
+
+    for (RkSize set = 0u; set < sparse_sets.size(); ++set)
+    {
+        SparseSetRecord&                      record     = sparse_sets[set];
+        WorldSnapshot::SparseSetHeader const* set_header = reader.Read<WorldSnapshot::SparseSetHeader>();
+
+        if (!set_header || set_header->component_id >= RUKEN_MAX_ECS_COMPONENTS || snapshot_sparse_sets.HasOne(set_header->component_id))
+            return false;
+
+        ComponentDescriptor const& component = components[set_header->component_id];
+
+        if (!snapshot_components.HasOne(set_header->component_id) || !component.IsSparse() || component.GetFields().size() != set_header->fields_count)
+            return false;
+
+        snapshot_sparse_sets.Add(set_header->component_id);
+
+        record.component_id   = set_header->component_id;
+        record.entities_count = set_header->entities_count;
+
+        std::vector<RkSize> column_sizes = {sizeof(EntityID)};
+
+        for (ComponentDescriptor::Field const& field : component.GetFields())
+            column_sizes.push_back(field.size);
+
+        for (RkSize const column_size : column_sizes)
+        {
+            if (record.entities_count > in_size / column_size || !reader.Align(column_alignment))
+                return false;
+
+            record.columns.push_back(reader.Read<RkUint8>(record.entities_count * column_size));
+
+            if (!record.columns.back())
+                return false;
+        }
+
+        if (!reader.Align(WorldSnapshot::section_alignment))
+            return false;
+
+        EntityID const* entities = reinterpret_cast<EntityID const*>(record.columns.front());
+
+        for (RkSize index = 0u; index < record.entities_count; ++index)
+        {
+            RkUint32 const slot = entities[index].GetIndex();
+
+            if (slot >= header->slots_count || !used_slots[slot] || generations[slot] != entities[index].GetGeneration() || sparse_marks[slot] == set + 1u)
+                return false;
+
+            sparse_marks[slot] = set + 1u;
+        }
+    }
+
+    // The snapshot is valid, loading it
+    for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+    {
+        if (snapshot_components.HasOne(id))
+            RegisterComponent(components[id]);
+    }
+
+    m_entities.Reset(generations, header->slots_count);
+
+    for (ArchetypeRecord const& record : archetypes)
+    {
+        Archetype::SharedValues shared_values {};
+        RkUint8 const*          shared_value = record.shared_values;
+
+        for (RkSize id = 0u; id < RUKEN_MAX_ECS_COMPONENTS; ++id)
+        {
+            if (!record.fingerprint.HasOne(id) || !m_components[id].IsShared())
+                continue;
+
+            shared_values[id] = m_shared_values.Intern(m_components[id], shared_value);
+            shared_value     += GetPackedSize(m_components[id]);
+        }
+
+        Archetype&     archetype = GetArchetype(record.fingerprint, shared_values);
+        RkSize   const first_row = archetype.CreateEntities(record.columns, record.entities_count);
+
+        EntityID const* entities = reinterpret_cast<EntityID const*>(record.columns.front());
+
+        for (RkSize index = 0u; index < record.entities_count; ++index)
+            m_entities.Restore(entities[index], EntityLocation {&archetype, first_row + index});
+    }
+
+    m_entities.RebuildFreeList();
+
+    // Sparse sets are empty since no entity is alive, the dense arrays of the snapshot can thus be copied as is
+    for (SparseSetRecord const& record : sparse_sets)
+    {
+        SparseSet&                                     sparse_set = m_sparse_sets[record.component_id];
+        std::vector<ComponentDescriptor::Field> const& fields     = m_components[record.component_id].GetFields();
+
+        if (record.entities_count == 0u)
+            continue;
+
+        EntityID const* entities = reinterpret_cast<EntityID const*>(record.columns.front());
+
+        for (RkSize index = 0u; index < record.entities_count; ++index)
+            sparse_set.Add(entities[index]);
+
+        for (RkSize field = 0u; field < fields.size(); ++field)
+            std::memcpy(sparse_set.GetColumn(field), record.columns[field + 1u], record.entities_count * fields[field].size);
+    }
+
+    return true;
+}
+
+RkVoid EntityAdmin::BindSparseSets(ComponentQuery& in_query) const noexcept
+{
+    in_query.m_included_sets.clear();
+    in_query.m_excluded_sets.clear();
+
+    for (RkSize const id : in_query.m_sparse_included)
+        in_query.m_included_sets.push_back(&m_sparse_sets[id]);
+
+    for (RkSize const id : in_query.m_sparse_excluded)
+        in_query.m_excluded_sets.push_back(&m_sparse_sets[id]);
+}
+
+RkVoid EntityAdmin::RegisterQuery(ComponentQuery& in_query) noexcept
+{
+    m_queries.AddQuery(in_query);
+
+    BindSparseSets(in_query);
+}
+
+RkVoid EntityAdmin::UnregisterQuery(ComponentQuery& in_query) noexcept
+{
+    m_queries.RemoveQuery(in_query);
+
+    in_query.m_included_sets.clear();
+    in_query.m_excluded_sets.clear();
+}
+
 RkVoid EntityAdmin::UpdateSystems() noexcept
 {
-    
+    m_system_jobs.resize(m_systems.size());
+
+    for (RkSize index = 0; index < m_systems.size(); ++index)
+    {
+        ComponentSystemBase* system = m_systems[index];
+
+        // Disabled systems keep an invalid handle, which is ignored by their dependents
+        if (!system->Enabled())
+            continue;
+
+        m_system_dependencies.clear();
+
+        system->m_version = m_version + static_cast<RkUint32>(index) + 1u;
+
+        for (RkSize previous = 0; previous < index; ++previous)
+        {
+            if (m_systems[previous]->Enabled() && m_systems[previous]->GetAccess().ConflictsWith(system->GetAccess()))
+                m_system_dependencies.push_back(m_system_jobs[previous]);
+        }
+
+        m_system_jobs[index] = m_scheduler.ScheduleTask([this, system] {
+            system->Update(m_scheduler);
+        }, m_system_dependencies);
+    }
+
+    for (JobHandle const& job : m_system_jobs)
+        m_scheduler.Wait(job);
+
+    for (ComponentSystemBase* system : m_systems)
+    {
+        if (system->Enabled())
+            system->m_last_version = system->m_version;
+    }
+
+    // Dropping the removed entities processed by every system tracking them, disabled systems keep theirs until their next update
+    if (!m_removed_entities.empty())
+    {
+        RkUint32 processed_version = m_version;
+
+        for (ComponentSystemBase const* system : m_systems)
+        {
+            if (system->m_track_removed_entities)
+                processed_version = std::min(processed_version, system->m_last_version);
+        }
+
+        // Entities are recorded by increasing version
+        m_removed_entities.erase(m_removed_entities.begin(), std::upper_bound(m_removed_entities.begin(), m_removed_entities.end(), processed_version, [] (RkUint32 const in_version, auto const& in_removed) {
+            return in_version < in_removed.first;
+        }));
+    }
+
+    // The commands are played back after every system, with a newer version
+    m_version += static_cast<RkUint32>(m_systems.size()) + 1u;
+
+    // Handles must not outlive the frame, nor the scheduler
+    m_system_jobs        .clear();
+    m_system_dependencies.clear();
+
+    PlaybackCommands();
+}
+
+EntityCommandBuffer& EntityAdmin::GetCommandBuffer() noexcept
+{
+    return m_command_buffers[m_scheduler.GetCurrentWorkerIndex()];
+}
+
+RkVoid EntityAdmin::PlaybackCommands() noexcept
+{
+    using Command = EntityCommandBuffer::Command;
+
+    m_command_batches.clear();
+
+    for (EntityCommandBuffer& buffer : m_command_buffers)
+    {
+        buffer.m_created.assign(buffer.m_created_count, EntityID());
+
+        for (EntityCommandBuffer::Batch const& batch : buffer.m_batches)
+            m_command_batches.emplace_back(&buffer, &batch);
+    }
+
+    // Batches sharing a sort key keep the order of the buffers, then their recording order
+    std::stable_sort(m_command_batches.begin(), m_command_batches.end(), [] (auto const& in_lhs, auto const& in_rhs) {
+        return in_lhs.second->sort_key < in_rhs.second->sort_key;
+    });
+
+    // Consecutive entities are often created into the same archetype
+    ArchetypeFingerprint fingerprint;
+    Archetype*           archetype = nullptr;
+
+    for (auto const& [buffer, batch] : m_command_batches)
+    {
+        buffer->ForEachCommand(*batch, [&, buffer = buffer] (Command const& in_command, RkUint8 const* in_payload) {
+            switch (in_command.type)
+            {
+                case EntityCommandBuffer::ECommandType::CreateEntity:
+                {
+                    RkSize const count = in_command.payload_size / sizeof(ComponentDescriptor const*);
+
+                    ArchetypeFingerprint created_fingerprint;
+
+                    for (RkSize index = 0u; index < count; ++index)
+                    {
+                        ComponentDescriptor const* component;
+
+                        std::memcpy(&component, in_payload + index * sizeof(ComponentDescriptor const*), sizeof(ComponentDescriptor const*));
+
+                        RegisterComponent(*component);
+
+                        // Sparse components are not stored into the archetypes, see ArchetypeFingerprint::CreateFingerPrintFrom
+                        if (!component->IsSparse())
+                            created_fingerprint.Add(component->GetId());
+                    }
+
+                    if (!archetype || !(created_fingerprint == fingerprint))
+                    {
+                        fingerprint = created_fingerprint;
+                        archetype   = &GetArchetype(fingerprint);
+                    }
+
+                    EntityID const entity = CreateEntity(*archetype);
+
+                    // Then adding the sparse components to their sparse set, see AddSparseComponents
+                    for (RkSize index = 0u; index < count; ++index)
+                    {
+                        ComponentDescriptor const* component;
+
+                        std::memcpy(&component, in_payload + index * sizeof(ComponentDescriptor const*), sizeof(ComponentDescriptor const*));
+
+                        if (component->IsSparse())
+                            m_sparse_sets[component->GetId()].Add(entity);
+                    }
+
+                    buffer->m_created[in_command.entity.GetIndex() - 1u] = entity;
+
+                    break;
+                }
+
+                case EntityCommandBuffer::ECommandType::DestroyEntity:
+                    DestroyEntity(buffer->Resolve(in_command.entity));
+                    break;
+
+                case EntityCommandBuffer::ECommandType::AddComponent:
+                {
+                    EntityID const entity = buffer->Resolve(in_command.entity);
+
+                    RegisterComponent(*in_command.component);
+
+                    // The recorded fields of a shared component are its value
+                    if (in_command.component->IsShared() && in_command.payload_size != 0u)
+                    {
+                        if (m_entities.IsAlive(entity) && !m_entities.GetLocation(entity).archetype->GetFingerprint().HasOne(in_command.component->GetId()))
+                            SetSharedComponent(entity, in_command.component->GetId(), m_shared_values.Intern(*in_command.component, in_payload));
+
+                        break;
+                    }
+
+                    if (!AddComponent(entity, in_command.component->GetId()) || in_command.payload_size == 0u)
+                        break;
+
+                    // Copying the recorded fields into the columns of the entity, or into the last item of the sparse set
+                    SparseSet      const& sparse_set = m_sparse_sets[in_command.component->GetId()];
+                    EntityLocation const& location   = m_entities.GetLocation(entity);
+                    RkSize         const  capacity   = location.archetype->GetChunkCapacity();
+                    RkSize                field      = 0u;
+
+                    for (ComponentDescriptor::Field const& field_descriptor : in_command.component->GetFields())
+                    {
+                        if (in_command.component->IsSparse())
+                        {
+                            std::memcpy(sparse_set.GetColumn(field++) + (sparse_set.GetSize() - 1u) * field_descriptor.size, in_payload, field_descriptor.size);
+                        }
+                        else
+                        {
+                            RkUint8* column = location.archetype->GetColumn(location.row / capacity, in_command.component->GetId(), field++);
+
+                            std::memcpy(column + location.row % capacity * field_descriptor.size, in_payload, field_descriptor.size);
+                        }
+
+                        in_payload += field_descriptor.size;
+                    }
+
+                    break;
+                }
+
+                case EntityCommandBuffer::ECommandType::RemoveComponent:
+                    RemoveComponent(buffer->Resolve(in_command.entity), in_command.component->GetId());
+                    break;
+            }
+        });
+    }
+
+    for (EntityCommandBuffer& buffer : m_command_buffers)
+        buffer.Clear();
+
+    m_command_batches.clear();
 }
@@ -22,33 +22,191 @@
  *  SOFTWARE.
  */
 
-template <typename TSystem>
-RkVoid EntityAdmin::CreateSystem() noexcept
+template <typename TSystem, typename... TArgs>
+TSystem& EntityAdmin::CreateSystem(TArgs&&... in_args) noexcept
 {
-    m_systems.emplace_back(new TSystem());
+    TSystem* system = new TSystem(std::forward<TArgs>(in_args)...);
+
+    m_systems.emplace_back(system);
+
+    system->m_admin = this;
+    system->m_order = static_cast<RkUint32>(m_systems.size() - 1u);
+
+    m_queries.AddQuery(system->m_query);
+
+    BindSparseSets(system->m_query);
+
+    m_track_removed_entities = m_track_removed_entities || system->m_track_removed_entities;
+
+    return *system;
+}
+
+template <typename... TComponents>
+RkVoid EntityAdmin::AddSparseComponents(EntityRange const& in_entities) noexcept
+{
+    if constexpr ((TComponents::sparse || ...))
+    {
+        // Sparse components are not stored into the archetype of the entities
+        for (RkSize index = 0u; index < in_entities.Size(); ++index)
+            ((TComponents::sparse ? RkVoid(m_sparse_sets[TComponents::id].Add(in_entities[index])) : RkVoid()), ...);
+    }
+}
+
+template <typename TComponent>
+TComponent EntityAdmin::GetComponent(Archetype const& in_archetype, RkSize const in_chunk) const noexcept
+{
+    if constexpr (TComponent::sparse)
+        return m_sparse_sets[TComponent::id].template GetComponent<TComponent>(in_archetype.GetEntities(in_chunk));
+    else
+        return in_archetype.template GetComponent<TComponent>(in_chunk);
+}
+
+template <typename TComponent>
+RkVoid EntityAdmin::RegisterComponent() noexcept
+{
+    if (!m_registered_components.HasOne(TComponent::id))
+        RegisterComponent(ComponentDescriptor::Get<TComponent>());
 }
 
 template <typename... TComponents>
 EntityID EntityAdmin::CreateEntity() noexcept
 {
-    using TargetArchetype = MakeArchetype<TComponents...>;
+    (RegisterComponent<TComponents>(), ...);
 
-    // Looking for the archetype of the entity
-    ArchetypeFingerprint const targeted_fingerprint = ArchetypeFingerprint::CreateFingerPrintFrom<TComponents...>();
+    EntityID const entity = CreateEntity(GetArchetype(ArchetypeFingerprint::CreateFingerPrintFrom<TComponents...>()));
 
-    TargetArchetype* target_archetype;
+    AddSparseComponents<TComponents...>(EntityRange(entity, 1u));
 
-    // If we didn't found any corresponding archetypes, creating it
-    if (m_archetypes.find(targeted_fingerprint) == m_archetypes.end())
+    return entity;
+}
+
+template <typename... TComponents>
+EntityRange EntityAdmin::CreateEntities(RkSize const in_count) noexcept
+{
+    (RegisterComponent<TComponents>(), ...);
+
+    EntityRange const entities = CreateEntities(GetArchetype(ArchetypeFingerprint::CreateFingerPrintFrom<TComponents...>()), in_count);
+
+    AddSparseComponents<TComponents...>(entities);
+
+    return entities;
+}
+
+template <typename... TComponents, typename TInitializer>
+EntityRange EntityAdmin::CreateEntities(RkSize const in_count, TInitializer&& in_initializer) noexcept
+{
+    (RegisterComponent<TComponents>(), ...);
+
+    Archetype&        archetype = GetArchetype(ArchetypeFingerprint::CreateFingerPrintFrom<TComponents...>());
+    EntityRange const entities  = CreateEntities(archetype, in_count);
+
+    AddSparseComponents<TComponents...>(entities);
+
+    if (in_count == 0u)
+        return entities;
+
+    RkSize const capacity  = archetype.GetChunkCapacity();
+    RkSize const first_row = m_entities.GetLocation(entities[0]).row;
+
+    for (RkSize row = first_row; row < first_row + in_count;)
     {
-        target_archetype                   = new TargetArchetype();
-        m_archetypes[targeted_fingerprint] = target_archetype;
+        RkSize const chunk = row / capacity;
+        RkSize const begin = row % capacity;
+        RkSize const end   = std::min(capacity, begin + first_row + in_count - row);
+
+        ComponentRange<TComponents...> range({GetComponent<TComponents>(archetype, chunk)...}, begin, end);
+
+        in_initializer(range);
+
+        row += end - begin;
+    }
+
+    return entities;
+}
+
+template <typename TComponent>
+RkBool EntityAdmin::AddComponent(EntityID const in_entity) noexcept
+{
+    RegisterComponent<TComponent>();
+
+    return AddComponent(in_entity, TComponent::id);
+}
+
+template <typename TComponent>
+RkBool EntityAdmin::AddComponent(EntityID const in_entity, typename TComponent::Item const& in_item) noexcept
+{
+    if constexpr (TComponent::sparse)
+    {
+        if (!AddComponent<TComponent>(in_entity))
+            return false;
+
+        // Viewing the entity as a chunk of a single row
+        m_sparse_sets[TComponent::id].template GetComponent<TComponent>(&in_entity).SetItem(0u, in_item);
+
+        return true;
+    }
+    else if constexpr (TComponent::shared)
+    {
+        if (!m_entities.IsAlive(in_entity) || HasComponent<TComponent>(in_entity))
+            return false;
+
+        return SetSharedComponent<TComponent>(in_entity, in_item);
     }
-    // Otherwise, fetching it
     else
     {
-        target_archetype = static_cast<TargetArchetype*>(m_archetypes[targeted_fingerprint]);
+        if (!AddComponent<TComponent>(in_entity))
+            return false;
+
+        EntityLocation const& location = m_entities.GetLocation(in_entity);
+        RkSize         const  capacity = location.archetype->GetChunkCapacity();
+
+        location.archetype->GetComponent<TComponent>(location.row / capacity).SetItem(location.row % capacity, in_item);
+
+        return true;
     }
+}
 
-    return target_archetype->CreateEntity();
+template <typename TComponent>
+RkBool EntityAdmin::RemoveComponent(EntityID const in_entity) noexcept
+{
+    return RemoveComponent(in_entity, TComponent::id);
 }
+
+template <typename TComponent>
+RkBool EntityAdmin::SetSharedComponent(EntityID const in_entity, typename TComponent::Item const& in_item) noexcept
+{
+    RUKEN_STATIC_ASSERT(TComponent::shared, "Only the values of the shared components can be set per archetype");
+
+    RegisterComponent<TComponent>();
+
+    return SetSharedComponent(in_entity, TComponent::id, m_shared_values.Intern<TComponent>(in_item));
+}
+
+template <typename TComponent>
+TComponent EntityAdmin::GetSharedComponent(EntityID const in_entity) const noexcept
+{
+    RUKEN_STATIC_ASSERT(TComponent::shared, "Only the values of the shared components are stored per archetype");
+
+    return m_entities.GetLocation(in_entity).archetype->template GetComponent<TComponent>(0u);
+}
+
+template <typename TComponent>
+RkVoid EntityAdmin::SetSingleton(typename TComponent::Item const& in_item) noexcept
+{
+    m_shared_values.SetSingleton<TComponent>(in_item);
+}
+
+template <typename TComponent>
+auto& EntityAdmin::GetSingleton() noexcept
+{
+    return m_shared_values.GetSingleton<TComponent>();
+}
+
+template <typename TComponent>
+RkBool EntityAdmin::HasComponent(EntityID const in_entity) const noexcept
+{
+    if constexpr (TComponent::sparse)
+        return m_sparse_sets[TComponent::id].Contains(in_entity);
+    else
+        return m_entities.IsAlive(in_entity) && m_entities.GetLocation(in_entity).archetype->GetFingerprint().HasOne(TComponent::id);
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <new>
+
+#include "Meta/Assert.hpp"
+
+#include "ECS/SystemJobContext.hpp"
+#include "ECS/EntityCommandBuffer.hpp"
+
+USING_RUKEN_NAMESPACE
+
+EntityCommandBuffer::EntityCommandBuffer(ChunkPool& in_chunk_pool) noexcept:
+    m_chunk_pool    {&in_chunk_pool},
+    m_pages         {},
+    m_batches       {},
+    m_page          {0u},
+    m_created_count {0u},
+    m_created       {}
+{}
+
+EntityCommandBuffer::~EntityCommandBuffer() noexcept
+{
+    for (Page const& page : m_pages)
+        m_chunk_pool->Release(page.data);
+}
+
+RkUint8* EntityCommandBuffer::Record(ECommandType const        in_type,
+                                     EntityID     const        in_entity,
+                                     ComponentDescriptor const* in_component,
+                                     RkSize       const        in_payload_size) noexcept
+{
+    RkSize const size = sizeof(Command) + (in_payload_size + alignof(Command) - 1u) / alignof(Command) * alignof(Command);
+
+    RUKEN_ASSERT_MESSAGE(size <= m_chunk_pool->GetChunkSize(), "An entity command cannot be bigger than a page");
+
+    if (m_pages.empty())
+        m_pages.push_back(Page {m_chunk_pool->Allocate(), 0u});
+
+    if (m_pages[m_page].size + size > m_chunk_pool->GetChunkSize())
+    {
+        if (++m_page == m_pages.size())
+            m_pages.push_back(Page {m_chunk_pool->Allocate(), 0u});
+    }
+
+    Page& page = m_pages[m_page];
+
+    SystemJobContext const* context  = SystemJobContext::GetCurrent();
+    RkUint64         const  sort_key = context ? context->sort_key : default_sort_key;
+
+    if (m_batches.empty() || m_batches.back().sort_key != sort_key)
+        m_batches.push_back(Batch {sort_key, m_page, page.size, 0u});
+
+    ++m_batches.back().count;
+
+    Command* command = new (page.data + page.size) Command {in_type, static_cast<RkUint32>(in_payload_size), EntityID(in_entity), in_component};
+
+    page.size += size;
+
+    return reinterpret_cast<RkUint8*>(command) + sizeof(Command);
+}
+
+EntityID EntityCommandBuffer::Resolve(EntityID const in_entity) const noexcept
+{
+    if (in_entity.GetGeneration() != 0u)
+        return in_entity;
+
+    RkSize const index = in_entity.GetIndex();
+
+    return index > 0u && index <= m_created.size() ? m_created[index - 1u] : EntityID();
+}
+
+RkVoid EntityCommandBuffer::DestroyEntity(EntityID const in_entity) noexcept
+{
+    Record(ECommandType::DestroyEntity, in_entity, nullptr, 0u);
+}
+
+RkBool EntityCommandBuffer::Empty() const noexcept
+{
+    return m_batches.empty();
+}
+
+RkVoid EntityCommandBuffer::Clear() noexcept
+{
+    for (Page& page : m_pages)
+        page.size = 0u;
+
+    m_batches.clear();
+    m_created.clear();
+
+    m_page          = 0u;
+    m_created_count = 0u;
+}
\ No newline at end of file
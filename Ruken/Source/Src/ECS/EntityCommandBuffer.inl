@@ -0,0 +1,94 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TFunction>
+RkVoid EntityCommandBuffer::ForEachCommand(Batch const& in_batch, TFunction&& in_function) const noexcept
+{
+    RkSize page   = in_batch.page;
+    RkSize offset = in_batch.offset;
+
+    for (RkSize index = 0u; index < in_batch.count; ++index)
+    {
+        // Commands not fitting at the end of a page are recorded at the start of the next one
+        if (offset == m_pages[page].size)
+        {
+            ++page;
+            offset = 0u;
+        }
+
+        Command const& command = *reinterpret_cast<Command const*>(m_pages[page].data + offset);
+
+        in_function(command, m_pages[page].data + offset + sizeof(Command));
+
+        offset += sizeof(Command) + (command.payload_size + alignof(Command) - 1u) / alignof(Command) * alignof(Command);
+    }
+}
+
+template <typename... TComponents>
+EntityID EntityCommandBuffer::CreateEntity() noexcept
+{
+    // Index 0 is skipped, a placeholder can thus never be mistaken for a default constructed ID
+    EntityID const entity = EntityID::Create(++m_created_count, 0u);
+
+    RkUint8* payload = Record(ECommandType::CreateEntity, entity, nullptr, sizeof...(TComponents) * sizeof(ComponentDescriptor const*));
+
+    if constexpr (sizeof...(TComponents) > 0u)
+    {
+        ComponentDescriptor const* components[] = {&ComponentDescriptor::Get<TComponents>()...};
+
+        std::memcpy(payload, components, sizeof(components));
+    }
+
+    return entity;
+}
+
+template <typename TComponent, RkSize... TIds>
+RkVoid EntityCommandBuffer::AddComponentHelper(EntityID const in_entity, typename TComponent::Item const& in_item, std::index_sequence<TIds...>) noexcept
+{
+    constexpr RkSize size = (sizeof(typename TComponent::Item::template FieldType<TIds>) + ... + 0u);
+
+    RkUint8* payload = Record(ECommandType::AddComponent, in_entity, &ComponentDescriptor::Get<TComponent>(), size);
+
+    // Fields are packed in declaration order, as described by the component descriptor
+    ((std::memcpy(payload, &std::get<TIds>(in_item), sizeof(typename TComponent::Item::template FieldType<TIds>)),
+      payload += sizeof(typename TComponent::Item::template FieldType<TIds>)), ...);
+}
+
+template <typename TComponent>
+RkVoid EntityCommandBuffer::AddComponent(EntityID const in_entity) noexcept
+{
+    Record(ECommandType::AddComponent, in_entity, &ComponentDescriptor::Get<TComponent>(), 0u);
+}
+
+template <typename TComponent>
+RkVoid EntityCommandBuffer::AddComponent(EntityID const in_entity, typename TComponent::Item const& in_item) noexcept
+{
+    AddComponentHelper<TComponent>(in_entity, in_item, std::make_index_sequence<TComponent::Item::fields_count>());
+}
+
+template <typename TComponent>
+RkVoid EntityCommandBuffer::RemoveComponent(EntityID const in_entity) noexcept
+{
+    Record(ECommandType::RemoveComponent, in_entity, &ComponentDescriptor::Get<TComponent>(), 0u);
+}
\ No newline at end of file
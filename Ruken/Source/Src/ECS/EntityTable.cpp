@@ -0,0 +1,172 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Meta/Assert.hpp"
+
+#include "ECS/EntityTable.hpp"
+
+USING_RUKEN_NAMESPACE
+
+EntityTable::EntityTable() noexcept:
+    m_slots       {},
+    m_free_head   {invalid_index},
+    m_alive_count {0u}
+{}
+
+EntityID EntityTable::Create(EntityLocation const& in_location) noexcept
+{
+    RkUint32 index;
+
+    if (m_free_head != invalid_index)
+    {
+        index       = m_free_head;
+        m_free_head = m_slots[index].next_free;
+    }
+    else
+    {
+        RUKEN_ASSERT_MESSAGE(m_slots.size() < invalid_index, "Too many entities, entity indices are limited to 32 bits");
+
+        index = static_cast<RkUint32>(m_slots.size());
+
+        // Generations start at 1 so that a default constructed ID is never alive
+        m_slots.push_back(Slot {{}, 1u, invalid_index});
+    }
+
+    Slot& slot = m_slots[index];
+
+    slot.location  = in_location;
+    slot.next_free = invalid_index;
+
+    ++m_alive_count;
+
+    return EntityID::Create(index, slot.generation);
+}
+
+EntityID EntityTable::CreateRange(EntityLocation const& in_location, RkSize const in_count) noexcept
+{
+    RUKEN_ASSERT_MESSAGE(m_slots.size() + in_count <= invalid_index, "Too many entities, entity indices are limited to 32 bits");
+
+    RkUint32 const first = static_cast<RkUint32>(m_slots.size());
+
+    m_slots.reserve(m_slots.size() + in_count);
+
+    // Recycled slots would not be contiguous nor share the same generation
+    for (RkSize index = 0u; index < in_count; ++index)
+        m_slots.push_back(Slot {EntityLocation {in_location.archetype, in_location.row + index}, 1u, invalid_index});
+
+    m_alive_count += in_count;
+
+    return EntityID::Create(first, 1u);
+}
+
+RkVoid EntityTable::Destroy(EntityID const in_entity) noexcept
+{
+    Slot& slot = m_slots[in_entity.GetIndex()];
+
+    // Skipping 0 when wrapping around, see Create
+    if (++slot.generation == 0u)
+        slot.generation = 1u;
+
+    slot.location  = {};
+    slot.next_free = m_free_head;
+    m_free_head    = in_entity.GetIndex();
+
+    --m_alive_count;
+}
+
+RkBool EntityTable::IsAlive(EntityID const in_entity) const noexcept
+{
+    if (in_entity.GetIndex() >= m_slots.size())
+        return false;
+
+    Slot const& slot = m_slots[in_entity.GetIndex()];
+
+    // Free slots have no archetype, their generation is already the one of the next entity
+    return slot.generation == in_entity.GetGeneration() && slot.location.archetype != nullptr;
+}
+
+EntityLocation const& EntityTable::GetLocation(EntityID const in_entity) const noexcept
+{
+    return m_slots[in_entity.GetIndex()].location;
+}
+
+RkVoid EntityTable::SetLocation(EntityID const in_entity, EntityLocation const& in_location) noexcept
+{
+    m_slots[in_entity.GetIndex()].location = in_location;
+}
+
+RkSize EntityTable::GetAliveCount() const noexcept
+{
+    return m_alive_count;
+}
+
+RkSize EntityTable::GetSlotsCount() const noexcept
+{
+    return m_slots.size();
+}
+
+RkUint32 EntityTable::GetGeneration(RkUint32 const in_index) const noexcept
+{
+    return m_slots[in_index].generation;
+}
+
+RkVoid EntityTable::Reset(RkUint32 const* in_generations, RkSize const in_count) noexcept
+{
+    RUKEN_ASSERT_MESSAGE(in_count < invalid_index, "Too many entities, entity indices are limited to 32 bits");
+
+    m_slots.resize(in_count);
+
+    for (RkSize index = 0u; index < in_count; ++index)
+        m_slots[index] = Slot {{}, in_generations[index], invalid_index};
+
+    m_free_head   = invalid_index;
+    m_alive_count = 0u;
+}
+
+RkVoid EntityTable::Restore(EntityID const in_entity, EntityLocation const& in_location) noexcept
+{
+    Slot& slot = m_slots[in_entity.GetIndex()];
+
+    RUKEN_ASSERT_MESSAGE(slot.location.archetype == nullptr && slot.generation == in_entity.GetGeneration(), "Only free slots of the same generation can be restored");
+
+    slot.location = in_location;
+
+    ++m_alive_count;
+}
+
+RkVoid EntityTable::RebuildFreeList() noexcept
+{
+    m_free_head = invalid_index;
+
+    for (RkSize index = m_slots.size(); index > 0u; --index)
+    {
+        Slot& slot = m_slots[index - 1u];
+
+        if (slot.location.archetype != nullptr)
+            continue;
+
+        slot.next_free = m_free_head;
+        m_free_head    = static_cast<RkUint32>(index - 1u);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TItem, RkSize TUniqueId>
+SharedComponent<TItem, TUniqueId>::SharedComponent(typename Layout::ContainerType const& in_value) noexcept:
+    m_value {in_value}
+{}
+
+template <typename TItem, RkSize TUniqueId>
+template <RkSize TMember>
+auto const& SharedComponent<TItem, TUniqueId>::Get() const noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, false);
+
+    return *std::get<TMember>(m_value);
+}
+
+template <typename TItem, RkSize TUniqueId>
+TItem SharedComponent<TItem, TUniqueId>::GetItem() const noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, false);
+
+    return std::apply([] (auto const*... in_fields) { return TItem(*in_fields...); }, m_value);
+}
\ No newline at end of file
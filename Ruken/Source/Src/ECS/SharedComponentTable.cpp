@@ -0,0 +1,110 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <cstring>
+#include <algorithm>
+
+#include "ECS/SharedComponentTable.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    /**
+     * \brief Hashes bytes with FNV-1a
+     * \param in_data Bytes to hash
+     * \param in_size Number of bytes
+     * \return Hash
+     */
+    RkSize HashBytes(RkUint8 const* in_data, RkSize const in_size) noexcept
+    {
+        RkUint64 hash = 14695981039346656037ull;
+
+        for (RkSize index = 0u; index < in_size; ++index)
+            hash = (hash ^ in_data[index]) * 1099511628211ull;
+
+        return static_cast<RkSize>(hash);
+    }
+}
+
+RkUint8 const* SharedComponentTable::Intern(ComponentDescriptor const& in_component, RkUint8 const* in_fields) noexcept
+{
+    RUKEN_ASSERT_MESSAGE(in_component.IsShared(), "Only the values of the shared components can be interned");
+
+    std::vector<ComponentDescriptor::Field> const& fields = in_component.GetFields();
+
+    RkSize fields_size = 0u;
+
+    for (ComponentDescriptor::Field const& field : fields)
+        fields_size += field.size;
+
+    RkSize const        hash   = HashBytes(in_fields, fields_size);
+    std::vector<Value>& values = m_values[in_component.GetId()];
+
+    for (Value const& value : values)
+    {
+        if (value.hash != hash)
+            continue;
+
+        RkUint8 const* field_data = in_fields;
+        RkBool         equal      = true;
+
+        for (RkSize index = 0u; equal && index < fields.size(); ++index)
+        {
+            equal       = std::memcmp(value.item.data() + fields[index].offset, field_data, fields[index].size) == 0;
+            field_data += fields[index].size;
+        }
+
+        if (equal)
+            return value.item.data();
+    }
+
+    // Laying out the new value field after field, fields without any byte still get a unique address
+    AlignedVector<RkUint8> item(std::max<RkSize>(in_component.GetItemSize(), 1u), 0u);
+
+    for (ComponentDescriptor::Field const& field : fields)
+    {
+        std::memcpy(item.data() + field.offset, in_fields, field.size);
+
+        in_fields += field.size;
+    }
+
+    // Moving the vector keeps its storage, the address of the value never changes
+    return values.emplace_back(Value {hash, std::move(item)}).item.data();
+}
+
+RkUint8 const* SharedComponentTable::Intern(ComponentDescriptor const& in_component) noexcept
+{
+    std::vector<RkUint8> fields;
+
+    for (ComponentDescriptor::Field const& field : in_component.GetFields())
+        fields.insert(fields.end(), field.default_value.begin(), field.default_value.end());
+
+    return Intern(in_component, fields.data());
+}
+
+RkSize SharedComponentTable::GetValuesCount(RkSize const in_component_id) const noexcept
+{
+    return m_values[in_component_id].size();
+}
\ No newline at end of file
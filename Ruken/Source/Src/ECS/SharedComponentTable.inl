@@ -0,0 +1,74 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TComponent, RkSize... TIds>
+RkUint8 const* SharedComponentTable::InternHelper(typename TComponent::Item const& in_item, std::index_sequence<TIds...>) noexcept
+{
+    std::array<RkUint8, (sizeof(typename TComponent::Item::template FieldType<TIds>) + ... + 0u)> fields;
+
+    RkSize offset = 0u;
+
+    ((std::memcpy(fields.data() + offset, &std::get<TIds>(in_item), sizeof(typename TComponent::Item::template FieldType<TIds>)),
+      offset += sizeof(typename TComponent::Item::template FieldType<TIds>)), ...);
+
+    return Intern(ComponentDescriptor::Get<TComponent>(), fields.data());
+}
+
+template <typename TComponent>
+RkUint8 const* SharedComponentTable::Intern(typename TComponent::Item const& in_item) noexcept
+{
+    RUKEN_STATIC_ASSERT(TComponent::shared, "Only the values of the shared components can be interned");
+
+    return InternHelper<TComponent>(in_item, std::make_index_sequence<TComponent::Item::fields_count>());
+}
+
+template <typename TComponent>
+RkVoid SharedComponentTable::SetSingleton(typename TComponent::Item const& in_item) noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(TComponent::id, true);
+
+    // Keeping the address of existing singletons stable
+    if (m_singletons[TComponent::id])
+        *static_cast<typename TComponent::Item*>(m_singletons[TComponent::id].get()) = in_item;
+    else
+        m_singletons[TComponent::id] = std::make_shared<typename TComponent::Item>(in_item);
+}
+
+template <typename TComponent>
+auto& SharedComponentTable::GetSingleton() const noexcept
+{
+    using Item = std::conditional_t<std::is_const_v<TComponent>, typename TComponent::Item const, typename TComponent::Item>;
+
+    RUKEN_ECS_VALIDATE_ACCESS(TComponent::id, !std::is_const_v<TComponent>);
+
+    RUKEN_ASSERT_MESSAGE(m_singletons[TComponent::id] != nullptr, "A singleton must be set before being accessed");
+
+    return *static_cast<Item*>(m_singletons[TComponent::id].get());
+}
+
+template <typename TComponent>
+RkBool SharedComponentTable::HasSingleton() const noexcept
+{
+    return m_singletons[TComponent::id] != nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TItem, RkSize TUniqueId>
+SparseComponent<TItem, TUniqueId>::SparseComponent(typename Layout::ContainerType const& in_storage,
+                                                   SparseSet                      const& in_set,
+                                                   EntityID                       const* in_entities) noexcept:
+    m_storage  {in_storage},
+    m_set      {&in_set},
+    m_entities {in_entities}
+{}
+
+template <typename TItem, RkSize TUniqueId>
+template <typename TView>
+auto SparseComponent<TItem, TUniqueId>::GetItem(ItemId const in_item_id) noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
+
+    return Layout::template Get<TView>(m_storage, m_set->GetDenseIndex(m_entities[in_item_id].GetIndex()));
+}
+
+template <typename TItem, RkSize TUniqueId>
+RkVoid SparseComponent<TItem, TUniqueId>::SetItem(ItemId const in_item_id, TItem const& in_item) noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
+
+    Layout::template Get<typename TItem::FullView>(m_storage, m_set->GetDenseIndex(m_entities[in_item_id].GetIndex())) = in_item;
+}
+
+template <typename TItem, RkSize TUniqueId>
+template <RkSize TMember>
+auto& SparseComponent<TItem, TUniqueId>::Get(ItemId const in_item_id) noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, true);
+
+    return std::get<TMember>(m_storage)[m_set->GetDenseIndex(m_entities[in_item_id].GetIndex())];
+}
+
+template <typename TItem, RkSize TUniqueId>
+template <RkSize TMember>
+auto const& SparseComponent<TItem, TUniqueId>::Get(ItemId const in_item_id) const noexcept
+{
+    RUKEN_ECS_VALIDATE_ACCESS(id, false);
+
+    return std::get<TMember>(m_storage)[m_set->GetDenseIndex(m_entities[in_item_id].GetIndex())];
+}
\ No newline at end of file
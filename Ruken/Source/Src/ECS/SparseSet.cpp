@@ -0,0 +1,156 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <cstring>
+
+#include "ECS/SparseSet.hpp"
+
+USING_RUKEN_NAMESPACE
+
+SparseSet::SparseSet() noexcept:
+    m_component {nullptr},
+    m_pages     {},
+    m_entities  {},
+    m_columns   {}
+{}
+
+RkVoid SparseSet::Reset(ComponentDescriptor const& in_component) noexcept
+{
+    m_component = &in_component;
+
+    m_pages   .clear();
+    m_entities.clear();
+
+    m_columns.assign(in_component.GetFields().size(), AlignedVector<RkUint8>());
+}
+
+RkBool SparseSet::Add(EntityID const in_entity) noexcept
+{
+    RkSize const page = in_entity.GetIndex() / page_size;
+
+    if (page >= m_pages.size())
+        m_pages.resize(page + 1u);
+
+    if (m_pages[page].empty())
+        m_pages[page].assign(page_size, invalid_index);
+
+    RkUint32& dense_index = m_pages[page][in_entity.GetIndex() & (page_size - 1u)];
+
+    if (dense_index != invalid_index)
+        return false;
+
+    dense_index = static_cast<RkUint32>(m_entities.size());
+
+    m_entities.push_back(in_entity);
+
+    for (RkSize field = 0u; field < m_columns.size(); ++field)
+    {
+        std::vector<RkUint8> const& default_value = m_component->GetFields()[field].default_value;
+
+        m_columns[field].insert(m_columns[field].end(), default_value.begin(), default_value.end());
+    }
+
+    return true;
+}
+
+RkBool SparseSet::Remove(EntityID const in_entity) noexcept
+{
+    if (!Contains(in_entity))
+        return false;
+
+    RkUint32&    dense_index = m_pages[in_entity.GetIndex() / page_size][in_entity.GetIndex() & (page_size - 1u)];
+    RkSize const last        = m_entities.size() - 1u;
+
+    // Moving the last entity into the position of the removed one
+    if (dense_index != last)
+    {
+        EntityID const moved = m_entities[last];
+
+        m_entities[dense_index] = moved;
+
+        for (RkSize field = 0u; field < m_columns.size(); ++field)
+        {
+            RkSize const size = m_component->GetFields()[field].size;
+
+            std::memcpy(m_columns[field].data() + dense_index * size, m_columns[field].data() + last * size, size);
+        }
+
+        m_pages[moved.GetIndex() / page_size][moved.GetIndex() & (page_size - 1u)] = dense_index;
+    }
+
+    dense_index = invalid_index;
+
+    m_entities.pop_back();
+
+    for (RkSize field = 0u; field < m_columns.size(); ++field)
+        m_columns[field].resize(last * m_component->GetFields()[field].size);
+
+    return true;
+}
+
+RkBool SparseSet::Contains(EntityID const in_entity) const noexcept
+{
+    // The index may have been recycled, the dense entity must be this very entity
+    return ContainsIndex(in_entity.GetIndex()) && m_entities[GetDenseIndex(in_entity.GetIndex())] == in_entity;
+}
+
+RkUint64 SparseSet::MatchEntities(EntityID const* in_entities, RkSize const in_count) const noexcept
+{
+    // Entities of a chunk are often created together, the page of the previous entity is thus looked up first
+    RkUint32 const* page_entries = nullptr;
+    RkSize          page         = ~RkSize(0u);
+    RkUint64        mask         = 0u;
+
+    for (RkSize index = 0u; index < in_count; ++index)
+    {
+        RkUint32 const entity_index = in_entities[index].GetIndex();
+
+        if (entity_index / page_size != page)
+        {
+            page         = entity_index / page_size;
+            page_entries = page < m_pages.size() && !m_pages[page].empty() ? m_pages[page].data() : nullptr;
+        }
+
+        if (page_entries)
+            mask |= static_cast<RkUint64>(page_entries[entity_index & (page_size - 1u)] != invalid_index) << index;
+    }
+
+    return mask;
+}
+
+RkSize SparseSet::GetSize() const noexcept
+{
+    return m_entities.size();
+}
+
+EntityID const* SparseSet::GetEntities() const noexcept
+{
+    return m_entities.data();
+}
+
+RkUint8* SparseSet::GetColumn(RkSize const in_field) const noexcept
+{
+    // Like the columns of the archetypes, fields are written through the views handed to the systems
+    return const_cast<RkUint8*>(m_columns[in_field].data());
+}
\ No newline at end of file
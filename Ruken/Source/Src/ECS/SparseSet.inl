@@ -0,0 +1,51 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+inline RkBool SparseSet::ContainsIndex(RkUint32 const in_index) const noexcept
+{
+    RkSize const page = in_index / page_size;
+
+    return page < m_pages.size() && !m_pages[page].empty() && m_pages[page][in_index & (page_size - 1u)] != invalid_index;
+}
+
+inline RkSize SparseSet::GetDenseIndex(RkUint32 const in_index) const noexcept
+{
+    return m_pages[in_index / page_size][in_index & (page_size - 1u)];
+}
+
+template <typename TComponent, RkSize... TIds>
+TComponent SparseSet::GetComponentHelper(EntityID const* in_entities, std::index_sequence<TIds...>) const noexcept
+{
+    using Columns = typename TComponent::Layout::ContainerType;
+
+    return TComponent(Columns {reinterpret_cast<typename TComponent::Item::template FieldType<TIds>*>(GetColumn(TIds))...}, *this, in_entities);
+}
+
+template <typename TComponent>
+TComponent SparseSet::GetComponent(EntityID const* in_entities) const noexcept
+{
+    RUKEN_STATIC_ASSERT(TComponent::sparse, "Only the sparse components are stored into sparse sets");
+
+    return GetComponentHelper<TComponent>(in_entities, std::make_index_sequence<TComponent::Item::fields_count>());
+}
\ No newline at end of file
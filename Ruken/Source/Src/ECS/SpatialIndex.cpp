@@ -0,0 +1,916 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "Build/Config.hpp"
+
+#if defined(RUKEN_ECS_ENABLE_SIMD_SPATIAL_QUERIES)
+    #include <xmmintrin.h>
+#endif
+
+#include "Threading/Scheduler.hpp"
+
+#include "ECS/SpatialIndex.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    // Cell coordinates are packed on 21 bits each into the cell keys
+    constexpr RkInt32 min_coordinate = -(1 << 20);
+    constexpr RkInt32 max_coordinate =  (1 << 20) - 1;
+
+    // Coordinates of the unused lanes of the blocks, any distance to them overflows to infinity
+    constexpr RkFloat unreachable = std::numeric_limits<RkFloat>::max();
+
+    /**
+     * \brief Returns the bound of the squared distances matching a query, distances strictly below it match.
+     *        Unused lanes are thus never matched, even by an infinite distance
+     * \param in_distance Maximum distance, inclusive
+     * \return Exclusive squared distance bound
+     */
+    RkFloat GetSquaredBound(RkFloat const in_distance) noexcept
+    {
+        return std::nextafter(in_distance * in_distance, std::numeric_limits<RkFloat>::infinity());
+    }
+
+    /**
+     * \brief Returns the coordinate of the cell containing a position along an axis
+     * \param in_value Position along the axis, in cells
+     * \return Cell coordinate, clamped to the range of the cell keys
+     */
+    RkInt32 GetCoordinate(RkFloat const in_value) noexcept
+    {
+        // Clamping first, the conversion below is then well defined. NaNs end up in the first cell
+        if (!(in_value > static_cast<RkFloat>(min_coordinate)))
+            return min_coordinate;
+
+        if (in_value >= static_cast<RkFloat>(max_coordinate))
+            return max_coordinate;
+
+        // Conversions truncate toward 0, negative values are rounded down afterwards
+        RkInt32 const coordinate = static_cast<RkInt32>(in_value);
+
+        return coordinate - static_cast<RkInt32>(static_cast<RkFloat>(coordinate) > in_value);
+    }
+
+    /**
+     * \brief Packs the coordinates of a cell into a key
+     * \param in_x Cell coordinate along x
+     * \param in_y Cell coordinate along y
+     * \param in_z Cell coordinate along z
+     * \return Cell key
+     */
+    RkUint64 PackKey(RkInt32 const in_x, RkInt32 const in_y, RkInt32 const in_z) noexcept
+    {
+        return  static_cast<RkUint64>(in_x - min_coordinate)
+             | (static_cast<RkUint64>(in_y - min_coordinate) << 21u)
+             | (static_cast<RkUint64>(in_z - min_coordinate) << 42u);
+    }
+
+    /**
+     * \brief Hashes a cell key, the low bits select the shard and the high bits the slot into the hash table of the shard
+     * \param in_key Cell key
+     * \return Hash
+     */
+    RkUint64 Hash(RkUint64 in_key) noexcept
+    {
+        in_key ^= in_key >> 33u;
+        in_key *= 0xFF51AFD7ED558CCDull;
+        in_key ^= in_key >> 33u;
+
+        return in_key;
+    }
+
+    /**
+     * \brief Returns the first slot of the probe sequence of a key into a hash table
+     * \param in_key Cell key
+     * \param in_table_size Size of the table, a power of 2
+     * \return Slot index
+     */
+    RkSize GetSlot(RkUint64 const in_key, RkSize const in_table_size) noexcept
+    {
+        return static_cast<RkSize>(Hash(in_key) >> 32u) & (in_table_size - 1u);
+    }
+
+    /**
+     * \brief Returns the number of cells of a box of cells
+     * \param in_min Minimum cell coordinates
+     * \param in_max Maximum cell coordinates
+     * \return Cells count
+     */
+    RkUint64 GetCellsCount(std::array<RkInt32, 3u> const& in_min, std::array<RkInt32, 3u> const& in_max) noexcept
+    {
+        RkUint64 count = 1u;
+
+        for (RkSize axis = 0u; axis < 3u; ++axis)
+        {
+            if (in_max[axis] < in_min[axis])
+                return 0u;
+
+            count *= static_cast<RkUint64>(in_max[axis] - in_min[axis]) + 1u;
+        }
+
+        return count;
+    }
+
+    /**
+     * \brief Hints the processor to fetch a cache line ahead of its use
+     * \param in_address Address within the cache line
+     */
+    RkVoid Prefetch(RkVoid const* in_address) noexcept
+    {
+        #if defined(RUKEN_ECS_ENABLE_SIMD_SPATIAL_QUERIES)
+
+        _mm_prefetch(static_cast<char const*>(in_address), _MM_HINT_T0);
+
+        #else
+
+        (RkVoid)in_address;
+
+        #endif
+    }
+}
+
+SpatialIndex::SpatialIndex(RkFloat const in_cell_size) noexcept:
+    m_cell_size         {in_cell_size},
+    m_inverse_cell_size {1.0f / in_cell_size},
+    m_size              {0u},
+    m_shards            {},
+    m_locations         {},
+    m_moves             {},
+    m_batches           {}
+{
+    RUKEN_ASSERT_MESSAGE(in_cell_size > 0.0f, "The cells of a spatial index must have a positive size");
+
+    for (Shard& shard : m_shards)
+        shard.cells_count = 0u;
+}
+
+RkUint64 SpatialIndex::GetKey(Vector3f const& in_position) const noexcept
+{
+    return PackKey(GetCoordinate(in_position.data[0] * m_inverse_cell_size),
+                   GetCoordinate(in_position.data[1] * m_inverse_cell_size),
+                   GetCoordinate(in_position.data[2] * m_inverse_cell_size));
+}
+
+RkSize SpatialIndex::GetShard(RkUint64 const in_key) noexcept
+{
+    return static_cast<RkSize>(Hash(in_key)) & (shards_count - 1u);
+}
+
+RkSize SpatialIndex::FindSlot(Shard const& in_shard, RkUint64 const in_key) noexcept
+{
+    RkSize const mask = in_shard.cells.size() - 1u;
+    RkSize       slot = GetSlot(in_key, in_shard.cells.size());
+
+    while (in_shard.cells[slot].key != in_key && in_shard.cells[slot].key != empty_key)
+        slot = (slot + 1u) & mask;
+
+    return slot;
+}
+
+SpatialIndex::Cell& SpatialIndex::FindOrCreateCell(Shard& in_shard, RkUint64 const in_key) noexcept
+{
+    // The table is kept at most half full, probe sequences thus stay short. Cells are never removed, so no tombstone is needed
+    if ((in_shard.cells_count + 1u) * 2u > in_shard.cells.size())
+    {
+        std::vector<Cell> cells(std::max(in_shard.cells.size() * 2u, RkSize(64u)), Cell {empty_key, invalid_index, invalid_index, 0u});
+
+        std::swap(cells, in_shard.cells);
+
+        for (Cell const& cell : cells)
+        {
+            if (cell.key != empty_key)
+                in_shard.cells[FindSlot(in_shard, cell.key)] = cell;
+        }
+    }
+
+    Cell& cell = in_shard.cells[FindSlot(in_shard, in_key)];
+
+    if (cell.key == empty_key)
+    {
+        cell.key = in_key;
+
+        ++in_shard.cells_count;
+    }
+
+    return cell;
+}
+
+RkSize SpatialIndex::FindCells(RkUint64 const* in_keys, RkSize const in_count, std::pair<Shard const*, Cell const*>* out_cells) const noexcept
+{
+    for (RkSize index = 0u; index < in_count; ++index)
+    {
+        Shard const& shard = m_shards[GetShard(in_keys[index])];
+
+        if (!shard.cells.empty())
+            Prefetch(shard.cells.data() + GetSlot(in_keys[index], shard.cells.size()));
+    }
+
+    RkSize found = 0u;
+
+    for (RkSize index = 0u; index < in_count; ++index)
+    {
+        Shard const& shard = m_shards[GetShard(in_keys[index])];
+
+        if (shard.cells.empty())
+            continue;
+
+        // Empty slots have no entity either
+        Cell const& cell = shard.cells[FindSlot(shard, in_keys[index])];
+
+        if (cell.count == 0u)
+            continue;
+
+        // Most cells fit in their first block
+        Block const& block = shard.blocks[cell.first_block];
+
+        for (RkSize group = 0u; group * group_size < std::min<RkSize>(cell.count, block_size); ++group)
+            Prefetch(block.groups + group);
+
+        out_cells[found++] = std::make_pair(&shard, &cell);
+    }
+
+    return found;
+}
+
+RkVoid SpatialIndex::Insert(Shard& in_shard, EntityID const in_entity, Vector3f const& in_position, RkUint64 const in_key) noexcept
+{
+    Cell&          cell = FindOrCreateCell(in_shard, in_key);
+    RkUint32 const lane = cell.count % block_size;
+
+    // The last block of the cell is full, linking a new one
+    if (lane == 0u)
+    {
+        RkUint32 block_index;
+
+        if (in_shard.free_blocks.empty())
+        {
+            block_index = static_cast<RkUint32>(in_shard.blocks.size());
+
+            in_shard.blocks.emplace_back();
+        }
+        else
+        {
+            block_index = in_shard.free_blocks.back();
+
+            in_shard.free_blocks.pop_back();
+        }
+
+        Block& block = in_shard.blocks[block_index];
+
+        for (Group& group : block.groups)
+        {
+            std::fill(std::begin(group.x), std::end(group.x), unreachable);
+            std::fill(std::begin(group.y), std::end(group.y), unreachable);
+            std::fill(std::begin(group.z), std::end(group.z), unreachable);
+        }
+
+        block.previous = cell.last_block;
+        block.next     = invalid_index;
+
+        if (cell.last_block == invalid_index)
+            cell.first_block = block_index;
+        else
+            in_shard.blocks[cell.last_block].next = block_index;
+
+        cell.last_block = block_index;
+    }
+
+    Block& block = in_shard.blocks[cell.last_block];
+    Group& group = block.groups[lane / group_size];
+
+    group.x[lane % group_size] = in_position.data[0];
+    group.y[lane % group_size] = in_position.data[1];
+    group.z[lane % group_size] = in_position.data[2];
+
+    block.entities[lane] = in_entity;
+
+    ++cell.count;
+
+    m_locations[in_entity.GetIndex()] = Location {in_entity, in_key, cell.last_block, lane};
+}
+
+RkVoid SpatialIndex::Erase(Shard& in_shard, Location& in_location) noexcept
+{
+    Cell&          cell       = in_shard.cells[FindSlot(in_shard, in_location.key)];
+    RkUint32 const last_index = cell.last_block;
+    RkUint32 const last_lane  = (cell.count - 1u) % block_size;
+    Block&         block      = in_shard.blocks[in_location.block];
+    Block&         last_block = in_shard.blocks[last_index];
+    Group&         last_group = last_block.groups[last_lane / group_size];
+
+    // Moving the last entity of the cell into the hole
+    if (in_location.block != last_index || in_location.lane != last_lane)
+    {
+        Group& group = block.groups[in_location.lane / group_size];
+
+        group.x[in_location.lane % group_size] = last_group.x[last_lane % group_size];
+        group.y[in_location.lane % group_size] = last_group.y[last_lane % group_size];
+        group.z[in_location.lane % group_size] = last_group.z[last_lane % group_size];
+
+        block.entities[in_location.lane] = last_block.entities[last_lane];
+
+        Location& moved = m_locations[block.entities[in_location.lane].GetIndex()];
+
+        moved.block = in_location.block;
+        moved.lane  = in_location.lane;
+    }
+
+    last_group.x[last_lane % group_size] = unreachable;
+    last_group.y[last_lane % group_size] = unreachable;
+    last_group.z[last_lane % group_size] = unreachable;
+
+    --cell.count;
+
+    // The last block is now empty, unlinking it
+    if (last_lane == 0u)
+    {
+        cell.last_block = last_block.previous;
+
+        if (cell.last_block == invalid_index)
+            cell.first_block = invalid_index;
+        else
+            in_shard.blocks[cell.last_block].next = invalid_index;
+
+        in_shard.free_blocks.push_back(last_index);
+    }
+
+    in_location = Location {};
+}
+
+RkVoid SpatialIndex::ApplyMoves(Shard& in_shard, RkBool const in_removals) noexcept
+{
+    if (in_removals)
+    {
+        for (RkUint32 const move : in_shard.removals)
+            Erase(in_shard, m_locations[m_moves[move].entity.GetIndex()]);
+
+        return;
+    }
+
+    // Entities entering the shard are scattered over m_locations, their locations are fetched a few insertions ahead
+    for (RkSize index = 0u; index < in_shard.insertions.size(); ++index)
+    {
+        if (index + prefetch_distance < in_shard.insertions.size())
+            Prefetch(m_locations.data() + m_moves[in_shard.insertions[index + prefetch_distance]].entity.GetIndex());
+
+        Move const& move = m_moves[in_shard.insertions[index]];
+
+        Insert(in_shard, move.entity, move.position, move.key);
+    }
+}
+
+RkVoid SpatialIndex::QueryBlock(Block const& in_block, RkSize const in_count, Sphere const& in_sphere, std::vector<EntityID>& out_entities) noexcept
+{
+    RkUint32     mask   = 0u;
+    RkSize const groups = (std::min(in_count, block_size) + group_size - 1u) / group_size;
+
+    #if defined(RUKEN_ECS_ENABLE_SIMD_SPATIAL_QUERIES)
+
+    __m128 const center_x = _mm_set1_ps(in_sphere.center.data[0]);
+    __m128 const center_y = _mm_set1_ps(in_sphere.center.data[1]);
+    __m128 const center_z = _mm_set1_ps(in_sphere.center.data[2]);
+    __m128 const bound    = _mm_set1_ps(GetSquaredBound(in_sphere.radius));
+
+    for (RkSize group = 0u; group < groups; ++group)
+    {
+        __m128 const x = _mm_sub_ps(_mm_load_ps(in_block.groups[group].x), center_x);
+        __m128 const y = _mm_sub_ps(_mm_load_ps(in_block.groups[group].y), center_y);
+        __m128 const z = _mm_sub_ps(_mm_load_ps(in_block.groups[group].z), center_z);
+
+        __m128 const distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+        mask |= static_cast<RkUint32>(_mm_movemask_ps(_mm_cmplt_ps(distance, bound))) << (group * group_size);
+    }
+
+    #else
+
+    RkFloat const bound = GetSquaredBound(in_sphere.radius);
+
+    for (RkSize lane = 0u; lane < groups * group_size; ++lane)
+    {
+        Group const& group = in_block.groups[lane / group_size];
+
+        RkFloat const x = group.x[lane % group_size] - in_sphere.center.data[0];
+        RkFloat const y = group.y[lane % group_size] - in_sphere.center.data[1];
+        RkFloat const z = group.z[lane % group_size] - in_sphere.center.data[2];
+
+        mask |= static_cast<RkUint32>(x * x + y * y + z * z < bound) << lane;
+    }
+
+    #endif
+
+    for (RkSize lane = 0u; mask != 0u; ++lane, mask >>= 1u)
+    {
+        if ((mask & 1u) != 0u)
+            out_entities.push_back(in_block.entities[lane]);
+    }
+}
+
+RkVoid SpatialIndex::FindNearestInBlock(Block    const& in_block,
+                                        RkSize   const  in_count,
+                                        Vector3f const& in_position,
+                                        RkFloat&        inout_distance,
+                                        EntityID&       inout_entity) noexcept
+{
+    alignas(16) RkFloat distances[block_size];
+
+    RkSize const groups = (std::min(in_count, block_size) + group_size - 1u) / group_size;
+
+    #if defined(RUKEN_ECS_ENABLE_SIMD_SPATIAL_QUERIES)
+
+    __m128 const position_x = _mm_set1_ps(in_position.data[0]);
+    __m128 const position_y = _mm_set1_ps(in_position.data[1]);
+    __m128 const position_z = _mm_set1_ps(in_position.data[2]);
+
+    for (RkSize group = 0u; group < groups; ++group)
+    {
+        __m128 const x = _mm_sub_ps(_mm_load_ps(in_block.groups[group].x), position_x);
+        __m128 const y = _mm_sub_ps(_mm_load_ps(in_block.groups[group].y), position_y);
+        __m128 const z = _mm_sub_ps(_mm_load_ps(in_block.groups[group].z), position_z);
+
+        _mm_store_ps(distances + group * group_size, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+    }
+
+    #else
+
+    for (RkSize lane = 0u; lane < groups * group_size; ++lane)
+    {
+        Group const& group = in_block.groups[lane / group_size];
+
+        RkFloat const x = group.x[lane % group_size] - in_position.data[0];
+        RkFloat const y = group.y[lane % group_size] - in_position.data[1];
+        RkFloat const z = group.z[lane % group_size] - in_position.data[2];
+
+        distances[lane] = x * x + y * y + z * z;
+    }
+
+    #endif
+
+    for (RkSize lane = 0u; lane < groups * group_size; ++lane)
+    {
+        if (distances[lane] < inout_distance)
+        {
+            inout_distance = distances[lane];
+            inout_entity   = in_block.entities[lane];
+        }
+    }
+}
+
+RkVoid SpatialIndex::Update(EntityID const in_entity, Vector3f const& in_position) noexcept
+{
+    RkUint64 const key   = GetKey(in_position);
+    RkSize   const index = in_entity.GetIndex();
+
+    if (index >= m_locations.size())
+        m_locations.resize(index + 1u);
+
+    Location& location = m_locations[index];
+
+    // The entity stays in its cell
+    if (location.entity == in_entity && location.key == key)
+    {
+        Group& group = m_shards[GetShard(key)].blocks[location.block].groups[location.lane / group_size];
+
+        group.x[location.lane % group_size] = in_position.data[0];
+        group.y[location.lane % group_size] = in_position.data[1];
+        group.z[location.lane % group_size] = in_position.data[2];
+
+        return;
+    }
+
+    // Either the entity itself, or a destroyed entity of the same index which has not been removed
+    if (location.entity.GetGeneration() != 0u)
+    {
+        Erase(m_shards[GetShard(location.key)], location);
+
+        --m_size;
+    }
+
+    Insert(m_shards[GetShard(key)], in_entity, in_position, key);
+
+    ++m_size;
+}
+
+RkBool SpatialIndex::Remove(EntityID const in_entity) noexcept
+{
+    if (!Contains(in_entity))
+        return false;
+
+    Location& location = m_locations[in_entity.GetIndex()];
+
+    Erase(m_shards[GetShard(location.key)], location);
+
+    --m_size;
+
+    return true;
+}
+
+RkVoid SpatialIndex::Clear() noexcept
+{
+    for (Shard& shard : m_shards)
+    {
+        shard.cells      .clear();
+        shard.blocks     .clear();
+        shard.free_blocks.clear();
+
+        shard.cells_count = 0u;
+    }
+
+    m_locations.clear();
+
+    m_size = 0u;
+}
+
+RkVoid SpatialIndex::BeginUpdate(RkSize const in_batches_count, RkSize const in_entities_count) noexcept
+{
+    m_moves  .resize(in_entities_count);
+    m_batches.assign(in_batches_count, std::make_pair(RkSize(0u), RkSize(0u)));
+}
+
+RkVoid SpatialIndex::UpdateBatch(RkSize          const in_batch,
+                                 RkSize          const in_offset,
+                                 EntityID const* const in_entities,
+                                 Vector3f const* const in_positions,
+                                 RkSize          const in_count) noexcept
+{
+    RkSize moves = 0u;
+
+    for (RkSize index = 0u; index < in_count; ++index)
+    {
+        // Positions are scattered over the blocks, the ones of the next entities are fetched while this one is updated
+        if (index + prefetch_distance < in_count && in_entities[index + prefetch_distance].GetIndex() < m_locations.size())
+        {
+            Location const& ahead = m_locations[in_entities[index + prefetch_distance].GetIndex()];
+
+            if (ahead.entity.GetGeneration() != 0u)
+                Prefetch(m_shards[GetShard(ahead.key)].blocks.data() + ahead.block);
+        }
+
+        EntityID const  entity   = in_entities [index];
+        Vector3f const& position = in_positions[index];
+        RkUint64 const  key      = GetKey(position);
+
+        // Lanes of distinct entities never overlap, entities staying in their cell are thus updated concurrently
+        if (entity.GetIndex() < m_locations.size())
+        {
+            Location const& location = m_locations[entity.GetIndex()];
+
+            if (location.entity == entity && location.key == key)
+            {
+                Group& group = m_shards[GetShard(key)].blocks[location.block].groups[location.lane / group_size];
+
+                group.x[location.lane % group_size] = position.data[0];
+                group.y[location.lane % group_size] = position.data[1];
+                group.z[location.lane % group_size] = position.data[2];
+
+                continue;
+            }
+        }
+
+        m_moves[in_offset + moves++] = Move {entity, position, key};
+    }
+
+    m_batches[in_batch] = std::make_pair(in_offset, moves);
+}
+
+RkVoid SpatialIndex::EndUpdate(Scheduler& in_scheduler) noexcept
+{
+    // Packing the moves of every batch
+    RkSize   moves_count = 0u;
+    RkUint32 max_index   = 0u;
+
+    for (auto const& [offset, count] : m_batches)
+    {
+        if (offset != moves_count)
+            std::copy(m_moves.begin() + offset, m_moves.begin() + offset + count, m_moves.begin() + moves_count);
+
+        moves_count += count;
+    }
+
+    m_moves  .resize(moves_count);
+    m_batches.clear();
+
+    if (moves_count == 0u)
+        return;
+
+    for (Move const& move : m_moves)
+        max_index = std::max(max_index, move.entity.GetIndex());
+
+    if (max_index >= m_locations.size())
+        m_locations.resize(max_index + 1u);
+
+    // Routing every move to the shard it leaves, if any, and to the shard it enters
+    for (Shard& shard : m_shards)
+    {
+        shard.removals  .clear();
+        shard.insertions.clear();
+    }
+
+    for (RkSize index = 0u; index < moves_count; ++index)
+    {
+        Move     const& move     = m_moves[index];
+        Location const& location = m_locations[move.entity.GetIndex()];
+
+        // Either the entity itself, or a destroyed entity of the same index which has not been removed
+        if (location.entity.GetGeneration() != 0u)
+        {
+            m_shards[GetShard(location.key)].removals.push_back(static_cast<RkUint32>(index));
+
+            --m_size;
+        }
+
+        m_shards[GetShard(move.key)].insertions.push_back(static_cast<RkUint32>(index));
+    }
+
+    m_size += moves_count;
+
+    // Every removal is applied before the insertions: the location of an entity is thus only written by a single shard at a time
+    if (moves_count < parallel_moves)
+    {
+        for (Shard& shard : m_shards)
+            ApplyMoves(shard, true);
+
+        for (Shard& shard : m_shards)
+            ApplyMoves(shard, false);
+    }
+    else
+    {
+        in_scheduler.ParallelFor(0u, shards_count, 1u, [this] (RkSize const in_shard) {
+            ApplyMoves(m_shards[in_shard], true);
+        });
+
+        in_scheduler.ParallelFor(0u, shards_count, 1u, [this] (RkSize const in_shard) {
+            ApplyMoves(m_shards[in_shard], false);
+        });
+    }
+}
+
+RkBool SpatialIndex::Contains(EntityID const in_entity) const noexcept
+{
+    return in_entity.GetGeneration() != 0u && in_entity.GetIndex() < m_locations.size() && m_locations[in_entity.GetIndex()].entity == in_entity;
+}
+
+RkVoid SpatialIndex::QueryRadius(Sphere const& in_sphere, std::vector<EntityID>& out_entities) const noexcept
+{
+    if (m_size == 0u || !(in_sphere.radius >= 0.0f))
+        return;
+
+    std::array<RkInt32, 3u> min;
+    std::array<RkInt32, 3u> max;
+
+    for (RkSize axis = 0u; axis < 3u; ++axis)
+    {
+        min[axis] = GetCoordinate((in_sphere.center.data[axis] - in_sphere.radius) * m_inverse_cell_size);
+        max[axis] = GetCoordinate((in_sphere.center.data[axis] + in_sphere.radius) * m_inverse_cell_size);
+    }
+
+    RkSize cells_count = 0u;
+
+    for (Shard const& shard : m_shards)
+        cells_count += shard.cells_count;
+
+    // Large spheres cover more cells than there are cells in the index, these are scanned instead
+    if (GetCellsCount(min, max) > cells_count)
+    {
+        for (Shard const& shard : m_shards)
+        {
+            for (Cell const& cell : shard.cells)
+            {
+                RkSize remaining = cell.key == empty_key ? 0u : cell.count;
+
+                for (RkUint32 block = cell.first_block; remaining != 0u; block = shard.blocks[block].next)
+                {
+                    QueryBlock(shard.blocks[block], remaining, in_sphere, out_entities);
+
+                    remaining -= std::min(remaining, block_size);
+                }
+            }
+        }
+
+        return;
+    }
+
+    RkUint64                             keys [cells_batch];
+    std::pair<Shard const*, Cell const*> cells[cells_batch];
+    RkSize                               count = 0u;
+
+    auto const flush = [&] {
+        RkSize const found = FindCells(keys, count, cells);
+
+        for (RkSize index = 0u; index < found; ++index)
+        {
+            auto const [shard, cell] = cells[index];
+
+            RkSize remaining = cell->count;
+
+            for (RkUint32 block = cell->first_block; remaining != 0u; block = shard->blocks[block].next)
+            {
+                QueryBlock(shard->blocks[block], remaining, in_sphere, out_entities);
+
+                remaining -= std::min(remaining, block_size);
+            }
+        }
+
+        count = 0u;
+    };
+
+    for (RkInt32 z = min[2]; z <= max[2]; ++z)
+    {
+        for (RkInt32 y = min[1]; y <= max[1]; ++y)
+        {
+            for (RkInt32 x = min[0]; x <= max[0]; ++x)
+            {
+                keys[count++] = PackKey(x, y, z);
+
+                if (count == cells_batch)
+                    flush();
+            }
+        }
+    }
+
+    flush();
+}
+
+RkVoid SpatialIndex::QueryRadius(Scheduler& in_scheduler, Sphere const* in_spheres, RkSize const in_count, QueryResults& out_results) const noexcept
+{
+    RkSize const jobs_count = (in_count + query_grain - 1u) / query_grain;
+
+    out_results.offsets.assign(in_count + 1u, 0u);
+
+    if (out_results.jobs.size() < jobs_count)
+        out_results.jobs.resize(jobs_count);
+
+    // Every job runs consecutive queries, the counts of entities found are stored then summed into offsets
+    in_scheduler.ParallelFor(0u, jobs_count, 1u, [&] (RkSize const in_job) {
+        std::vector<EntityID>& entities = out_results.jobs[in_job];
+
+        entities.clear();
+
+        for (RkSize query = in_job * query_grain; query < std::min(in_count, (in_job + 1u) * query_grain); ++query)
+        {
+            RkSize const previous_size = entities.size();
+
+            QueryRadius(in_spheres[query], entities);
+
+            out_results.offsets[query + 1u] = entities.size() - previous_size;
+        }
+    });
+
+    for (RkSize query = 0u; query < in_count; ++query)
+        out_results.offsets[query + 1u] += out_results.offsets[query];
+
+    out_results.entities.resize(out_results.offsets[in_count]);
+
+    for (RkSize job = 0u; job < jobs_count; ++job)
+        std::copy(out_results.jobs[job].begin(), out_results.jobs[job].end(), out_results.entities.begin() + out_results.offsets[job * query_grain]);
+}
+
+EntityID SpatialIndex::FindNearest(Vector3f const& in_position, RkFloat const in_max_distance) const noexcept
+{
+    EntityID nearest  = EntityID();
+    RkFloat  distance = GetSquaredBound(in_max_distance);
+
+    if (m_size == 0u || !(in_max_distance >= 0.0f))
+        return nearest;
+
+    std::array<RkInt32, 3u> center;
+    std::array<RkInt32, 3u> min;
+    std::array<RkInt32, 3u> max;
+    RkInt32                 rings = 0;
+
+    for (RkSize axis = 0u; axis < 3u; ++axis)
+    {
+        center[axis] = GetCoordinate( in_position.data[axis]                    * m_inverse_cell_size);
+        min   [axis] = GetCoordinate((in_position.data[axis] - in_max_distance) * m_inverse_cell_size);
+        max   [axis] = GetCoordinate((in_position.data[axis] + in_max_distance) * m_inverse_cell_size);
+        rings        = std::max({rings, center[axis] - min[axis], max[axis] - center[axis]});
+    }
+
+    RkSize cells_count = 0u;
+
+    for (Shard const& shard : m_shards)
+        cells_count += shard.cells_count;
+
+    // Large distances cover more cells than there are cells in the index, these are scanned instead
+    if (GetCellsCount(min, max) > cells_count)
+    {
+        for (Shard const& shard : m_shards)
+        {
+            for (Cell const& cell : shard.cells)
+            {
+                RkSize remaining = cell.key == empty_key ? 0u : cell.count;
+
+                for (RkUint32 block = cell.first_block; remaining != 0u; block = shard.blocks[block].next)
+                {
+                    FindNearestInBlock(shard.blocks[block], remaining, in_position, distance, nearest);
+
+                    remaining -= std::min(remaining, block_size);
+                }
+            }
+        }
+
+        return nearest;
+    }
+
+    RkUint64                             keys [cells_batch];
+    std::pair<Shard const*, Cell const*> cells[cells_batch];
+    RkSize                               count = 0u;
+
+    auto const flush = [&] {
+        RkSize const found = FindCells(keys, count, cells);
+
+        for (RkSize index = 0u; index < found; ++index)
+        {
+            auto const [shard, cell] = cells[index];
+
+            RkSize remaining = cell->count;
+
+            for (RkUint32 block = cell->first_block; remaining != 0u; block = shard->blocks[block].next)
+            {
+                FindNearestInBlock(shard->blocks[block], remaining, in_position, distance, nearest);
+
+                remaining -= std::min(remaining, block_size);
+            }
+        }
+
+        count = 0u;
+    };
+
+    auto const visit = [&] (RkInt32 const in_x, RkInt32 const in_y, RkInt32 const in_z) {
+        if (in_x < min[0] || in_x > max[0] || in_y < min[1] || in_y > max[1] || in_z < min[2] || in_z > max[2])
+            return;
+
+        keys[count++] = PackKey(in_x, in_y, in_z);
+
+        if (count == cells_batch)
+            flush();
+    };
+
+    // Cells are visited ring by ring around the cell of the position, nearest rings first
+    for (RkInt32 ring = 0; ring <= rings; ++ring)
+    {
+        for (RkInt32 z = -ring; z <= ring; ++z)
+        {
+            for (RkInt32 y = -ring; y <= ring; ++y)
+            {
+                if (std::abs(z) == ring || std::abs(y) == ring)
+                {
+                    for (RkInt32 x = -ring; x <= ring; ++x)
+                        visit(center[0] + x, center[1] + y, center[2] + z);
+                }
+                else
+                {
+                    visit(center[0] - ring, center[1] + y, center[2] + z);
+                    visit(center[0] + ring, center[1] + y, center[2] + z);
+                }
+            }
+        }
+
+        flush();
+
+        // Entities of the next rings are at least this far from the position
+        RkFloat const reach = static_cast<RkFloat>(ring) * m_cell_size;
+
+        if (nearest.GetGeneration() != 0u && distance <= reach * reach)
+            break;
+    }
+
+    return nearest;
+}
+
+RkSize SpatialIndex::GetSize() const noexcept
+{
+    return m_size;
+}
+
+RkFloat SpatialIndex::GetCellSize() const noexcept
+{
+    return m_cell_size;
+}
\ No newline at end of file
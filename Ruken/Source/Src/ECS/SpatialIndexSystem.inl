@@ -0,0 +1,90 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TComponent, RkSize TMember>
+SpatialIndexSystem<TComponent, TMember>::SpatialIndexSystem(RkFloat const in_cell_size) noexcept:
+    ComponentSystemBase(),
+    m_index   {in_cell_size},
+    m_offsets {}
+{
+    SetupQuery        <TComponent const>();
+    SetupChangedFilter<TComponent const>();
+    SetupRemovedEntities();
+}
+
+template <typename TComponent, RkSize TMember>
+SpatialIndex const& SpatialIndexSystem<TComponent, TMember>::GetIndex() const noexcept
+{
+    return m_index;
+}
+
+template <typename TComponent, RkSize TMember>
+RkVoid SpatialIndexSystem<TComponent, TMember>::Update(Scheduler& in_scheduler) noexcept
+{
+    // Removing the entities which left the matching archetypes first, their index might have been recycled by an entity of the changed chunks
+    GatherRemovedEntities();
+
+    for (EntityID const& entity : m_removed_entities)
+    {
+        if (!MatchEntity(entity))
+            m_index.Remove(entity);
+    }
+
+    GatherChunks();
+
+    m_offsets.resize(m_chunks.size() + 1u);
+
+    m_offsets[0] = 0u;
+
+    for (RkSize index = 0u; index < m_chunks.size(); ++index)
+        m_offsets[index + 1u] = m_offsets[index] + m_chunks[index].first->GetChunk(m_chunks[index].second).count;
+
+    m_index.BeginUpdate(m_chunks.size(), m_offsets.back());
+
+    in_scheduler.ParallelFor(0u, m_chunks.size(), 1u, [this] (RkSize const in_begin, RkSize const in_end) {
+        #if defined(RUKEN_ECS_ENABLE_ACCESS_VALIDATION)
+
+        SystemJobContext const  context          {&GetAccess(), EntityCommandBuffer::default_sort_key};
+        SystemJobContext const* previous_context = SystemJobContext::SetCurrent(&context);
+
+        #endif
+
+        for (RkSize index = in_begin; index < in_end; ++index)
+        {
+            auto const [archetype, chunk] = m_chunks[index];
+
+            TComponent const component = archetype->template GetComponent<TComponent>(chunk);
+
+            m_index.UpdateBatch(index, m_offsets[index], archetype->GetEntities(chunk), component.template GetStorage<TMember>(), archetype->GetChunk(chunk).count);
+        }
+
+        #if defined(RUKEN_ECS_ENABLE_ACCESS_VALIDATION)
+
+        SystemJobContext::SetCurrent(previous_context);
+
+        #endif
+    });
+
+    m_index.EndUpdate(in_scheduler);
+}
\ No newline at end of file
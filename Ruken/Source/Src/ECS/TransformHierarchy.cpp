@@ -0,0 +1,483 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <utility>
+#include <algorithm>
+
+#include "Meta/Assert.hpp"
+#include "Threading/Scheduler.hpp"
+
+#include "ECS/TransformHierarchy.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    /**
+     * \brief Checks if an ID refers to an entity, generations of valid IDs are never 0
+     * \param in_entity Entity ID
+     * \return True if the ID is not a default constructed one
+     */
+    RkBool IsValid(EntityID const& in_entity) noexcept
+    {
+        return in_entity.GetGeneration() != 0u;
+    }
+
+    /**
+     * \brief Multiplies two quaternions
+     * \param in_lhs Left quaternion, applied last
+     * \param in_rhs Right quaternion, applied first
+     * \return Product
+     */
+    Vector4f Multiply(Vector4f const& in_lhs, Vector4f const& in_rhs) noexcept
+    {
+        RkFloat const* a = in_lhs.data;
+        RkFloat const* b = in_rhs.data;
+
+        Vector4f product;
+
+        product.data[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+        product.data[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+        product.data[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+        product.data[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+
+        return product;
+    }
+
+    /**
+     * \brief Applies a parent transform to a local transform
+     * \param in_parent_position World position of the parent
+     * \param in_parent_rotation World rotation of the parent
+     * \param in_parent_scale World scale of the parent
+     * \param in_local_position Local position of the child
+     * \param in_local_rotation Local rotation of the child
+     * \param in_local_scale Local scale of the child
+     * \param out_position World position of the child
+     * \param out_rotation World rotation of the child
+     * \param out_scale World scale of the child
+     */
+    RkVoid Combine(Vector3f const& in_parent_position, Vector4f const& in_parent_rotation, Vector3f const& in_parent_scale,
+                   Vector3f const& in_local_position,  Vector4f const& in_local_rotation,  Vector3f const& in_local_scale,
+                   Vector3f&       out_position,       Vector4f&       out_rotation,       Vector3f&       out_scale) noexcept
+    {
+        RkFloat const* q = in_parent_rotation.data;
+
+        // Scaled local position, rotated by the parent: v + 2w (u x v) + 2u x (u x v)
+        RkFloat const v[3] = {
+            in_local_position.data[0] * in_parent_scale.data[0],
+            in_local_position.data[1] * in_parent_scale.data[1],
+            in_local_position.data[2] * in_parent_scale.data[2]
+        };
+
+        RkFloat const t[3] = {
+            2.0f * (q[1] * v[2] - q[2] * v[1]),
+            2.0f * (q[2] * v[0] - q[0] * v[2]),
+            2.0f * (q[0] * v[1] - q[1] * v[0])
+        };
+
+        out_position.data[0] = in_parent_position.data[0] + v[0] + q[3] * t[0] + (q[1] * t[2] - q[2] * t[1]);
+        out_position.data[1] = in_parent_position.data[1] + v[1] + q[3] * t[1] + (q[2] * t[0] - q[0] * t[2]);
+        out_position.data[2] = in_parent_position.data[2] + v[2] + q[3] * t[2] + (q[0] * t[1] - q[1] * t[0]);
+
+        out_rotation = Multiply(in_parent_rotation, in_local_rotation);
+
+        out_scale.data[0] = in_parent_scale.data[0] * in_local_scale.data[0];
+        out_scale.data[1] = in_parent_scale.data[1] * in_local_scale.data[1];
+        out_scale.data[2] = in_parent_scale.data[2] * in_local_scale.data[2];
+    }
+
+    /**
+     * \brief Gathers the values of a column in a new order
+     * \param out_sorted Sorted column
+     * \param in_column Column to sort
+     * \param in_order Previous index of every value of the sorted column
+     */
+    template <typename TColumn>
+    RkVoid GatherColumn(TColumn& out_sorted, TColumn const& in_column, std::vector<RkUint32> const& in_order) noexcept
+    {
+        out_sorted.resize(in_order.size());
+
+        for (RkSize index = 0u; index < in_order.size(); ++index)
+            out_sorted[index] = in_column[in_order[index]];
+    }
+
+    template <typename TContainer, RkSize... TColumns>
+    RkVoid Gather(TContainer& out_sorted, TContainer const& in_nodes, std::vector<RkUint32> const& in_order, std::index_sequence<TColumns...>) noexcept
+    {
+        (GatherColumn(std::get<TColumns>(out_sorted), std::get<TColumns>(in_nodes), in_order), ...);
+    }
+}
+
+TransformHierarchy::Transform TransformHierarchy::Transform::Identity() noexcept
+{
+    Transform identity;
+
+    for (RkSize index = 0u; index < 3u; ++index)
+    {
+        identity.position.data[index] = 0.0f;
+        identity.rotation.data[index] = 0.0f;
+        identity.scale   .data[index] = 1.0f;
+    }
+
+    identity.rotation.data[3] = 1.0f;
+
+    return identity;
+}
+
+TransformHierarchy::TransformHierarchy() noexcept:
+    m_nodes             {},
+    m_nodes_of_entities {},
+    m_levels            {},
+    m_removed_count     {0u},
+    m_dirty_count       {0u},
+    m_sorted            {true},
+    m_sorted_nodes      {},
+    m_order             {},
+    m_children          {},
+    m_children_offsets  {},
+    m_sorted_indices    {}
+{}
+
+TransformHierarchy::NodeIndex TransformHierarchy::GetNode(EntityID const in_entity) const noexcept
+{
+    RUKEN_ASSERT_MESSAGE(Contains(in_entity), "This entity is not part of the hierarchy");
+
+    return m_nodes_of_entities[in_entity.GetIndex()];
+}
+
+RkVoid TransformHierarchy::MarkDirty(NodeIndex const in_node) noexcept
+{
+    RkUint8& dirty = std::get<dirty_column>(m_nodes)[in_node];
+
+    if (dirty == 0u)
+    {
+        dirty = 1u;
+        ++m_dirty_count;
+    }
+}
+
+RkVoid TransformHierarchy::Sort() noexcept
+{
+    auto const& entities = std::get<entity_column>(m_nodes);
+    auto const& parents  = std::get<parent_column>(m_nodes);
+
+    RkSize const nodes_count = entities.size();
+
+    // A node whose parent has been removed becomes a root
+    auto const is_root = [&] (RkSize const in_node) {
+        return parents[in_node] == invalid_node || !IsValid(entities[parents[in_node]]);
+    };
+
+    // Children of every node, grouped by parent in node order
+    std::vector<NodeIndex>& children_offsets = m_children_offsets;
+
+    children_offsets.assign(nodes_count + 1u, 0u);
+
+    for (RkSize node = 0u; node < nodes_count; ++node)
+    {
+        if (IsValid(entities[node]) && !is_root(node))
+            ++children_offsets[parents[node] + 1u];
+    }
+
+    for (RkSize node = 0u; node < nodes_count; ++node)
+        children_offsets[node + 1u] += children_offsets[node];
+
+    std::vector<NodeIndex>& children = m_children;
+
+    children.resize(children_offsets[nodes_count]);
+
+    // Offsets are used as cursors, then shifted back
+    for (RkSize node = 0u; node < nodes_count; ++node)
+    {
+        if (IsValid(entities[node]) && !is_root(node))
+            children[children_offsets[parents[node]]++] = static_cast<NodeIndex>(node);
+    }
+
+    for (RkSize node = nodes_count; node > 0u; --node)
+        children_offsets[node] = children_offsets[node - 1u];
+
+    children_offsets[0] = 0u;
+
+    // Breadth first order, level after level
+    std::vector<NodeIndex>& order = m_order;
+
+    order.clear();
+    order.reserve(nodes_count - m_removed_count);
+
+    for (RkSize node = 0u; node < nodes_count; ++node)
+    {
+        if (IsValid(entities[node]) && is_root(node))
+            order.push_back(static_cast<NodeIndex>(node));
+    }
+
+    m_levels.clear();
+    m_levels.push_back(0u);
+
+    for (RkSize level_begin = 0u; level_begin < order.size();)
+    {
+        RkSize const level_end = order.size();
+
+        m_levels.push_back(level_end);
+
+        for (RkSize index = level_begin; index < level_end; ++index)
+        {
+            NodeIndex const node = order[index];
+
+            order.insert(order.end(), children.begin() + children_offsets[node], children.begin() + children_offsets[node + 1u]);
+        }
+
+        level_begin = level_end;
+    }
+
+    RUKEN_ASSERT_MESSAGE(order.size() == nodes_count - m_removed_count, "Cycle detected in the transform hierarchy");
+
+    std::vector<NodeIndex>& sorted_indices = m_sorted_indices;
+
+    sorted_indices.assign(nodes_count, invalid_node);
+
+    for (RkSize index = 0u; index < order.size(); ++index)
+        sorted_indices[order[index]] = static_cast<NodeIndex>(index);
+
+    Layout::ContainerType& sorted = m_sorted_nodes;
+
+    Gather(sorted, m_nodes, order, std::make_index_sequence<NodeItem::fields_count>());
+
+    auto& sorted_parents = std::get<parent_column>(sorted);
+    auto& sorted_dirty   = std::get<dirty_column> (sorted);
+
+    m_dirty_count = 0u;
+
+    for (RkSize index = 0u; index < order.size(); ++index)
+    {
+        if (is_root(order[index]))
+        {
+            // Orphans keep their local transform, their world transform thus changes
+            if (sorted_parents[index] != invalid_node)
+                sorted_dirty[index] = 1u;
+
+            sorted_parents[index] = invalid_node;
+        }
+        else
+            sorted_parents[index] = sorted_indices[sorted_parents[index]];
+
+        m_dirty_count += sorted_dirty[index];
+    }
+
+    std::swap(m_nodes, sorted);
+
+    auto const& sorted_entities = std::get<entity_column>(m_nodes);
+
+    for (RkSize index = 0u; index < sorted_entities.size(); ++index)
+        m_nodes_of_entities[sorted_entities[index].GetIndex()] = static_cast<NodeIndex>(index);
+
+    m_removed_count = 0u;
+    m_sorted        = true;
+}
+
+RkVoid TransformHierarchy::PropagateRange(RkSize const in_begin, RkSize const in_end) noexcept
+{
+    NodeIndex const* parents         = std::get<parent_column>        (m_nodes).data();
+    Vector3f  const* local_positions = std::get<local_position_column>(m_nodes).data();
+    Vector4f  const* local_rotations = std::get<local_rotation_column>(m_nodes).data();
+    Vector3f  const* local_scales    = std::get<local_scale_column>   (m_nodes).data();
+    Vector3f*        world_positions = std::get<world_position_column>(m_nodes).data();
+    Vector4f*        world_rotations = std::get<world_rotation_column>(m_nodes).data();
+    Vector3f*        world_scales    = std::get<world_scale_column>   (m_nodes).data();
+    RkUint8*         dirty           = std::get<dirty_column>         (m_nodes).data();
+
+    for (RkSize node = in_begin; node < in_end; ++node)
+    {
+        NodeIndex const parent = parents[node];
+
+        if (parent == invalid_node)
+        {
+            if (dirty[node] == 0u)
+                continue;
+
+            world_positions[node] = local_positions[node];
+            world_rotations[node] = local_rotations[node];
+            world_scales   [node] = local_scales   [node];
+
+            continue;
+        }
+
+        // Parents belong to the previous level, which is done already
+        if ((dirty[node] | dirty[parent]) == 0u)
+            continue;
+
+        Combine(world_positions[parent], world_rotations[parent], world_scales[parent],
+                local_positions[node],   local_rotations[node],   local_scales[node],
+                world_positions[node],   world_rotations[node],   world_scales[node]);
+
+        // Flags the whole subtree
+        dirty[node] = 1u;
+    }
+}
+
+RkVoid TransformHierarchy::Add(EntityID const in_entity, Transform const& in_local, EntityID const in_parent) noexcept
+{
+    RUKEN_ASSERT_MESSAGE(IsValid(in_entity) && !Contains(in_entity), "This entity is already part of the hierarchy");
+
+    NodeIndex const parent = IsValid(in_parent) ? GetNode(in_parent) : invalid_node;
+    NodeIndex const node   = static_cast<NodeIndex>(Layout::Size(m_nodes));
+
+    if (in_entity.GetIndex() >= m_nodes_of_entities.size())
+        m_nodes_of_entities.resize(in_entity.GetIndex() + 1u, invalid_node);
+
+    m_nodes_of_entities[in_entity.GetIndex()] = node;
+
+    std::get<entity_column>        (m_nodes).emplace_back(in_entity);
+    std::get<parent_column>        (m_nodes).push_back(parent);
+    std::get<local_position_column>(m_nodes).push_back(in_local.position);
+    std::get<local_rotation_column>(m_nodes).push_back(in_local.rotation);
+    std::get<local_scale_column>   (m_nodes).push_back(in_local.scale);
+    std::get<world_position_column>(m_nodes).push_back(in_local.position);
+    std::get<world_rotation_column>(m_nodes).push_back(in_local.rotation);
+    std::get<world_scale_column>   (m_nodes).push_back(in_local.scale);
+    std::get<dirty_column>         (m_nodes).push_back(0u);
+
+    MarkDirty(node);
+
+    m_sorted = false;
+}
+
+RkVoid TransformHierarchy::Remove(EntityID const in_entity) noexcept
+{
+    NodeIndex const node = GetNode(in_entity);
+
+    // The node is dropped by the next sort, which also turns its children into roots
+    std::get<entity_column>(m_nodes)[node] = EntityID();
+    m_nodes_of_entities[in_entity.GetIndex()] = invalid_node;
+
+    m_dirty_count -= std::get<dirty_column>(m_nodes)[node];
+    std::get<dirty_column>(m_nodes)[node] = 0u;
+
+    ++m_removed_count;
+    m_sorted = false;
+}
+
+RkVoid TransformHierarchy::SetParent(EntityID const in_entity, EntityID const in_parent) noexcept
+{
+    auto const& entities = std::get<entity_column>(m_nodes);
+    auto&       parents  = std::get<parent_column>(m_nodes);
+
+    NodeIndex const node   = GetNode(in_entity);
+    NodeIndex const parent = IsValid(in_parent) ? GetNode(in_parent) : invalid_node;
+
+    for (NodeIndex ancestor = parent; ancestor != invalid_node && IsValid(entities[ancestor]); ancestor = parents[ancestor])
+        RUKEN_ASSERT_MESSAGE(ancestor != node, "An entity cannot be parented to one of its descendants");
+
+    parents[node] = parent;
+
+    MarkDirty(node);
+
+    m_sorted = false;
+}
+
+RkBool TransformHierarchy::Contains(EntityID const in_entity) const noexcept
+{
+    if (in_entity.GetIndex() >= m_nodes_of_entities.size())
+        return false;
+
+    NodeIndex const node = m_nodes_of_entities[in_entity.GetIndex()];
+
+    return node != invalid_node && std::get<entity_column>(m_nodes)[node] == in_entity;
+}
+
+EntityID TransformHierarchy::GetParent(EntityID const in_entity) const noexcept
+{
+    NodeIndex const parent = std::get<parent_column>(m_nodes)[GetNode(in_entity)];
+
+    // Removed parents are default constructed IDs already
+    return parent == invalid_node ? EntityID() : EntityID(std::get<entity_column>(m_nodes)[parent]);
+}
+
+RkVoid TransformHierarchy::SetLocalTransform(EntityID const in_entity, Transform const& in_local) noexcept
+{
+    NodeIndex const node = GetNode(in_entity);
+
+    std::get<local_position_column>(m_nodes)[node] = in_local.position;
+    std::get<local_rotation_column>(m_nodes)[node] = in_local.rotation;
+    std::get<local_scale_column>   (m_nodes)[node] = in_local.scale;
+
+    MarkDirty(node);
+}
+
+TransformHierarchy::Transform TransformHierarchy::GetLocalTransform(EntityID const in_entity) const noexcept
+{
+    NodeIndex const node = GetNode(in_entity);
+
+    return Transform {
+        std::get<local_position_column>(m_nodes)[node],
+        std::get<local_rotation_column>(m_nodes)[node],
+        std::get<local_scale_column>   (m_nodes)[node]
+    };
+}
+
+TransformHierarchy::Transform TransformHierarchy::GetWorldTransform(EntityID const in_entity) const noexcept
+{
+    NodeIndex const node = GetNode(in_entity);
+
+    return Transform {
+        std::get<world_position_column>(m_nodes)[node],
+        std::get<world_rotation_column>(m_nodes)[node],
+        std::get<world_scale_column>   (m_nodes)[node]
+    };
+}
+
+RkVoid TransformHierarchy::Propagate(Scheduler& in_scheduler) noexcept
+{
+    if (!m_sorted)
+        Sort();
+
+    if (m_dirty_count == 0u)
+        return;
+
+    for (RkSize level = 0u; level + 1u < m_levels.size(); ++level)
+    {
+        RkSize const begin = m_levels[level];
+        RkSize const end   = m_levels[level + 1u];
+
+        if (end - begin <= propagation_grain)
+            PropagateRange(begin, end);
+        else
+            in_scheduler.ParallelFor(begin, end, propagation_grain, [this] (RkSize const in_begin, RkSize const in_end) {
+                PropagateRange(in_begin, in_end);
+            });
+    }
+
+    std::fill(std::get<dirty_column>(m_nodes).begin(), std::get<dirty_column>(m_nodes).end(), RkUint8(0u));
+
+    m_dirty_count = 0u;
+}
+
+RkSize TransformHierarchy::GetSize() const noexcept
+{
+    return Layout::Size(m_nodes) - m_removed_count;
+}
+
+RkSize TransformHierarchy::GetLevelsCount() const noexcept
+{
+    return m_levels.empty() ? 0u : m_levels.size() - 1u;
+}
\ No newline at end of file
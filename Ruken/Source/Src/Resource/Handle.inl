@@ -108,20 +108,44 @@ ResourceManifest::ReferenceCountType Handle<TResource_Type>::ReferenceCount() co
 }
 
 template <typename TResource_Type>
-RkBool Handle<TResource_Type>::WaitForValidity(RkFloat in_timeout) const noexcept
+RkBool Handle<TResource_Type>::WaitForValidity(RkFloat const in_timeout) const noexcept
 {
     // No manifest, cannot wait for anything (this avoid infinite loops in case of a problem)
     if (!m_manifest)
         return false;
 
-    TODO("Jul 23 2019", "Implement the handle timeout");
+    std::chrono::steady_clock::time_point const deadline = in_timeout < 0.0f ?
+        std::chrono::steady_clock::time_point::max() :
+        std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<RkFloat>(in_timeout));
+
+    // Called from a job, suspending it instead of blocking its worker
+    if (Scheduler* scheduler = Scheduler::GetCurrentScheduler())
+    {
+        scheduler->WaitUntil([this, deadline] {
+            return Available() ||
+                   m_manifest->status.load(std::memory_order_acquire) == EResourceStatus::Invalid ||
+                   std::chrono::steady_clock::now() >= deadline;
+        });
+
+        return Available();
+    }
+
+    IdlePolicy const idle_policy;
+    RkUint32         idle_iteration = 0u;
+
     while (!Available())
     {
+        EResourceStatus const status = m_manifest->status.load(std::memory_order_acquire);
+
         // If something wrong happened, then stopping the wait here and notifying the user
-        if (m_manifest->status.load(std::memory_order_acquire) == EResourceStatus::Invalid)
+        if (status == EResourceStatus::Invalid)
             return false;
 
-        std::this_thread::yield();
+        if (idle_policy.Idle(idle_iteration))
+            continue;
+
+        if (!m_manifest->WaitForStatusChange(status, deadline))
+            return Available();
     }
 
     return true;
@@ -33,14 +33,14 @@ USING_RUKEN_NAMESPACE
 
 RkVoid ResourceManager::LoadingRoutine(ResourceManifest* in_manifest, ResourceLoadingDescriptor const& in_descriptor)
 {
-    in_manifest->status.store(EResourceStatus::Processed, std::memory_order_release);
+    in_manifest->SetStatus(EResourceStatus::Processed);
 
     ++m_current_operation_count;
     
     try
     {
         in_manifest->data.load(std::memory_order_acquire)->Load(*this, in_descriptor);
-        in_manifest->status.store(EResourceStatus::Loaded, std::memory_order_release);
+        in_manifest->SetStatus(EResourceStatus::Loaded);
 
         --m_current_operation_count;
 
@@ -50,7 +50,7 @@ RkVoid ResourceManager::LoadingRoutine(ResourceManifest* in_manifest, ResourceLo
     // Something happened
     catch (ResourceProcessingFailure const& failure)
     {
-        in_manifest->status.store(failure.resource_validity ? EResourceStatus::Loaded : EResourceStatus::Invalid, std::memory_order_release);
+        in_manifest->SetStatus(failure.resource_validity ? EResourceStatus::Loaded : EResourceStatus::Invalid);
 
         std::cout << static_cast<std::string>(in_manifest->GetIdentifier()) << " failed to load. What: " << static_cast<std::string>(failure) << std::endl;
 
@@ -73,14 +73,14 @@ RkVoid ResourceManager::ReloadingRoutine(ResourceManifest* in_manifest)
     if (!in_manifest || in_manifest->status.load(std::memory_order_acquire) != EResourceStatus::Loaded)
         return;
 
-    in_manifest->status.store(EResourceStatus::Processed, std::memory_order_release);
+    in_manifest->SetStatus(EResourceStatus::Processed);
 
     ++m_current_operation_count;
 
     try
     {
         in_manifest->data.load(std::memory_order_acquire)->Reload(*this);
-        in_manifest->status.store(EResourceStatus::Loaded, std::memory_order_release);
+        in_manifest->SetStatus(EResourceStatus::Loaded);
 
         --m_current_operation_count;
         
@@ -90,7 +90,7 @@ RkVoid ResourceManager::ReloadingRoutine(ResourceManifest* in_manifest)
     // Something happened
     catch (ResourceProcessingFailure const& failure)
     {
-        in_manifest->status.store(failure.resource_validity ? EResourceStatus::Loaded : EResourceStatus::Invalid, std::memory_order_release);
+        in_manifest->SetStatus(failure.resource_validity ? EResourceStatus::Loaded : EResourceStatus::Invalid);
 
         std::cout << static_cast<std::string>(in_manifest->GetIdentifier()) << " failed to load. What: " << static_cast<std::string>(failure) << std::endl;
         --m_current_operation_count;
@@ -117,7 +117,7 @@ RkVoid ResourceManager::UnloadingRoutine(ResourceManifest* in_manifest)
     if (in_manifest->status.load(std::memory_order_acquire) == EResourceStatus::Loaded)
     {
         in_manifest->data.load(std::memory_order_acquire)->Unload(*this);
-        in_manifest->status.store(EResourceStatus::Invalid, std::memory_order_release);
+        in_manifest->SetStatus(EResourceStatus::Invalid);
     }
 
     --m_current_operation_count;
@@ -166,7 +166,7 @@ RkVoid ResourceManager::Cleanup() noexcept
             InvalidateResource(manifest);
 
             delete manifest;
-        });
+        }, EJobPriority::Background);
     }
 
     access->clear();
@@ -220,9 +220,9 @@ RkBool ResourceManager::UnloadResource(ResourceIdentifier const& in_identifier,
         UnloadingRoutine(manifest);
     else
     {
-        m_scheduler_reference.ScheduleTask([&manifest, this] {
+        m_scheduler_reference.ScheduleTask([manifest, this] {
             UnloadingRoutine(manifest);
-        });
+        }, EJobPriority::Background);
     }
 
     return true;
@@ -46,7 +46,7 @@ RkVoid ResourceManager::GarbageCollection(TUnary_Predicate in_predicate, RkBool
 
                 if (in_clear_invalid_resources && manifest->status.load(std::memory_order_acquire) == EResourceStatus::Invalid)
                     delete manifest;
-            });
+            }, EJobPriority::Background);
         }
 
         // If clearing invalid resources has been requested and the resource is invalid:
@@ -73,14 +73,15 @@ RkVoid ResourceManager::LoadResource(ResourceManifest* in_manifest, ResourceLoad
         if (in_manifest->status.load(std::memory_order_acquire) != EResourceStatus::Invalid)
             return;
 
-        in_manifest->status.store(EResourceStatus::Pending, std::memory_order_release);
+        in_manifest->SetStatus(EResourceStatus::Pending);
         in_manifest->data  .store(new TResource_Type()    , std::memory_order_release);
     }
 
     if (in_loading_mode == ESynchronizationMode::Synchronous)
         return LoadingRoutine(in_manifest, in_descriptor);
 
-    m_scheduler_reference.ScheduleTask([in_manifest, &in_descriptor, this] {
+    // Loading routines block on the file system, keeping them away from the compute workers
+    m_scheduler_reference.ScheduleIOTask([in_manifest, &in_descriptor, this] {
         LoadingRoutine(in_manifest, in_descriptor);
     });
 }
@@ -108,8 +109,8 @@ Handle<TResource_Type> ResourceManager::ReloadResource(Handle<TResource_Type> co
         ReloadingRoutine(in_handle.m_manifest);
     else
     {
-        m_scheduler_reference.ScheduleTask([&in_handle, this] {
-            ReloadingRoutine(in_handle.m_manifest);
+        m_scheduler_reference.ScheduleIOTask([manifest = in_handle.m_manifest, this] {
+            ReloadingRoutine(manifest);
         });
     }
 
@@ -131,7 +132,7 @@ Handle<TResource_Type> ResourceManager::ReferenceResource(ResourceIdentifier con
 
     manifest->gc_strategy    = in_strategy;
     manifest->data            = in_resource;
-    manifest->status.store(EResourceStatus::Loaded, std::memory_order_release);
+    manifest->SetStatus(EResourceStatus::Loaded);
 
     return Handle<TResource_Type>(manifest);
 }
@@ -149,7 +150,7 @@ Handle<TResource_Type> ResourceManager::ReloadResource(ResourceIdentifier const&
         ReloadingRoutine(manifest);
     else
     {
-        m_scheduler_reference.ScheduleTask([&manifest, this] {
+        m_scheduler_reference.ScheduleIOTask([manifest, this] {
             ReloadingRoutine(manifest);
         });
     }
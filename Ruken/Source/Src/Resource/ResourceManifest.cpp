@@ -26,6 +26,8 @@
 
 USING_RUKEN_NAMESPACE
 
+EventCount ResourceManifest::m_status_event;
+
 ResourceManifest::ResourceManifest() noexcept:
 #ifdef RUKEN_RESOURCE_MANIFEST_STORE_IDENTIFIER
     m_identifier    {""},
@@ -60,4 +62,24 @@ ResourceIdentifier ResourceManifest::GetIdentifier() const noexcept
     return ResourceIdentifier("");
 }
 
-#endif
\ No newline at end of file
+#endif
+
+RkVoid ResourceManifest::SetStatus(EResourceStatus const in_status) noexcept
+{
+    status.store(in_status, std::memory_order_release);
+
+    m_status_event.NotifyAll();
+}
+
+RkBool ResourceManifest::WaitForStatusChange(EResourceStatus const in_status, std::chrono::steady_clock::time_point const in_deadline) const noexcept
+{
+    RkUint32 const key = m_status_event.PrepareWait();
+
+    if (status.load(std::memory_order_acquire) != in_status)
+    {
+        m_status_event.CancelWait();
+        return true;
+    }
+
+    return m_status_event.WaitUntil(key, in_deadline);
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TType>
+RkSize BoundedQueue<TType>::RoundCapacity(RkSize const in_capacity) noexcept
+{
+    RkSize capacity = 2u;
+
+    while (capacity < in_capacity)
+        capacity <<= 1u;
+
+    return capacity;
+}
+
+template <typename TType>
+BoundedQueue<TType>::BoundedQueue(RkSize const in_capacity):
+    m_slots            {std::make_unique<Slot[]>(RoundCapacity(in_capacity))},
+    m_mask             {RoundCapacity(in_capacity) - 1u},
+    m_enqueue_position {0u},
+    m_dequeue_position {0u}
+{
+    // Every slot starts ready to be written at its own position
+    for (RkSize index = 0; index <= m_mask; ++index)
+        m_slots[index].sequence.store(index, std::memory_order_relaxed);
+}
+
+template <typename TType>
+BoundedQueue<TType>::~BoundedQueue() noexcept
+{
+    RkSize const end = m_enqueue_position.load(std::memory_order_relaxed);
+
+    // Destroying the items that haven't been dequeued
+    for (RkSize position = m_dequeue_position.load(std::memory_order_relaxed); position != end; ++position)
+        std::launder(reinterpret_cast<TType*>(m_slots[position & m_mask].storage))->~TType();
+}
+
+template <typename TType>
+RkBool BoundedQueue<TType>::TryEnqueue(TType&& in_item) noexcept
+{
+    RkSize position = m_enqueue_position.load(std::memory_order_relaxed);
+    Slot*  slot     = nullptr;
+
+    for (;;)
+    {
+        slot = &m_slots[position & m_mask];
+
+        RkSize  const sequence   = slot->sequence.load(std::memory_order_acquire);
+        RkInt64 const difference = static_cast<RkInt64>(sequence) - static_cast<RkInt64>(position);
+
+        // The slot is free, trying to claim it
+        if (difference == 0)
+        {
+            if (m_enqueue_position.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                break;
+        }
+
+        // The slot still holds the item of the previous lap, the queue is full
+        else if (difference < 0)
+            return false;
+
+        // Another producer claimed the slot, catching up
+        else
+            position = m_enqueue_position.load(std::memory_order_relaxed);
+    }
+
+    new (slot->storage) TType(std::move(in_item));
+
+    slot->sequence.store(position + 1u, std::memory_order_release);
+
+    return true;
+}
+
+template <typename TType>
+RkBool BoundedQueue<TType>::TryDequeue(TType& out_item) noexcept
+{
+    RkSize position = m_dequeue_position.load(std::memory_order_relaxed);
+    Slot*  slot     = nullptr;
+
+    for (;;)
+    {
+        slot = &m_slots[position & m_mask];
+
+        RkSize  const sequence   = slot->sequence.load(std::memory_order_acquire);
+        RkInt64 const difference = static_cast<RkInt64>(sequence) - static_cast<RkInt64>(position + 1u);
+
+        // The slot has been written, trying to claim it
+        if (difference == 0)
+        {
+            if (m_dequeue_position.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                break;
+        }
+
+        // The slot hasn't been written yet, the queue is empty
+        else if (difference < 0)
+            return false;
+
+        // Another consumer claimed the slot, catching up
+        else
+            position = m_dequeue_position.load(std::memory_order_relaxed);
+    }
+
+    TType* item = std::launder(reinterpret_cast<TType*>(slot->storage));
+
+    out_item = std::move(*item);
+    item->~TType();
+
+    // Making the slot available for the next lap of the producers
+    slot->sequence.store(position + m_mask + 1u, std::memory_order_release);
+
+    return true;
+}
+
+template <typename TType>
+RkBool BoundedQueue<TType>::Empty() const noexcept
+{
+    RkSize const position = m_dequeue_position.load(std::memory_order_relaxed);
+
+    return m_slots[position & m_mask].sequence.load(std::memory_order_acquire) != position + 1u;
+}
+
+template <typename TType>
+RkSize BoundedQueue<TType>::Capacity() const noexcept
+{
+    return m_mask + 1u;
+}
\ No newline at end of file
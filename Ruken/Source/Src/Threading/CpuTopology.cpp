@@ -0,0 +1,368 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <map>
+#include <string>
+#include <thread>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+
+#include "Build/OperatingSystem.hpp"
+#include "Threading/CpuTopology.hpp"
+
+#if defined(RUKEN_OS_WINDOWS)
+    #include "Utility/WindowsOS.hpp"
+#elif defined(RUKEN_OS_LINUX)
+    #include <sched.h>
+#endif
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    #if defined(RUKEN_OS_LINUX)
+
+    /**
+     * \brief Reads the first line of a sysfs file
+     * \param in_path Path of the file
+     * \param out_content First line of the file
+     * \return True if the file could be read
+     */
+    RkBool ReadSysfsFile(std::string const& in_path, std::string& out_content) noexcept
+    {
+        std::ifstream file(in_path);
+
+        return file.is_open() && static_cast<RkBool>(std::getline(file, out_content));
+    }
+
+    /**
+     * \brief Parses a sysfs list, such as "0-3,8,10-11"
+     * \param in_list List to parse
+     * \return Parsed indices
+     */
+    std::vector<RkUint32> ParseSysfsList(std::string const& in_list) noexcept
+    {
+        std::vector<RkUint32> indices;
+        RkSize                position = 0u;
+
+        while (position < in_list.size())
+        {
+            RkSize      const separator = std::min(in_list.find(',', position), in_list.size());
+            std::string const range     = in_list.substr(position, separator - position);
+            RkSize      const dash      = range.find('-');
+
+            if (!range.empty())
+            {
+                RkUint32 const first = static_cast<RkUint32>(std::stoul(range.substr(0u, dash)));
+                RkUint32 const last  = dash == std::string::npos ? first : static_cast<RkUint32>(std::stoul(range.substr(dash + 1u)));
+
+                for (RkUint32 index = first; index <= last; ++index)
+                    indices.push_back(index);
+            }
+
+            position = separator + 1u;
+        }
+
+        return indices;
+    }
+
+    #endif
+
+    /**
+     * \brief Returns the logical processors the process is allowed to run on
+     * \param out_processors Allowed processors, sorted
+     * \return True if the affinity of the process could be read
+     */
+    RkBool GetProcessAffinity(std::vector<RkUint32>& out_processors) noexcept
+    {
+        #if defined(RUKEN_OS_WINDOWS)
+
+        DWORD_PTR process_mask;
+        DWORD_PTR system_mask;
+
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+            return false;
+
+        for (RkUint32 processor = 0u; processor < sizeof(DWORD_PTR) * 8u; ++processor)
+        {
+            if (process_mask & (static_cast<DWORD_PTR>(1u) << processor))
+                out_processors.push_back(processor);
+        }
+
+        return true;
+
+        #elif defined(RUKEN_OS_LINUX)
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &set) != 0)
+            return false;
+
+        for (RkUint32 processor = 0u; processor < CPU_SETSIZE; ++processor)
+        {
+            if (CPU_ISSET(processor, &set))
+                out_processors.push_back(processor);
+        }
+
+        return true;
+
+        #else
+
+        (RkVoid)out_processors;
+
+        return false;
+
+        #endif
+    }
+}
+
+CpuTopology::CpuTopology() noexcept:
+    m_cores            {},
+    m_processor_nodes  {},
+    m_numa_nodes_count {1u}
+{
+    if (!Detect() || m_cores.empty())
+    {
+        // Fallback, every logical processor is considered as a physical core
+        RkUint32 const processors_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+        m_cores           .clear();
+        m_processor_nodes .assign(processors_count, 0u);
+        m_numa_nodes_count = 1u;
+
+        for (RkUint32 processor = 0u; processor < processors_count; ++processor)
+            m_cores.push_back(PhysicalCore {{processor}, 0u});
+    }
+
+    RestrictToProcessAffinity();
+}
+
+RkVoid CpuTopology::RestrictToProcessAffinity() noexcept
+{
+    std::vector<RkUint32> allowed_processors;
+
+    if (!GetProcessAffinity(allowed_processors))
+        return;
+
+    std::vector<PhysicalCore> cores;
+
+    for (PhysicalCore core : m_cores)
+    {
+        core.processors.erase(std::remove_if(core.processors.begin(), core.processors.end(), [&allowed_processors](RkUint32 const in_processor) {
+            return !std::binary_search(allowed_processors.begin(), allowed_processors.end(), in_processor);
+        }), core.processors.end());
+
+        if (!core.processors.empty())
+            cores.push_back(std::move(core));
+    }
+
+    // Keeping the whole machine if the mask doesn't match any detected processor, rather than reporting no processor at all
+    if (!cores.empty())
+        m_cores = std::move(cores);
+}
+
+RkBool CpuTopology::Detect() noexcept
+{
+    #if defined(RUKEN_OS_LINUX)
+
+    std::string content;
+
+    if (!ReadSysfsFile("/sys/devices/system/cpu/online", content))
+        return false;
+
+    try
+    {
+        std::vector<RkUint32> const processors = ParseSysfsList(content);
+
+        if (processors.empty())
+            return false;
+
+        m_processor_nodes.assign(processors.back() + 1u, 0u);
+
+        // NUMA nodes, ids are remapped to be contiguous
+        if (ReadSysfsFile("/sys/devices/system/node/online", content))
+        {
+            std::vector<RkUint32> const nodes = ParseSysfsList(content);
+
+            for (RkUint32 node_index = 0u; node_index < nodes.size(); ++node_index)
+            {
+                if (!ReadSysfsFile("/sys/devices/system/node/node" + std::to_string(nodes[node_index]) + "/cpulist", content))
+                    continue;
+
+                for (RkUint32 const processor : ParseSysfsList(content))
+                {
+                    if (processor < m_processor_nodes.size())
+                        m_processor_nodes[processor] = node_index;
+                }
+            }
+
+            m_numa_nodes_count = std::max(static_cast<RkUint32>(nodes.size()), 1u);
+        }
+
+        // Physical cores, identified by their package and core ids
+        std::map<std::pair<RkUint32, RkUint32>, RkSize> cores;
+
+        for (RkUint32 const processor : processors)
+        {
+            std::string const topology = "/sys/devices/system/cpu/cpu" + std::to_string(processor) + "/topology/";
+            std::string       core_id;
+            std::string       package_id;
+
+            if (!ReadSysfsFile(topology + "core_id", core_id) || !ReadSysfsFile(topology + "physical_package_id", package_id))
+                return false;
+
+            auto const key    = std::make_pair(static_cast<RkUint32>(std::stoul(package_id)), static_cast<RkUint32>(std::stoul(core_id)));
+            auto const result = cores.emplace(key, m_cores.size());
+
+            if (result.second)
+                m_cores.push_back(PhysicalCore {{}, m_processor_nodes[processor]});
+
+            m_cores[result.first->second].processors.push_back(processor);
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    #elif defined(RUKEN_OS_WINDOWS)
+
+    DWORD length = 0u;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+
+    std::vector<RkUint8> buffer(length);
+
+    if (length == 0u || !GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length))
+        return false;
+
+    m_processor_nodes.assign(sizeof(KAFFINITY) * 8u, 0u);
+    m_numa_nodes_count = 0u;
+
+    // Nodes first, cores need them
+    for (DWORD offset = 0u; offset < length;)
+    {
+        auto const* info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+
+        if (info->Relationship == RelationNumaNode && info->NumaNode.GroupMask.Group == 0u)
+        {
+            for (RkUint32 processor = 0u; processor < m_processor_nodes.size(); ++processor)
+            {
+                if (info->NumaNode.GroupMask.Mask & (static_cast<KAFFINITY>(1u) << processor))
+                    m_processor_nodes[processor] = m_numa_nodes_count;
+            }
+
+            ++m_numa_nodes_count;
+        }
+
+        offset += info->Size;
+    }
+
+    m_numa_nodes_count = std::max(m_numa_nodes_count, 1u);
+
+    for (DWORD offset = 0u; offset < length;)
+    {
+        auto const* info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+
+        if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0u)
+        {
+            PhysicalCore core {{}, 0u};
+
+            for (RkUint32 processor = 0u; processor < m_processor_nodes.size(); ++processor)
+            {
+                if (info->Processor.GroupMask[0].Mask & (static_cast<KAFFINITY>(1u) << processor))
+                    core.processors.push_back(processor);
+            }
+
+            if (!core.processors.empty())
+            {
+                core.numa_node = m_processor_nodes[core.processors.front()];
+                m_cores.push_back(std::move(core));
+            }
+        }
+
+        offset += info->Size;
+    }
+
+    #else
+
+    return false;
+
+    #endif
+
+    // Grouping the cores by NUMA node
+    std::stable_sort(m_cores.begin(), m_cores.end(), [](PhysicalCore const& in_lhs, PhysicalCore const& in_rhs) {
+        return in_lhs.numa_node < in_rhs.numa_node;
+    });
+
+    return true;
+}
+
+std::vector<CpuTopology::PhysicalCore> const& CpuTopology::GetPhysicalCores() const noexcept
+{
+    return m_cores;
+}
+
+RkSize CpuTopology::GetLogicalProcessorsCount() const noexcept
+{
+    RkSize count = 0u;
+
+    for (PhysicalCore const& core : m_cores)
+        count += core.processors.size();
+
+    return count;
+}
+
+RkUint32 CpuTopology::GetNumaNodesCount() const noexcept
+{
+    return m_numa_nodes_count;
+}
+
+RkUint32 CpuTopology::GetNumaNode(RkUint32 const in_processor) const noexcept
+{
+    if (in_processor >= m_processor_nodes.size())
+        return 0u;
+
+    return m_processor_nodes[in_processor];
+}
+
+RkUint32 CpuTopology::GetCurrentProcessor() noexcept
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    return static_cast<RkUint32>(GetCurrentProcessorNumber());
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    RkInt32 const processor = sched_getcpu();
+
+    return processor < 0 ? 0u : static_cast<RkUint32>(processor);
+
+    #else
+
+    return 0u;
+
+    #endif
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Threading/EventCount.hpp"
+
+USING_RUKEN_NAMESPACE
+
+EventCount::EventCount() noexcept:
+    m_waiters   {0u},
+    m_epoch     {0u},
+    m_mutex     {},
+    m_condition {}
+{}
+
+RkUint32 EventCount::PrepareWait() noexcept
+{
+    // Sequentially consistent, pairs with the fence of the notifying threads
+    m_waiters.fetch_add(1u, std::memory_order_seq_cst);
+
+    return m_epoch.load(std::memory_order_seq_cst);
+}
+
+RkVoid EventCount::CancelWait() noexcept
+{
+    m_waiters.fetch_sub(1u, std::memory_order_seq_cst);
+}
+
+RkVoid EventCount::Wait(RkUint32 const in_key) noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_condition.wait(lock, [&] {
+            return m_epoch.load(std::memory_order_relaxed) != in_key;
+        });
+    }
+
+    m_waiters.fetch_sub(1u, std::memory_order_seq_cst);
+}
+
+RkBool EventCount::WaitUntil(RkUint32 const in_key, std::chrono::steady_clock::time_point const in_deadline) noexcept
+{
+    RkBool notified;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        notified = m_condition.wait_until(lock, in_deadline, [&] {
+            return m_epoch.load(std::memory_order_relaxed) != in_key;
+        });
+    }
+
+    m_waiters.fetch_sub(1u, std::memory_order_seq_cst);
+
+    return notified;
+}
+
+RkVoid EventCount::NotifyOne() noexcept
+{
+    // Either the waiter registered itself before this fence and will be notified,
+    // or it registered itself after and will see the condition as true
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_waiters.load(std::memory_order_relaxed) == 0u)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_epoch.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    m_condition.notify_one();
+}
+
+RkVoid EventCount::NotifyAll() noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_waiters.load(std::memory_order_relaxed) == 0u)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_epoch.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    m_condition.notify_all();
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Build/OperatingSystem.hpp"
+#include "Threading/Fiber.hpp"
+
+#if defined(RUKEN_OS_WINDOWS)
+    #include "Utility/WindowsOS.hpp"
+#elif defined(RUKEN_OS_LINUX)
+    #include <unistd.h>
+    #include <ucontext.h>
+    #include <sys/mman.h>
+#endif
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    VOID WINAPI FiberProc(LPVOID in_fiber)
+    {
+        Fiber::Run(static_cast<Fiber*>(in_fiber));
+    }
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    /**
+     * \brief Context of a fiber, its stack is mapped with a guard page to catch overflows
+     */
+    struct FiberContext
+    {
+        ucontext_t context;
+        RkVoid*    stack;
+        RkSize     stack_size;
+    };
+
+    // makecontext only forwards int arguments, the fiber pointer is split in two halves
+    RkVoid FiberProc(RkUint32 const in_low, RkUint32 const in_high)
+    {
+        RkUint64 const address = static_cast<RkUint64>(in_high) << 32u | in_low;
+
+        Fiber::Run(reinterpret_cast<Fiber*>(static_cast<uintptr_t>(address)));
+    }
+
+    #endif
+}
+
+Fiber::Fiber() noexcept:
+    m_handle       {nullptr},
+    m_entry        {nullptr},
+    m_argument     {nullptr},
+    m_thread_fiber {true}
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    m_handle = ConvertThreadToFiber(nullptr);
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    // The context of the thread is saved on the first switch
+    m_handle = new FiberContext {{}, nullptr, 0u};
+
+    #endif
+}
+
+Fiber::Fiber(Entry const in_entry, RkVoid* in_argument, RkSize const in_stack_size) noexcept:
+    m_handle       {nullptr},
+    m_entry        {in_entry},
+    m_argument     {in_argument},
+    m_thread_fiber {false}
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    m_handle = CreateFiber(in_stack_size, &FiberProc, this);
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    RkSize const page_size  = static_cast<RkSize>(sysconf(_SC_PAGESIZE));
+    RkSize const stack_size = (in_stack_size + page_size - 1u) / page_size * page_size + page_size;
+
+    RkVoid* stack = mmap(nullptr, stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+
+    if (stack == MAP_FAILED)
+        return;
+
+    // Stacks grow downward, the guard page is the lowest one
+    mprotect(stack, page_size, PROT_NONE);
+
+    FiberContext* context = new FiberContext {{}, stack, stack_size};
+
+    getcontext(&context->context);
+
+    context->context.uc_stack.ss_sp   = static_cast<RkUint8*>(stack) + page_size;
+    context->context.uc_stack.ss_size = stack_size - page_size;
+    context->context.uc_link          = nullptr;
+
+    uintptr_t const address = reinterpret_cast<uintptr_t>(this);
+
+    // makecontext expects a "void (*)()" entry point, spelled out so that the compiler recognizes the generic function pointer type
+    makecontext(&context->context, reinterpret_cast<void (*)()>(&FiberProc), 2,
+                static_cast<RkUint32>(address & 0xFFFFFFFFu),
+                static_cast<RkUint32>(static_cast<RkUint64>(address) >> 32u));
+
+    m_handle = context;
+
+    #endif
+}
+
+Fiber::~Fiber() noexcept
+{
+    if (!m_handle)
+        return;
+
+    #if defined(RUKEN_OS_WINDOWS)
+
+    if (m_thread_fiber)
+        ConvertFiberToThread();
+    else
+        DeleteFiber(m_handle);
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    FiberContext* context = static_cast<FiberContext*>(m_handle);
+
+    if (context->stack)
+        munmap(context->stack, context->stack_size);
+
+    delete context;
+
+    #endif
+}
+
+RkVoid Fiber::Run(Fiber* in_fiber) noexcept
+{
+    in_fiber->m_entry(in_fiber->m_argument);
+}
+
+RkVoid Fiber::SwitchTo(Fiber& in_fiber) noexcept
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    SwitchToFiber(in_fiber.m_handle);
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    swapcontext(&static_cast<FiberContext*>(m_handle)->context, &static_cast<FiberContext*>(in_fiber.m_handle)->context);
+
+    #endif
+}
+
+RkBool Fiber::Valid() const noexcept
+{
+    return m_handle != nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "Threading/Histogram.hpp"
+
+USING_RUKEN_NAMESPACE
+
+Histogram::Histogram() noexcept:
+    m_buckets {},
+    m_sum     {0u},
+    m_max     {0u}
+{
+    Reset();
+}
+
+Histogram::Histogram(Histogram const& in_copy) noexcept:
+    Histogram()
+{
+    Merge(in_copy);
+}
+
+Histogram::Histogram(Histogram&& in_move) noexcept:
+    Histogram()
+{
+    Merge(in_move);
+}
+
+RkSize Histogram::GetBucket(RkUint64 const in_value) noexcept
+{
+    // Small values get a bucket of their own
+    if (in_value < sub_buckets_count)
+        return static_cast<RkSize>(in_value);
+
+    RkSize exponent = 0u;
+    for (RkUint64 value = in_value; value >>= 1u;)
+        ++exponent;
+
+    // The bits following the most significant one select the sub-bucket
+    RkSize const shift      = exponent - sub_buckets_bits;
+    RkSize const sub_bucket = static_cast<RkSize>(in_value >> shift) & (sub_buckets_count - 1u);
+
+    return (shift + 1u) * sub_buckets_count + sub_bucket;
+}
+
+RkUint64 Histogram::GetBucketUpperBound(RkSize const in_bucket) noexcept
+{
+    if (in_bucket < sub_buckets_count)
+        return in_bucket;
+
+    RkSize   const shift      = in_bucket / sub_buckets_count - 1u;
+    RkUint64 const sub_bucket = in_bucket % sub_buckets_count;
+    RkUint64 const lower      = (sub_buckets_count | sub_bucket) << shift;
+
+    return lower + ((RkUint64(1u) << shift) - 1u);
+}
+
+RkVoid Histogram::Record(RkUint64 const in_value) noexcept
+{
+    m_buckets[GetBucket(in_value)].fetch_add(1u, std::memory_order_relaxed);
+    m_sum                         .fetch_add(in_value, std::memory_order_relaxed);
+
+    RkUint64 max = m_max.load(std::memory_order_relaxed);
+    while (in_value > max && !m_max.compare_exchange_weak(max, in_value, std::memory_order_relaxed))
+    {}
+}
+
+RkVoid Histogram::RecordExclusive(RkUint64 const in_value) noexcept
+{
+    std::atomic<RkUint64>& bucket = m_buckets[GetBucket(in_value)];
+
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1u       , std::memory_order_relaxed);
+    m_sum .store(m_sum .load(std::memory_order_relaxed) + in_value , std::memory_order_relaxed);
+
+    if (in_value > m_max.load(std::memory_order_relaxed))
+        m_max.store(in_value, std::memory_order_relaxed);
+}
+
+RkVoid Histogram::Merge(Histogram const& in_other) noexcept
+{
+    for (RkSize bucket = 0u; bucket < buckets_count; ++bucket)
+    {
+        RkUint64 const count = in_other.m_buckets[bucket].load(std::memory_order_relaxed);
+
+        if (count)
+            m_buckets[bucket].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    m_sum.fetch_add(in_other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    RkUint64 const other_max = in_other.m_max.load(std::memory_order_relaxed);
+    RkUint64       max       = m_max.load(std::memory_order_relaxed);
+
+    while (other_max > max && !m_max.compare_exchange_weak(max, other_max, std::memory_order_relaxed))
+    {}
+}
+
+RkVoid Histogram::Reset() noexcept
+{
+    for (std::atomic<RkUint64>& bucket : m_buckets)
+        bucket.store(0u, std::memory_order_relaxed);
+
+    m_sum.store(0u, std::memory_order_relaxed);
+    m_max.store(0u, std::memory_order_relaxed);
+}
+
+RkUint64 Histogram::GetCount() const noexcept
+{
+    RkUint64 count = 0u;
+
+    for (std::atomic<RkUint64> const& bucket : m_buckets)
+        count += bucket.load(std::memory_order_relaxed);
+
+    return count;
+}
+
+RkDouble Histogram::GetMean() const noexcept
+{
+    RkUint64 const count = GetCount();
+
+    return count ? static_cast<RkDouble>(m_sum.load(std::memory_order_relaxed)) / static_cast<RkDouble>(count) : 0.0;
+}
+
+RkUint64 Histogram::GetMax() const noexcept
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+RkUint64 Histogram::GetValueAtPercentile(RkDouble const in_percentile) const noexcept
+{
+    RkUint64 const count = GetCount();
+
+    if (count == 0u)
+        return 0u;
+
+    RkUint64 const rank = std::max<RkUint64>(static_cast<RkUint64>(std::ceil(std::clamp(in_percentile, 0.0, 100.0) / 100.0 * static_cast<RkDouble>(count))), 1u);
+    RkUint64       seen = 0u;
+
+    for (RkSize bucket = 0u; bucket < buckets_count; ++bucket)
+    {
+        seen += m_buckets[bucket].load(std::memory_order_relaxed);
+
+        // The maximum is exact, never reporting more than it
+        if (seen >= rank)
+            return std::min(GetBucketUpperBound(bucket), GetMax());
+    }
+
+    return GetMax();
+}
+
+Histogram& Histogram::operator=(Histogram const& in_copy) noexcept
+{
+    if (this != &in_copy)
+    {
+        Reset();
+        Merge(in_copy);
+    }
+
+    return *this;
+}
+
+Histogram& Histogram::operator=(Histogram&& in_move) noexcept
+{
+    return *this = static_cast<Histogram const&>(in_move);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define RUKEN_THREADING_PAUSE() _mm_pause()
+#else
+    #define RUKEN_THREADING_PAUSE()
+#endif
+
+#include "Threading/IdlePolicy.hpp"
+
+USING_RUKEN_NAMESPACE
+
+RkBool IdlePolicy::Idle(RkUint32& in_out_iteration) const noexcept
+{
+    if (in_out_iteration < spin_count)
+    {
+        RUKEN_THREADING_PAUSE();
+    }
+    else if (in_out_iteration < spin_count + yield_count)
+    {
+        std::this_thread::yield();
+    }
+    else
+    {
+        return false;
+    }
+
+    ++in_out_iteration;
+
+    return true;
+}
\ No newline at end of file
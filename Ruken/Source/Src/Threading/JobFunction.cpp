@@ -0,0 +1,96 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Threading/JobFunction.hpp"
+
+USING_RUKEN_NAMESPACE
+
+JobFunction::JobFunction() noexcept:
+    m_storage    {},
+    m_operations {nullptr}
+{}
+
+JobFunction::JobFunction(std::nullptr_t) noexcept:
+    m_storage    {},
+    m_operations {nullptr}
+{}
+
+JobFunction::JobFunction(JobFunction&& in_move) noexcept:
+    m_storage    {},
+    m_operations {in_move.m_operations}
+{
+    if (m_operations)
+    {
+        m_operations->move(m_storage, in_move.m_storage);
+        in_move.m_operations = nullptr;
+    }
+}
+
+JobFunction::~JobFunction()
+{
+    Reset();
+}
+
+RkVoid JobFunction::Reset() noexcept
+{
+    if (m_operations)
+    {
+        m_operations->destroy(m_storage);
+        m_operations = nullptr;
+    }
+}
+
+RkVoid JobFunction::operator()()
+{
+    m_operations->invoke(m_storage);
+}
+
+JobFunction::operator RkBool() const noexcept
+{
+    return m_operations != nullptr;
+}
+
+JobFunction& JobFunction::operator=(JobFunction&& in_move) noexcept
+{
+    if (this == &in_move)
+        return *this;
+
+    Reset();
+
+    if (in_move.m_operations)
+    {
+        m_operations = in_move.m_operations;
+        m_operations->move(m_storage, in_move.m_storage);
+        in_move.m_operations = nullptr;
+    }
+
+    return *this;
+}
+
+JobFunction& JobFunction::operator=(std::nullptr_t) noexcept
+{
+    Reset();
+
+    return *this;
+}
\ No newline at end of file
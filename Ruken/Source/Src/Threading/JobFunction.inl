@@ -0,0 +1,70 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TCallable>
+RkVoid JobFunction::Invoke(RkVoid* in_storage)
+{
+    (*static_cast<TCallable*>(in_storage))();
+}
+
+template <typename TCallable>
+RkVoid JobFunction::Move(RkVoid* in_destination, RkVoid* in_source) noexcept
+{
+    TCallable* source = static_cast<TCallable*>(in_source);
+
+    new (in_destination) TCallable(std::move(*source));
+
+    source->~TCallable();
+}
+
+template <typename TCallable>
+RkVoid JobFunction::Destroy(RkVoid* in_storage) noexcept
+{
+    static_cast<TCallable*>(in_storage)->~TCallable();
+}
+
+template <typename TCallable>
+JobFunction::Operations const* JobFunction::GetOperations() noexcept
+{
+    static constexpr Operations operations {&Invoke<TCallable>, &Move<TCallable>, &Destroy<TCallable>};
+
+    return &operations;
+}
+
+template <typename TCallable, typename>
+JobFunction::JobFunction(TCallable&& in_callable) noexcept:
+    m_storage    {},
+    m_operations {nullptr}
+{
+    using Callable = std::decay_t<TCallable>;
+
+    static_assert(sizeof (Callable) <= capacity,                   "The callable is too big to be stored into a job, consider capturing less data or increasing RUKEN_THREADING_JOB_CAPACITY");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),  "The callable is over-aligned and cannot be stored into a job");
+    static_assert(std::is_nothrow_move_constructible_v<Callable>, "The callable must be nothrow move constructible");
+    static_assert(std::is_invocable_v<Callable&>,                 "The callable must be invocable without any argument");
+
+    new (m_storage) Callable(std::forward<TCallable>(in_callable));
+
+    m_operations = GetOperations<Callable>();
+}
\ No newline at end of file
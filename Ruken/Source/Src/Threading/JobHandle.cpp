@@ -0,0 +1,110 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Threading/JobHandle.hpp"
+#include "Threading/Scheduler.hpp"
+
+USING_RUKEN_NAMESPACE
+
+JobHandle::JobHandle(JobNode* in_node) noexcept:
+    m_node {in_node}
+{
+    if (m_node)
+        m_node->AddReference();
+}
+
+JobHandle::JobHandle() noexcept:
+    m_node {nullptr}
+{}
+
+JobHandle::JobHandle(JobHandle const& in_copy) noexcept:
+    m_node {in_copy.m_node}
+{
+    if (m_node)
+        m_node->AddReference();
+}
+
+JobHandle::JobHandle(JobHandle&& in_move) noexcept:
+    m_node {in_move.m_node}
+{
+    in_move.m_node = nullptr;
+}
+
+JobHandle::~JobHandle()
+{
+    if (m_node)
+        m_node->RemoveReference();
+}
+
+RkBool JobHandle::Valid() const noexcept
+{
+    return m_node != nullptr;
+}
+
+RkBool JobHandle::Done() const noexcept
+{
+    return !m_node || m_node->Completed();
+}
+
+RkVoid JobHandle::Wait() const noexcept
+{
+    if (m_node)
+        m_node->scheduler->Wait(*this);
+}
+
+JobHandle JobHandle::Then(JobFunction&& in_continuation) const noexcept
+{
+    if (!m_node)
+        return JobHandle();
+
+    // Continuations keep the priority class of the job they follow
+    return m_node->scheduler->ScheduleTask(std::forward<JobFunction>(in_continuation), {*this}, m_node->priority.load(std::memory_order_relaxed));
+}
+
+JobHandle& JobHandle::operator=(JobHandle const& in_copy) noexcept
+{
+    if (in_copy.m_node)
+        in_copy.m_node->AddReference();
+
+    if (m_node)
+        m_node->RemoveReference();
+
+    m_node = in_copy.m_node;
+
+    return *this;
+}
+
+JobHandle& JobHandle::operator=(JobHandle&& in_move) noexcept
+{
+    if (this == &in_move)
+        return *this;
+
+    if (m_node)
+        m_node->RemoveReference();
+
+    m_node         = in_move.m_node;
+    in_move.m_node = nullptr;
+
+    return *this;
+}
\ No newline at end of file
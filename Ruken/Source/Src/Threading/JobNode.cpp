@@ -0,0 +1,107 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Threading/JobNode.hpp"
+#include "Threading/JobNodePool.hpp"
+
+USING_RUKEN_NAMESPACE
+
+namespace
+{
+    // Address used to mark a continuation stack as closed
+    JobNode::Link closed_continuations;
+}
+
+JobNode::JobNode(JobFunction&& in_task, Scheduler* in_scheduler, JobNodePool* in_pool, RkSize const in_dependencies_count) noexcept:
+    task                 {std::forward<JobFunction>(in_task)},
+    scheduler            {in_scheduler},
+    pool                 {in_pool},
+    priority             {EJobPriority::Normal},
+    io_bound             {false},
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+    submit_time          {0u},
+    #endif
+    references           {1u},
+    pending_dependencies {static_cast<RkUint32>(in_dependencies_count) + 1u},
+    continuations        {nullptr},
+    inline_links         {},
+    extra_links          {}
+{
+    if (in_dependencies_count > inline_links_count)
+        extra_links = std::make_unique<Link[]>(in_dependencies_count - inline_links_count);
+}
+
+JobNode::Link* JobNode::GetLink(RkSize const in_index) noexcept
+{
+    if (in_index < inline_links_count)
+        return &inline_links[in_index];
+
+    return &extra_links[in_index - inline_links_count];
+}
+
+RkBool JobNode::AddContinuation(Link* in_link) noexcept
+{
+    Link* head = continuations.load(std::memory_order_acquire);
+
+    do
+    {
+        if (head == &closed_continuations)
+            return false;
+
+        in_link->next = head;
+    }
+    while (!continuations.compare_exchange_weak(head, in_link, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return true;
+}
+
+JobNode::Link* JobNode::CloseContinuations() noexcept
+{
+    return continuations.exchange(&closed_continuations, std::memory_order_acq_rel);
+}
+
+RkBool JobNode::Completed() const noexcept
+{
+    return continuations.load(std::memory_order_acquire) == &closed_continuations;
+}
+
+RkVoid JobNode::RaisePriority(EJobPriority const in_priority) noexcept
+{
+    EJobPriority current = priority.load(std::memory_order_relaxed);
+
+    // Priorities are sorted from the highest to the lowest
+    while (in_priority < current && !priority.compare_exchange_weak(current, in_priority, std::memory_order_relaxed))
+    {}
+}
+
+RkVoid JobNode::AddReference() noexcept
+{
+    references.fetch_add(1u, std::memory_order_relaxed);
+}
+
+RkVoid JobNode::RemoveReference() noexcept
+{
+    if (references.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        pool->Release(this);
+}
\ No newline at end of file
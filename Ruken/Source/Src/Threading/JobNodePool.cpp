@@ -0,0 +1,126 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "Threading/JobNodePool.hpp"
+
+USING_RUKEN_NAMESPACE
+
+JobNodePool::JobNodePool() noexcept:
+    m_head         {invalid_index},
+    m_growth_mutex {},
+    m_blocks_count {0u},
+    m_blocks       {}
+{}
+
+JobNodePool::Slot& JobNodePool::GetSlot(RkUint32 const in_index) const noexcept
+{
+    return m_blocks[in_index / block_size][in_index % block_size];
+}
+
+RkVoid JobNodePool::Push(Slot& in_first, Slot& in_last) noexcept
+{
+    RkUint64 head = m_head.load(std::memory_order_relaxed);
+    RkUint64 new_head;
+
+    do
+    {
+        in_last.next.store(static_cast<RkUint32>(head), std::memory_order_relaxed);
+
+        new_head = (((head >> 32u) + 1u) << 32u) | in_first.index;
+    }
+    while (!m_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+JobNodePool::Slot* JobNodePool::Grow() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_growth_mutex);
+
+    if (m_blocks_count == max_blocks)
+        return nullptr;
+
+    std::unique_ptr<Slot[]>& block      = m_blocks[m_blocks_count];
+    RkUint32 const           base_index = m_blocks_count * block_size;
+
+    block = std::make_unique<Slot[]>(block_size);
+
+    for (RkUint32 index = 0u; index < block_size; ++index)
+    {
+        block[index].index = base_index + index;
+        block[index].next.store(base_index + index + 1u, std::memory_order_relaxed);
+    }
+
+    ++m_blocks_count;
+
+    // The first slot is kept for the caller, the rest of the block becomes available to everyone
+    Push(block[1], block[block_size - 1u]);
+
+    return &block[0];
+}
+
+JobNode* JobNodePool::Allocate(JobFunction&& in_task, Scheduler* in_scheduler, RkSize const in_dependencies_count) noexcept
+{
+    Slot*    slot = nullptr;
+    RkUint64 head = m_head.load(std::memory_order_acquire);
+
+    while (static_cast<RkUint32>(head) != invalid_index)
+    {
+        // Slots are never freed, reading the next index is safe even if another thread already popped this slot.
+        // In that case the tag of the head changed and the exchange below will fail
+        Slot&          candidate = GetSlot(static_cast<RkUint32>(head));
+        RkUint64 const new_head  = (((head >> 32u) + 1u) << 32u) | candidate.next.load(std::memory_order_relaxed);
+
+        if (m_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            slot = &candidate;
+            break;
+        }
+    }
+
+    if (!slot)
+        slot = Grow();
+
+    // The pool is exhausted, falling back on a standalone slot
+    if (!slot)
+    {
+        slot        = new Slot();
+        slot->index = invalid_index;
+    }
+
+    return new (slot->storage) JobNode(std::forward<JobFunction>(in_task), in_scheduler, this, in_dependencies_count);
+}
+
+RkVoid JobNodePool::Release(JobNode* in_node) noexcept
+{
+    Slot* slot = reinterpret_cast<Slot*>(in_node);
+
+    in_node->~JobNode();
+
+    if (slot->index == invalid_index)
+    {
+        delete slot;
+        return;
+    }
+
+    Push(*slot, *slot);
+}
\ No newline at end of file
@@ -22,26 +22,188 @@
  *  SOFTWARE.
  */
 
+#include <cstdio>
+#include <utility>
+#include <algorithm>
+
+#include "Meta/Assert.hpp"
 #include "Threading/Scheduler.hpp"
 #include "Core/ServiceProvider.hpp"
 
 USING_RUKEN_NAMESPACE
 
-Scheduler::Scheduler(ServiceProvider& in_service_provider, RkUint16 const in_workers_count):
+namespace
+{
+    // Identifies the scheduler and worker owning the current thread, if any
+    thread_local Scheduler* current_scheduler    = nullptr;
+    thread_local RkUint16   current_worker_index = 0u;
+
+    // Scheduler of the job being executed by the current thread, if any (workers, I/O workers and helping threads alike)
+    thread_local Scheduler const* executing_scheduler = nullptr;
+
+    // Data of the job running on the current thread, see Scheduler::SetJobData
+    thread_local RkVoid const* current_job_data = nullptr;
+
+    // Xorshift state used when a thread that isn't a worker steals jobs
+    thread_local RkUint32 external_random_state = 0x9E3779B9u;
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    // Identifies the scheduler and telemetry slot of the current thread, if it is a worker or an I/O worker
+    thread_local Scheduler const* telemetry_scheduler = nullptr;
+    thread_local RkSize           telemetry_slot      = 0u;
+
+    WorkerStatistics MakeStatistics(WorkerTelemetry const& in_telemetry, RkUint64 const in_now) noexcept
+    {
+        WorkerStatistics statistics;
+
+        RkUint64 const start      = in_telemetry.start_time.load(std::memory_order_relaxed);
+        RkUint64 const idle_since   = in_telemetry.idle_since  .load(std::memory_order_relaxed);
+        RkUint64 const parked_since = in_telemetry.parked_since.load(std::memory_order_relaxed);
+
+        statistics.jobs_executed   = in_telemetry.jobs_executed  .load(std::memory_order_relaxed);
+        statistics.steal_attempts  = in_telemetry.steal_attempts .load(std::memory_order_relaxed);
+        statistics.steal_successes = in_telemetry.steal_successes.load(std::memory_order_relaxed);
+        statistics.parked_time     = in_telemetry.parked_time    .load(std::memory_order_relaxed);
+        statistics.idle_time       = in_telemetry.idle_time      .load(std::memory_order_relaxed);
+
+        // Accounting for the idle and parked periods in progress, if any
+        if (idle_since != 0u && in_now > idle_since)
+            statistics.idle_time += in_now - idle_since;
+
+        if (parked_since != 0u && in_now > parked_since)
+            statistics.parked_time += in_now - parked_since;
+
+        if (start != 0u && in_now > start)
+            statistics.busy_time = std::max(in_now - start, statistics.idle_time) - statistics.idle_time;
+
+        return statistics;
+    }
+
+    std::string FormatDuration(RkUint64 const in_nanoseconds)
+    {
+        RkChar buffer[32];
+
+        if (in_nanoseconds < 10'000u)
+            std::snprintf(buffer, sizeof buffer, "%lluns", static_cast<unsigned long long>(in_nanoseconds));
+        else if (in_nanoseconds < 10'000'000u)
+            std::snprintf(buffer, sizeof buffer, "%.1fus", static_cast<RkDouble>(in_nanoseconds) / 1e3);
+        else
+            std::snprintf(buffer, sizeof buffer, "%.1fms", static_cast<RkDouble>(in_nanoseconds) / 1e6);
+
+        return buffer;
+    }
+
+    std::string FormatStatistics(WorkerStatistics const& in_statistics)
+    {
+        RkUint64 const uptime = in_statistics.busy_time + in_statistics.idle_time;
+        RkChar         buffer[64];
+
+        std::snprintf(buffer, sizeof buffer, "%.1f%%", uptime ? 100.0 * static_cast<RkDouble>(in_statistics.busy_time) / static_cast<RkDouble>(uptime) : 0.0);
+
+        return std::to_string(in_statistics.jobs_executed) + " jobs, busy " + buffer
+             + " (" + FormatDuration(in_statistics.busy_time) + "), idle " + FormatDuration(in_statistics.idle_time)
+             + " (parked " + FormatDuration(in_statistics.parked_time) + "), steals "
+             + std::to_string(in_statistics.steal_successes) + "/" + std::to_string(in_statistics.steal_attempts);
+    }
+
+    std::string FormatHistogram(Histogram const& in_histogram)
+    {
+        return std::to_string(in_histogram.GetCount()) + " jobs, mean " + FormatDuration(static_cast<RkUint64>(in_histogram.GetMean()))
+             + ", p50 "  + FormatDuration(in_histogram.GetValueAtPercentile(50.0))
+             + ", p90 "  + FormatDuration(in_histogram.GetValueAtPercentile(90.0))
+             + ", p99 "  + FormatDuration(in_histogram.GetValueAtPercentile(99.0))
+             + ", max "  + FormatDuration(in_histogram.GetMax());
+    }
+
+    #endif
+}
+
+Scheduler::Scheduler(ServiceProvider&       in_service_provider,
+                     RkUint16         const in_workers_count,
+                     ESchedulerMode   const in_mode,
+                     EWorkerPlacement const in_placement,
+                     IdlePolicy       const& in_idle_policy):
     Service<Scheduler> {in_service_provider},
-    m_workers   {in_workers_count == 0u ? std::thread::hardware_concurrency() - 1 : in_workers_count},
-    m_running   {true},
-    m_job_queue {}
+    m_job_pool         {},
+    m_mode             {in_mode},
+    m_placement        {in_placement},
+    m_topology         {},
+    m_workers          {},
+    m_running          {true},
+    m_job_queues       {},
+    m_contexts         {},
+    m_nodes            {},
+    m_nodes_count      {1u},
+    m_critical_jobs    {0u},
+    m_io_workers       {RUKEN_THREADING_IO_WORKERS_COUNT},
+    m_io_queue         {},
+    m_fibers           {},
+    m_suspended_fibers {0u},
+    m_idle_policy      {in_idle_policy},
+    m_pending_jobs     {0u},
+    m_work_event       {},
+    m_completion_event {}
 {
+    RkSize const processors_count = m_placement == EWorkerPlacement::PhysicalCores ? m_topology.GetPhysicalCores().size() : m_topology.GetLogicalProcessorsCount();
+
+    m_workers.resize(in_workers_count == 0u ? std::max<RkSize>(processors_count, 2u) - 1u : in_workers_count);
+    m_fibers = std::make_unique<FiberContext[]>(m_workers.size());
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    m_telemetry = std::make_unique<WorkerTelemetry[]>(m_workers.size() + m_io_workers.size() + 1u);
+    m_telemetry[m_workers.size() + m_io_workers.size()].shared = true;
+
+    #endif
+
+    if (m_mode == ESchedulerMode::WorkStealing)
+    {
+        if (m_placement == EWorkerPlacement::PhysicalCores)
+            m_nodes_count = m_topology.GetNumaNodesCount();
+
+        m_contexts = std::make_unique<WorkerContext[]>(m_workers.size());
+        m_nodes    = std::make_unique<NodeContext  []>(m_nodes_count);
+
+        // Seeding every worker with a different value, 0 is not a valid xorshift state
+        for (RkSize index = 0; index < m_workers.size(); ++index)
+        {
+            m_contexts[index].random_state = static_cast<RkUint32>(index) * 0x9E3779B9u + 1u;
+            m_contexts[index].node         = 0u;
+        }
+    }
+
+    if (m_placement == EWorkerPlacement::PhysicalCores)
+        PlaceWorkers();
+    else if (m_mode == ESchedulerMode::WorkStealing)
+    {
+        for (RkSize index = 0; index < m_workers.size(); ++index)
+            m_nodes[0].workers.push_back(static_cast<RkUint16>(index));
+    }
+
     m_logger = m_service_provider.LocateService<Logger>()->AddChild("scheduler");
     if (m_logger)
-        m_logger->Info("Spawning " + std::to_string(m_workers.size()) + " workers");
+    {
+        if (m_placement == EWorkerPlacement::PhysicalCores)
+            m_logger->Info("Spawning " + std::to_string(m_workers.size()) + " workers pinned on " + std::to_string(m_topology.GetPhysicalCores().size()) + " physical cores over " + std::to_string(m_topology.GetNumaNodesCount()) + " NUMA nodes");
+        else
+            m_logger->Info("Spawning " + std::to_string(m_workers.size()) + " workers");
+    }
 
     RkUint16 index = 0;
     for (Worker& worker : m_workers)
     {
-        worker.Label() = "Scheduler worker " + std::to_string(index++);
-        worker.Execute(&Scheduler::WorkersJob, this);
+        worker.SetLogger(m_logger);
+        worker.Label() = "Scheduler worker " + std::to_string(index);
+        worker.Execute(&Scheduler::WorkersJob, this, index++);
+    }
+
+    index = 0;
+    for (Worker& worker : m_io_workers)
+    {
+        worker.SetLogger(m_logger);
+        worker.Label() = "Scheduler IO worker " + std::to_string(index);
+        worker.Execute(&Scheduler::IOWorkersJob, this, index++);
     }
 }
 
@@ -50,21 +212,50 @@ Scheduler::~Scheduler()
     Shutdown();
 }
 
-RkVoid Scheduler::ScheduleTask(Job&& in_task) noexcept
+JobHandle Scheduler::ScheduleTask(Job&& in_task, EJobPriority const in_priority) noexcept
 {
-    if (!m_running.load(std::memory_order_acquire))
+    return CreateJob(std::forward<Job>(in_task), {}, in_priority, false);
+}
+
+JobHandle Scheduler::ScheduleTask(Job&& in_task, std::vector<JobHandle> const& in_dependencies, EJobPriority const in_priority) noexcept
+{
+    return CreateJob(std::forward<Job>(in_task), in_dependencies, in_priority, false);
+}
+
+JobHandle Scheduler::ScheduleIOTask(Job&& in_task) noexcept
+{
+    return CreateJob(std::forward<Job>(in_task), {}, EJobPriority::Normal, true);
+}
+
+JobHandle Scheduler::ScheduleIOTask(Job&& in_task, std::vector<JobHandle> const& in_dependencies) noexcept
+{
+    return CreateJob(std::forward<Job>(in_task), in_dependencies, EJobPriority::Normal, true);
+}
+
+RkVoid Scheduler::Wait(JobHandle const& in_handle) noexcept
+{
+    auto const predicate = [&in_handle] {
+        return in_handle.Done();
+    };
+
+    if (predicate())
         return;
 
-    m_job_queue.Enqueue(std::forward<Job>(in_task));
+    // Job completions notify the scheduler, no need to poll when helping
+    if (CanSuspend())
+        Suspend(&CheckPredicate<decltype(predicate)>, &predicate);
+    else
+        HelpUntil(predicate);
 }
 
 RkVoid Scheduler::WaitForQueuedTasks() noexcept
 {
-    if (!m_running.load(std::memory_order_acquire))
-        return;
+    // The pending jobs count includes the calling job, which would wait for itself forever
+    RUKEN_ASSERT_MESSAGE(executing_scheduler != this, "WaitForQueuedTasks can't be called from a job of the same scheduler");
 
-    while (!m_job_queue.Empty())
-        std::this_thread::yield();
+    HelpUntil([this] {
+        return m_pending_jobs.load(std::memory_order_acquire) == 0u;
+    });
 }
 
 RkVoid Scheduler::Shutdown() noexcept
@@ -73,10 +264,47 @@ RkVoid Scheduler::Shutdown() noexcept
         return;
 
     m_running.store(false, std::memory_order_release);
-    m_job_queue.Clear();
+    m_io_queue.Release();
+
+    m_work_event      .NotifyAll();
+    m_completion_event.NotifyAll();
 
     for (Worker& worker : m_workers)
-        worker.Detach();
+        worker.WaitForAvailability();
+
+    for (Worker& worker : m_io_workers)
+        worker.WaitForAvailability();
+
+    // Workers are now stopped, dropping any job left in the queues
+    JobNode* job = nullptr;
+    while (m_io_queue.TryDequeue(job))
+        job->RemoveReference();
+
+    for (RkSize priority = 0u; priority < priorities_count; ++priority)
+    {
+        while (m_job_queues[priority].Dequeue(job))
+            job->RemoveReference();
+
+        if (m_mode == ESchedulerMode::SharedQueue)
+            continue;
+
+        for (RkUint32 node = 0u; node < m_nodes_count; ++node)
+        {
+            while (m_nodes[node].queues[priority].Dequeue(job))
+                job->RemoveReference();
+        }
+
+        for (RkSize index = 0; index < m_workers.size(); ++index)
+        {
+            while (m_contexts[index].queues[priority].Pop(job))
+                job->RemoveReference();
+        }
+    }
+
+    m_critical_jobs.store(0u, std::memory_order_relaxed);
+
+    // Jobs still waiting for their dependencies will never be executed
+    m_pending_jobs.store(0u, std::memory_order_release);
 }
 
 std::vector<Worker> const& Scheduler::GetWorkers() const noexcept
@@ -84,16 +312,671 @@ std::vector<Worker> const& Scheduler::GetWorkers() const noexcept
     return m_workers;
 }
 
-RkVoid Scheduler::WorkersJob() noexcept
+Scheduler* Scheduler::GetCurrentScheduler() noexcept
+{
+    return current_scheduler && current_scheduler->CanSuspend() ? current_scheduler : nullptr;
+}
+
+RkVoid const* Scheduler::SetJobData(RkVoid const* const in_data) noexcept
+{
+    return std::exchange(current_job_data, in_data);
+}
+
+RkVoid const* Scheduler::GetJobData() noexcept
 {
-    Job current_job;
+    return current_job_data;
+}
+
+RkSize Scheduler::GetCurrentWorkerIndex() const noexcept
+{
+    return current_scheduler == this ? current_worker_index : m_workers.size();
+}
+
+std::vector<Worker> const& Scheduler::GetIOWorkers() const noexcept
+{
+    return m_io_workers;
+}
+
+ESchedulerMode Scheduler::GetMode() const noexcept
+{
+    return m_mode;
+}
+
+EWorkerPlacement Scheduler::GetPlacement() const noexcept
+{
+    return m_placement;
+}
+
+CpuTopology const& Scheduler::GetTopology() const noexcept
+{
+    return m_topology;
+}
+
+SchedulerStatistics Scheduler::GetStatistics() const noexcept
+{
+    SchedulerStatistics statistics;
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    RkUint64 const now            = WorkerTelemetry::Now();
+    RkSize   const slots_count    = m_workers.size() + m_io_workers.size() + 1u;
+    RkUint64       jobs_submitted = 0u;
+    RkUint64       jobs_executed  = 0u;
+
+    for (RkSize slot = 0u; slot < slots_count; ++slot)
+    {
+        WorkerTelemetry const& telemetry = m_telemetry[slot];
+
+        // Started jobs are read first, a job started after that can only make the queue look longer, never negative
+        jobs_executed  += telemetry.jobs_executed .load(std::memory_order_relaxed);
+        jobs_submitted += telemetry.jobs_submitted.load(std::memory_order_relaxed);
+
+        statistics.queue_latency.Merge(telemetry.queue_latency);
+        statistics.run_time     .Merge(telemetry.run_time);
+
+        if (slot < m_workers.size())
+            statistics.workers.push_back(MakeStatistics(telemetry, now));
+        else if (slot < slots_count - 1u)
+            statistics.io_workers.push_back(MakeStatistics(telemetry, now));
+        else
+            statistics.external = MakeStatistics(telemetry, now);
+    }
+
+    statistics.queued_jobs  = jobs_submitted > jobs_executed ? jobs_submitted - jobs_executed : 0u;
+    statistics.pending_jobs = m_pending_jobs.load(std::memory_order_relaxed);
+
+    #endif
+
+    return statistics;
+}
+
+RkVoid Scheduler::LogStatistics() const noexcept
+{
+    if (!m_logger)
+        return;
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    SchedulerStatistics const statistics = GetStatistics();
+
+    for (RkSize index = 0u; index < statistics.workers.size(); ++index)
+        m_logger->Info("Worker " + std::to_string(index) + ": " + FormatStatistics(statistics.workers[index]));
+
+    for (RkSize index = 0u; index < statistics.io_workers.size(); ++index)
+        m_logger->Info("IO worker " + std::to_string(index) + ": " + FormatStatistics(statistics.io_workers[index]));
+
+    m_logger->Info("External threads: " + std::to_string(statistics.external.jobs_executed) + " jobs, steals "
+                 + std::to_string(statistics.external.steal_successes) + "/" + std::to_string(statistics.external.steal_attempts));
+
+    m_logger->Info("Queued jobs: " + std::to_string(statistics.queued_jobs) + ", pending jobs: " + std::to_string(statistics.pending_jobs));
+    m_logger->Info("Queue latency: " + FormatHistogram(statistics.queue_latency));
+    m_logger->Info("Run time: "      + FormatHistogram(statistics.run_time));
+
+    #else
+
+    m_logger->Info("Telemetry is disabled, see RUKEN_THREADING_ENABLE_TELEMETRY");
+
+    #endif
+}
+
+RkVoid Scheduler::PlaceWorkers() noexcept
+{
+    std::vector<CpuTopology::PhysicalCore> const& cores = m_topology.GetPhysicalCores();
+
+    // Leaving the first core to the calling thread whenever possible
+    RkSize const first_core = m_workers.size() < cores.size() ? 1u : 0u;
+
+    for (RkSize index = 0; index < m_workers.size(); ++index)
+    {
+        CpuTopology::PhysicalCore const& core = cores[(first_core + index) % cores.size()];
+
+        m_workers[index].SetAffinity(core.processors);
+
+        if (m_mode == ESchedulerMode::WorkStealing)
+        {
+            m_contexts[index].node = core.numa_node;
+            m_nodes[core.numa_node].workers.push_back(static_cast<RkUint16>(index));
+        }
+    }
+}
+
+RkUint32 Scheduler::GetCurrentNode() const noexcept
+{
+    if (m_nodes_count == 1u)
+        return 0u;
+
+    if (current_scheduler == this)
+        return m_contexts[current_worker_index].node;
+
+    return std::min(m_topology.GetNumaNode(CpuTopology::GetCurrentProcessor()), m_nodes_count - 1u);
+}
+
+RkBool Scheduler::StealJob(RkUint32& in_random_state, std::vector<RkUint16> const& in_victims, RkSize const in_thief_index, EJobPriority const in_priority, JobNode*& out_job) noexcept
+{
+    RkSize const victims_count = in_victims.size();
+
+    if (victims_count == 0u)
+        return false;
+
+    // Xorshift32, picking a random victim to start with
+    in_random_state ^= in_random_state << 13u;
+    in_random_state ^= in_random_state >> 17u;
+    in_random_state ^= in_random_state << 5u;
+
+    RkSize const first_victim = in_random_state % victims_count;
+    RkBool       stolen       = false;
+
+    RUKEN_THREADING_TELEMETRY(RkUint64 attempts = 0u;)
+
+    for (RkSize offset = 0; offset < victims_count && !stolen; ++offset)
+    {
+        RkSize const victim = in_victims[(first_victim + offset) % victims_count];
+
+        if (victim == in_thief_index)
+            continue;
+
+        RUKEN_THREADING_TELEMETRY(++attempts;)
+
+        stolen = m_contexts[victim].queues[static_cast<RkSize>(in_priority)].Steal(out_job);
+    }
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    if (attempts)
+    {
+        WorkerTelemetry& telemetry = GetThreadTelemetry();
+
+        telemetry.Add(telemetry.steal_attempts, attempts);
+
+        if (stolen)
+            telemetry.Add(telemetry.steal_successes, 1u);
+    }
+
+    #endif
+
+    return stolen;
+}
+
+RkBool Scheduler::TryGetNodeJob(RkUint32 const in_node, RkUint32& in_random_state, RkSize const in_thief_index, EJobPriority const in_priority, JobNode*& out_job) noexcept
+{
+    NodeContext& node = m_nodes[in_node];
+
+    return node.queues[static_cast<RkSize>(in_priority)].Dequeue(out_job) || StealJob(in_random_state, node.workers, in_thief_index, in_priority, out_job);
+}
+
+JobHandle Scheduler::CreateJob(Job&& in_task, std::vector<JobHandle> const& in_dependencies, EJobPriority const in_priority, RkBool const in_io_bound) noexcept
+{
+    if (!m_running.load(std::memory_order_acquire))
+        return JobHandle();
+
+    JobNode*  const node = m_job_pool.Allocate(std::forward<Job>(in_task), this, in_dependencies.size());
+    JobHandle const handle(node);
+
+    node->priority.store(in_priority, std::memory_order_relaxed);
+    node->io_bound = in_io_bound;
+
+    m_pending_jobs.fetch_add(1u, std::memory_order_relaxed);
+
+    // Every dependency that already completed (or that is invalid) is released right away
+    RkUint32 released_dependencies = 1u;
+    for (RkSize index = 0; index < in_dependencies.size(); ++index)
+    {
+        JobNode* dependency = in_dependencies[index].m_node;
+        JobNode::Link* link = node->GetLink(index);
+
+        link->dependent = node;
+
+        // Priority inheritance, only effective if the dependency hasn't been submitted yet
+        if (dependency)
+            dependency->RaisePriority(in_priority);
+
+        if (!dependency || !dependency->AddContinuation(link))
+            ++released_dependencies;
+    }
+
+    // The extra pending dependency held during the setup prevents the job from being submitted too early
+    if (node->pending_dependencies.fetch_sub(released_dependencies, std::memory_order_acq_rel) == released_dependencies)
+        Submit(node);
+
+    return handle;
+}
+
+RkVoid Scheduler::Submit(JobNode* in_job) noexcept
+{
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    WorkerTelemetry& telemetry = GetThreadTelemetry();
+
+    in_job->submit_time = WorkerTelemetry::Now();
+    telemetry.Add(telemetry.jobs_submitted, 1u);
+
+    #endif
+
+    // Blocking jobs never reach the compute workers
+    if (in_job->io_bound)
+    {
+        m_io_queue.Enqueue(std::move(in_job));
+        return;
+    }
+
+    EJobPriority const priority = in_job->priority.load(std::memory_order_relaxed);
+    RkSize       const queue    = static_cast<RkSize>(priority);
+
+    if (priority == EJobPriority::Critical)
+        m_critical_jobs.fetch_add(1u, std::memory_order_relaxed);
+
+    // Jobs spawned by a worker go onto its own deque, without any lock
+    if (m_mode == ESchedulerMode::SharedQueue)
+        m_job_queues[queue].Enqueue(std::move(in_job));
+    else if (current_scheduler == this)
+        m_contexts[current_worker_index].queues[queue].Push(in_job);
+    else
+        m_nodes[GetCurrentNode()].queues[queue].Enqueue(std::move(in_job));
+
+    // Waking up an idle worker, as well as any waiting thread since they help executing jobs
+    m_work_event      .NotifyOne();
+    m_completion_event.NotifyAll();
+}
+
+RkVoid Scheduler::Execute(JobNode* in_job) noexcept
+{
+    Scheduler const* const previous_scheduler = executing_scheduler;
+
+    executing_scheduler = this;
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    WorkerTelemetry& telemetry = GetThreadTelemetry();
+    RkUint64 const   start     = WorkerTelemetry::Now();
+
+    telemetry.Add   (telemetry.jobs_executed, 1u);
+    telemetry.Record(telemetry.queue_latency, start - std::min(in_job->submit_time, start));
+
+    in_job->task();
+
+    // Suspended jobs are always resumed by the same worker, the telemetry is still the one of the calling thread
+    telemetry.Record(telemetry.run_time, WorkerTelemetry::Now() - start);
+
+    #else
+
+    in_job->task();
+
+    #endif
+
+    executing_scheduler = previous_scheduler;
+
+    // Releasing the task now frees its captures as soon as possible
+    in_job->task = nullptr;
+
+    JobNode::Link* continuation = in_job->CloseContinuations();
+    while (continuation)
+    {
+        // The link lives in the dependent node, which might be executed (and deleted) as soon as it's released
+        JobNode::Link* const next      = continuation->next;
+        JobNode*       const dependent = continuation->dependent;
+
+        if (dependent->pending_dependencies.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            Submit(dependent);
+
+        continuation = next;
+    }
+
+    in_job->RemoveReference();
+
+    // Continuations have been submitted (and accounted for) by now
+    m_pending_jobs.fetch_sub(1u, std::memory_order_acq_rel);
+    m_completion_event.NotifyAll();
+
+    // Suspended jobs might be waiting for this one, waking up their workers
+    if (m_suspended_fibers.load(std::memory_order_relaxed) > 0u)
+        m_work_event.NotifyAll();
+}
+
+RkBool Scheduler::TryGetJob(EJobPriority const in_priority, JobNode*& out_job) noexcept
+{
+    RkSize   const queue        = static_cast<RkSize>(in_priority);
+    RkUint32&      random_state = current_scheduler == this ? m_contexts[current_worker_index].random_state : external_random_state;
+    RkSize   const thief_index  = current_scheduler == this ? current_worker_index : m_workers.size();
+    RkUint32 const local_node   = GetCurrentNode();
+
+    // Local work first, then work of the local node (coming from outside of the scheduler, then from other workers)
+    if (current_scheduler == this && m_contexts[current_worker_index].queues[queue].Pop(out_job))
+        return true;
+
+    if (TryGetNodeJob(local_node, random_state, thief_index, in_priority, out_job))
+        return true;
+
+    // And finally work of the remote nodes
+    for (RkUint32 offset = 1u; offset < m_nodes_count; ++offset)
+    {
+        if (TryGetNodeJob((local_node + offset) % m_nodes_count, random_state, thief_index, in_priority, out_job))
+            return true;
+    }
+
+    return false;
+}
+
+RkBool Scheduler::TryGetJob(JobNode*& out_job) noexcept
+{
+    if (m_mode == ESchedulerMode::SharedQueue)
+    {
+        for (RkSize queue = 0u; queue < priorities_count; ++queue)
+        {
+            if (m_job_queues[queue].Dequeue(out_job))
+            {
+                if (queue == static_cast<RkSize>(EJobPriority::Critical))
+                    m_critical_jobs.fetch_sub(1u, std::memory_order_relaxed);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Searching every queue of the scheduler is expensive, critical jobs are only looked for when there are some
+    if (m_critical_jobs.load(std::memory_order_relaxed) > 0u && TryGetJob(EJobPriority::Critical, out_job))
+    {
+        m_critical_jobs.fetch_sub(1u, std::memory_order_relaxed);
+        return true;
+    }
+
+    return TryGetJob(EJobPriority::Normal, out_job) || TryGetJob(EJobPriority::Background, out_job);
+}
+
+RkBool Scheduler::ExecutePendingJob() noexcept
+{
+    JobNode* job = nullptr;
+
+    if (!TryGetJob(job))
+        return false;
+
+    Execute(job);
+    return true;
+}
+
+RkBool Scheduler::HasPendingJobs() noexcept
+{
+    for (RkSize queue = 0u; queue < priorities_count; ++queue)
+    {
+        RkBool pending = false;
+
+        if (m_mode == ESchedulerMode::SharedQueue)
+            pending = !m_job_queues[queue].Empty();
+        else if (current_scheduler == this)
+            pending = !m_contexts[current_worker_index].queues[queue].Empty();
+        else
+            pending = !m_nodes[GetCurrentNode()].queues[queue].Empty();
+
+        if (pending)
+            return true;
+    }
+
+    return false;
+}
+
+RkVoid Scheduler::WorkersJob(RkUint16 const in_worker_index) noexcept
+{
+    current_scheduler    = this;
+    current_worker_index = in_worker_index;
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    telemetry_scheduler = this;
+    telemetry_slot      = in_worker_index;
+
+    m_telemetry[in_worker_index].start_time.store(WorkerTelemetry::Now(), std::memory_order_relaxed);
+
+    #endif
+
+    FiberContext& context = m_fibers[in_worker_index];
+
+    context.thread_fiber = std::make_unique<Fiber>();
+    context.current      = context.thread_fiber->Valid() ? AcquireFiber(context) : nullptr;
+
+    // The worker loop runs on fibers, which switch back to the thread fiber once the scheduler gets shut down
+    if (context.current)
+        context.thread_fiber->SwitchTo(*context.current);
+    else
+        WorkersLoop();
+
+    // Jobs that never resumed are dropped along with their fiber
+    m_suspended_fibers.fetch_sub(context.suspended_fibers.size(), std::memory_order_relaxed);
+
+    context.suspended_fibers.clear();
+    context.free_fibers     .clear();
+    context.fibers          .clear();
+    context.current = nullptr;
+    context.thread_fiber.reset();
+
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    m_telemetry[in_worker_index].EndIdle();
+    telemetry_scheduler = nullptr;
+
+    #endif
+
+    current_scheduler = nullptr;
+}
+
+RkVoid Scheduler::WorkersLoop() noexcept
+{
+    FiberContext& context = m_fibers[current_worker_index];
+
+    RUKEN_THREADING_TELEMETRY(WorkerTelemetry& telemetry = m_telemetry[current_worker_index];)
+
+    RkUint32 idle_iteration = 0u;
+    JobNode* job            = nullptr;
 
     while (m_running.load(std::memory_order_acquire))
     {
-        // Always try to dequeue jobs, the job queue will lock us if nothing is available
-        RkBool const job_validity = m_job_queue.Dequeue(current_job);
+        // Resuming suspended jobs first, started work is completed before taking new one
+        if (!context.suspended_fibers.empty() && ResumeSuspendedFiber())
+        {
+            idle_iteration = 0u;
+            continue;
+        }
+
+        if (TryGetJob(job))
+        {
+            RUKEN_THREADING_TELEMETRY(telemetry.EndIdle();)
+
+            Execute(job);
+
+            idle_iteration = 0u;
+            continue;
+        }
+
+        #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+        if (idle_iteration == 0u)
+            telemetry.BeginIdle(WorkerTelemetry::Now());
+
+        #endif
+
+        if (m_idle_policy.Idle(idle_iteration))
+            continue;
+
+        // Out of work, parking until new jobs get submitted
+        RkUint32 const key = m_work_event.PrepareWait();
+
+        if (!m_running.load(std::memory_order_acquire))
+        {
+            m_work_event.CancelWait();
+            break;
+        }
+
+        if (TryGetJob(job))
+        {
+            m_work_event.CancelWait();
+
+            RUKEN_THREADING_TELEMETRY(telemetry.EndIdle();)
 
-        if (job_validity)
-            current_job();
+            Execute(job);
+
+            idle_iteration = 0u;
+            continue;
+        }
+
+        RUKEN_THREADING_TELEMETRY(telemetry.BeginPark();)
+
+        // Conditions of suspended jobs (fences...) cannot notify the worker, waking up periodically to check them
+        if (context.suspended_fibers.empty())
+            m_work_event.Wait(key);
+        else
+            m_work_event.WaitUntil(key, std::chrono::steady_clock::now() + std::chrono::microseconds(RUKEN_THREADING_FIBER_POLL_INTERVAL));
+
+        RUKEN_THREADING_TELEMETRY(telemetry.EndPark();)
     }
 }
+
+RkVoid Scheduler::FiberEntry(RkVoid* in_scheduler) noexcept
+{
+    Scheduler* scheduler = static_cast<Scheduler*>(in_scheduler);
+
+    scheduler->WorkersLoop();
+
+    // The scheduler has been shut down, handing the thread back to the worker. This fiber is never resumed
+    FiberContext& context = scheduler->m_fibers[current_worker_index];
+
+    context.current->SwitchTo(*context.thread_fiber);
+}
+
+Fiber* Scheduler::AcquireFiber(FiberContext& in_context) noexcept
+{
+    if (!in_context.free_fibers.empty())
+    {
+        Fiber* fiber = in_context.free_fibers.back();
+
+        in_context.free_fibers.pop_back();
+
+        return fiber;
+    }
+
+    std::unique_ptr<Fiber> fiber = std::make_unique<Fiber>(&Scheduler::FiberEntry, this, RUKEN_THREADING_FIBER_STACK_SIZE);
+
+    if (!fiber->Valid())
+        return nullptr;
+
+    in_context.fibers.push_back(std::move(fiber));
+
+    return in_context.fibers.back().get();
+}
+
+RkVoid Scheduler::Suspend(RkBool (*in_ready)(RkVoid const*), RkVoid const* in_predicate) noexcept
+{
+    FiberContext& context = m_fibers[current_worker_index];
+    Fiber*        next    = AcquireFiber(context);
+
+    // Out of memory for a new fiber, the job has no other choice but to block its worker
+    if (!next)
+    {
+        HelpUntil([in_ready, in_predicate] {
+            return in_ready(in_predicate);
+        }, true);
+
+        return;
+    }
+
+    Fiber* suspended = context.current;
+
+    // The worker carries on without the data of the suspended job, nor any stale pointer to it
+    context.suspended_fibers.push_back(SuspendedFiber {suspended, in_ready, in_predicate, std::exchange(current_job_data, nullptr)});
+    context.current = next;
+
+    m_suspended_fibers.fetch_add(1u, std::memory_order_relaxed);
+
+    // Returns once the worker resumes this fiber, see ResumeSuspendedFiber()
+    suspended->SwitchTo(*next);
+}
+
+RkBool Scheduler::ResumeSuspendedFiber() noexcept
+{
+    FiberContext& context = m_fibers[current_worker_index];
+
+    for (RkSize index = 0; index < context.suspended_fibers.size(); ++index)
+    {
+        SuspendedFiber const suspended = context.suspended_fibers[index];
+
+        if (!suspended.ready(suspended.predicate))
+            continue;
+
+        context.suspended_fibers[index] = context.suspended_fibers.back();
+        context.suspended_fibers.pop_back();
+
+        m_suspended_fibers.fetch_sub(1u, std::memory_order_relaxed);
+
+        RUKEN_THREADING_TELEMETRY(m_telemetry[current_worker_index].EndIdle();)
+
+        // The current fiber is sitting in the worker loop, it will carry on from here the next time it gets acquired
+        Fiber* current = context.current;
+
+        context.free_fibers.push_back(current);
+        context.current = suspended.fiber;
+
+        current_job_data = suspended.job_data;
+
+        current->SwitchTo(*suspended.fiber);
+
+        return true;
+    }
+
+    return false;
+}
+
+RkBool Scheduler::CanSuspend() const noexcept
+{
+    return current_scheduler == this && m_fibers[current_worker_index].current != nullptr;
+}
+
+RkVoid Scheduler::IOWorkersJob([[maybe_unused]] RkUint16 const in_worker_index) noexcept
+{
+    #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+    telemetry_scheduler = this;
+    telemetry_slot      = m_workers.size() + in_worker_index;
+
+    WorkerTelemetry& telemetry = m_telemetry[telemetry_slot];
+
+    telemetry.start_time.store(WorkerTelemetry::Now(), std::memory_order_relaxed);
+
+    #endif
+
+    JobNode* job = nullptr;
+
+    while (m_running.load(std::memory_order_acquire))
+    {
+        #if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+        // I/O workers never spin, all of their idle time is spent parked
+        telemetry.BeginIdle(WorkerTelemetry::Now());
+        telemetry.BeginPark();
+
+        RkBool const dequeued = m_io_queue.Dequeue(job);
+
+        telemetry.EndPark();
+        telemetry.EndIdle();
+
+        if (dequeued)
+            Execute(job);
+
+        #else
+
+        // I/O workers are expected to block, the job queue will lock us if nothing is available
+        if (m_io_queue.Dequeue(job))
+            Execute(job);
+
+        #endif
+    }
+
+    RUKEN_THREADING_TELEMETRY(telemetry_scheduler = nullptr;)
+}
+
+#if defined(RUKEN_THREADING_ENABLE_TELEMETRY)
+
+WorkerTelemetry& Scheduler::GetThreadTelemetry() noexcept
+{
+    return m_telemetry[telemetry_scheduler == this ? telemetry_slot : m_workers.size() + m_io_workers.size()];
+}
+
+#endif
\ No newline at end of file
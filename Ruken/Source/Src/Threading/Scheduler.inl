@@ -0,0 +1,191 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TPredicate>
+RkBool Scheduler::CheckPredicate(RkVoid const* in_predicate) noexcept
+{
+    return (*static_cast<TPredicate const*>(in_predicate))();
+}
+
+template <typename TPredicate>
+RkVoid Scheduler::HelpUntil(TPredicate const& in_predicate, RkBool const in_poll) noexcept
+{
+    RkUint32 idle_iteration = 0u;
+    JobNode* job            = nullptr;
+
+    while (!in_predicate() && m_running.load(std::memory_order_acquire))
+    {
+        if (TryGetJob(job))
+        {
+            Execute(job);
+
+            idle_iteration = 0u;
+            continue;
+        }
+
+        if (m_idle_policy.Idle(idle_iteration))
+            continue;
+
+        // Parking until a job completes or new work is submitted
+        RkUint32 const key = m_completion_event.PrepareWait();
+
+        if (in_predicate() || !m_running.load(std::memory_order_acquire))
+        {
+            m_completion_event.CancelWait();
+            return;
+        }
+
+        if (TryGetJob(job))
+        {
+            m_completion_event.CancelWait();
+            Execute(job);
+
+            idle_iteration = 0u;
+            continue;
+        }
+
+        if (in_poll)
+            m_completion_event.WaitUntil(key, std::chrono::steady_clock::now() + std::chrono::microseconds(RUKEN_THREADING_FIBER_POLL_INTERVAL));
+        else
+            m_completion_event.Wait(key);
+    }
+}
+
+template <typename TPredicate>
+RkVoid Scheduler::WaitUntil(TPredicate const& in_predicate) noexcept
+{
+    if (in_predicate())
+        return;
+
+    if (CanSuspend())
+        Suspend(&CheckPredicate<TPredicate>, &in_predicate);
+    else
+        HelpUntil(in_predicate, true);
+}
+
+template <typename TFunction>
+RkVoid Scheduler::InvokeRange(TFunction& in_function, RkSize const in_begin, RkSize const in_end)
+{
+    if constexpr (std::is_invocable_v<TFunction&, RkSize, RkSize>)
+    {
+        in_function(in_begin, in_end);
+    }
+    else
+    {
+        for (RkSize index = in_begin; index < in_end; ++index)
+            in_function(index);
+    }
+}
+
+template <typename TFunction>
+RkVoid Scheduler::ProcessRange(ParallelForContext<TFunction>& in_context, RkSize in_begin, RkSize in_end) noexcept
+{
+    while (in_end - in_begin > in_context.grain)
+    {
+        // The previously split halves haven't been picked up yet, splitting further would only add overhead
+        if (HasPendingJobs())
+        {
+            RkSize const chunk_end = in_begin + in_context.grain;
+
+            InvokeRange(in_context.function, in_begin, chunk_end);
+
+            in_begin = chunk_end;
+            continue;
+        }
+
+        RkSize const middle = in_begin + (in_end - in_begin) / 2u;
+
+        in_context.pending_ranges.fetch_add(1u, std::memory_order_relaxed);
+
+        JobHandle const handle = ScheduleTask([this, &in_context, middle, in_end] {
+            ProcessRange(in_context, middle, in_end);
+
+            in_context.pending_ranges.fetch_sub(1u, std::memory_order_release);
+        });
+
+        // The scheduler has been shut down, processing the upper half right away
+        if (!handle.Valid())
+        {
+            in_context.pending_ranges.fetch_sub(1u, std::memory_order_relaxed);
+
+            InvokeRange(in_context.function, middle, in_end);
+        }
+
+        in_end = middle;
+    }
+
+    InvokeRange(in_context.function, in_begin, in_end);
+}
+
+template <typename TFunction>
+RkVoid Scheduler::ParallelFor(RkSize const in_begin, RkSize const in_end, RkSize const in_grain, TFunction&& in_function) noexcept
+{
+    if (in_begin >= in_end)
+        return;
+
+    ParallelForContext<std::remove_reference_t<TFunction>> context {in_function, std::max<RkSize>(in_grain, 1u), {0u}};
+
+    ProcessRange(context, in_begin, in_end);
+
+    auto const predicate = [&context] {
+        return context.pending_ranges.load(std::memory_order_acquire) == 0u;
+    };
+
+    if (predicate())
+        return;
+
+    // Suspending lets a worker keep resuming its own ready fibers while the other sub-ranges are processed,
+    // sub-range completions notify the scheduler so there is no need to poll when helping
+    if (CanSuspend())
+        Suspend(&CheckPredicate<decltype(predicate)>, &predicate);
+    else
+        HelpUntil(predicate);
+}
+
+template <typename TValue, typename TFunction, typename TReduction>
+TValue Scheduler::ParallelReduce(RkSize const in_begin, RkSize const in_end, RkSize const in_grain, TValue const& in_identity, TFunction&& in_function, TReduction&& in_reduction) noexcept
+{
+    TValue     result {in_identity};
+    std::mutex result_mutex;
+
+    ParallelFor(in_begin, in_end, in_grain, [&](RkSize const in_range_begin, RkSize const in_range_end) {
+        TValue partial_result {in_identity};
+
+        if constexpr (std::is_invocable_v<TFunction&, RkSize, RkSize>)
+        {
+            partial_result = in_function(in_range_begin, in_range_end);
+        }
+        else
+        {
+            for (RkSize index = in_range_begin; index < in_range_end; ++index)
+                partial_result = in_reduction(partial_result, in_function(index));
+        }
+
+        std::lock_guard<std::mutex> lock(result_mutex);
+
+        result = in_reduction(result, partial_result);
+    });
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <chrono>
+
+#include "Threading/SchedulerTelemetry.hpp"
+
+USING_RUKEN_NAMESPACE
+
+RkUint64 WorkerTelemetry::Now() noexcept
+{
+    return static_cast<RkUint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+RkVoid WorkerTelemetry::Add(std::atomic<RkUint64>& in_counter, RkUint64 const in_value) noexcept
+{
+    if (shared)
+        in_counter.fetch_add(in_value, std::memory_order_relaxed);
+    else
+        in_counter.store(in_counter.load(std::memory_order_relaxed) + in_value, std::memory_order_relaxed);
+}
+
+RkVoid WorkerTelemetry::Record(Histogram& in_histogram, RkUint64 const in_value) noexcept
+{
+    if (shared)
+        in_histogram.Record(in_value);
+    else
+        in_histogram.RecordExclusive(in_value);
+}
+
+RkVoid WorkerTelemetry::BeginIdle(RkUint64 const in_now) noexcept
+{
+    if (idle_since.load(std::memory_order_relaxed) == 0u)
+        idle_since.store(in_now, std::memory_order_relaxed);
+}
+
+RkVoid WorkerTelemetry::EndIdle() noexcept
+{
+    RkUint64 const since = idle_since.load(std::memory_order_relaxed);
+
+    if (since == 0u)
+        return;
+
+    Add(idle_time, Now() - since);
+
+    idle_since.store(0u, std::memory_order_relaxed);
+}
+
+RkVoid WorkerTelemetry::BeginPark() noexcept
+{
+    parked_since.store(Now(), std::memory_order_relaxed);
+}
+
+RkVoid WorkerTelemetry::EndPark() noexcept
+{
+    RkUint64 const since = parked_since.load(std::memory_order_relaxed);
+
+    if (since == 0u)
+        return;
+
+    Add(parked_time, Now() - since);
+
+    parked_since.store(0u, std::memory_order_relaxed);
+}
\ No newline at end of file
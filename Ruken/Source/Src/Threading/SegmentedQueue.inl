@@ -0,0 +1,270 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#pragma region Segment
+
+template <typename TType, RkSize TSegmentCapacity>
+SegmentedQueue<TType, TSegmentCapacity>::Segment::Segment() noexcept:
+    enqueue_index {0u},
+    dequeue_index {0u},
+    next          {nullptr},
+    next_retired  {nullptr}
+{
+    for (Slot& slot : slots)
+        slot.ready.store(false, std::memory_order_relaxed);
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+RkVoid SegmentedQueue<TType, TSegmentCapacity>::Segment::Reset() noexcept
+{
+    enqueue_index.store(0u     , std::memory_order_relaxed);
+    dequeue_index.store(0u     , std::memory_order_relaxed);
+    next         .store(nullptr, std::memory_order_relaxed);
+    next_retired = nullptr;
+
+    for (Slot& slot : slots)
+        slot.ready.store(false, std::memory_order_relaxed);
+}
+
+#pragma endregion
+
+#pragma region OperationGuard
+
+template <typename TType, RkSize TSegmentCapacity>
+SegmentedQueue<TType, TSegmentCapacity>::OperationGuard::OperationGuard(SegmentedQueue const& in_queue) noexcept:
+    m_queue {in_queue}
+{
+    m_queue.m_operations.fetch_add(1u, std::memory_order_seq_cst);
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+SegmentedQueue<TType, TSegmentCapacity>::OperationGuard::~OperationGuard() noexcept
+{
+    // Segments retired before this point cannot be reached by operations starting after it,
+    // they can be released if every operation that started before is done as well
+    Segment* retired = nullptr;
+
+    if (m_queue.m_retired.load(std::memory_order_relaxed))
+        retired = m_queue.m_retired.exchange(nullptr, std::memory_order_acquire);
+
+    if (m_queue.m_operations.fetch_sub(1u, std::memory_order_seq_cst) == 1u)
+    {
+        m_queue.ReleaseSegments(retired);
+        return;
+    }
+
+    // Other operations are still running, giving the segments back
+    if (retired)
+    {
+        Segment* last = retired;
+
+        while (last->next_retired)
+            last = last->next_retired;
+
+        m_queue.RetireSegments(retired, last);
+    }
+}
+
+#pragma endregion
+
+template <typename TType, RkSize TSegmentCapacity>
+SegmentedQueue<TType, TSegmentCapacity>::SegmentedQueue() noexcept:
+    m_head       {nullptr},
+    m_tail       {nullptr},
+    m_operations {0u},
+    m_retired    {nullptr},
+    m_spare      {nullptr}
+{
+    Segment* segment = new Segment();
+
+    m_head.store(segment, std::memory_order_relaxed);
+    m_tail.store(segment, std::memory_order_relaxed);
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+SegmentedQueue<TType, TSegmentCapacity>::~SegmentedQueue() noexcept
+{
+    Segment* segment = m_head.load(std::memory_order_relaxed);
+
+    // Destroying the items that haven't been dequeued
+    while (segment)
+    {
+        Segment* next = segment->next.load(std::memory_order_relaxed);
+        RkSize   end  = std::min(segment->enqueue_index.load(std::memory_order_relaxed), TSegmentCapacity);
+
+        for (RkSize index = segment->dequeue_index.load(std::memory_order_relaxed); index < end; ++index)
+            std::launder(reinterpret_cast<TType*>(segment->slots[index].storage))->~TType();
+
+        delete segment;
+        segment = next;
+    }
+
+    ReleaseSegments(m_retired.exchange(nullptr, std::memory_order_relaxed));
+
+    delete m_spare.exchange(nullptr, std::memory_order_relaxed);
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+typename SegmentedQueue<TType, TSegmentCapacity>::Segment* SegmentedQueue<TType, TSegmentCapacity>::AcquireSegment() noexcept
+{
+    Segment* segment = m_spare.exchange(nullptr, std::memory_order_acquire);
+
+    if (!segment)
+        return new Segment();
+
+    segment->Reset();
+
+    return segment;
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+RkVoid SegmentedQueue<TType, TSegmentCapacity>::ReleaseSegments(Segment* in_segments) const noexcept
+{
+    while (in_segments)
+    {
+        Segment* next     = in_segments->next_retired;
+        Segment* expected = nullptr;
+
+        if (!m_spare.compare_exchange_strong(expected, in_segments, std::memory_order_release, std::memory_order_relaxed))
+            delete in_segments;
+
+        in_segments = next;
+    }
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+RkVoid SegmentedQueue<TType, TSegmentCapacity>::RetireSegments(Segment* in_first, Segment* in_last) const noexcept
+{
+    Segment* head = m_retired.load(std::memory_order_relaxed);
+
+    do
+    {
+        in_last->next_retired = head;
+    }
+    while (!m_retired.compare_exchange_weak(head, in_first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+RkBool SegmentedQueue<TType, TSegmentCapacity>::TryEnqueue(TType&& in_item) noexcept
+{
+    OperationGuard const guard(*this);
+
+    for (;;)
+    {
+        Segment*     segment = m_tail.load(std::memory_order_acquire);
+        RkSize const index   = segment->enqueue_index.fetch_add(1u, std::memory_order_relaxed);
+
+        if (index < TSegmentCapacity)
+        {
+            Slot& slot = segment->slots[index];
+
+            new (slot.storage) TType(std::move(in_item));
+
+            slot.ready.store(true, std::memory_order_release);
+
+            return true;
+        }
+
+        // The segment is full, linking a new one if no other producer did it already
+        Segment* next = segment->next.load(std::memory_order_acquire);
+
+        if (!next)
+        {
+            Segment* created = AcquireSegment();
+
+            if (segment->next.compare_exchange_strong(next, created, std::memory_order_acq_rel, std::memory_order_acquire))
+                next = created;
+            else
+                ReleaseSegments(created);
+        }
+
+        m_tail.compare_exchange_strong(segment, next, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+RkBool SegmentedQueue<TType, TSegmentCapacity>::TryDequeue(TType& out_item) noexcept
+{
+    OperationGuard const guard(*this);
+
+    for (;;)
+    {
+        Segment* segment = m_head.load(std::memory_order_acquire);
+        RkSize   index   = segment->dequeue_index.load(std::memory_order_acquire);
+
+        // Every slot of the segment has been consumed, moving on to the next one
+        if (index >= TSegmentCapacity)
+        {
+            Segment* next = segment->next.load(std::memory_order_acquire);
+
+            if (!next)
+                return false;
+
+            // The tail is never left behind the head, so that retired segments can't be reached anymore
+            Segment* tail = segment;
+            m_tail.compare_exchange_strong(tail, next, std::memory_order_acq_rel, std::memory_order_relaxed);
+
+            if (m_head.compare_exchange_strong(segment, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+                RetireSegments(segment, segment);
+
+            continue;
+        }
+
+        if (index >= std::min(segment->enqueue_index.load(std::memory_order_acquire), TSegmentCapacity))
+            return false;
+
+        if (!segment->dequeue_index.compare_exchange_weak(index, index + 1u, std::memory_order_acq_rel, std::memory_order_relaxed))
+            continue;
+
+        Slot& slot = segment->slots[index];
+
+        // The producer claimed the slot but might still be moving the item in
+        while (!slot.ready.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        TType* item = std::launder(reinterpret_cast<TType*>(slot.storage));
+
+        out_item = std::move(*item);
+        item->~TType();
+
+        return true;
+    }
+}
+
+template <typename TType, RkSize TSegmentCapacity>
+RkBool SegmentedQueue<TType, TSegmentCapacity>::Empty() const noexcept
+{
+    OperationGuard const guard(*this);
+
+    Segment*     segment = m_head.load(std::memory_order_acquire);
+    RkSize const index   = segment->dequeue_index.load(std::memory_order_acquire);
+
+    if (index < std::min(segment->enqueue_index.load(std::memory_order_acquire), TSegmentCapacity))
+        return false;
+
+    // The head segment is consumed, items might be waiting in the next one
+    Segment* next = segment->next.load(std::memory_order_acquire);
+
+    return !next || next->dequeue_index.load(std::memory_order_acquire) >= std::min(next->enqueue_index.load(std::memory_order_acquire), TSegmentCapacity);
+}
\ No newline at end of file
@@ -42,7 +42,12 @@ RkVoid ThreadSafeLockQueue<TType>::Enqueue(TType&& in_item) noexcept
 {
     {
         QueueWriteAccess access(m_queue);
-        access->push(in_item);
+        access->push(std::move(in_item));
+    }
+
+    // Taking the push mutex makes sure that a waiting thread cannot miss the notification
+    {
+        std::lock_guard<std::mutex> push_lock(m_push_mutex);
     }
 
     m_push_notification.notify_one();
@@ -71,8 +76,34 @@ RkBool ThreadSafeLockQueue<TType>::Dequeue(TType& out_item) noexcept
 
     QueueWriteAccess access(m_queue);
 
+    // Another consumer might have emptied the queue in the meantime, waiting again
+    if (access->empty())
+    {
+        access.GetLock().unlock();
+
+        return Dequeue(out_item);
+    }
+
     // Popping a new data
-    out_item = access->front();
+    out_item = std::move(access->front());
+    access->pop();
+
+    // If the queue is empty, notifying the waitUntilEmpty() method
+    if (access->empty())
+        m_empty_notification.notify_all();
+
+    return true;
+}
+
+template<typename TType>
+RkBool ThreadSafeLockQueue<TType>::TryDequeue(TType& out_item) noexcept
+{
+    QueueWriteAccess access(m_queue);
+
+    if (access->empty())
+        return false;
+
+    out_item = std::move(access->front());
     access->pop();
 
     // If the queue is empty, notifying the waitUntilEmpty() method
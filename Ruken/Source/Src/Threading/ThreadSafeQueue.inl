@@ -22,27 +22,32 @@
  *  SOFTWARE.
  */
 
-template <typename TType>
-RkBool ThreadSafeQueue<TType>::Empty() const noexcept
-{
-    QueueReadAccess access(m_queue);
+template <typename TType, typename TStorage>
+ThreadSafeQueue<TType, TStorage>::ThreadSafeQueue(RkSize const in_capacity):
+    m_queue {in_capacity}
+{}
 
-    return access->empty();
+template <typename TType, typename TStorage>
+RkBool ThreadSafeQueue<TType, TStorage>::Empty() const noexcept
+{
+    return m_queue.Empty();
 }
 
-template <typename TType>
-RkVoid ThreadSafeQueue<TType>::Enqueue(TType&& in_item) noexcept
+template <typename TType, typename TStorage>
+RkVoid ThreadSafeQueue<TType, TStorage>::Enqueue(TType&& in_item) noexcept
 {
-    QueueWriteAccess access(m_queue);
+    while (!m_queue.TryEnqueue(std::forward<TType>(in_item)))
+        std::this_thread::yield();
+}
 
-    access->emplace_back(std::forward<TType>(in_item));
+template <typename TType, typename TStorage>
+RkBool ThreadSafeQueue<TType, TStorage>::TryEnqueue(TType&& in_item) noexcept
+{
+    return m_queue.TryEnqueue(std::forward<TType>(in_item));
 }
 
-template <typename TType>
-RkVoid ThreadSafeQueue<TType>::Dequeue(TType& out_item) noexcept
+template <typename TType, typename TStorage>
+RkBool ThreadSafeQueue<TType, TStorage>::Dequeue(TType& out_item) noexcept
 {
-    QueueWriteAccess access(m_queue);
-    
-    out_item = std::move(access->front());
-    access->pop_front();
+    return m_queue.TryDequeue(out_item);
 }
\ No newline at end of file
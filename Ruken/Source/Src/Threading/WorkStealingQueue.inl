@@ -0,0 +1,158 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+template <typename TType>
+WorkStealingQueue<TType>::Buffer::Buffer(RkInt64 const in_capacity):
+    mask  {in_capacity - 1},
+    items {std::make_unique<std::atomic<TType>[]>(static_cast<RkSize>(in_capacity))}
+{}
+
+template <typename TType>
+RkInt64 WorkStealingQueue<TType>::Buffer::Capacity() const noexcept
+{
+    return mask + 1;
+}
+
+template <typename TType>
+TType WorkStealingQueue<TType>::Buffer::Load(RkInt64 const in_index) const noexcept
+{
+    return items[in_index & mask].load(std::memory_order_relaxed);
+}
+
+template <typename TType>
+RkVoid WorkStealingQueue<TType>::Buffer::Store(RkInt64 const in_index, TType in_item) noexcept
+{
+    items[in_index & mask].store(in_item, std::memory_order_relaxed);
+}
+
+template <typename TType>
+WorkStealingQueue<TType>::WorkStealingQueue(RkInt64 const in_capacity):
+    m_top     {0},
+    m_bottom  {0},
+    m_buffer  {nullptr},
+    m_buffers {}
+{
+    m_buffers.emplace_back(std::make_unique<Buffer>(in_capacity));
+    m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+template <typename TType>
+typename WorkStealingQueue<TType>::Buffer* WorkStealingQueue<TType>::Grow(RkInt64 const in_top, RkInt64 const in_bottom)
+{
+    Buffer* old_buffer = m_buffer.load(std::memory_order_relaxed);
+
+    m_buffers.emplace_back(std::make_unique<Buffer>(old_buffer->Capacity() * 2));
+    Buffer* new_buffer = m_buffers.back().get();
+
+    for (RkInt64 index = in_top; index < in_bottom; ++index)
+        new_buffer->Store(index, old_buffer->Load(index));
+
+    // The old buffer is kept alive since a thief might still be reading from it
+    m_buffer.store(new_buffer, std::memory_order_release);
+
+    return new_buffer;
+}
+
+template <typename TType>
+RkVoid WorkStealingQueue<TType>::Push(TType in_item)
+{
+    RkInt64 const bottom = m_bottom.load(std::memory_order_relaxed);
+    RkInt64 const top    = m_top   .load(std::memory_order_acquire);
+    Buffer*       buffer = m_buffer.load(std::memory_order_relaxed);
+
+    if (bottom - top > buffer->Capacity() - 1)
+        buffer = Grow(top, bottom);
+
+    buffer->Store(bottom, in_item);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename TType>
+RkBool WorkStealingQueue<TType>::Pop(TType& out_item) noexcept
+{
+    RkInt64 const bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Buffer*       buffer = m_buffer.load(std::memory_order_relaxed);
+
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    RkInt64 top = m_top.load(std::memory_order_relaxed);
+
+    // The deque was empty, restoring the bottom index
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    out_item = buffer->Load(bottom);
+
+    // More than one item left, no possible race with thieves
+    if (top != bottom)
+        return true;
+
+    // Last item, racing against thieves for it
+    RkBool const won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+    return won;
+}
+
+template <typename TType>
+RkBool WorkStealingQueue<TType>::Steal(TType& out_item) noexcept
+{
+    RkInt64 top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    RkInt64 const bottom = m_bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return false;
+
+    TType const item = m_buffer.load(std::memory_order_acquire)->Load(top);
+
+    // Another thief or the owner got the item first
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    out_item = item;
+
+    return true;
+}
+
+template <typename TType>
+RkBool WorkStealingQueue<TType>::Empty() const noexcept
+{
+    return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+}
+
+template <typename TType>
+RkSize WorkStealingQueue<TType>::Size() const noexcept
+{
+    RkInt64 const size = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+
+    return size > 0 ? static_cast<RkSize>(size) : 0u;
+}
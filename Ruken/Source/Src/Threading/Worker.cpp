@@ -22,7 +22,19 @@
  *  SOFTWARE.
  */
 
+#include "Build/OperatingSystem.hpp"
 #include "Threading/Worker.hpp"
+#include "Debug/Logging/Logger.hpp"
+
+#if defined(RUKEN_OS_WINDOWS)
+    #include "Utility/WindowsOS.hpp"
+#elif defined(RUKEN_OS_LINUX)
+    #include <sched.h>
+    #include <unistd.h>
+    #include <pthread.h>
+    #include <sys/syscall.h>
+    #include <sys/resource.h>
+#endif
 
 USING_RUKEN_NAMESPACE
 
@@ -30,13 +42,19 @@ USING_RUKEN_NAMESPACE
 #ifdef RUKEN_THREADING_ENABLE_THREAD_LABELS
 
 Worker::Worker(RkChar const* in_label) noexcept:
-    m_thread {},
-    m_label  {in_label}
+    m_thread   {},
+    m_affinity {},
+    m_priority {EThreadPriority::Normal},
+    m_logger   {nullptr},
+    m_label    {in_label}
 {}
 
 Worker::Worker() noexcept:
-    m_thread {},
-    m_label  {"Unlabeled"}
+    m_thread   {},
+    m_affinity {},
+    m_priority {EThreadPriority::Normal},
+    m_logger   {nullptr},
+    m_label    {"Unlabeled"}
 {}
 
 std::string const& Worker::Label() const noexcept
@@ -52,11 +70,17 @@ std::string& Worker::Label() noexcept
 #else // Label disabled code
 
 Worker::Worker(RkChar const*) noexcept:
-    m_thread {}
+    m_thread   {},
+    m_affinity {},
+    m_priority {EThreadPriority::Normal},
+    m_logger   {nullptr}
 {}
 
 Worker::Worker() noexcept:
-    m_thread {}
+    m_thread   {},
+    m_affinity {},
+    m_priority {EThreadPriority::Normal},
+    m_logger   {nullptr}
 {}
 
 std::string Worker::Label() const noexcept
@@ -66,6 +90,118 @@ std::string Worker::Label() const noexcept
 
 #endif
 
+RkVoid Worker::ApplyToCurrentThread(std::vector<RkUint32> const& in_affinity,
+                                    EThreadPriority       const  in_priority,
+                                    Logger                const* in_logger,
+                                    std::string           const& in_label) noexcept
+{
+    if (!SetCurrentThreadAffinity(in_affinity) && in_logger)
+    {
+        std::string processors;
+
+        for (RkUint32 const processor : in_affinity)
+            processors += (processors.empty() ? "" : ",") + std::to_string(processor);
+
+        in_logger->Warning("Failed to restrict " + (in_label.empty() ? std::string("a worker") : in_label) + " to the processors {" + processors + "}, it may run on any processor");
+    }
+
+    SetCurrentThreadPriority(in_priority);
+}
+
+RkBool Worker::SetCurrentThreadAffinity(std::vector<RkUint32> const& in_processors) noexcept
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    DWORD_PTR mask = 0u;
+
+    for (RkUint32 const processor : in_processors)
+    {
+        if (processor < sizeof(DWORD_PTR) * 8u)
+            mask |= static_cast<DWORD_PTR>(1u) << processor;
+    }
+
+    // Allowing every processor of the process
+    if (mask == 0u)
+    {
+        DWORD_PTR system_mask;
+
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &system_mask))
+            return false;
+    }
+
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0u;
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (RkUint32 const processor : in_processors)
+    {
+        if (processor < CPU_SETSIZE)
+            CPU_SET(processor, &set);
+    }
+
+    // Allowing every processor of the process
+    if (CPU_COUNT(&set) == 0 && sched_getaffinity(0, sizeof(cpu_set_t), &set) != 0)
+        return false;
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+
+    #else
+
+    return in_processors.empty();
+
+    #endif
+}
+
+RkBool Worker::SetCurrentThreadPriority(EThreadPriority const in_priority) noexcept
+{
+    #if defined(RUKEN_OS_WINDOWS)
+
+    static constexpr RkInt32 priorities[] = {THREAD_PRIORITY_LOWEST, THREAD_PRIORITY_BELOW_NORMAL, THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_ABOVE_NORMAL, THREAD_PRIORITY_HIGHEST};
+
+    return SetThreadPriority(GetCurrentThread(), priorities[static_cast<RkSize>(in_priority)]) != 0;
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    // On Linux, the niceness of a SCHED_OTHER thread is set through its thread id
+    static constexpr RkInt32 niceness[] = {10, 5, 0, -5, -10};
+
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceness[static_cast<RkSize>(in_priority)]) == 0;
+
+    #else
+
+    return in_priority == EThreadPriority::Normal;
+
+    #endif
+}
+
+RkVoid Worker::SetAffinity(std::vector<RkUint32> const& in_processors) noexcept
+{
+    m_affinity = in_processors;
+}
+
+std::vector<RkUint32> const& Worker::GetAffinity() const noexcept
+{
+    return m_affinity;
+}
+
+RkVoid Worker::SetLogger(Logger const* in_logger) noexcept
+{
+    m_logger = in_logger;
+}
+
+RkVoid Worker::SetPriority(EThreadPriority const in_priority) noexcept
+{
+    m_priority = in_priority;
+}
+
+EThreadPriority Worker::GetPriority() const noexcept
+{
+    return m_priority;
+}
+
 Worker::~Worker() noexcept
 {
     if (m_thread.joinable())
@@ -85,7 +221,7 @@ RkVoid Worker::WaitForAvailability() noexcept
 
 RkVoid Worker::Detach() noexcept
 {
-    if (!m_thread.joinable())
+    if (m_thread.joinable())
         m_thread.detach();
 }
 
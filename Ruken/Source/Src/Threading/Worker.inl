@@ -28,7 +28,11 @@ RkVoid Worker::Execute(TExecutable in_job, TArgs... in_args) noexcept
     // This avoids an std::terminate throw
     WaitForAvailability();
 
-    m_thread = std::thread {in_job, in_args...};
+    m_thread = std::thread {[affinity = m_affinity, priority = m_priority, logger = m_logger, label = Label(), in_job, in_args...] {
+        ApplyToCurrentThread(affinity, priority, logger, label);
+
+        std::invoke(in_job, in_args...);
+    }};
 }
 
 template <typename TExecutable, typename ...TArgs>
@@ -37,5 +41,9 @@ RkVoid Worker::ExecuteWithInstance(TExecutable in_job, TArgs... in_args) noexcep
     // This avoids an std::terminate throw
     WaitForAvailability();
 
-    m_thread = std::thread{in_job, in_args..., this};
+    m_thread = std::thread {[affinity = m_affinity, priority = m_priority, logger = m_logger, label = Label(), in_job, in_args..., this] {
+        ApplyToCurrentThread(affinity, priority, logger, label);
+
+        std::invoke(in_job, in_args..., this);
+    }};
 }
\ No newline at end of file
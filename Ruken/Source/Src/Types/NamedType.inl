@@ -35,12 +35,12 @@ constexpr NamedType<TBase, TUniquePhantom>::NamedType(TBase const& in_base) noex
 
 template <typename TBase, typename TUniquePhantom>
 constexpr NamedType<TBase, TUniquePhantom>::NamedType(NamedType const& in_copy) noexcept(std::is_nothrow_copy_constructible_v<TBase>):
-    m_value {in_copy}
+    m_value {in_copy.m_value}
 {}
 
 template <typename TBase, typename TUniquePhantom>
 constexpr NamedType<TBase, TUniquePhantom>::NamedType(NamedType&& in_move) noexcept(std::is_nothrow_move_constructible_v<TBase>):
-    m_value {std::forward<TBase>(in_move)}
+    m_value {std::move(in_move.m_value)}
 {}
 
 template <typename TBase, typename TUniquePhantom>
@@ -64,7 +64,7 @@ template <typename TBase, typename TUniquePhantom>
 constexpr NamedType<TBase, TUniquePhantom>& NamedType<TBase, TUniquePhantom>::
     operator=(NamedType const& in_copy) noexcept(std::is_nothrow_copy_assignable_v<TBase>)
 {
-    m_value = std::forward<TBase>(in_copy.m_value);
+    m_value = in_copy.m_value;
     return *this;
 }
 
@@ -72,6 +72,6 @@ template <typename TBase, typename TUniquePhantom>
 constexpr NamedType<TBase, TUniquePhantom>& NamedType<TBase, TUniquePhantom>::
     operator=(NamedType&& in_move) noexcept(std::is_nothrow_move_assignable_v<TBase>)
 {
-    m_value = std::forward<TBase>(in_move.m_value);
+    m_value = std::move(in_move.m_value);
     return *this;
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*
+ *  MIT License
+ *
+ *  Copyright (c) 2019-2020 Basile Combet, Philippe Yi
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include <string>
+
+#include "Build/OperatingSystem.hpp"
+#include "Utility/MappedFile.hpp"
+
+#if defined(RUKEN_OS_WINDOWS)
+    #include "Utility/WindowsOS.hpp"
+#elif defined(RUKEN_OS_LINUX)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+USING_RUKEN_NAMESPACE
+
+MappedFile::MappedFile(std::string_view const in_path) noexcept:
+    m_data {nullptr},
+    m_size {0u}
+{
+    // The path must be null terminated
+    std::string const path(in_path);
+
+    #if defined(RUKEN_OS_WINDOWS)
+
+    HANDLE const file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER size;
+
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        // The view keeps the mapping alive, both handles can be closed right away
+        if (HANDLE const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            m_data = static_cast<RkUint8 const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = m_data ? static_cast<RkSize>(size.QuadPart) : 0u;
+
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    int const file = open(path.c_str(), O_RDONLY);
+
+    if (file == -1)
+        return;
+
+    struct stat status;
+
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        // The mapping keeps the file alive, the descriptor can be closed right away
+        RkVoid* data = mmap(nullptr, static_cast<RkSize>(status.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, file, 0);
+
+        if (data != MAP_FAILED)
+        {
+            m_data = static_cast<RkUint8 const*>(data);
+            m_size = static_cast<RkSize>(status.st_size);
+        }
+    }
+
+    close(file);
+
+    #endif
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    if (!m_data)
+        return;
+
+    #if defined(RUKEN_OS_WINDOWS)
+
+    UnmapViewOfFile(m_data);
+
+    #elif defined(RUKEN_OS_LINUX)
+
+    munmap(const_cast<RkUint8*>(m_data), m_size);
+
+    #endif
+}
+
+RkBool MappedFile::IsValid() const noexcept
+{
+    return m_data != nullptr;
+}
+
+RkUint8 const* MappedFile::GetData() const noexcept
+{
+    return m_data;
+}
+
+RkSize MappedFile::GetSize() const noexcept
+{
+    return m_size;
+}
\ No newline at end of file
@@ -26,6 +26,8 @@
 
 #include "Vulkan/Core/VulkanFence.hpp"
 
+#include "Threading/Scheduler.hpp"
+
 #include "Vulkan/Utilities/VulkanDebug.hpp"
 #include "Vulkan/Utilities/VulkanLoader.hpp"
 
@@ -71,6 +73,16 @@ RkBool VulkanFence::Reset() const noexcept
 
 RkVoid VulkanFence::Wait() const noexcept
 {
+    // Called from a job, suspending it until the fence gets signaled instead of blocking its worker
+    if (Scheduler* scheduler = Scheduler::GetCurrentScheduler())
+    {
+        scheduler->WaitUntil([this] {
+            return IsSignaled();
+        });
+
+        return;
+    }
+
     VK_CHECK(vkWaitForFences(VulkanLoader::GetLoadedDevice(), 1u, &m_handle, VK_TRUE, UINT64_MAX));
 }
 